@@ -14,6 +14,8 @@
 #include "stubext.h"
 
 #include <dfm-base/base/db/sqliteconnectionpool.h>
+#include <dfm-base/base/db/private/sqliteconnectionpool_p.h>
+#include <dfm-base/base/db/sqlitehelper.h>
 
 DFMBASE_USE_NAMESPACE
 
@@ -240,6 +242,153 @@ TEST_F(TestSqliteConnectionPool, openConnection_IsolatedConnections)
     EXPECT_EQ(count, 1);
 }
 
+// ========== Tuning and Statement Cache Tests ==========
+
+TEST_F(TestSqliteConnectionPool, openConnection_WalNotEnabled_DefaultJournal)
+{
+    // Test that WAL is only used by databases that opt in
+    QSqlDatabase db = SqliteConnectionPool::instance().openConnection(dbPath);
+    ASSERT_TRUE(db.isValid());
+
+    QSqlQuery query(db);
+    ASSERT_TRUE(query.exec("PRAGMA journal_mode;"));
+    ASSERT_TRUE(query.next());
+    EXPECT_NE(query.value(0).toString().toLower(), QString("wal"));
+}
+
+TEST_F(TestSqliteConnectionPool, openConnection_WalModeEnabled)
+{
+    // Test that new connections of an opted-in database are tuned for WAL
+    SqliteConnectionPool::instance().enableWal(dbPath);
+    QSqlDatabase db = SqliteConnectionPool::instance().openConnection(dbPath);
+    ASSERT_TRUE(db.isValid());
+
+    QSqlQuery query(db);
+    ASSERT_TRUE(query.exec("PRAGMA journal_mode;"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(query.value(0).toString().toLower(), QString("wal"));
+
+    ASSERT_TRUE(query.exec("PRAGMA synchronous;"));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(query.value(0).toInt(), 1);   // NORMAL
+}
+
+TEST_F(TestSqliteConnectionPool, preparedQuery_SameSql_ReturnsCachedStatement)
+{
+    // Test that the same SQL text reuses one prepared statement
+    QSqlDatabase db = SqliteConnectionPool::instance().openConnection(dbPath);
+    ASSERT_TRUE(db.isValid());
+    QSqlQuery setup(db);
+    ASSERT_TRUE(setup.exec("CREATE TABLE cached (id INTEGER PRIMARY KEY, name TEXT);"));
+    ASSERT_TRUE(setup.exec("INSERT INTO cached (id, name) VALUES (1, 'one');"));
+
+    const QString sql("SELECT name FROM cached WHERE id = ?;");
+    QSharedPointer<QSqlQuery> query1 = SqliteConnectionPool::instance().preparedQuery(dbPath, sql);
+    ASSERT_FALSE(query1.isNull());
+    query1->bindValue(0, 1);
+    ASSERT_TRUE(query1->exec());
+    ASSERT_TRUE(query1->next());
+    EXPECT_EQ(query1->value(0).toString(), QString("one"));
+    query1->finish();
+
+    QSharedPointer<QSqlQuery> query2 = SqliteConnectionPool::instance().preparedQuery(dbPath, sql);
+    EXPECT_EQ(query1, query2);
+
+    QSharedPointer<QSqlQuery> other = SqliteConnectionPool::instance().preparedQuery(dbPath, "SELECT id FROM cached;");
+    ASSERT_FALSE(other.isNull());
+    EXPECT_NE(other, query1);
+}
+
+TEST_F(TestSqliteConnectionPool, preparedQuery_InvalidSql_ReturnsNull)
+{
+    // Test that statements failing to prepare are not cached
+    EXPECT_TRUE(SqliteConnectionPool::instance().preparedQuery(dbPath, "SELECT * FROM missing_table;").isNull());
+}
+
+TEST_F(TestSqliteConnectionPool, excutePrepared_NestedWithCapacityOne_OuterStatementStaysValid)
+{
+    // Test that a nested prepared call evicting the outer statement does not free it while in use
+    QSqlDatabase db = SqliteConnectionPool::instance().openConnection(dbPath);
+    ASSERT_TRUE(db.isValid());
+    QSqlQuery setup(db);
+    ASSERT_TRUE(setup.exec("CREATE TABLE nested (id INTEGER PRIMARY KEY, name TEXT);"));
+    ASSERT_TRUE(setup.exec("INSERT INTO nested (id, name) VALUES (1, 'one'), (2, 'two'), (3, 'three');"));
+
+    auto *pool = &SqliteConnectionPool::instance();
+    SqliteThreadConnections *conns = pool->d->threadConnections();
+    const int oldMax = conns->maxStatements;
+    conns->maxStatements = 1;
+
+    const QString outerSql("SELECT name FROM nested WHERE id >= ? ORDER BY id;");
+    const QString innerSql("SELECT name FROM nested WHERE id = ?;");
+    QStringList outerNames;
+    QStringList innerNames;
+    auto readInner = [&innerNames](QSqlQuery *inner) {
+        if (inner->next())
+            innerNames.append(inner->value(0).toString());
+    };
+    auto readOuter = [&](QSqlQuery *outer) {
+        while (outer->next()) {
+            outerNames.append(outer->value(0).toString());
+            // 不同 SQL 会把外层语句挤出缓存，相同 SQL 不能复用仍在执行的外层语句
+            SqliteHelper::excutePrepared(dbPath, innerSql, { 1 }, nullptr, readInner);
+            SqliteHelper::excutePrepared(dbPath, outerSql, { 3 }, nullptr, readInner);
+        }
+    };
+    const bool ok = SqliteHelper::excutePrepared(dbPath, outerSql, { 1 }, nullptr, readOuter);
+
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(outerNames, QStringList({ "one", "two", "three" }));
+    EXPECT_EQ(innerNames, QStringList({ "one", "three", "one", "three", "one", "three" }));
+    EXPECT_EQ(conns->statements.size(), 1);
+    EXPECT_EQ(conns->statementOrder.size(), 1);
+
+    conns->maxStatements = oldMax;
+}
+
+TEST_F(TestSqliteConnectionPool, preparedQuery_DroppedWhileHeld_StatementStaysAlive)
+{
+    // Test that dropping the cached statements keeps a statement alive for its holder
+    QSqlDatabase db = SqliteConnectionPool::instance().openConnection(dbPath);
+    ASSERT_TRUE(db.isValid());
+
+    QSharedPointer<QSqlQuery> query = SqliteConnectionPool::instance().preparedQuery(dbPath, "SELECT 1;");
+    ASSERT_FALSE(query.isNull());
+    QWeakPointer<QSqlQuery> weak = query;
+
+    SqliteConnectionPool::instance().d->threadConnections()->dropStatements(db.connectionName());
+    EXPECT_FALSE(weak.isNull());
+    EXPECT_TRUE(query->exec());
+
+    query.reset();
+    EXPECT_TRUE(weak.isNull());
+}
+
+TEST_F(TestSqliteConnectionPool, reportError_NextOpenChecksAndReuses)
+{
+    // Test that a reported error triggers a health check but keeps a healthy connection
+    QSqlDatabase db1 = SqliteConnectionPool::instance().openConnection(dbPath);
+    ASSERT_TRUE(db1.isOpen());
+
+    SqliteConnectionPool::instance().reportError(dbPath);
+
+    QSqlDatabase db2 = SqliteConnectionPool::instance().openConnection(dbPath);
+    EXPECT_TRUE(db2.isOpen());
+    EXPECT_EQ(db1.connectionName(), db2.connectionName());
+}
+
+TEST_F(TestSqliteConnectionPool, openConnection_ClosedConnection_Reopened)
+{
+    // Test that a connection closed by its user is reopened on the next request
+    QSqlDatabase db = SqliteConnectionPool::instance().openConnection(dbPath);
+    ASSERT_TRUE(db.isOpen());
+    db.close();
+
+    QSqlDatabase reopened = SqliteConnectionPool::instance().openConnection(dbPath);
+    EXPECT_TRUE(reopened.isOpen());
+    EXPECT_EQ(reopened.connectionName(), db.connectionName());
+}
+
 // ========== Error Handling Tests ==========
 
 TEST_F(TestSqliteConnectionPool, openConnection_InvalidSQL)
@@ -623,6 +623,31 @@ TEST_F(TestSqliteHandle, excute_CustomSQL)
     EXPECT_EQ(user->age(), 30);
 }
 
+TEST_F(TestSqliteHandle, excutePrepared_BindValues)
+{
+    // Test executing a parameterized statement repeatedly with different values
+    handle->createTable<User>(
+            SqliteConstraint::primary("id"),
+            SqliteConstraint::autoIncreament("id"));
+
+    const QString sql("INSERT INTO users (username, age, score) VALUES (?, ?, ?);");
+    EXPECT_TRUE(handle->excutePrepared(sql, { QString("It's"), 30, 85.5 }));
+    EXPECT_TRUE(handle->excutePrepared(sql, { QString("Second"), 31, 60.0 }));
+
+    int count { 0 };
+    EXPECT_TRUE(handle->excutePrepared("SELECT COUNT(*) FROM users WHERE age > ?;", { 29 }, [&count](QSqlQuery *query) {
+        if (query->next())
+            count = query->value(0).toInt();
+    }));
+    EXPECT_EQ(count, 2);
+
+    auto user = handle->query<User>()
+                        .where(Expression::Field<User>("age") == 30)
+                        .toBean();
+    ASSERT_TRUE(user != nullptr);
+    EXPECT_EQ(user->username(), QString("It's"));
+}
+
 // ========== Integration Tests ==========
 
 TEST_F(TestSqliteHandle, Integration_CompleteWorkflow)
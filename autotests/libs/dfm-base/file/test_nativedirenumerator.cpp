@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDir>
+#include <QSet>
+
+#include <dfm-base/file/local/nativedirenumerator.h>
+
+#include <memory>
+
+#include <unistd.h>
+
+DFMBASE_USE_NAMESPACE
+
+class TestNativeDirEnumerator : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        tempDir = std::make_unique<QTemporaryDir>();
+        ASSERT_TRUE(tempDir->isValid());
+        tempDirPath = tempDir->path();
+    }
+
+    void TearDown() override
+    {
+        tempDir.reset();
+    }
+
+    void createTestFile(const QString &name, const QByteArray &content = QByteArray("test"))
+    {
+        QFile file(tempDirPath + "/" + name);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(content);
+    }
+
+    QHash<QString, NativeDirEnumerator::Entry> readAll(NativeDirEnumerator &enumerator, int batchSize, int *batchCount = nullptr)
+    {
+        QHash<QString, NativeDirEnumerator::Entry> result;
+        NativeDirEnumerator::Batch batch;
+        int count = 0;
+        while (enumerator.nextBatch(&batch, batchSize)) {
+            EXPECT_LE(batch.entries.size(), batchSize);
+            for (const auto &entry : std::as_const(batch.entries))
+                result.insert(batch.fileName(entry), entry);
+            ++count;
+        }
+        if (batchCount)
+            *batchCount = count;
+        return result;
+    }
+
+    std::unique_ptr<QTemporaryDir> tempDir;
+    QString tempDirPath;
+};
+
+TEST_F(TestNativeDirEnumerator, Open_NonExistentDir_ExpectedFailure)
+{
+    NativeDirEnumerator enumerator(tempDirPath + "/not-exists");
+    EXPECT_FALSE(enumerator.open());
+    EXPECT_NE(enumerator.error(), 0);
+
+    NativeDirEnumerator::Batch batch;
+    EXPECT_FALSE(enumerator.nextBatch(&batch, 10));
+}
+
+TEST_F(TestNativeDirEnumerator, NextBatch_EmptyDir_ExpectedNoEntries)
+{
+    NativeDirEnumerator enumerator(tempDirPath);
+    ASSERT_TRUE(enumerator.open());
+
+    NativeDirEnumerator::Batch batch;
+    EXPECT_FALSE(enumerator.nextBatch(&batch, 10));
+    EXPECT_TRUE(batch.entries.isEmpty());
+}
+
+TEST_F(TestNativeDirEnumerator, NextBatch_MixedEntries_ExpectedAttributes)
+{
+    createTestFile("file.txt", QByteArray(1234, 'x'));
+    createTestFile(".dotfile");
+    createTestFile("listed");
+    ASSERT_TRUE(QDir(tempDirPath).mkdir("subdir"));
+    ASSERT_TRUE(QFile::link(tempDirPath + "/subdir", tempDirPath + "/link-to-dir"));
+
+    NativeDirEnumerator enumerator(tempDirPath);
+    ASSERT_TRUE(enumerator.open());
+    enumerator.setHiddenNames({ "listed" });
+
+    const auto entries = readAll(enumerator, 100);
+    EXPECT_EQ(entries.size(), 5);
+    EXPECT_FALSE(entries.contains("."));
+    EXPECT_FALSE(entries.contains(".."));
+
+    const auto &file = entries.value("file.txt");
+    EXPECT_TRUE(file.isFile);
+    EXPECT_FALSE(file.isDir);
+    EXPECT_EQ(file.size, 1234);
+    EXPECT_FALSE(file.isHidden);
+    EXPECT_GT(file.lastModified, 0);
+
+    EXPECT_TRUE(entries.value(".dotfile").isHidden);
+    EXPECT_TRUE(entries.value("listed").isHidden);
+
+    EXPECT_TRUE(entries.value("subdir").isDir);
+    EXPECT_FALSE(entries.value("subdir").isSymlink);
+
+    const auto &link = entries.value("link-to-dir");
+    EXPECT_TRUE(link.isSymlink);
+    EXPECT_TRUE(link.isDir);
+}
+
+TEST_F(TestNativeDirEnumerator, NextBatch_Permissions_ExpectedEffectiveAccess)
+{
+    createTestFile("owner-none");
+    createTestFile("read-only");
+    createTestFile("script");
+    ASSERT_TRUE(QFile::setPermissions(tempDirPath + "/owner-none", QFile::ReadGroup | QFile::ReadOther));
+    ASSERT_TRUE(QFile::setPermissions(tempDirPath + "/read-only", QFile::ReadOwner));
+    ASSERT_TRUE(QFile::setPermissions(tempDirPath + "/script", QFile::ReadOwner | QFile::WriteOwner | QFile::ExeOwner));
+
+    NativeDirEnumerator enumerator(tempDirPath);
+    ASSERT_TRUE(enumerator.open());
+    const auto entries = readAll(enumerator, 100);
+    ASSERT_EQ(entries.size(), 3);
+
+    // 结果与 access() 一致，root 等特权用户不受属主位限制
+    for (auto it = entries.cbegin(); it != entries.cend(); ++it) {
+        const QByteArray path = QFile::encodeName(tempDirPath + "/" + it.key());
+        EXPECT_EQ(it.value().readable, ::access(path.constData(), R_OK) == 0) << it.key().toStdString();
+        EXPECT_EQ(it.value().writable, ::access(path.constData(), W_OK) == 0) << it.key().toStdString();
+        EXPECT_EQ(it.value().executable, ::access(path.constData(), X_OK) == 0) << it.key().toStdString();
+    }
+
+    EXPECT_TRUE(entries.value("script").executable);
+    EXPECT_FALSE(entries.value("read-only").executable);
+}
+
+TEST_F(TestNativeDirEnumerator, NextBatch_SmallBatchSize_ExpectedAllEntriesInBatches)
+{
+    const int fileCount = 250;
+    for (int i = 0; i < fileCount; ++i)
+        createTestFile(QString("file_%1").arg(i));
+
+    NativeDirEnumerator enumerator(tempDirPath);
+    ASSERT_TRUE(enumerator.open());
+
+    int batchCount = 0;
+    const auto entries = readAll(enumerator, 16, &batchCount);
+    EXPECT_EQ(entries.size(), fileCount);
+    EXPECT_EQ(batchCount, (fileCount + 15) / 16);
+    for (int i = 0; i < fileCount; ++i)
+        EXPECT_TRUE(entries.contains(QString("file_%1").arg(i)));
+}
+
+TEST_F(TestNativeDirEnumerator, Batch_FileName_ExpectedNonAsciiName)
+{
+    createTestFile("中文文件名.txt");
+
+    NativeDirEnumerator enumerator(tempDirPath);
+    ASSERT_TRUE(enumerator.open());
+
+    const auto entries = readAll(enumerator, 10);
+    EXPECT_TRUE(entries.contains("中文文件名.txt"));
+}
+
+TEST_F(TestNativeDirEnumerator, SetTypeOnly_ExpectedTypesWithoutFollowingLinks)
+{
+    createTestFile("file.txt", QByteArray(1234, 'x'));
+    ASSERT_TRUE(QDir(tempDirPath).mkdir("subdir"));
+    ASSERT_TRUE(QFile::link(tempDirPath + "/subdir", tempDirPath + "/link-to-dir"));
+
+    NativeDirEnumerator enumerator(tempDirPath);
+    enumerator.setTypeOnly(true);
+    ASSERT_TRUE(enumerator.open());
+
+    const auto entries = readAll(enumerator, 100);
+    ASSERT_EQ(entries.size(), 3);
+    EXPECT_TRUE(entries.value("file.txt").isFile);
+    EXPECT_TRUE(entries.value("subdir").isDir);
+    EXPECT_TRUE(entries.value("link-to-dir").isSymlink);
+}
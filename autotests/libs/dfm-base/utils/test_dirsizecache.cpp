@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QThreadPool>
+
+#include <dfm-base/utils/dirsizecache.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace dfmbase;
+
+class DirSizeCacheTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        cacheFile = tempDir.filePath("dirsize.cache");
+    }
+
+    static DirSizeCache::Record makeRecord(qint64 mtime)
+    {
+        DirSizeCache::Record rec;
+        rec.mtime = mtime;
+        rec.checkedAt = QDateTime::currentSecsSinceEpoch();
+        rec.totalSize = 1000;
+        rec.allocatedSize = 4096;
+        rec.progressSize = 1000;
+        rec.fileCount = 3;
+        rec.subdirs = { "a", "b" };
+        rec.linkedFiles = { "link" };
+        return rec;
+    }
+
+    QTemporaryDir tempDir;
+    QString cacheFile;
+};
+
+TEST_F(DirSizeCacheTest, Find_SameMtime_ExpectedRecordReturned)
+{
+    DirSizeCache cache(cacheFile);
+    cache.insert(1, 2, makeRecord(100), cache.epoch());
+
+    DirSizeCache::Record rec;
+    ASSERT_TRUE(cache.find(1, 2, 100, &rec));
+    EXPECT_EQ(rec.fileCount, 3);
+    EXPECT_EQ(rec.totalSize, 1000);
+    EXPECT_EQ(rec.subdirs, QByteArrayList({ "a", "b" }));
+    EXPECT_EQ(rec.linkedFiles, QByteArrayList({ "link" }));
+}
+
+TEST_F(DirSizeCacheTest, Find_DifferentMtime_ExpectedMiss)
+{
+    DirSizeCache cache(cacheFile);
+    cache.insert(1, 2, makeRecord(100), cache.epoch());
+
+    DirSizeCache::Record rec;
+    EXPECT_FALSE(cache.find(1, 2, 101, &rec));
+    EXPECT_FALSE(cache.find(1, 3, 100, &rec));
+}
+
+TEST_F(DirSizeCacheTest, Find_ExpiredRecord_ExpectedMiss)
+{
+    DirSizeCache cache(cacheFile);
+    auto rec = makeRecord(100);
+    rec.checkedAt -= DirSizeCache::kMaxRecordAge + 1;
+    cache.insert(1, 2, rec, cache.epoch());
+
+    EXPECT_FALSE(cache.find(1, 2, 100, &rec));
+}
+
+TEST_F(DirSizeCacheTest, Insert_InvalidatedAfterEpoch_ExpectedRejected)
+{
+    DirSizeCache cache(cacheFile);
+    const quint64 epoch = cache.epoch();
+    cache.invalidate(1, 2);
+    cache.insert(1, 2, makeRecord(100), epoch);
+
+    EXPECT_EQ(cache.count(), 0);
+}
+
+TEST_F(DirSizeCacheTest, Insert_OtherDirectoryInvalidated_ExpectedInserted)
+{
+    DirSizeCache cache(cacheFile);
+    const quint64 epoch = cache.epoch();
+    cache.invalidate(7, 7);
+    cache.insert(1, 2, makeRecord(100), epoch);
+
+    EXPECT_EQ(cache.count(), 1);
+}
+
+TEST_F(DirSizeCacheTest, Insert_InvalidatedBeforeEpoch_ExpectedInserted)
+{
+    DirSizeCache cache(cacheFile);
+    cache.invalidate(1, 2);
+    cache.insert(1, 2, makeRecord(100), cache.epoch());
+
+    EXPECT_EQ(cache.count(), 1);
+}
+
+TEST_F(DirSizeCacheTest, Insert_ClearedAfterEpoch_ExpectedRejected)
+{
+    DirSizeCache cache(cacheFile);
+    const quint64 epoch = cache.epoch();
+    cache.clear();
+    cache.insert(1, 2, makeRecord(100), epoch);
+
+    EXPECT_EQ(cache.count(), 0);
+}
+
+TEST_F(DirSizeCacheTest, Insert_InvalidationsForgotten_ExpectedOlderScansRejected)
+{
+    DirSizeCache cache(cacheFile);
+    const quint64 epoch = cache.epoch();
+    for (int i = 0; i <= DirSizeCache::kMaxInvalidatedKeys; ++i)
+        cache.invalidate(100, i);
+
+    // 失效记录被清理后无法判断，更早开始的遍历不写入，之后开始的正常写入
+    cache.insert(1, 2, makeRecord(100), epoch);
+    EXPECT_EQ(cache.count(), 0);
+    cache.insert(1, 2, makeRecord(100), cache.epoch());
+    EXPECT_EQ(cache.count(), 1);
+}
+
+TEST_F(DirSizeCacheTest, Insert_RecentlyModified_ExpectedRejected)
+{
+    DirSizeCache cache(cacheFile);
+    auto rec = makeRecord(0);
+    rec.mtime = (rec.checkedAt - 1) * 1000000000;
+    cache.insert(1, 2, rec, cache.epoch());
+
+    EXPECT_EQ(cache.count(), 0);
+}
+
+TEST_F(DirSizeCacheTest, IsSupportedFileSystem_Proc_ExpectedFalse)
+{
+    const int fd = ::open("/proc", O_RDONLY | O_DIRECTORY);
+    ASSERT_GE(fd, 0);
+    EXPECT_FALSE(DirSizeCache::isSupportedFileSystem(fd));
+    ::close(fd);
+}
+
+TEST_F(DirSizeCacheTest, InvalidatePath_FileInDirectory_ExpectedParentRemoved)
+{
+    const QString dir = tempDir.filePath("dir");
+    ASSERT_TRUE(QDir().mkpath(dir));
+    struct stat statBuf;
+    ASSERT_EQ(::stat(QFile::encodeName(dir).constData(), &statBuf), 0);
+
+    DirSizeCache cache(cacheFile);
+    cache.insert(statBuf.st_dev, statBuf.st_ino, makeRecord(100), cache.epoch());
+    ASSERT_EQ(cache.count(), 1);
+
+    cache.invalidate(dir + "/file");
+    EXPECT_EQ(cache.count(), 0);
+}
+
+TEST_F(DirSizeCacheTest, InvalidateLater_FileInDirectory_ExpectedParentRemovedInPool)
+{
+    const QString dir = tempDir.filePath("dir");
+    ASSERT_TRUE(QDir().mkpath(dir));
+    struct stat statBuf;
+    ASSERT_EQ(::stat(QFile::encodeName(dir).constData(), &statBuf), 0);
+
+    DirSizeCache cache(cacheFile);
+    cache.insert(statBuf.st_dev, statBuf.st_ino, makeRecord(100), cache.epoch());
+    ASSERT_EQ(cache.count(), 1);
+
+    cache.invalidateLater(dir + "/file");
+    cache.invalidateLater(dir + "/other");
+    QThreadPool::globalInstance()->waitForDone();
+    EXPECT_EQ(cache.count(), 0);
+    EXPECT_TRUE(cache.pendingPaths.isEmpty());
+}
+
+TEST_F(DirSizeCacheTest, Save_ThenLoad_ExpectedRecordsRestored)
+{
+    {
+        DirSizeCache cache(cacheFile);
+        cache.insert(1, 2, makeRecord(100), cache.epoch());
+        cache.insert(3, 4, makeRecord(200), cache.epoch());
+        ASSERT_TRUE(cache.save());
+    }
+
+    DirSizeCache cache(cacheFile);
+    EXPECT_EQ(cache.count(), 2);
+    DirSizeCache::Record rec;
+    ASSERT_TRUE(cache.find(3, 4, 200, &rec));
+    EXPECT_EQ(rec.allocatedSize, 4096);
+    EXPECT_EQ(rec.subdirs, QByteArrayList({ "a", "b" }));
+}
+
+TEST_F(DirSizeCacheTest, Load_CorruptedFile_ExpectedEmpty)
+{
+    QFile file(cacheFile);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("not a cache file");
+    file.close();
+
+    DirSizeCache cache(cacheFile);
+    EXPECT_EQ(cache.count(), 0);
+}
+
+TEST_F(DirSizeCacheTest, Save_OverCapacity_ExpectedOldestPruned)
+{
+    DirSizeCache cache(cacheFile, 4);
+    for (int i = 0; i < 6; ++i) {
+        auto rec = makeRecord(100);
+        rec.checkedAt = 1000 + i;   // 已过期也不影响淘汰顺序
+        cache.insert(1, i, rec, cache.epoch());
+    }
+    ASSERT_TRUE(cache.save());
+
+    EXPECT_EQ(cache.count(), 3);
+}
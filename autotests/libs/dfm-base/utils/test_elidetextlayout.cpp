@@ -11,6 +11,7 @@
 #include <QTextLine>
 
 #include <dfm-base/utils/elidetextlayout.h>
+#include <dfm-base/utils/elidetextlayoutcache.h>
 #include "stubext.h"
 
 using namespace dfmbase;
@@ -161,3 +162,74 @@ TEST_F(ElideTextLayoutTest, Layout_WithEmptyText_ExpectedEmptyLayout) {
     // Just ensure no crash
     EXPECT_TRUE(true);
 }
+
+TEST_F(ElideTextLayoutTest, Layout_CacheEnabled_ExpectedSameLinesAsUncached) {
+    const QString text("A long file name that wraps into several lines and gets elided.txt");
+    const QRectF rect(10, 20, 80, 40);
+
+    ElideTextLayout plain(text);
+    QStringList plainLines;
+    const QList<QRectF> &expected = plain.layout(rect, Qt::ElideMiddle, nullptr, Qt::NoBrush, &plainLines);
+
+    ElideTextLayoutCache::instance()->clear();
+    for (int i = 0; i < 2; ++i) {
+        ElideTextLayout cached(text);
+        cached.setCacheEnabled(true);
+        QStringList cachedLines;
+        EXPECT_EQ(cached.layout(rect, Qt::ElideMiddle, nullptr, Qt::NoBrush, &cachedLines), expected);
+        EXPECT_EQ(cachedLines, plainLines);
+    }
+    EXPECT_EQ(ElideTextLayoutCache::instance()->count(), 1);
+
+    // 结果相对目标矩形平移
+    ElideTextLayout moved(text);
+    moved.setCacheEnabled(true);
+    const QList<QRectF> &movedRects = moved.layout(rect.translated(5, 5), Qt::ElideMiddle);
+    ASSERT_EQ(movedRects.size(), expected.size());
+    EXPECT_EQ(movedRects.first(), expected.first().translated(5, 5));
+    EXPECT_EQ(ElideTextLayoutCache::instance()->count(), 1);
+    ElideTextLayoutCache::instance()->clear();
+}
+
+TEST_F(ElideTextLayoutTest, Layout_CacheKeyChanged_ExpectedNewEntry) {
+    const QRectF rect(0, 0, 80, 40);
+    ElideTextLayoutCache::instance()->clear();
+
+    ElideTextLayout first("same name");
+    first.setCacheEnabled(true);
+    first.layout(rect, Qt::ElideRight);
+
+    ElideTextLayout other("same name");
+    other.setCacheEnabled(true);
+    other.setHighlightEnabled(true);
+    other.setHighlightColor(Qt::blue);
+    other.setHighlightKeywords({ "name" });
+    other.layout(rect, Qt::ElideRight);
+
+    ElideTextLayout wider("same name");
+    wider.setCacheEnabled(true);
+    wider.layout(rect.adjusted(0, 0, 20, 0), Qt::ElideRight);
+
+    EXPECT_EQ(ElideTextLayoutCache::instance()->count(), 3);
+    ElideTextLayoutCache::instance()->clear();
+}
+
+TEST_F(ElideTextLayoutTest, DocumentHandle_AfterCached_ExpectedCacheUntouched) {
+    const QRectF rect(0, 0, 80, 40);
+    ElideTextLayoutCache::instance()->clear();
+
+    ElideTextLayout layout("original");
+    layout.setCacheEnabled(true);
+    QStringList lines;
+    layout.layout(rect, Qt::ElideRight, nullptr, Qt::NoBrush, &lines);
+
+    // 修改文本不会影响缓存中的排版
+    layout.setText("changed");
+    ElideTextLayout again("original");
+    again.setCacheEnabled(true);
+    QStringList cachedLines;
+    again.layout(rect, Qt::ElideRight, nullptr, Qt::NoBrush, &cachedLines);
+    EXPECT_EQ(cachedLines, lines);
+    EXPECT_EQ(layout.text(), QString("changed"));
+    ElideTextLayoutCache::instance()->clear();
+}
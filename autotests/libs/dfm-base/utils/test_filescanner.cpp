@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <QUrl>
+
+#include <dfm-base/utils/filescanner.h>
+#include <dfm-base/utils/dirsizecache.h>
+#include "stubext.h"
+
+#include <ctime>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace dfmbase;
+
+class FileScannerTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        root = tempDir.path() + "/root";
+
+        // 构造 20 个子目录，每个目录 3 层、每层 5 个文件，保证多线程遍历有足够的目录可分发
+        for (int i = 0; i < 20; ++i) {
+            QString dir = root + QString("/d%1").arg(i);
+            for (int depth = 0; depth < 3; ++depth) {
+                dir += QString("/l%1").arg(depth);
+                ASSERT_TRUE(QDir().mkpath(dir));
+                for (int f = 0; f < 5; ++f)
+                    writeFile(dir + QString("/f%1").arg(f), 100);
+                ++expectedDirs;
+            }
+            ++expectedDirs;
+        }
+
+        writeFile(root + "/big", 4096);
+        ASSERT_EQ(::link(QFile::encodeName(root + "/big").constData(),
+                         QFile::encodeName(root + "/d0/big-link").constData()),
+                  0);
+        ASSERT_TRUE(QFile::link(root + "/big", root + "/d1/big-symlink"));
+        ++expectedFiles;   // d0/big-link 与 big 是同一 inode：计数，但大小只统计一次
+        ++expectedFiles;   // 符号链接只计数，不计大小
+    }
+
+    // 目录大小缓存不写入刚修改过的目录，把测试目录的修改时间调到一分钟前
+    void ageDirectories()
+    {
+        const struct timespec old { time(nullptr) - 60, 0 };
+        const struct timespec times[2] { old, old };
+        QStringList dirs { root };
+        while (!dirs.isEmpty()) {
+            const QString dir = dirs.takeLast();
+            for (const QString &name : QDir(dir).entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+                dirs << dir + "/" + name;
+            ASSERT_EQ(::utimensat(AT_FDCWD, QFile::encodeName(dir).constData(), times, 0), 0);
+        }
+    }
+
+    void writeFile(const QString &path, int size)
+    {
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(QByteArray(size, 'x'));
+        ++expectedFiles;
+        expectedSize += size;
+    }
+
+    FileScanner::ScanResult scan(const QList<QUrl> &urls, int threads,
+                                 FileScanner::ScanOptions options = FileScanner::ScanOption::NoOption)
+    {
+        FileScanner scanner;
+        scanner.setOptions(options);
+        scanner.setMaxThreadCount(threads);
+
+        FileScanner::ScanResult result;
+        QEventLoop loop;
+        QObject::connect(&scanner, &FileScanner::finished, &loop, [&](const FileScanner::ScanResult &r) {
+            result = r;
+            loop.quit();
+        });
+        QTimer::singleShot(10000, &loop, &QEventLoop::quit);
+        scanner.start(urls);
+        loop.exec();
+        return result;
+    }
+
+    stub_ext::StubExt stub;
+    QTemporaryDir tempDir;
+    QString root;
+    int expectedFiles { 0 };
+    int expectedDirs { 0 };
+    qint64 expectedSize { 0 };
+};
+
+TEST_F(FileScannerTest, Scan_SingleThread_ExpectedTreeTotals)
+{
+    const auto &result = scan({ QUrl::fromLocalFile(root) }, 1);
+
+    EXPECT_EQ(result.fileCount, expectedFiles);
+    EXPECT_EQ(result.directoryCount, expectedDirs);
+    EXPECT_EQ(result.totalSize, expectedSize);
+    EXPECT_GT(result.allocatedSize, 0);
+}
+
+TEST_F(FileScannerTest, Scan_MultiThread_ExpectedSameTotalsAsSingleThread)
+{
+    const auto &single = scan({ QUrl::fromLocalFile(root) }, 1);
+    const auto &multi = scan({ QUrl::fromLocalFile(root) }, 4);
+
+    EXPECT_EQ(multi.fileCount, single.fileCount);
+    EXPECT_EQ(multi.directoryCount, single.directoryCount);
+    EXPECT_EQ(multi.totalSize, single.totalSize);
+    EXPECT_EQ(multi.allocatedSize, single.allocatedSize);
+}
+
+TEST_F(FileScannerTest, Scan_HardlinkInTwoSources_ExpectedSizeCountedOnce)
+{
+    const auto &result = scan({ QUrl::fromLocalFile(root + "/big"),
+                                QUrl::fromLocalFile(root + "/d0/big-link") },
+                              4);
+
+    EXPECT_EQ(result.fileCount, 2);
+    EXPECT_EQ(result.totalSize, 4096);
+}
+
+TEST_F(FileScannerTest, Scan_IncludeSource_ExpectedSourceDirCounted)
+{
+    const auto &result = scan({ QUrl::fromLocalFile(root) }, 4, FileScanner::ScanOption::IncludeSource);
+
+    EXPECT_EQ(result.directoryCount, expectedDirs + 1);
+}
+
+TEST_F(FileScannerTest, Scan_SingleDepth_ExpectedTopLevelOnly)
+{
+    const auto &result = scan({ QUrl::fromLocalFile(root) }, 4, FileScanner::ScanOption::SingleDepth);
+
+    EXPECT_EQ(result.fileCount, 1);
+    EXPECT_EQ(result.directoryCount, 20);
+    EXPECT_EQ(result.totalSize, 4096);
+}
+
+TEST_F(FileScannerTest, Scan_WithSizeCache_ExpectedUnchangedDirsReused)
+{
+    DirSizeCache cache(tempDir.path() + "/dirsize.cache");
+    stub.set_lamda(&DirSizeCache::isEnabled, []() { return true; });
+    stub.set_lamda(&DirSizeCache::instance, [&cache]() { return &cache; });
+    // 临时目录可能位于 overlayfs 等不在白名单中的文件系统上
+    stub.set_lamda(&DirSizeCache::isSupportedFileSystem, [](int) { return true; });
+    ageDirectories();
+
+    const auto &cold = scan({ QUrl::fromLocalFile(root) }, 4);
+    EXPECT_EQ(cache.count(), expectedDirs + 1);
+
+    const auto &warm = scan({ QUrl::fromLocalFile(root) }, 4);
+    EXPECT_EQ(warm.fileCount, cold.fileCount);
+    EXPECT_EQ(warm.directoryCount, cold.directoryCount);
+    EXPECT_EQ(warm.totalSize, cold.totalSize);
+    EXPECT_EQ(warm.allocatedSize, cold.allocatedSize);
+
+    // 新增文件改变目录修改时间，原地修改文件由监视器使记录失效
+    writeFile(root + "/d3/l0/added", 50);
+    QFile file(root + "/d5/l0/f0");
+    ASSERT_TRUE(file.open(QIODevice::Append));
+    file.write(QByteArray(10, 'y'));
+    file.close();
+    expectedSize += 10;
+    cache.invalidate(root + "/d5/l0/f0");
+
+    const auto &changed = scan({ QUrl::fromLocalFile(root) }, 4);
+    EXPECT_EQ(changed.fileCount, expectedFiles);
+    EXPECT_EQ(changed.totalSize, expectedSize);
+}
@@ -255,3 +255,34 @@ TEST_F(InfoCacheTest, UrlNormalization)
     auto retrievedInfo = cache.getCacheInfo(dirUrl);
     EXPECT_NE(retrievedInfo, nullptr);
 }
+
+TEST_F(InfoCacheTest, StatisticsCountHitsAndMisses)
+{
+    auto &cache = InfoCache::instance();
+    cache.cacheInfo(fileUrl1, QSharedPointer<AsyncFileInfo>::create(fileUrl1));
+
+    const auto before = cache.statistics();
+    EXPECT_NE(cache.getCacheInfo(fileUrl1), nullptr);
+    EXPECT_EQ(cache.getCacheInfo(QUrl::fromLocalFile(tempDir->filePath("missing.txt"))), nullptr);
+    const auto after = cache.statistics();
+
+    EXPECT_EQ(after.hits, before.hits + 1);
+    EXPECT_EQ(after.misses, before.misses + 1);
+    EXPECT_GT(after.hitRate(), 0.0);
+}
+
+TEST_F(InfoCacheTest, CacheCountIsBounded)
+{
+    auto &cache = InfoCache::instance();
+    const auto before = cache.statistics();
+
+    // 超过缓存数量上限后，插入时按 CLOCK 淘汰
+    for (int i = 0; i < 25000; ++i) {
+        QUrl url = QUrl::fromLocalFile(tempDir->filePath(QString("bounded_%1.txt").arg(i)));
+        cache.cacheInfo(url, QSharedPointer<AsyncFileInfo>::create(url));
+    }
+
+    const auto after = cache.statistics();
+    EXPECT_LE(after.size, 20000);
+    EXPECT_GT(after.evictions, before.evictions);
+}
@@ -84,6 +84,13 @@ TEST_F(SortUtilsTest, CompareStringForMimeType_SimpleMimes_ExpectedCorrectCompar
     EXPECT_TRUE(result);  // Directory should come before Text according to type ranking
 }
 
+TEST_F(SortUtilsTest, MimeTypeRank_MajorType_ExpectedRankOrder) {
+    // Act & Assert
+    EXPECT_EQ(SortUtils::mimeTypeRank("Directory"), 0);
+    EXPECT_LT(SortUtils::mimeTypeRank("Text (text/plain)"), SortUtils::mimeTypeRank("Image (image/png)"));
+    EXPECT_EQ(SortUtils::mimeTypeRank("Something else"), SortUtils::mimeTypeRank("Unknown"));
+}
+
 TEST_F(SortUtilsTest, CompareForSize_WithInt64Values_ExpectedCorrectComparison) {
     // Arrange
     qint64 size1 = 100;
@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <dfm-base/utils/thumbnail/thumbnailfactory.h>
+#include <dfm-base/utils/fileutils.h>
+#include "stubext.h"
+
+#include <QUrl>
+
+DFMBASE_USE_NAMESPACE
+DFMGLOBAL_USE_NAMESPACE
+
+class ThumbnailFactoryTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // 工作线程不真正生成缩略图，调度结果通过 runningUrl 检查
+        stub.set_lamda(&ThumbnailWorker::onTaskAdded, [](ThumbnailWorker *, const ThumbnailWorker::ThumbnailTaskMap &) {
+            __DBG_STUB_INVOKE__
+        });
+        stub.set_lamda(&FileUtils::containsCopyingFileUrl, [](const QUrl &) {
+            __DBG_STUB_INVOKE__
+            return false;
+        });
+
+        factory.reset(new ThumbnailFactory);
+        // 先让所有工作线程处于忙碌状态，新任务都留在队列中
+        for (int i = 0; i < factory->workers.size(); ++i)
+            factory->workers[i].runningUrl = QUrl::fromLocalFile(QString("/busy/%1").arg(i));
+    }
+
+    void TearDown() override
+    {
+        factory.reset();
+        stub.clear();
+    }
+
+    QList<QUrl> queuedUrls() const
+    {
+        return factory->taskQueue.values();
+    }
+
+    static QUrl fileUrl(const QString &name)
+    {
+        return QUrl::fromLocalFile("/tmp/thumbs/" + name);
+    }
+
+    QScopedPointer<ThumbnailFactory> factory;
+    stub_ext::StubExt stub;
+};
+
+TEST_F(ThumbnailFactoryTest, JoinJob_SamePriority_ExpectedNewestFirst)
+{
+    factory->doJoinThumbnailJob(fileUrl("a"), kLarge);
+    factory->doJoinThumbnailJob(fileUrl("b"), kLarge);
+    factory->doJoinThumbnailJob(fileUrl("c"), kLarge);
+
+    EXPECT_EQ(queuedUrls(), QList<QUrl>({ fileUrl("c"), fileUrl("b"), fileUrl("a") }));
+}
+
+TEST_F(ThumbnailFactoryTest, UpdateTaskPriority_VisibleBeforePrefetchBeforeNormal)
+{
+    factory->doJoinThumbnailJob(fileUrl("a"), kLarge);
+    factory->doJoinThumbnailJob(fileUrl("b"), kLarge);
+    factory->doJoinThumbnailJob(fileUrl("c"), kLarge);
+    factory->doJoinThumbnailJob(QUrl::fromLocalFile("/tmp/other/d"), kLarge);
+
+    factory->updateTaskPriority(QUrl::fromLocalFile("/tmp/thumbs"), { fileUrl("a") }, { fileUrl("b") });
+
+    // c 已滚出视图降到最低，其他目录的任务保持 kNormal
+    EXPECT_EQ(queuedUrls(), QList<QUrl>({ fileUrl("a"), fileUrl("b"), QUrl::fromLocalFile("/tmp/other/d"), fileUrl("c") }));
+    EXPECT_EQ(factory->pendingTasks.value(fileUrl("c")).order.first,
+              static_cast<int>(ThumbnailFactory::TaskPriority::kOutOfView));
+
+    factory->onWorkerIdle(0);
+    EXPECT_EQ(factory->workers.at(0).runningUrl, fileUrl("a"));
+}
+
+TEST_F(ThumbnailFactoryTest, UpdateTaskPriority_DemotedTaskPromotedAgain)
+{
+    factory->doJoinThumbnailJob(fileUrl("a"), kLarge);
+    factory->doJoinThumbnailJob(fileUrl("b"), kLarge);
+
+    const QUrl dir = QUrl::fromLocalFile("/tmp/thumbs");
+    factory->updateTaskPriority(dir, { fileUrl("a") }, {});
+    EXPECT_EQ(queuedUrls(), QList<QUrl>({ fileUrl("a"), fileUrl("b") }));
+
+    // 另一个视图又显示了 b，重新提升到可见优先级
+    factory->updateTaskPriority(dir, { fileUrl("b") }, {});
+    EXPECT_EQ(factory->pendingTasks.value(fileUrl("b")).order.first,
+              static_cast<int>(ThumbnailFactory::TaskPriority::kVisible));
+    EXPECT_EQ(queuedUrls().first(), fileUrl("b"));
+}
+
+TEST_F(ThumbnailFactoryTest, JoinJob_PendingDuplicate_ExpectedQueuedOnce)
+{
+    factory->doJoinThumbnailJob(fileUrl("a"), kLarge);
+    factory->doJoinThumbnailJob(fileUrl("a"), kLarge);
+
+    EXPECT_EQ(queuedUrls(), QList<QUrl>({ fileUrl("a") }));
+    EXPECT_EQ(factory->pendingTasks.size(), 1);
+}
+
+TEST_F(ThumbnailFactoryTest, JoinJob_RunningDuplicate_ExpectedNotDispatchedTwice)
+{
+    factory->doJoinThumbnailJob(fileUrl("a"), kLarge);
+    factory->onWorkerIdle(0);
+    ASSERT_EQ(factory->workers.at(0).runningUrl, fileUrl("a"));
+    EXPECT_TRUE(factory->runningTasks.contains(fileUrl("a")));
+
+    // 正在生成时再次请求，不能交给另一个空闲线程同时生成
+    if (factory->workers.size() > 1)
+        factory->onWorkerIdle(1);
+    factory->doJoinThumbnailJob(fileUrl("a"), kLarge);
+    EXPECT_TRUE(factory->taskQueue.isEmpty());
+    EXPECT_TRUE(factory->pendingTasks.isEmpty());
+
+    // 生成结束后可以重新请求
+    factory->onWorkerIdle(0);
+    EXPECT_FALSE(factory->runningTasks.contains(fileUrl("a")));
+    factory->doJoinThumbnailJob(fileUrl("a"), kLarge);
+    EXPECT_TRUE(factory->runningTasks.contains(fileUrl("a")));
+}
@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <dfm-base/utils/thumbnail/thumbnailindex.h>
+#include <dfm-base/utils/thumbnail/thumbnailhelper.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <memory>
+
+DFMBASE_USE_NAMESPACE
+DFMGLOBAL_USE_NAMESPACE
+
+class ThumbnailIndexTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        tempDir.reset(new QTemporaryDir());
+        ASSERT_TRUE(tempDir->isValid());
+        indexPath = tempDir->filePath("thumbnail.index");
+        md5Hex = ThumbnailHelper::dataToMd5Hex("file:///tmp/test_image.png");
+    }
+
+    void TearDown() override
+    {
+        tempDir.reset();
+    }
+
+    std::unique_ptr<QTemporaryDir> tempDir;
+    QString indexPath;
+    QByteArray md5Hex;
+};
+
+TEST_F(ThumbnailIndexTest, Update_MatchingSource_ExpectedStoredState)
+{
+    ThumbnailIndex index(indexPath, 64);
+    ASSERT_TRUE(index.isValid());
+
+    EXPECT_EQ(index.state(md5Hex, kLarge, 100, 2048), ThumbnailIndex::State::kUnknown);
+
+    index.update(md5Hex, kLarge, 100, 2048, ThumbnailIndex::State::kOk);
+    EXPECT_EQ(index.state(md5Hex, kLarge, 100, 2048), ThumbnailIndex::State::kOk);
+
+    index.update(md5Hex, kLarge, 100, 2048, ThumbnailIndex::State::kFailed);
+    EXPECT_EQ(index.state(md5Hex, kLarge, 100, 2048), ThumbnailIndex::State::kFailed);
+}
+
+TEST_F(ThumbnailIndexTest, State_SourceChanged_ExpectedUnknown)
+{
+    ThumbnailIndex index(indexPath, 64);
+    index.update(md5Hex, kLarge, 100, 2048, ThumbnailIndex::State::kOk);
+
+    EXPECT_EQ(index.state(md5Hex, kLarge, 101, 2048), ThumbnailIndex::State::kUnknown);
+    EXPECT_EQ(index.state(md5Hex, kLarge, 100, 4096), ThumbnailIndex::State::kUnknown);
+}
+
+TEST_F(ThumbnailIndexTest, State_DifferentThumbnailSize_ExpectedIndependent)
+{
+    ThumbnailIndex index(indexPath, 64);
+    index.update(md5Hex, kLarge, 100, 2048, ThumbnailIndex::State::kOk);
+
+    EXPECT_EQ(index.state(md5Hex, kNormal, 100, 2048), ThumbnailIndex::State::kUnknown);
+    EXPECT_EQ(index.state(md5Hex, kSmall, 100, 2048), ThumbnailIndex::State::kUnknown);
+
+    index.update(md5Hex, kNormal, 100, 2048, ThumbnailIndex::State::kUnsupported);
+    EXPECT_EQ(index.state(md5Hex, kLarge, 100, 2048), ThumbnailIndex::State::kOk);
+    EXPECT_EQ(index.state(md5Hex, kNormal, 100, 2048), ThumbnailIndex::State::kUnsupported);
+}
+
+TEST_F(ThumbnailIndexTest, Remove_ExistingEntry_ExpectedUnknown)
+{
+    ThumbnailIndex index(indexPath, 64);
+    index.update(md5Hex, kLarge, 100, 2048, ThumbnailIndex::State::kOk);
+    index.remove(md5Hex, kLarge);
+
+    EXPECT_EQ(index.state(md5Hex, kLarge, 100, 2048), ThumbnailIndex::State::kUnknown);
+}
+
+TEST_F(ThumbnailIndexTest, Reopen_SameFile_ExpectedEntriesPersisted)
+{
+    {
+        ThumbnailIndex index(indexPath, 64);
+        index.update(md5Hex, kLarge, 100, 2048, ThumbnailIndex::State::kOk);
+    }
+
+    ThumbnailIndex index(indexPath, 64);
+    EXPECT_EQ(index.state(md5Hex, kLarge, 100, 2048), ThumbnailIndex::State::kOk);
+}
+
+TEST_F(ThumbnailIndexTest, Reopen_CorruptedHeader_ExpectedRebuilt)
+{
+    {
+        ThumbnailIndex index(indexPath, 64);
+        index.update(md5Hex, kLarge, 100, 2048, ThumbnailIndex::State::kOk);
+    }
+
+    QFile file(indexPath);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    file.write("garbage!");
+    file.close();
+
+    ThumbnailIndex index(indexPath, 64);
+    ASSERT_TRUE(index.isValid());
+    EXPECT_EQ(index.state(md5Hex, kLarge, 100, 2048), ThumbnailIndex::State::kUnknown);
+}
+
+TEST_F(ThumbnailIndexTest, Update_TableFull_ExpectedNoCrashAndLatestKept)
+{
+    ThumbnailIndex index(indexPath, 8);
+    for (int i = 0; i < 100; ++i) {
+        const QByteArray &hex = ThumbnailHelper::dataToMd5Hex(QByteArray::number(i));
+        index.update(hex, kLarge, i, i, ThumbnailIndex::State::kOk);
+    }
+
+    const QByteArray &last = ThumbnailHelper::dataToMd5Hex(QByteArray::number(99));
+    EXPECT_EQ(index.state(last, kLarge, 99, 99), ThumbnailIndex::State::kOk);
+}
+
+TEST_F(ThumbnailIndexTest, Reopen_FailedEntry_ExpectedNotPersisted)
+{
+    {
+        ThumbnailIndex index(indexPath, 64);
+        index.update(md5Hex, kLarge, 100, 2048, ThumbnailIndex::State::kOk);
+        index.update(md5Hex, kLarge, 100, 2048, ThumbnailIndex::State::kFailed);
+        index.update(md5Hex, kNormal, 100, 2048, ThumbnailIndex::State::kUnsupported);
+        EXPECT_EQ(index.state(md5Hex, kLarge, 100, 2048), ThumbnailIndex::State::kFailed);
+    }
+
+    ThumbnailIndex index(indexPath, 64);
+    EXPECT_EQ(index.state(md5Hex, kLarge, 100, 2048), ThumbnailIndex::State::kUnknown);
+    EXPECT_EQ(index.state(md5Hex, kNormal, 100, 2048), ThumbnailIndex::State::kUnknown);
+}
+
+TEST_F(ThumbnailIndexTest, ClearFailures_ExpectedOnlyOkKept)
+{
+    ThumbnailIndex index(indexPath, 64);
+    index.update(md5Hex, kLarge, 100, 2048, ThumbnailIndex::State::kOk);
+    index.update(md5Hex, kNormal, 100, 2048, ThumbnailIndex::State::kUnsupported);
+    index.update(md5Hex, kSmall, 100, 2048, ThumbnailIndex::State::kFailed);
+
+    index.clearFailures();
+    EXPECT_EQ(index.state(md5Hex, kLarge, 100, 2048), ThumbnailIndex::State::kOk);
+    EXPECT_EQ(index.state(md5Hex, kNormal, 100, 2048), ThumbnailIndex::State::kUnknown);
+    EXPECT_EQ(index.state(md5Hex, kSmall, 100, 2048), ThumbnailIndex::State::kUnknown);
+}
+
+TEST_F(ThumbnailIndexTest, InvalidDigest_ExpectedIgnored)
+{
+    ThumbnailIndex index(indexPath, 64);
+    index.update("not-a-md5", kLarge, 100, 2048, ThumbnailIndex::State::kOk);
+
+    EXPECT_EQ(index.state("not-a-md5", kLarge, 100, 2048), ThumbnailIndex::State::kUnknown);
+}
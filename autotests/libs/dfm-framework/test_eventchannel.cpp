@@ -499,4 +499,58 @@ TEST_F(EventChannelTest, ChannelManagerDirectDisconnect)
     EXPECT_TRUE(stringDisconnected);
 }
 
+/**
+ * @brief 测试EventChannelHandle类型化调用
+ */
+TEST_F(EventChannelTest, TypedHandleInvoke)
+{
+    EventType eventType = registerTestEvent("typed_handle");
+    auto handle = channelManager->resolve<QString(QString, QString)>("test", "slot_typed_handle");
+    EXPECT_TRUE(handle.isValid());
+    EXPECT_EQ(handle.eventType(), eventType);
+
+    // 未连接时返回默认值
+    EXPECT_TRUE(handle("a", "b").isEmpty());
+
+    channelManager->connect(eventType, receiver, &TestReceiver::combineStrings);
+    EXPECT_EQ(handle("Hello", "World"), QString("HelloWorld"));
+
+    // 重新连接后句柄仍然有效
+    channelManager->disconnect(eventType);
+    EXPECT_TRUE(handle("a", "b").isEmpty());
+    channelManager->connect(eventType, receiver, &TestReceiver::combineStrings);
+    EXPECT_EQ(handle("a", "b"), QString("ab"));
+}
+
+/**
+ * @brief 测试签名不一致时回退到QVariant路径
+ */
+TEST_F(EventChannelTest, TypedHandleSignatureMismatchFallback)
+{
+    EventType eventType = registerTestEvent("typed_fallback");
+    channelManager->connect(eventType, receiver, &TestReceiver::addOne);
+
+    auto typed = channelManager->resolve<int(int)>(eventType);
+    EXPECT_EQ(typed(1), 2);
+
+    auto fallback = channelManager->resolve<QVariant(int)>(eventType);
+    EXPECT_EQ(fallback(1).toInt(), 2);
+
+    channelManager->connect(eventType, receiver, &TestReceiver::voidFunction);
+    auto voidHandle = channelManager->resolve<void()>(eventType);
+    voidHandle();
+    voidHandle();
+    EXPECT_EQ(receiver->getCallCount(), 2);
+}
+
+/**
+ * @brief 测试无效事件的句柄
+ */
+TEST_F(EventChannelTest, TypedHandleInvalidEvent)
+{
+    auto handle = channelManager->resolve<int(int)>("test", "slot_not_registered");
+    EXPECT_FALSE(handle.isValid());
+    EXPECT_EQ(handle(1), 0);
+}
+
 #include "test_eventchannel.moc"
\ No newline at end of file
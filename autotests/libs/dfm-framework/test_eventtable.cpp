@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <dfm-framework/event/eventtable.h>
+
+using namespace dpf;
+
+namespace {
+struct TestItem
+{
+    int value { 0 };
+};
+}   // namespace
+
+TEST(EventTableTest, InsertAndLookup)
+{
+    EventTable<TestItem> table;
+    EXPECT_FALSE(table.contains(EventTypeScope::kCustomBase));
+    EXPECT_TRUE(table.value(EventTypeScope::kCustomBase).isNull());
+
+    QSharedPointer<TestItem> item { new TestItem { 42 } };
+    table.insert(EventTypeScope::kCustomBase, item);
+    EXPECT_TRUE(table.contains(EventTypeScope::kCustomBase));
+    EXPECT_EQ(table.value(EventTypeScope::kCustomBase)->value, 42);
+    EXPECT_EQ(table[EventTypeScope::kCustomBase], item);
+
+    // 未插入的相邻槽位为空
+    EXPECT_FALSE(table.contains(EventTypeScope::kCustomBase - 1));
+    EXPECT_FALSE(table.contains(EventTypeScope::kCustomBase + 1));
+}
+
+TEST(EventTableTest, InvalidTypes)
+{
+    EventTable<TestItem> table;
+    EXPECT_FALSE(table.contains(EventTypeScope::kInValid));
+    EXPECT_FALSE(table.contains(EventTypeScope::kCustomTop + 1));
+    EXPECT_TRUE(table.value(EventTypeScope::kInValid).isNull());
+    EXPECT_EQ(table.remove(EventTypeScope::kInValid), 0);
+}
+
+TEST(EventTableTest, Remove)
+{
+    EventTable<TestItem> table;
+    table.insert(1, QSharedPointer<TestItem>(new TestItem));
+    EXPECT_EQ(table.remove(1), 1);
+    EXPECT_FALSE(table.contains(1));
+    EXPECT_EQ(table.remove(1), 0);
+}
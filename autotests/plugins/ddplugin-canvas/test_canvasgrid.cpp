@@ -5,6 +5,7 @@
 #include "stubext.h"
 #include "plugins/desktop/ddplugin-canvas/grid/canvasgrid.h"
 #include "plugins/desktop/ddplugin-canvas/grid/gridcore.h"
+#include "plugins/desktop/ddplugin-canvas/displayconfig.h"
 
 #include <QStringList>
 #include <QPoint>
@@ -201,4 +202,69 @@ TEST_F(UT_CanvasGrid, core)
     GridCore &core = grid->core();
     // Should return a valid reference
     SUCCEED();
-}
\ No newline at end of file
+}
+
+namespace {
+class TestGridCore : public GridCore
+{
+public:
+    TestGridCore(const QMap<int, QSize> &sizes)
+    {
+        surfaces = sizes;
+    }
+};
+}
+
+TEST(UT_GridCore, voidPos_followsDirectChanges)
+{
+    TestGridCore core({ { 1, QSize(2, 3) } });
+    core.insert(1, QPoint(0, 0), "a");
+    core.insert(1, QPoint(0, 2), "b");
+    EXPECT_EQ(core.voidPos(1), QList<QPoint>({ QPoint(0, 1), QPoint(1, 0), QPoint(1, 1), QPoint(1, 2) }));
+
+    core.remove(1, "a");
+    GridPos pos;
+    ASSERT_TRUE(core.findVoidPos(pos));
+    EXPECT_EQ(pos, GridPos(1, QPoint(0, 0)));
+
+    // 子类直接改写 posItem 后，占用位图要随之重建
+    QHash<QPoint, QString> allPos { { QPoint(0, 0), "c" }, { QPoint(0, 1), "d" } };
+    core.posItem.insert(1, allPos);
+    EXPECT_EQ(core.voidPos(1).first(), QPoint(0, 2));
+
+    core.posItem[1].insert(QPoint(0, 2), "e");
+    EXPECT_EQ(core.voidPos(1).first(), QPoint(1, 0));
+
+    core.surfaces[1] = QSize(1, 4);
+    EXPECT_EQ(core.voidPos(1), QList<QPoint>({ QPoint(0, 3) }));
+}
+
+TEST(UT_GridCore, appendAfter_skipsOccupied)
+{
+    stub_ext::StubExt stub;
+    stub.set_lamda(ADDR(DisplayConfig, autoAlign), [](DisplayConfig *) -> bool {
+        return false;
+    });
+
+    TestGridCore core({ { 1, QSize(2, 2) }, { 2, QSize(1, 2) } });
+    core.insert(1, QPoint(1, 0), "a");
+
+    AppendOper oper(&core);
+    QStringList left = oper.appendAfter({ "b", "c", "d" }, 1, QPoint(0, 1));
+    EXPECT_EQ(left, QStringList({ "d" }));
+    EXPECT_EQ(oper.item(GridPos(1, QPoint(0, 1))), QString("b"));
+    EXPECT_EQ(oper.item(GridPos(1, QPoint(1, 1))), QString("c"));
+    EXPECT_TRUE(oper.isVoid(1, QPoint(0, 0)));
+
+    oper.append({ "e", "f", "g", "h" });
+    EXPECT_EQ(oper.item(GridPos(1, QPoint(0, 0))), QString("e"));
+    EXPECT_EQ(oper.item(GridPos(2, QPoint(0, 0))), QString("f"));
+    EXPECT_EQ(oper.item(GridPos(2, QPoint(0, 1))), QString("g"));
+    EXPECT_EQ(oper.overload, QStringList({ "h" }));
+
+    // 操作对象上的修改在 applay 之前不影响原数据
+    EXPECT_EQ(core.voidPos(1).size(), 3);
+    core.applay(&oper);
+    EXPECT_TRUE(core.isFull(1));
+    EXPECT_TRUE(core.voidPos(2).isEmpty());
+}
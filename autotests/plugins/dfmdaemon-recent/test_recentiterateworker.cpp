@@ -85,6 +85,13 @@ protected:
         tempXbelFile->flush();
     }
 
+    static RecentIterateWorker::BookmarkRecord parseBookmark(const QString &xmlContent)
+    {
+        QXmlStreamReader reader(xmlContent);
+        reader.readNext();   // Move to StartElement
+        return RecentIterateWorker::parseBookmark(reader);
+    }
+
 protected:
     RecentIterateWorker *worker { nullptr };
     stub_ext::StubExt stub;
@@ -532,12 +539,18 @@ TEST_F(UT_RecentIterateWorker, onRequestPurgeItems_WithFileOpenFailure_EmitsSign
     EXPECT_EQ(spy.count(), 1);
 }
 
-TEST_F(UT_RecentIterateWorker, processBookmarkElement_WithValidElement_AddsNewItem)
+TEST_F(UT_RecentIterateWorker, parseBookmark_ReadsHrefAndModified)
+{
+    const auto &record = parseBookmark(R"(<bookmark href="file:///test/newfile.txt" modified="2024-01-01T12:00:00Z"/>)");
+
+    EXPECT_EQ(record.location, "file:///test/newfile.txt");
+    EXPECT_EQ(record.modified, QDateTime::fromString("2024-01-01T12:00:00Z", Qt::ISODate).toSecsSinceEpoch());
+    EXPECT_TRUE(record.path.isEmpty());
+}
+
+TEST_F(UT_RecentIterateWorker, checkAndCommitBookmark_WithValidElement_AddsNewItem)
 {
-    // Create a mock XML reader with a bookmark element
-    QString xmlContent = R"(<bookmark href="file:///test/newfile.txt" modified="2024-01-01T12:00:00Z"/>)";
-    QXmlStreamReader reader(xmlContent);
-    reader.readNext();   // Move to StartElement
+    auto record = parseBookmark(R"(<bookmark href="file:///test/newfile.txt" modified="2024-01-01T12:00:00Z"/>)");
 
     QStringList curPathList;
     bool itemAddedEmitted = false;
@@ -560,17 +573,6 @@ TEST_F(UT_RecentIterateWorker, processBookmarkElement_WithValidElement_AddsNewIt
         return "/test/newfile.txt";
     });
 
-    // Mock URL operations
-    stub.set_lamda(static_cast<bool (QUrl::*)() const>(&QUrl::isLocalFile), [](const QUrl *) {
-        __DBG_STUB_INVOKE__
-        return true;
-    });
-
-    stub.set_lamda(static_cast<QString (QUrl::*)() const>(&QUrl::toLocalFile), [](const QUrl *) {
-        __DBG_STUB_INVOKE__
-        return "/test/newfile.txt";
-    });
-
     // Mock protocol check
     stub.set_lamda(&ProtocolUtils::isRemoteFile, [](const QUrl &) {
         __DBG_STUB_INVOKE__
@@ -590,7 +592,9 @@ TEST_F(UT_RecentIterateWorker, processBookmarkElement_WithValidElement_AddsNewIt
                          addedItem = item;
                      });
 
-    worker->processBookmarkElement(reader, curPathList);
+    RecentIterateWorker::checkBookmark(record);
+    EXPECT_EQ(record.path, "/test/newfile.txt");
+    worker->commitBookmark(record, curPathList);
 
     EXPECT_TRUE(itemAddedEmitted);
     EXPECT_EQ(addedPath, "/test/newfile.txt");
@@ -598,52 +602,33 @@ TEST_F(UT_RecentIterateWorker, processBookmarkElement_WithValidElement_AddsNewIt
     EXPECT_TRUE(curPathList.contains("/test/newfile.txt"));
 }
 
-TEST_F(UT_RecentIterateWorker, processBookmarkElement_WithNonLocalFile_IgnoresItem)
+TEST_F(UT_RecentIterateWorker, checkAndCommitBookmark_WithNonLocalFile_IgnoresItem)
 {
-    QString xmlContent = R"(<bookmark href="http://example.com/file.txt" modified="2024-01-01T12:00:00Z"/>)";
-    QXmlStreamReader reader(xmlContent);
-    reader.readNext();
+    auto record = parseBookmark(R"(<bookmark href="http://example.com/file.txt" modified="2024-01-01T12:00:00Z"/>)");
 
     QStringList curPathList;
     bool itemAddedEmitted = false;
 
-    // Mock URL operations to return non-local file
-    stub.set_lamda(static_cast<bool (QUrl::*)() const>(&QUrl::isLocalFile), [](const QUrl *) {
-        __DBG_STUB_INVOKE__
-        return false;
-    });
-
     QObject::connect(worker, &RecentIterateWorker::itemAdded,
                      [&](const QString &, const RecentItem &) {
                          itemAddedEmitted = true;
                      });
 
-    worker->processBookmarkElement(reader, curPathList);
+    RecentIterateWorker::checkBookmark(record);
+    EXPECT_TRUE(record.path.isEmpty());
+    worker->commitBookmark(record, curPathList);
 
     EXPECT_FALSE(itemAddedEmitted);
     EXPECT_TRUE(curPathList.isEmpty());
 }
 
-TEST_F(UT_RecentIterateWorker, processBookmarkElement_WithNonExistentFile_IgnoresItem)
+TEST_F(UT_RecentIterateWorker, checkAndCommitBookmark_WithNonExistentFile_IgnoresItem)
 {
-    QString xmlContent = R"(<bookmark href="file:///nonexistent/file.txt" modified="2024-01-01T12:00:00Z"/>)";
-    QXmlStreamReader reader(xmlContent);
-    reader.readNext();
+    auto record = parseBookmark(R"(<bookmark href="file:///nonexistent/file.txt" modified="2024-01-01T12:00:00Z"/>)");
 
     QStringList curPathList;
     bool itemAddedEmitted = false;
 
-    // Mock URL operations
-    stub.set_lamda(static_cast<bool (QUrl::*)() const>(&QUrl::isLocalFile), [](const QUrl *) {
-        __DBG_STUB_INVOKE__
-        return true;
-    });
-
-    stub.set_lamda(static_cast<QString (QUrl::*)() const>(&QUrl::toLocalFile), [](const QUrl *) {
-        __DBG_STUB_INVOKE__
-        return "/nonexistent/file.txt";
-    });
-
     // Mock file validation to return false
     stub.set_lamda(static_cast<bool (QFileInfo::*)() const>(&QFileInfo::exists), [](const QFileInfo *) {
         __DBG_STUB_INVOKE__
@@ -661,12 +646,54 @@ TEST_F(UT_RecentIterateWorker, processBookmarkElement_WithNonExistentFile_Ignore
                          itemAddedEmitted = true;
                      });
 
-    worker->processBookmarkElement(reader, curPathList);
+    RecentIterateWorker::checkBookmark(record);
+    EXPECT_TRUE(record.path.isEmpty());
+    worker->commitBookmark(record, curPathList);
 
     EXPECT_FALSE(itemAddedEmitted);
     EXPECT_TRUE(curPathList.isEmpty());
 }
 
+TEST_F(UT_RecentIterateWorker, checkBookmark_CachedRecord_RecheckedOnEveryReload)
+{
+    // 同一条缓存的解析结果在每次重载时都重新检查，文件被删除后 path 被清空
+    auto record = parseBookmark(R"(<bookmark href="file:///test/file.txt" modified="2024-01-01T12:00:00Z"/>)");
+
+    bool exists = true;
+    int existsCount = 0;
+    stub.set_lamda(static_cast<bool (QFileInfo::*)() const>(&QFileInfo::exists), [&](const QFileInfo *) {
+        __DBG_STUB_INVOKE__
+        ++existsCount;
+        return exists;
+    });
+    stub.set_lamda(static_cast<bool (QFileInfo::*)() const>(&QFileInfo::isFile), [](const QFileInfo *) {
+        __DBG_STUB_INVOKE__
+        return true;
+    });
+    stub.set_lamda(&ProtocolUtils::isRemoteFile, [](const QUrl &) {
+        __DBG_STUB_INVOKE__
+        return false;
+    });
+    stub.set_lamda(&FileUtils::bindPathTransform, [](const QString &path, bool) {
+        __DBG_STUB_INVOKE__
+        return path;
+    });
+
+    QList<RecentIterateWorker::BookmarkRecord> records { record };
+    RecentIterateWorker::checkBookmarks(records);
+    EXPECT_EQ(records.first().path, "/test/file.txt");
+
+    exists = false;
+    records = { record };
+    RecentIterateWorker::checkBookmarks(records);
+    EXPECT_TRUE(records.first().path.isEmpty());
+
+    exists = true;
+    RecentIterateWorker::checkBookmarks(records);
+    EXPECT_EQ(records.first().path, "/test/file.txt");
+    EXPECT_EQ(existsCount, 3);
+}
+
 TEST_F(UT_RecentIterateWorker, removeOutdatedItems_RemovesCorrectItems)
 {
     // Pre-populate worker with items
@@ -726,3 +753,103 @@ TEST_F(UT_RecentIterateWorker, removeOutdatedItems_WithNoRemovals_DoesNotEmitSig
 
     EXPECT_FALSE(itemsRemovedEmitted);
 }
+
+TEST_F(UT_RecentIterateWorker, bookmarkTags_SkipsPrefixedElements)
+{
+    const QByteArray content = R"(<xbel><bookmark href="file:///a" modified="x"><info>)"
+                               R"(<bookmark:applications><bookmark:application name="a"/></bookmark:applications>)"
+                               R"(</info></bookmark><bookmark
+    href="file:///b"/></xbel>)";
+
+    const QList<QByteArray> tags = RecentIterateWorker::bookmarkTags(content);
+    ASSERT_EQ(tags.size(), 2);
+    EXPECT_EQ(tags.at(0), QByteArray(R"(<bookmark href="file:///a" modified="x">)"));
+    EXPECT_TRUE(tags.at(1).startsWith("<bookmark\n"));
+    EXPECT_TRUE(tags.at(1).endsWith("/>"));
+}
+
+TEST_F(UT_RecentIterateWorker, onRequestReload_RechecksAllBookmarks)
+{
+    int existsCount = 0;
+    QString deletedPath;
+    stub.set_lamda(static_cast<bool (QFileInfo::*)() const>(&QFileInfo::exists), [&](const QFileInfo *info) {
+        __DBG_STUB_INVOKE__
+        ++existsCount;
+        return info->filePath() != deletedPath;
+    });
+    stub.set_lamda(static_cast<bool (QFileInfo::*)() const>(&QFileInfo::isFile), [](const QFileInfo *) {
+        __DBG_STUB_INVOKE__
+        return true;
+    });
+    stub.set_lamda(&ProtocolUtils::isRemoteFile, [](const QUrl &) {
+        __DBG_STUB_INVOKE__
+        return false;
+    });
+    stub.set_lamda(&FileUtils::bindPathTransform, [](const QString &path, bool) {
+        __DBG_STUB_INVOKE__
+        return path;
+    });
+
+    QStringList addedPaths;
+    QStringList removedPaths;
+    QObject::connect(worker, &RecentIterateWorker::itemAdded,
+                     [&](const QString &path, const RecentItem &) {
+                         addedPaths << path;
+                     });
+    QObject::connect(worker, &RecentIterateWorker::itemsRemoved,
+                     [&](const QStringList &paths) {
+                         removedPaths << paths;
+                     });
+
+    worker->onRequestReload(tempXbelPath, 0);
+    EXPECT_EQ(existsCount, 2);
+    EXPECT_EQ(addedPaths, QStringList({ "/test/file1.txt", "/test/file2.txt" }));
+
+    // 内容未变化时沿用解析结果，但仍重新检查文件，删除的文件被移除
+    deletedPath = "/test/file1.txt";
+    worker->onRequestReload(tempXbelPath, 0);
+    EXPECT_EQ(existsCount, 4);
+    EXPECT_EQ(removedPaths, QStringList({ "/test/file1.txt" }));
+
+    // 追加一条书签
+    QFile file(tempXbelPath);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    QByteArray content = file.readAll();
+    file.close();
+    content.replace("</xbel>", R"(<bookmark href="file:///test/file3.txt" modified="2024-01-01T12:00:00Z"></bookmark></xbel>)");
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(content);
+    file.close();
+
+    addedPaths.clear();
+    deletedPath.clear();
+    worker->onRequestReload(tempXbelPath, 0);
+    EXPECT_EQ(existsCount, 7);
+    EXPECT_EQ(addedPaths, QStringList({ "/test/file1.txt", "/test/file3.txt" }));
+    EXPECT_EQ(worker->itemsInfo.size(), 3);
+    EXPECT_EQ(worker->bookmarkCache.size(), 3);
+}
+
+TEST_F(UT_RecentIterateWorker, onRequestReload_WithIncompleteFile_KeepsItems)
+{
+    RecentItem item;
+    item.href = "file:///keep/file1.txt";
+    item.modified = 1000000000;
+    worker->itemsInfo.insert("/keep/file1.txt", item);
+
+    QFile file(tempXbelPath);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(R"(<?xml version="1.0" encoding="UTF-8"?><xbel version="1.0"><bookmark href="file:///test/file1.txt")");
+    file.close();
+
+    bool itemsRemovedEmitted = false;
+    QObject::connect(worker, &RecentIterateWorker::itemsRemoved,
+                     [&](const QStringList &) {
+                         itemsRemovedEmitted = true;
+                     });
+
+    worker->onRequestReload(tempXbelPath, 0);
+
+    EXPECT_FALSE(itemsRemovedEmitted);
+    EXPECT_TRUE(worker->itemsInfo.contains("/keep/file1.txt"));
+}
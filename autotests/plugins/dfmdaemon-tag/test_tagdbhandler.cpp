@@ -63,6 +63,10 @@ protected:
             __DBG_STUB_INVOKE__
             return true; // Always succeed for table creation, etc.
         });
+        stub.set_lamda(ADDR(SqliteHandle, excutePrepared), [](SqliteHandle *, const QString &, const QVariantList &, std::function<void(QSqlQuery *)>) {
+            __DBG_STUB_INVOKE__
+            return true;
+        });
         
         // Reset mock data for each test
         mockTags.clear();
@@ -153,6 +157,53 @@ TEST_F(TestTagDbHandler, GetTagsByUrls_WithValidInput_ShouldReturnTags)
     EXPECT_TRUE(handler->lastError().isEmpty());
 }
 
+// Test getTagsByUrls splits large inputs into bounded IN (...) chunks
+TEST_F(TestTagDbHandler, GetTagsByUrls_WithManyUrls_ShouldQueryInChunks)
+{
+    QStringList urls;
+    for (int i = 0; i < 1200; ++i)
+        urls << QString("/path/file%1").arg(i);
+
+    QList<int> chunkSizes;
+    stub.set_lamda(&TagDbHandler::queryTagsOfFiles, [&chunkSizes](TagDbHandler *, const QStringList &paths, QHash<QString, QStringList> *fileTags) {
+        __DBG_STUB_INVOKE__
+        chunkSizes << paths.size();
+        (*fileTags)[paths.first()] << "tag";
+        return true;
+    });
+
+    QVariantMap result = handler->getTagsByUrls(urls);
+
+    EXPECT_EQ(chunkSizes, (QList<int> { 500, 500, 200 }));
+    EXPECT_EQ(result.size(), 3);
+    EXPECT_EQ(result.value("/path/file500").toStringList(), QStringList { "tag" });
+}
+
+// Test getTagsByUrls returns nothing instead of partial results when a chunk fails
+TEST_F(TestTagDbHandler, GetTagsByUrls_ChunkFails_ShouldReturnEmptyWithError)
+{
+    QStringList urls;
+    for (int i = 0; i < 1200; ++i)
+        urls << QString("/path/file%1").arg(i);
+
+    int calls = 0;
+    stub.set_lamda(&TagDbHandler::queryTagsOfFiles, [&calls](TagDbHandler *, const QStringList &paths, QHash<QString, QStringList> *fileTags) {
+        __DBG_STUB_INVOKE__
+        (*fileTags)[paths.first()] << "tag";
+        return ++calls < 2;
+    });
+
+    QVariantMap result = handler->getTagsByUrls(urls);
+
+    EXPECT_EQ(calls, 2);
+    EXPECT_TRUE(result.isEmpty());
+    EXPECT_FALSE(handler->lastError().isEmpty());
+
+    QVariant sameTags = handler->getSameTagsOfDiffUrls(urls);
+    EXPECT_TRUE(sameTags.toStringList().isEmpty());
+    EXPECT_FALSE(handler->lastError().isEmpty());
+}
+
 // Test getSameTagsOfDiffUrls method with valid URLs
 TEST_F(TestTagDbHandler, GetSameTagsOfDiffUrls_WithValidUrls_ShouldReturnCommonTags)
 {
@@ -457,7 +508,7 @@ TEST_F(TestTagDbHandler, DeleteFiles_WithValidInput_ShouldReturnResult)
     QStringList urls = {"/path/file1", "/path/file2"};
     
     // Mock database operations to return success (prevents real database write)
-    stub.set_lamda(ADDR(SqliteHandle, excute), [](SqliteHandle *, const QString &, std::function<void(QSqlQuery *)>) {
+    stub.set_lamda(ADDR(SqliteHandle, excutePrepared), [](SqliteHandle *, const QString &, const QVariantList &, std::function<void(QSqlQuery *)>) {
         __DBG_STUB_INVOKE__
         return true;
     });
@@ -87,6 +87,27 @@ TEST_F(TestTagManagerDBus, Query_WithTagsOfFileOption_ShouldReturnTagsByUrls)
     EXPECT_EQ(result.variant().toMap(), mockResult);
 }
 
+// Test QueryTagsOfFiles returns the map without QDBusVariant wrapping
+TEST_F(TestTagManagerDBus, QueryTagsOfFiles_WithPaths_ShouldReturnTagsByUrls)
+{
+    QStringList paths = {"/path/file1", "/path/file2", "/path/file3"};
+    QVariantMap mockResult;
+    mockResult["/path/file1"] = QStringList{"tag1"};
+
+    int callCount = 0;
+    stub.set_lamda(&TagDbHandler::getTagsByUrls, [&mockResult, &callCount](TagDbHandler *, const QStringList &urlList) {
+        __DBG_STUB_INVOKE__
+        ++callCount;
+        EXPECT_EQ(urlList.size(), 3);
+        return mockResult;
+    });
+
+    EXPECT_EQ(manager->QueryTagsOfFiles(paths), mockResult);
+    EXPECT_EQ(callCount, 1);
+    EXPECT_TRUE(manager->QueryTagsOfFiles({}).isEmpty());
+    EXPECT_EQ(callCount, 1);
+}
+
 // Test Query method with kFilesOfTag option
 TEST_F(TestTagManagerDBus, Query_WithFilesOfTagOption_ShouldReturnFilesByTag)
 {
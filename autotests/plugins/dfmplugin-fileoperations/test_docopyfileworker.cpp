@@ -8,6 +8,7 @@
 #include <QTextStream>
 #include <QUrl>
 #include <QDir>
+#include <QThreadPool>
 
 #include "stubext.h"
 
@@ -148,6 +149,57 @@ TEST_F(TestDoCopyFileWorker, DoFileCopy_CallsDoCopyFileByRange)
     EXPECT_EQ(workData->completeFileCount, 1);
 }
 
+TEST_F(TestDoCopyFileWorker, DoFileCopy_TryCloneSkipsDfmio)
+{
+    auto sourceFile = createTestFile("clone_small_source.txt");
+    QString targetPath = tempDirPath + "/clone_small_target.txt";
+
+    auto fromInfo = DFileInfoPointer(new DFileInfo(sourceFile->urlOf(UrlInfoType::kUrl)));
+    auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(targetPath)));
+    fromInfo->initQuerier();
+
+    stub.set_lamda(&DoCopyFileWorker::tryCloneFile, [](DoCopyFileWorker *, const int, const int, const qint64) {
+        __DBG_STUB_INVOKE__
+        return true;
+    });
+    bool dfmioCopied = false;
+    stub.set_lamda(&DoCopyFileWorker::doDfmioFileCopy,
+                   [&dfmioCopied](DoCopyFileWorker *, const DFileInfoPointer, const DFileInfoPointer, bool *) {
+                       __DBG_STUB_INVOKE__
+                       dfmioCopied = true;
+                       return true;
+                   });
+
+    worker->doFileCopy(fromInfo, toInfo, true);
+    EXPECT_FALSE(dfmioCopied);
+    EXPECT_EQ(workData->completeFileCount, 1);
+}
+
+TEST_F(TestDoCopyFileWorker, DoFileCopy_CloneFailedFallsBackToDfmio)
+{
+    auto sourceFile = createTestFile("clone_fail_source.txt");
+    QString targetPath = tempDirPath + "/clone_fail_target.txt";
+
+    auto fromInfo = DFileInfoPointer(new DFileInfo(sourceFile->urlOf(UrlInfoType::kUrl)));
+    auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(targetPath)));
+    fromInfo->initQuerier();
+
+    stub.set_lamda(&DoCopyFileWorker::tryCloneFile, [](DoCopyFileWorker *, const int, const int, const qint64) {
+        __DBG_STUB_INVOKE__
+        return false;
+    });
+    bool dfmioCopied = false;
+    stub.set_lamda(&DoCopyFileWorker::doDfmioFileCopy,
+                   [&dfmioCopied](DoCopyFileWorker *, const DFileInfoPointer, const DFileInfoPointer, bool *) {
+                       __DBG_STUB_INVOKE__
+                       dfmioCopied = true;
+                       return true;
+                   });
+
+    worker->doFileCopy(fromInfo, toInfo, true);
+    EXPECT_TRUE(dfmioCopied);
+}
+
 // ========== doDfmioFileCopy Tests ==========
 
 TEST_F(TestDoCopyFileWorker, DoDfmioFileCopy_Success)
@@ -326,6 +378,271 @@ TEST_F(TestDoCopyFileWorker, DoCopyFilePractically_TraditionalMode)
     EXPECT_EQ(result, DoCopyFileWorker::NextDo::kDoCopyNext);
 }
 
+// ========== doCopyFileWithIoUring Tests ==========
+
+TEST_F(TestDoCopyFileWorker, DoCopyFileWithIoUring_SmallFileFallback)
+{
+    auto sourceFile = createTestFile("uring_small.txt", "small");
+    QString targetPath = tempDirPath + "/uring_small_target.txt";
+
+    auto fromInfo = DFileInfoPointer(new DFileInfo(sourceFile->urlOf(UrlInfoType::kUrl)));
+    fromInfo->initQuerier();
+    auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(targetPath)));
+
+    workData->useIoUringCopy = true;
+
+    bool skip = false;
+    auto result = worker->doCopyFileWithIoUring(fromInfo, toInfo, &skip);
+    EXPECT_EQ(result, DoCopyFileWorker::NextDo::kDoCopyFallback);
+    EXPECT_FALSE(QFile::exists(targetPath));
+}
+
+TEST_F(TestDoCopyFileWorker, DoCopyFileWithIoUring_IntegrityCheckingFallback)
+{
+    QString sourcePath = tempDirPath + "/uring_verify.bin";
+    QFile sourceFile(sourcePath);
+    ASSERT_TRUE(sourceFile.open(QIODevice::WriteOnly));
+    sourceFile.write(QByteArray(5 * 1024 * 1024, 'v'));
+    sourceFile.close();
+    QString targetPath = tempDirPath + "/uring_verify_target.bin";
+
+    auto fromInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(sourcePath)));
+    fromInfo->initQuerier();
+    auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(targetPath)));
+
+    stub.set_lamda(&DoCopyFileWorker::isIoUringAvailable, []() {
+        __DBG_STUB_INVOKE__
+        return true;
+    });
+
+    workData->useIoUringCopy = true;
+    workData->jobFlags |= AbstractJobHandler::JobFlag::kCopyIntegrityChecking;
+
+    bool skip = false;
+    auto result = worker->doCopyFileWithIoUring(fromInfo, toInfo, &skip);
+    EXPECT_EQ(result, DoCopyFileWorker::NextDo::kDoCopyFallback);
+    EXPECT_FALSE(QFile::exists(targetPath));
+}
+
+TEST_F(TestDoCopyFileWorker, DoCopyFileWithIoUring_CopiesLargeFile)
+{
+    if (!DoCopyFileWorker::isIoUringAvailable())
+        GTEST_SKIP() << "io_uring is not available";
+
+    QByteArray content;
+    for (int i = 0; content.size() < 5 * 1024 * 1024 + 123; ++i)
+        content.append(QByteArray::number(i)).append('\n');
+
+    QString sourcePath = tempDirPath + "/uring_large.bin";
+    QFile sourceFile(sourcePath);
+    ASSERT_TRUE(sourceFile.open(QIODevice::WriteOnly));
+    sourceFile.write(content);
+    sourceFile.close();
+    QString targetPath = tempDirPath + "/uring_large_target.bin";
+
+    auto fromInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(sourcePath)));
+    fromInfo->initQuerier();
+    auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(targetPath)));
+
+    stub.set_lamda(&DoCopyFileWorker::setTargetPermissions,
+                   [](DoCopyFileWorker *, const QUrl &, const QUrl &) {
+                       __DBG_STUB_INVOKE__
+                   });
+
+    workData->useIoUringCopy = true;
+
+    bool skip = false;
+    auto result = worker->doCopyFileWithIoUring(fromInfo, toInfo, &skip);
+    EXPECT_EQ(result, DoCopyFileWorker::NextDo::kDoCopyNext);
+    EXPECT_EQ(workData->currentWriteSize.load(), content.size());
+
+    QFile targetFile(targetPath);
+    ASSERT_TRUE(targetFile.open(QIODevice::ReadOnly));
+    EXPECT_EQ(targetFile.readAll(), content);
+}
+
+TEST_F(TestDoCopyFileWorker, DoCopyFilePractically_IoUringFallback)
+{
+    auto sourceFile = createTestFile("uring_fallback.txt");
+    QString targetPath = tempDirPath + "/uring_fallback_target.txt";
+
+    auto fromInfo = DFileInfoPointer(new DFileInfo(sourceFile->urlOf(UrlInfoType::kUrl)));
+    auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(targetPath)));
+
+    workData->useIoUringCopy = true;
+    workData->exBlockSyncEveryWrite = false;
+
+    bool traditionalCalled = false;
+    stub.set_lamda(&DoCopyFileWorker::doCopyFileWithIoUring,
+                   [](DoCopyFileWorker *, const DFileInfoPointer &,
+                      const DFileInfoPointer &, bool *) -> DoCopyFileWorker::NextDo {
+                       __DBG_STUB_INVOKE__
+                       return DoCopyFileWorker::NextDo::kDoCopyFallback;
+                   });
+    stub.set_lamda(&DoCopyFileWorker::doCopyFileTraditional,
+                   [&traditionalCalled](DoCopyFileWorker *, const DFileInfoPointer &,
+                                        const DFileInfoPointer &, bool *) -> DoCopyFileWorker::NextDo {
+                       __DBG_STUB_INVOKE__
+                       traditionalCalled = true;
+                       return DoCopyFileWorker::NextDo::kDoCopyNext;
+                   });
+
+    bool skip = false;
+    auto result = worker->doCopyFilePractically(fromInfo, toInfo, &skip);
+    EXPECT_EQ(result, DoCopyFileWorker::NextDo::kDoCopyNext);
+    EXPECT_TRUE(traditionalCalled);
+}
+
+// ========== chunk parallel copy Tests ==========
+
+TEST_F(TestDoCopyFileWorker, DoCopyFileByChunks_SmallFileFallback)
+{
+    auto sourceFile = createTestFile("chunk_small.txt");
+    QString targetPath = tempDirPath + "/chunk_small_target.txt";
+
+    auto fromInfo = DFileInfoPointer(new DFileInfo(sourceFile->urlOf(UrlInfoType::kUrl)));
+    fromInfo->initQuerier();
+    auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(targetPath)));
+
+    QThreadPool pool;
+    QVector<QSharedPointer<DoCopyFileWorker>> chunkWorkers { QSharedPointer<DoCopyFileWorker>(new DoCopyFileWorker(workData)),
+                                                             QSharedPointer<DoCopyFileWorker>(new DoCopyFileWorker(workData)) };
+
+    bool skip = false;
+    auto result = worker->doCopyFileByChunks(fromInfo, toInfo, &pool, chunkWorkers, &skip);
+    EXPECT_EQ(result, DoCopyFileWorker::NextDo::kDoCopyFallback);
+    EXPECT_FALSE(QFile::exists(targetPath));
+}
+
+TEST_F(TestDoCopyFileWorker, DoCopyFileRangeChunk_CopiesRange)
+{
+    QByteArray content(3 * 1024 * 1024, 'a');
+    for (int i = 0; i < content.size(); ++i)
+        content[i] = static_cast<char>('a' + i % 26);
+
+    QString sourcePath = tempDirPath + "/chunk_source.bin";
+    QFile sourceFile(sourcePath);
+    ASSERT_TRUE(sourceFile.open(QIODevice::WriteOnly));
+    sourceFile.write(content);
+    sourceFile.close();
+    QString targetPath = tempDirPath + "/chunk_target.bin";
+
+    auto fromInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(sourcePath)));
+    auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(targetPath)));
+
+    int srcFd = open(sourcePath.toLocal8Bit().constData(), O_RDONLY);
+    int dstFd = open(targetPath.toLocal8Bit().constData(), O_CREAT | O_WRONLY | O_TRUNC, 0666);
+    ASSERT_GE(srcFd, 0);
+    ASSERT_GE(dstFd, 0);
+    ASSERT_EQ(ftruncate(dstFd, content.size()), 0);
+
+    const qint64 offset = 1024 * 1024;
+    const qint64 length = 1024 * 1024 + 5;
+    std::atomic_bool abort { false };
+    qint64 copied = 0;
+    DoCopyFileWorker::ChunkError error;
+    auto result = worker->doCopyFileRangeChunk(srcFd, dstFd, fromInfo, toInfo, offset, length, abort, &copied, &error);
+    close(srcFd);
+    close(dstFd);
+
+    EXPECT_EQ(result, DoCopyFileWorker::NextDo::kDoCopyNext);
+    EXPECT_EQ(copied, length);
+    EXPECT_EQ(workData->currentWriteSize.load(), length);
+
+    QFile targetFile(targetPath);
+    ASSERT_TRUE(targetFile.open(QIODevice::ReadOnly));
+    EXPECT_EQ(targetFile.readAll().mid(offset, length), content.mid(offset, length));
+}
+
+TEST_F(TestDoCopyFileWorker, DoCopyFileRangeChunk_Aborted)
+{
+    auto fromInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(tempDirPath + "/abort_source.bin")));
+    auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(tempDirPath + "/abort_target.bin")));
+
+    std::atomic_bool abort { true };
+    qint64 copied = 0;
+    DoCopyFileWorker::ChunkError error;
+    auto result = worker->doCopyFileRangeChunk(-1, -1, fromInfo, toInfo, 0, 1024, abort, &copied, &error);
+    EXPECT_EQ(result, DoCopyFileWorker::NextDo::kDoCopyErrorAddCancel);
+    EXPECT_EQ(copied, 0);
+    EXPECT_FALSE(error.claimed);
+}
+
+TEST_F(TestDoCopyFileWorker, DoCopyFileRangeChunk_ErrorRecordedWithoutDialog)
+{
+    auto fromInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(tempDirPath + "/error_source.bin")));
+    auto toInfo = DFileInfoPointer(new DFileInfo(QUrl::fromLocalFile(tempDirPath + "/error_target.bin")));
+
+    bool dialogShown = false;
+    stub.set_lamda(&DoCopyFileWorker::doHandleErrorAndWait,
+                   [&dialogShown](DoCopyFileWorker *, const QUrl &, const QUrl &,
+                                  const AbstractJobHandler::JobErrorType &, const bool,
+                                  const QString &) -> AbstractJobHandler::SupportAction {
+                       __DBG_STUB_INVOKE__
+                       dialogShown = true;
+                       return AbstractJobHandler::SupportAction::kCancelAction;
+                   });
+
+    std::atomic_bool abort { false };
+    qint64 copied = 0;
+    DoCopyFileWorker::ChunkError error;
+    auto result = worker->doCopyFileRangeChunk(-1, -1, fromInfo, toInfo, 0, 1024, abort, &copied, &error);
+    EXPECT_EQ(result, DoCopyFileWorker::NextDo::kDoCopyErrorAddCancel);
+    EXPECT_TRUE(abort);
+    EXPECT_TRUE(error.claimed);
+    EXPECT_EQ(error.code, EBADF);
+    EXPECT_FALSE(dialogShown);
+}
+
+// ========== clone fast path Tests ==========
+
+TEST_F(TestDoCopyFileWorker, TryCloneFile_EmptyFile)
+{
+    EXPECT_FALSE(worker->tryCloneFile(-1, -1, 0));
+    EXPECT_EQ(workData->cloneFileCount, 0);
+}
+
+TEST_F(TestDoCopyFileWorker, TryCloneFile_UnsupportedSkipsIoctl)
+{
+    workData->cloneUnsupported = true;
+    EXPECT_FALSE(worker->tryCloneFile(-1, -1, 4096));
+    EXPECT_EQ(workData->currentWriteSize.load(), 0);
+}
+
+TEST_F(TestDoCopyFileWorker, TryCloneFile_ReportsWholeSize)
+{
+    QString sourcePath = tempDirPath + "/clone_source.bin";
+    QFile sourceFile(sourcePath);
+    ASSERT_TRUE(sourceFile.open(QIODevice::WriteOnly));
+    sourceFile.write(QByteArray(8192, 'c'));
+    sourceFile.close();
+    QString targetPath = tempDirPath + "/clone_target.bin";
+
+    int srcFd = open(sourcePath.toLocal8Bit().constData(), O_RDONLY);
+    int dstFd = open(targetPath.toLocal8Bit().constData(), O_CREAT | O_WRONLY | O_TRUNC, 0666);
+    ASSERT_GE(srcFd, 0);
+    ASSERT_GE(dstFd, 0);
+
+    // result depends on the file system of the temp dir
+    bool cloned = worker->tryCloneFile(srcFd, dstFd, 8192);
+    close(srcFd);
+    close(dstFd);
+
+    if (cloned) {
+        EXPECT_EQ(workData->currentWriteSize.load(), 8192);
+        EXPECT_EQ(workData->cloneFileCount, 1);
+        EXPECT_EQ(workData->cloneFileSize, 8192);
+    } else {
+        EXPECT_EQ(workData->currentWriteSize.load(), 0);
+        EXPECT_EQ(workData->cloneFileCount, 0);
+    }
+}
+
+TEST_F(TestDoCopyFileWorker, SupportCopyOffload_InvalidFd)
+{
+    EXPECT_FALSE(worker->supportCopyOffload(-1));
+}
+
 // ========== doCopyFileTraditional Tests ==========
 
 TEST_F(TestDoCopyFileWorker, DoCopyFileTraditional_Success)
@@ -9,6 +9,7 @@
 #include <QUrl>
 #include <QDir>
 #include <QThread>
+#include <QMutexLocker>
 #include <QDBusAbstractInterface>
 
 #include "stubext.h"
@@ -161,6 +162,40 @@ TEST_F(TestFileOperateBaseWorker, EmitSpeedUpdatedNotify_ValidData)
     EXPECT_TRUE(signalEmitted);
 }
 
+TEST_F(TestFileOperateBaseWorker, EmitSpeedUpdatedNotify_SmoothsSpeed)
+{
+    worker->jobType = AbstractJobHandler::JobType::kCopyType;
+    worker->currentState = AbstractJobHandler::JobState::kRunningState;
+    worker->sourceFilesTotalSize = 100 * 1000;
+    worker->elapsed = 0;
+
+    QElapsedTimer timer;
+    worker->speedtimer = &timer;
+    qint64 elapsedMs = 1000;
+    stub.set_lamda(&QElapsedTimer::elapsed, [&elapsedMs]() -> qint64 {
+        __DBG_STUB_INVOKE__
+        return elapsedMs;
+    });
+
+    QList<qint64> speeds;
+    QObject::connect(worker, &DoCopyFilesWorker::speedUpdatedNotify,
+                     [&speeds](const JobInfoPointer &info) {
+                         speeds.append(info->value(AbstractJobHandler::NotifyInfoKey::kSpeedKey).toLongLong());
+                     });
+
+    // 1000 bytes/s on average, then a burst of 11000 bytes/s
+    worker->emitSpeedUpdatedNotify(1000);
+    elapsedMs = 2000;
+    worker->emitSpeedUpdatedNotify(12000);
+    worker->speedtimer = nullptr;
+
+    ASSERT_EQ(speeds.size(), 2);
+    EXPECT_EQ(speeds.at(0), 1000);
+    // the burst is damped instead of being reported as is
+    EXPECT_GT(speeds.at(1), 1000);
+    EXPECT_LT(speeds.at(1), 11000);
+}
+
 // ========== checkDiskSpaceAvailable Tests ==========
 
 TEST_F(TestFileOperateBaseWorker, CheckDiskSpaceAvailable_SufficientSpace)
@@ -643,21 +678,22 @@ TEST_F(TestFileOperateBaseWorker, CheckTotalDiskSpaceAvailable_InsufficientSpace
     EXPECT_TRUE(skip);
 }
 
-// ========== getTidWriteSize Tests ==========
+// ========== getWriteDataSize Tests ==========
 
-TEST_F(TestFileOperateBaseWorker, GetTidWriteSize_ValidDevice)
+TEST_F(TestFileOperateBaseWorker, GetWriteDataSize_CustomizeType)
 {
-    worker->workData->isBlockDevice = true;
+    worker->countWriteType = AbstractWorker::CountWriteSizeType::kCustomizeType;
+    worker->workData->currentWriteSize = 1000;
+    worker->workData->skipWriteSize = 20;
+    worker->workData->zeroOrlinkOrDirWriteSize = 4;
 
-    qint64 size = worker->getTidWriteSize();
-    EXPECT_GE(size, 0);
+    EXPECT_EQ(worker->getWriteDataSize(), 1024);
 }
 
-TEST_F(TestFileOperateBaseWorker, GetTidWriteSize_NoWorkData)
+TEST_F(TestFileOperateBaseWorker, GetWriteDataSize_NoWorkData)
 {
     worker->workData.reset();
-    qint64 size = worker->getTidWriteSize();
-    EXPECT_EQ(size, 0);
+    EXPECT_EQ(worker->getWriteDataSize(), 0);
 }
 
 // ========== getSectorsWritten Tests ==========
@@ -825,6 +861,108 @@ TEST_F(TestFileOperateBaseWorker, DoCopyFile_Stopped)
     EXPECT_FALSE(result);
 }
 
+// ========== small file batch Tests ==========
+
+TEST_F(TestFileOperateBaseWorker, ShouldUseSmallFileBatch_LocalCopy)
+{
+    worker->jobType = AbstractJobHandler::JobType::kCopyType;
+    worker->isSourceFileLocal = true;
+    worker->isTargetFileLocal = true;
+    worker->workData->useSmallFileBatchCopy = true;
+
+    DFileInfoPointer dirInfo(new DFileInfo(tempDirUrl));
+    EXPECT_TRUE(worker->shouldUseSmallFileBatch(dirInfo));
+
+    worker->workData->useSmallFileBatchCopy = false;
+    EXPECT_FALSE(worker->shouldUseSmallFileBatch(dirInfo));
+}
+
+TEST_F(TestFileOperateBaseWorker, ShouldUseSmallFileBatch_CutOrRemote)
+{
+    worker->workData->useSmallFileBatchCopy = true;
+    worker->isSourceFileLocal = true;
+    worker->isTargetFileLocal = true;
+    DFileInfoPointer dirInfo(new DFileInfo(tempDirUrl));
+
+    worker->jobType = AbstractJobHandler::JobType::kCutType;
+    EXPECT_FALSE(worker->shouldUseSmallFileBatch(dirInfo));
+
+    worker->jobType = AbstractJobHandler::JobType::kCopyType;
+    worker->isTargetFileLocal = false;
+    EXPECT_FALSE(worker->shouldUseSmallFileBatch(dirInfo));
+}
+
+TEST_F(TestFileOperateBaseWorker, DoCopySmallFilesBatch_CountsProgress)
+{
+    const QString sourcePath = tempDirPath + "/batch_source";
+    const QString targetPath = tempDirPath + "/batch_target";
+    QDir().mkpath(sourcePath);
+    QDir().mkpath(targetPath);
+    for (const QString &name : { QString("a.txt"), QString("b.txt") }) {
+        QFile file(sourcePath + "/" + name);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write("12345");
+        file.close();
+    }
+
+    stub.set_lamda(VADDR(AbstractWorker, stateCheck), [](AbstractWorker *) -> bool {
+        __DBG_STUB_INVOKE__
+        return true;
+    });
+
+    stub.set_lamda(&AbstractWorker::needFormatFileName, [](AbstractWorker *) -> bool {
+        __DBG_STUB_INVOKE__
+        return false;
+    });
+    int expectedSizeCount = 0;
+    stub.set_lamda(&FileOperateBaseWorker::setExpectedSizeForTarget,
+                   [&expectedSizeCount](FileOperateBaseWorker *, const QUrl &, qint64) {
+                       __DBG_STUB_INVOKE__
+                       expectedSizeCount++;
+                   });
+
+    DFileInfoPointer fromInfo(new DFileInfo(QUrl::fromLocalFile(sourcePath)));
+    DFileInfoPointer toInfo(new DFileInfo(QUrl::fromLocalFile(targetPath)));
+    const QSet<QByteArray> copied = worker->doCopySmallFilesBatch(fromInfo, toInfo);
+
+    EXPECT_EQ(copied, QSet<QByteArray>({ "a.txt", "b.txt" }));
+    EXPECT_EQ(worker->workData->currentWriteSize.load(), 10);
+    EXPECT_EQ(worker->workData->completeFileCount, 2);
+    EXPECT_EQ(expectedSizeCount, 2);
+    EXPECT_FALSE(worker->cleanupManager.hasIncompleteFiles());
+    EXPECT_TRUE(QFile::exists(targetPath + "/a.txt"));
+}
+
+TEST_F(TestFileOperateBaseWorker, DoCopySmallFilesBatch_FormattedNamesLeftToCaller)
+{
+    const QString sourcePath = tempDirPath + "/batch_format_source";
+    const QString targetPath = tempDirPath + "/batch_format_target";
+    QDir().mkpath(sourcePath);
+    QDir().mkpath(targetPath);
+    for (const QString &name : { QString("a.txt"), QString("b:c.txt") }) {
+        QFile file(sourcePath + "/" + name);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write("12345");
+        file.close();
+    }
+
+    stub.set_lamda(VADDR(AbstractWorker, stateCheck), [](AbstractWorker *) -> bool {
+        __DBG_STUB_INVOKE__
+        return true;
+    });
+    stub.set_lamda(&AbstractWorker::needFormatFileName, [](AbstractWorker *) -> bool {
+        __DBG_STUB_INVOKE__
+        return true;
+    });
+
+    DFileInfoPointer fromInfo(new DFileInfo(QUrl::fromLocalFile(sourcePath)));
+    DFileInfoPointer toInfo(new DFileInfo(QUrl::fromLocalFile(targetPath)));
+    const QSet<QByteArray> copied = worker->doCopySmallFilesBatch(fromInfo, toInfo);
+
+    EXPECT_EQ(copied, QSet<QByteArray>({ "a.txt" }));
+    EXPECT_FALSE(QFile::exists(targetPath + "/b:c.txt"));
+}
+
 // ========== waitThreadPoolOver Tests ==========
 
 TEST_F(TestFileOperateBaseWorker, WaitThreadPoolOver_NoThreadPool)
@@ -834,6 +972,98 @@ TEST_F(TestFileOperateBaseWorker, WaitThreadPoolOver_NoThreadPool)
     SUCCEED();
 }
 
+TEST_F(TestFileOperateBaseWorker, WaitThreadPoolOver_WakesOnLastTask)
+{
+    worker->pendingCopyTasks = 2;
+
+    std::atomic_int finishedTasks { 0 };
+    auto finishTask = [this, &finishedTasks]() {
+        QThread::msleep(20);
+        finishedTasks++;
+        QMutexLocker locker(&worker->copyTaskMutex);
+        if (--worker->pendingCopyTasks == 0)
+            worker->copyTaskFinished.wakeAll();
+    };
+    QScopedPointer<QThread> first(QThread::create(finishTask));
+    QScopedPointer<QThread> second(QThread::create(finishTask));
+    first->start();
+    second->start();
+
+    worker->waitThreadPoolOver();
+    EXPECT_EQ(finishedTasks.load(), 2);
+    EXPECT_EQ(worker->pendingCopyTasks, 0);
+
+    first->wait();
+    second->wait();
+}
+
+TEST_F(TestFileOperateBaseWorker, BeginBigFileCopy_WaitsForRunningCopy)
+{
+    ASSERT_TRUE(worker->beginBigFileCopy());
+
+    std::atomic_bool started { false };
+    QScopedPointer<QThread> other(QThread::create([this, &started]() {
+        started = worker->beginBigFileCopy();
+    }));
+    other->start();
+
+    // 前一个大文件拷贝结束前不能开始
+    EXPECT_FALSE(other->wait(50));
+    EXPECT_FALSE(started.load());
+
+    worker->endBigFileCopy();
+    EXPECT_TRUE(other->wait(1000));
+    EXPECT_TRUE(started.load());
+    worker->endBigFileCopy();
+}
+
+TEST_F(TestFileOperateBaseWorker, BeginBigFileCopy_StoppedWhileWaiting_ReturnsFalse)
+{
+    ASSERT_TRUE(worker->beginBigFileCopy());
+
+    QScopedPointer<DoCopyFilesWorker> waiting(new DoCopyFilesWorker());
+    std::atomic_bool started { true };
+    QScopedPointer<QThread> other(QThread::create([&waiting, &started]() {
+        started = waiting->beginBigFileCopy();
+    }));
+    other->start();
+    EXPECT_FALSE(other->wait(50));
+
+    waiting->stop();
+    EXPECT_TRUE(other->wait(1000));
+    EXPECT_FALSE(started.load());
+    EXPECT_FALSE(waiting->waitBigFileCopy());
+
+    worker->endBigFileCopy();
+    EXPECT_TRUE(worker->waitBigFileCopy());
+}
+
+TEST_F(TestFileOperateBaseWorker, DoCopyLocalFile_TracksPendingTask)
+{
+    worker->workData.reset(new WorkerData);
+    worker->threadCount = 1;
+    worker->initThreadCopy();
+
+    stub.set_lamda(VADDR(AbstractWorker, stateCheck), [](AbstractWorker *) -> bool {
+        __DBG_STUB_INVOKE__
+        return true;
+    });
+    bool copied = false;
+    stub.set_lamda(&DoCopyFileWorker::doFileCopy, [&copied](DoCopyFileWorker *, const DFileInfoPointer, const DFileInfoPointer, const bool) {
+        __DBG_STUB_INVOKE__
+        QThread::msleep(20);
+        copied = true;
+    });
+
+    DFileInfoPointer fromInfo(new DFileInfo(QUrl::fromLocalFile(tempDirPath + "/from.txt")));
+    DFileInfoPointer toInfo(new DFileInfo(QUrl::fromLocalFile(tempDirPath + "/to.txt")));
+    EXPECT_TRUE(worker->doCopyLocalFile(fromInfo, toInfo));
+
+    worker->waitThreadPoolOver();
+    EXPECT_TRUE(copied);
+    EXPECT_EQ(worker->pendingCopyTasks, 0);
+}
+
 // ========== removeTrashInfo Tests ==========
 
 TEST_F(TestFileOperateBaseWorker, RemoveTrashInfo_ValidTrashInfo)
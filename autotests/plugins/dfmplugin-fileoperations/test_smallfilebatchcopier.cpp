@@ -0,0 +1,193 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+
+#include "fileoperations/fileoperationutils/smallfilebatchcopier.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+class TestSmallFileBatchCopier : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        tempDir = std::make_unique<QTemporaryDir>();
+        ASSERT_TRUE(tempDir->isValid());
+
+        sourcePath = tempDir->path() + "/source";
+        targetPath = tempDir->path() + "/target";
+        ASSERT_TRUE(QDir().mkpath(sourcePath));
+        ASSERT_TRUE(QDir().mkpath(targetPath));
+    }
+
+    void TearDown() override
+    {
+        tempDir.reset();
+    }
+
+protected:
+    void createFile(const QString &dir, const QString &name, const QByteArray &content)
+    {
+        QFile file(dir + "/" + name);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(content);
+        file.close();
+    }
+
+    QByteArray readFile(const QString &dir, const QString &name)
+    {
+        QFile file(dir + "/" + name);
+        if (!file.open(QIODevice::ReadOnly))
+            return {};
+        return file.readAll();
+    }
+
+    std::unique_ptr<QTemporaryDir> tempDir;
+    QString sourcePath;
+    QString targetPath;
+};
+
+TEST_F(TestSmallFileBatchCopier, Scan_InvalidDirectory)
+{
+    SmallFileBatchCopier copier(tempDir->path() + "/not_exist", targetPath);
+    EXPECT_FALSE(copier.scan(1024));
+    EXPECT_TRUE(copier.entries().isEmpty());
+}
+
+TEST_F(TestSmallFileBatchCopier, Scan_OnlySmallRegularFiles)
+{
+    createFile(sourcePath, "small.txt", QByteArray(100, 'a'));
+    createFile(sourcePath, "big.bin", QByteArray(4096, 'b'));
+    ASSERT_TRUE(QDir(sourcePath).mkdir("subdir"));
+    ASSERT_TRUE(QFile::link(sourcePath + "/small.txt", sourcePath + "/link.txt"));
+
+    SmallFileBatchCopier copier(sourcePath, targetPath);
+    ASSERT_TRUE(copier.scan(1024));
+    ASSERT_EQ(copier.entries().size(), 1);
+    EXPECT_EQ(copier.entries().first().name, QByteArray("small.txt"));
+    EXPECT_EQ(copier.entries().first().size, 100);
+}
+
+TEST_F(TestSmallFileBatchCopier, Scan_FilterRejectedLeftToCaller)
+{
+    createFile(sourcePath, "a.txt", "data");
+    createFile(sourcePath, "b:c.txt", "data");
+
+    SmallFileBatchCopier copier(sourcePath, targetPath);
+    ASSERT_TRUE(copier.scan(1024, [](const QByteArray &name) { return !name.contains(':'); }));
+    ASSERT_EQ(copier.entries().size(), 1);
+    EXPECT_EQ(copier.entries().first().name, QByteArray("a.txt"));
+}
+
+TEST_F(TestSmallFileBatchCopier, FileName_NonUtf8NameMatchesRawBytes)
+{
+    // Latin-1 编码的文件名在 gio 返回的 uri 中是百分号编码的原始字节
+    const QUrl url("file:///tmp/caf%E9.txt");
+    EXPECT_EQ(SmallFileBatchCopier::fileName(url), QByteArray("caf\xe9.txt"));
+    EXPECT_EQ(SmallFileBatchCopier::fileName(QUrl::fromLocalFile("/tmp/普通.txt")), QByteArray("普通.txt"));
+}
+
+TEST_F(TestSmallFileBatchCopier, Copy_CopiesContentAndMetadata)
+{
+    createFile(sourcePath, "a.txt", "hello");
+    createFile(sourcePath, "b.txt", QByteArray(300, 'x'));
+    createFile(sourcePath, "empty.txt", QByteArray());
+    ::chmod(QFile::encodeName(sourcePath + "/a.txt").constData(), 0640);
+
+    SmallFileBatchCopier copier(sourcePath, targetPath);
+    ASSERT_TRUE(copier.scan(1024));
+
+    int callbackCount = 0;
+    // 内存区只能放下一部分文件，验证分组复用
+    int writeCount = 0;
+    const auto copied = copier.copy(
+            310, []() { return true; },
+            [&writeCount](const SmallFileBatchCopier::Entry &) { writeCount++; },
+            [&callbackCount](const SmallFileBatchCopier::Entry &) { callbackCount++; });
+
+    EXPECT_EQ(copied.size(), 3);
+    EXPECT_EQ(writeCount, 3);
+    EXPECT_EQ(callbackCount, 3);
+    EXPECT_EQ(readFile(targetPath, "a.txt"), QByteArray("hello"));
+    EXPECT_EQ(readFile(targetPath, "b.txt"), QByteArray(300, 'x'));
+    EXPECT_TRUE(QFileInfo::exists(targetPath + "/empty.txt"));
+
+    struct stat from, to;
+    ASSERT_EQ(::stat(QFile::encodeName(sourcePath + "/a.txt").constData(), &from), 0);
+    ASSERT_EQ(::stat(QFile::encodeName(targetPath + "/a.txt").constData(), &to), 0);
+    EXPECT_EQ(to.st_mode & 07777, 0640u);
+    EXPECT_EQ(to.st_mtim.tv_sec, from.st_mtim.tv_sec);
+}
+
+TEST_F(TestSmallFileBatchCopier, Copy_WithoutPreserveAttributes_DefaultPermissions)
+{
+    createFile(sourcePath, "a.txt", "hello");
+    ::chmod(QFile::encodeName(sourcePath + "/a.txt").constData(), 0600);
+    // 源文件时间设为很早以前，验证目标不会沿用
+    const struct timespec oldTimes[2] = { { 1000, 0 }, { 1000, 0 } };
+    ::utimensat(AT_FDCWD, QFile::encodeName(sourcePath + "/a.txt").constData(), oldTimes, 0);
+
+    SmallFileBatchCopier copier(sourcePath, targetPath);
+    ASSERT_TRUE(copier.scan(1024));
+    copier.setPreserveAttributes(false);
+    const auto copied = copier.copy(1024, nullptr, nullptr, nullptr);
+    ASSERT_EQ(copied.size(), 1);
+    EXPECT_EQ(readFile(targetPath, "a.txt"), QByteArray("hello"));
+
+    const mode_t mask = ::umask(0);
+    ::umask(mask);
+    struct stat to;
+    ASSERT_EQ(::stat(QFile::encodeName(targetPath + "/a.txt").constData(), &to), 0);
+    EXPECT_EQ(to.st_mode & 07777, 0666u & ~mask);
+    EXPECT_NE(to.st_mtim.tv_sec, 1000);
+}
+
+TEST_F(TestSmallFileBatchCopier, Copy_ExistingTargetLeftToCaller)
+{
+    createFile(sourcePath, "a.txt", "new");
+    createFile(sourcePath, "b.txt", "new");
+    createFile(targetPath, "a.txt", "old");
+
+    SmallFileBatchCopier copier(sourcePath, targetPath);
+    ASSERT_TRUE(copier.scan(1024));
+    const auto copied = copier.copy(1024, nullptr, nullptr, nullptr);
+
+    ASSERT_EQ(copied.size(), 1);
+    EXPECT_EQ(copied.first(), QByteArray("b.txt"));
+    EXPECT_EQ(readFile(targetPath, "a.txt"), QByteArray("old"));
+}
+
+TEST_F(TestSmallFileBatchCopier, Copy_StopBeforeStart)
+{
+    createFile(sourcePath, "a.txt", "data");
+
+    SmallFileBatchCopier copier(sourcePath, targetPath);
+    ASSERT_TRUE(copier.scan(1024));
+    const auto copied = copier.copy(1024, []() { return false; }, nullptr, nullptr);
+
+    EXPECT_TRUE(copied.isEmpty());
+    EXPECT_FALSE(QFileInfo::exists(targetPath + "/a.txt"));
+}
+
+TEST_F(TestSmallFileBatchCopier, Copy_SourceChangedAfterScan)
+{
+    createFile(sourcePath, "a.txt", "short");
+
+    SmallFileBatchCopier copier(sourcePath, targetPath);
+    ASSERT_TRUE(copier.scan(1024));
+    // 扫描后文件变大，交给原流程重新处理
+    createFile(sourcePath, "a.txt", "much longer content");
+    const auto copied = copier.copy(1024, nullptr, nullptr, nullptr);
+
+    EXPECT_TRUE(copied.isEmpty());
+    EXPECT_FALSE(QFileInfo::exists(targetPath + "/a.txt"));
+}
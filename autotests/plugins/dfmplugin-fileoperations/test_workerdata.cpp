@@ -236,20 +236,6 @@ TEST_F(TestWorkerData, ErrorOfAction_InsertAndRetrieve)
     EXPECT_EQ(data.errorOfAction[AbstractJobHandler::JobErrorType::kProrogramError], AbstractJobHandler::SupportAction::kRetryAction);
 }
 
-TEST_F(TestWorkerData, EveryFileWriteSize_ThreadSafe)
-{
-    WorkerData data;
-
-    QUrl file1 = QUrl::fromLocalFile("/tmp/file1.txt");
-    QUrl file2 = QUrl::fromLocalFile("/tmp/file2.txt");
-
-    data.everyFileWriteSize.insert(file1, 1024);
-    data.everyFileWriteSize.insert(file2, 2048);
-
-    EXPECT_TRUE(data.everyFileWriteSize.contains(file1));
-    EXPECT_TRUE(data.everyFileWriteSize.contains(file2));
-}
-
 // ========== WorkerData JobFlags Tests ==========
 
 TEST_F(TestWorkerData, JobFlags_DefaultIsNoHint)
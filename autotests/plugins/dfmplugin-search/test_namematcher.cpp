@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "searchmanager/searcher/realtime/namematcher.h"
+
+DPSEARCH_USE_NAMESPACE
+
+namespace {
+bool matchBytes(const NameMatcher &matcher, const QString &name)
+{
+    const QByteArray &bytes = name.toUtf8();
+    return matcher.matches(bytes.constData(), static_cast<int>(bytes.size()));
+}
+}   // namespace
+
+TEST(TestNameMatcher, PlainKeyword_ExpectedCaseInsensitiveContains)
+{
+    NameMatcher matcher("Report");
+    EXPECT_EQ(matcher.mode(), NameMatcher::Mode::kContains);
+    EXPECT_TRUE(matcher.canMatchBytes());
+
+    EXPECT_TRUE(matcher.matches(u"annual-REPORT.pdf"));
+    EXPECT_TRUE(matchBytes(matcher, "annual-REPORT.pdf"));
+    EXPECT_TRUE(matchBytes(matcher, "中文report"));
+    EXPECT_FALSE(matchBytes(matcher, "repor.txt"));
+    EXPECT_FALSE(matcher.matches(u"repor.txt"));
+}
+
+TEST(TestNameMatcher, SimpleWildcards_ExpectedPrefixSuffixExact)
+{
+    NameMatcher prefix("abc*");
+    EXPECT_EQ(prefix.mode(), NameMatcher::Mode::kPrefix);
+    EXPECT_TRUE(matchBytes(prefix, "ABCdef"));
+    EXPECT_FALSE(matchBytes(prefix, "xabc"));
+
+    NameMatcher suffix("*.TXT");
+    EXPECT_EQ(suffix.mode(), NameMatcher::Mode::kSuffix);
+    EXPECT_TRUE(matchBytes(suffix, "note.txt"));
+    EXPECT_FALSE(matchBytes(suffix, "note.txt.bak"));
+
+    NameMatcher all("**");
+    EXPECT_EQ(all.mode(), NameMatcher::Mode::kAll);
+    EXPECT_TRUE(matchBytes(all, "anything"));
+}
+
+TEST(TestNameMatcher, ComplexWildcards_ExpectedRegexFallback)
+{
+    NameMatcher matcher("a?c*.txt");
+    EXPECT_EQ(matcher.mode(), NameMatcher::Mode::kRegex);
+    EXPECT_FALSE(matcher.canMatchBytes());
+
+    EXPECT_TRUE(matchBytes(matcher, "ABC-1.txt"));
+    EXPECT_TRUE(matcher.matches(u"axc.TXT"));
+    EXPECT_FALSE(matcher.matches(u"ac.txt"));
+}
+
+TEST(TestNameMatcher, NonAsciiKeyword_ExpectedDecodedMatch)
+{
+    NameMatcher matcher("文档");
+    EXPECT_EQ(matcher.mode(), NameMatcher::Mode::kContains);
+    EXPECT_FALSE(matcher.canMatchBytes());
+
+    EXPECT_TRUE(matchBytes(matcher, "项目文档.docx"));
+    EXPECT_FALSE(matchBytes(matcher, "项目.docx"));
+}
@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "searchmanager/searcher/realtime/realtimesearcher.h"
+#include "searchmanager/searcher/dfmsearch/dfmsearcher.h"
+
+#include <dfm-base/base/application/application.h>
+
+#include <dfm-search/dsearch_global.h>
+
+#include "stubext.h"
+
+#include <algorithm>
+
+DFMBASE_USE_NAMESPACE
+DPSEARCH_USE_NAMESPACE
+
+class TestRealtimeSearcher : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+
+        stub.set_lamda(&DFMSearcher::realSearchPath, [](const QUrl &url) -> QString {
+            __DBG_STUB_INVOKE__
+            return url.toLocalFile();
+        });
+        stub.set_lamda(&Application::genericAttribute, [] {
+            __DBG_STUB_INVOKE__
+            return QVariant(false);
+        });
+        stub.set_lamda(&DFMSEARCH::Global::isHiddenPathOrInHiddenDir, [](const QString &) -> bool {
+            __DBG_STUB_INVOKE__
+            return false;
+        });
+
+        // 构造三层目录，每层若干文件
+        QDir root(tempDir.path());
+        ASSERT_TRUE(root.mkpath("a/b/c"));
+        ASSERT_TRUE(root.mkpath("d"));
+        ASSERT_TRUE(root.mkpath(".secret"));
+        for (const QString &path : { "report.txt", "a/Report-2024.pdf", "a/b/notes.md", "a/b/c/old_report",
+                                     "d/other.txt", ".secret/report.txt", "a/.report-hidden", "a/listed-report" }) {
+            QFile file(root.filePath(path));
+            ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        }
+
+        QFile hiddenList(root.filePath("a/.hidden"));
+        ASSERT_TRUE(hiddenList.open(QIODevice::WriteOnly));
+        hiddenList.write("listed-report\n");
+    }
+
+    void TearDown() override
+    {
+        stub.clear();
+    }
+
+    // 遍历线程可能在 wait 之前就已经发出 finished
+    static bool waitFinished(QSignalSpy &spy)
+    {
+        for (int i = 0; i < 500 && spy.isEmpty(); ++i)
+            QTest::qWait(10);
+        return !spy.isEmpty();
+    }
+
+    QList<QUrl> runSearch(const QString &keyword)
+    {
+        RealtimeSearcher searcher(QUrl::fromLocalFile(tempDir.path()), keyword);
+        QSignalSpy finishedSpy(&searcher, &AbstractSearcher::finished);
+        EXPECT_TRUE(searcher.search());
+        EXPECT_TRUE(waitFinished(finishedSpy));
+
+        QList<QUrl> urls = searcher.takeAll().keys();
+        std::sort(urls.begin(), urls.end());
+        return urls;
+    }
+
+    QTemporaryDir tempDir;
+    stub_ext::StubExt stub;
+};
+
+TEST_F(TestRealtimeSearcher, Search_Keyword_ExpectedAllVisibleMatches)
+{
+    const QList<QUrl> &urls = runSearch("report");
+
+    QList<QUrl> expected {
+        QUrl::fromLocalFile(tempDir.filePath("report.txt")),
+        QUrl::fromLocalFile(tempDir.filePath("a/Report-2024.pdf")),
+        QUrl::fromLocalFile(tempDir.filePath("a/b/c/old_report")),
+    };
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(urls, expected);
+}
+
+TEST_F(TestRealtimeSearcher, Search_MatchDirectoryName_ExpectedDirectoryReported)
+{
+    const QList<QUrl> &urls = runSearch("b");
+
+    EXPECT_TRUE(urls.contains(QUrl::fromLocalFile(tempDir.filePath("a/b"))));
+}
+
+TEST_F(TestRealtimeSearcher, Search_NoMatch_ExpectedFinishedWithoutResults)
+{
+    EXPECT_TRUE(runSearch("nothing-matches-this").isEmpty());
+}
+
+TEST_F(TestRealtimeSearcher, Search_Twice_ExpectedSecondCallRejected)
+{
+    RealtimeSearcher searcher(QUrl::fromLocalFile(tempDir.path()), "report");
+    QSignalSpy finishedSpy(&searcher, &AbstractSearcher::finished);
+    EXPECT_TRUE(searcher.search());
+    EXPECT_FALSE(searcher.search());
+    EXPECT_TRUE(waitFinished(finishedSpy));
+}
+
+TEST_F(TestRealtimeSearcher, Stop_Running_ExpectedFinishedOnce)
+{
+    RealtimeSearcher searcher(QUrl::fromLocalFile(tempDir.path()), "report");
+    QSignalSpy finishedSpy(&searcher, &AbstractSearcher::finished);
+    EXPECT_TRUE(searcher.search());
+    searcher.stop();
+    searcher.stop();
+
+    QTest::qWait(100);
+    EXPECT_EQ(finishedSpy.count(), 1);
+}
+
+TEST_F(TestRealtimeSearcher, SupportUrl_NonLocalScheme_ExpectedRejected)
+{
+    stub.set_lamda(&RealtimeSearcher::isEnabled, [] {
+        __DBG_STUB_INVOKE__
+        return true;
+    });
+
+    EXPECT_FALSE(RealtimeSearcher::supportUrl(QUrl("smb://host/share/dir")));
+    EXPECT_FALSE(RealtimeSearcher::supportUrl(QUrl("recent:///")));
+}
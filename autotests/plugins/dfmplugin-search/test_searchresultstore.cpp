@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QUrl>
+#include <QThread>
+
+#include "searchmanager/searcher/searchresultstore.h"
+
+#include <atomic>
+
+DPSEARCH_USE_NAMESPACE
+
+namespace {
+DFMSearchResultMap createResults(int begin, int end, double score = 0.5)
+{
+    DFMSearchResultMap results;
+    for (int i = begin; i < end; ++i) {
+        const QUrl &url = QUrl::fromLocalFile(QString("/home/test/file%1.txt").arg(i));
+        DFMSearchResult result(url);
+        result.setMatchScore(score);
+        results.insert(url, result);
+    }
+    return results;
+}
+}   // namespace
+
+TEST(TestSearchResultStore, Read_Cursor_ExpectedOnlyNewResults)
+{
+    SearchResultStore store;
+    qsizetype cursor = 0;
+    EXPECT_TRUE(store.read(&cursor).isEmpty());
+
+    store.append(createResults(0, 10));
+    EXPECT_EQ(store.read(&cursor).size(), 10);
+    EXPECT_EQ(cursor, 10);
+    EXPECT_TRUE(store.read(&cursor).isEmpty());
+
+    store.append(createResults(10, 15));
+    const auto &delta = store.read(&cursor);
+    ASSERT_EQ(delta.size(), 5);
+    EXPECT_EQ(delta.first().url(), QUrl::fromLocalFile("/home/test/file10.txt"));
+    EXPECT_EQ(cursor, 15);
+}
+
+TEST(TestSearchResultStore, Append_AcrossChunks_ExpectedAllReadable)
+{
+    SearchResultStore store;
+    store.append(createResults(0, 5000));
+    store.append(createResults(5000, 9000));
+
+    qsizetype cursor = 0;
+    const auto &results = store.read(&cursor);
+    ASSERT_EQ(results.size(), 9000);
+    EXPECT_EQ(store.size(), 9000);
+    EXPECT_EQ(store.compacted().size(), 9000);
+}
+
+TEST(TestSearchResultStore, Compacted_DuplicateUrls_ExpectedHigherScoreKept)
+{
+    SearchResultStore store;
+    store.append(createResults(0, 3, 0.5));
+    store.append(createResults(1, 2, 1.0));
+    store.append(createResults(2, 3, 0.1));
+
+    const auto &compacted = store.compacted();
+    ASSERT_EQ(compacted.size(), 3);
+    EXPECT_DOUBLE_EQ(compacted.value(QUrl::fromLocalFile("/home/test/file1.txt")).matchScore(), 1.0);
+    EXPECT_DOUBLE_EQ(compacted.value(QUrl::fromLocalFile("/home/test/file2.txt")).matchScore(), 0.5);
+
+    // 增量压缩：之后的追加同样生效
+    store.append(createResults(3, 4));
+    EXPECT_EQ(store.compacted().size(), 4);
+}
+
+TEST(TestSearchResultStore, Read_ConcurrentWithAppend_ExpectedNoLossOrDuplicate)
+{
+    SearchResultStore store;
+    constexpr int kBatches = 200;
+    constexpr int kBatchSize = 50;
+
+    std::atomic<bool> writerDone { false };
+    QThread *writer = QThread::create([&store, &writerDone]() {
+        for (int i = 0; i < kBatches; ++i)
+            store.append(createResults(i * kBatchSize, (i + 1) * kBatchSize));
+        writerDone.store(true);
+    });
+    writer->start();
+
+    qsizetype cursor = 0;
+    qsizetype readCount = 0;
+    while (!writerDone.load() || cursor < store.size())
+        readCount += store.read(&cursor).size();
+
+    writer->wait();
+    delete writer;
+
+    EXPECT_EQ(readCount, kBatches * kBatchSize);
+    EXPECT_EQ(store.compacted().size(), kBatches * kBatchSize);
+}
@@ -5,6 +5,7 @@
 #include "stubext.h"
 #include "plugins/common/dfmplugin-tag/utils/filetagcache.h"
 #include "plugins/common/dfmplugin-tag/utils/private/filetagcache_p.h"
+#include "plugins/common/dfmplugin-tag/data/tagproxyhandle.h"
 
 #include <gtest/gtest.h>
 
@@ -153,6 +154,22 @@ TEST_F(UT_FileTagCacheController, getCacheTagsColor_ValidTags)
     EXPECT_TRUE(colors.contains("Tag2"));
 }
 
+TEST_F(UT_FileTagCacheController, getCacheAllTags)
+{
+    // Test getting all cached tag definitions
+    stub.set_lamda(&FileTagCache::getAllTags, [](const FileTagCache*) -> QMap<QString, QColor> {
+        __DBG_STUB_INVOKE__
+        QMap<QString, QColor> colors;
+        colors["Tag1"] = QColor("#ffa503");
+        return colors;
+    });
+
+    QMap<QString, QColor> colors = controller->getCacheAllTags();
+
+    EXPECT_EQ(colors.size(), 1);
+    EXPECT_EQ(colors.value("Tag1"), QColor("#ffa503"));
+}
+
 TEST_F(UT_FileTagCacheController, findChildren_Empty)
 {
     // Test finding children for empty path
@@ -240,3 +257,51 @@ TEST_F(UT_FileTagCacheController, findChildren_NestedPaths)
 
     EXPECT_EQ(children.size(), 3);
 }
+
+TEST_F(UT_FileTagCacheController, loadFileTagsFromDatabase_ServiceInvalid_StaysUnloaded)
+{
+    // Test that the cache is not marked loaded before the tag service is available
+    stub.set_lamda(&TagProxyHandle::isValid, [](TagProxyHandle *) {
+        __DBG_STUB_INVOKE__
+        return false;
+    });
+    bool queried = false;
+    stub.set_lamda(&TagProxyHandle::getAllFileWithTags, [&queried](TagProxyHandle *) -> QVariantHash {
+        __DBG_STUB_INVOKE__
+        queried = true;
+        return {};
+    });
+
+    FileTagCache::instance().d->loaded = false;
+    FileTagCache::instance().loadFileTagsFromDatabase();
+
+    EXPECT_FALSE(queried);
+    EXPECT_FALSE(controller->isLoaded());
+}
+
+TEST_F(UT_FileTagCacheController, loadFileTagsFromDatabase_ServiceValid_Loaded)
+{
+    // Test that a load after the service appears fills the cache and marks it loaded
+    stub.set_lamda(&TagProxyHandle::isValid, [](TagProxyHandle *) {
+        __DBG_STUB_INVOKE__
+        return true;
+    });
+    stub.set_lamda(&TagProxyHandle::getAllFileWithTags, [](TagProxyHandle *) -> QVariantHash {
+        __DBG_STUB_INVOKE__
+        return { { "/path/file1", QStringList { "Red" } } };
+    });
+    stub.set_lamda(&TagProxyHandle::getAllTags, [](TagProxyHandle *) -> QVariantMap {
+        __DBG_STUB_INVOKE__
+        return { { "Red", "#ff0000" } };
+    });
+    stub.set_lamda(&TagProxyHandle::getAllTrashFileTags, [](TagProxyHandle *) -> QVariantHash {
+        __DBG_STUB_INVOKE__
+        return {};
+    });
+
+    FileTagCache::instance().d->loaded = false;
+    FileTagCache::instance().loadFileTagsFromDatabase();
+
+    EXPECT_TRUE(controller->isLoaded());
+    EXPECT_EQ(FileTagCache::instance().getTagsByFiles({ "/path/file1" }), QStringList { "Red" });
+}
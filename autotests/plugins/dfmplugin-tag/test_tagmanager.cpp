@@ -220,6 +220,11 @@ TEST_F(UT_TagManager, getTagsByUrls_ValidUrls)
         return url1 == url2;
     });
 
+    stub.set_lamda(&FileTagCacheController::isLoaded, [](FileTagCacheController *) -> bool {
+        __DBG_STUB_INVOKE__
+        return true;
+    });
+
     stub.set_lamda(&FileTagCacheController::getTagsByFiles, [](FileTagCacheController *, const QStringList &) -> QStringList {
         __DBG_STUB_INVOKE__
         QStringList tags;
@@ -233,6 +238,48 @@ TEST_F(UT_TagManager, getTagsByUrls_ValidUrls)
     EXPECT_EQ(tags.size(), 2);
 }
 
+TEST_F(UT_TagManager, getTagsByUrls_CacheNotLoaded_BatchQuery)
+{
+    // Test that an unloaded cache falls back to one batched query
+    QList<QUrl> urls;
+    urls << QUrl::fromLocalFile("/home/user/a.txt")
+         << QUrl::fromLocalFile("/home/user/b.txt");
+
+    stub.set_lamda(&UniversalUtils::urlsTransformToLocal, [&urls](const QList<QUrl> &, QList<QUrl> *realUrls) -> bool {
+        __DBG_STUB_INVOKE__
+        *realUrls = urls;
+        return true;
+    });
+
+    stub.set_lamda(&TagHelper::commonUrls, [&urls](const QList<QUrl> &) -> QList<QUrl> {
+        __DBG_STUB_INVOKE__
+        return urls;
+    });
+
+    stub.set_lamda(&FileTagCacheController::isLoaded, [](FileTagCacheController *) -> bool {
+        __DBG_STUB_INVOKE__
+        return false;
+    });
+
+    int queryCount = 0;
+    QStringList queriedPaths;
+    stub.set_lamda(&TagProxyHandle::getTagsOfFiles, [&queryCount, &queriedPaths](TagProxyHandle *, const QStringList &paths) -> QVariantMap {
+        __DBG_STUB_INVOKE__
+        ++queryCount;
+        queriedPaths = paths;
+        QVariantMap result;
+        result["/home/user/a.txt"] = QStringList { "Red", "Blue" };
+        result["/home/user/b.txt"] = QStringList { "Blue", "Green" };
+        return result;
+    });
+
+    QStringList tags = ins->getTagsByUrls(urls);
+
+    EXPECT_EQ(queryCount, 1);
+    EXPECT_EQ(queriedPaths.size(), 2);
+    EXPECT_EQ(tags, QStringList { "Blue" });
+}
+
 TEST_F(UT_TagManager, getFilesByTag_EmptyTag)
 {
     // Test with empty tag
@@ -271,6 +318,69 @@ TEST_F(UT_TagManager, setTagsForFiles_EmptyFiles)
     EXPECT_FALSE(result);
 }
 
+TEST_F(UT_TagManager, setTagsForFiles_GroupsFilesByNewTags)
+{
+    // Files needing the same new tags are submitted in one call
+    QList<QUrl> files;
+    for (int i = 0; i < 4; ++i)
+        files << QUrl::fromLocalFile(QString("/home/user/file%1").arg(i));
+
+    stub.set_lamda(&UniversalUtils::urlsTransformToLocal, [](const QList<QUrl> &urls, QList<QUrl> *realUrls) -> bool {
+        __DBG_STUB_INVOKE__
+        *realUrls = urls;
+        return true;
+    });
+    stub.set_lamda(&TagHelper::commonUrls, [](const QList<QUrl> &urls) -> QList<QUrl> {
+        __DBG_STUB_INVOKE__
+        return urls;
+    });
+    stub.set_lamda(&TagManager::getTagsByUrls, [](TagManager *, const QList<QUrl> &urls) -> QStringList {
+        __DBG_STUB_INVOKE__
+        // file0 already has Red
+        if (urls.size() == 1 && urls.first().path() == "/home/user/file0")
+            return { "Red" };
+        return {};
+    });
+
+    QList<QPair<QStringList, int>> calls;
+    stub.set_lamda(&TagManager::addTagsForFiles, [&calls](TagManager *, const QList<QString> &tags, const QList<QUrl> &urls) -> bool {
+        __DBG_STUB_INVOKE__
+        calls.append({ tags, static_cast<int>(urls.size()) });
+        return true;
+    });
+
+    EXPECT_TRUE(ins->setTagsForFiles({ "Red", "Blue" }, files));
+
+    ASSERT_EQ(calls.size(), 2);
+    EXPECT_TRUE(calls.contains(qMakePair(QStringList { "Blue" }, 1)));
+    EXPECT_TRUE(calls.contains(qMakePair(QStringList { "Red", "Blue" }, 3)));
+}
+
+TEST_F(UT_TagManager, getTagsColor_CacheLoaded)
+{
+    // A loaded cache answers without going through DBus
+    stub.set_lamda(&FileTagCacheController::isLoaded, [](FileTagCacheController *) -> bool {
+        __DBG_STUB_INVOKE__
+        return true;
+    });
+    stub.set_lamda(&FileTagCacheController::getCacheTagsColor, [](FileTagCacheController *, const QStringList &) -> QMap<QString, QColor> {
+        __DBG_STUB_INVOKE__
+        QMap<QString, QColor> colors;
+        colors["Tag1"] = QColor("#ffa503");
+        return colors;
+    });
+    bool dbusCalled = false;
+    stub.set_lamda(&TagProxyHandle::getTagsColor, [&dbusCalled](TagProxyHandle *, const QStringList &) -> QVariantMap {
+        __DBG_STUB_INVOKE__
+        dbusCalled = true;
+        return {};
+    });
+
+    EXPECT_EQ(ins->getTagsColor({ "Tag1" }).value("Tag1"), QColor("#ffa503"));
+    EXPECT_EQ(ins->getTagsColorName({ "Tag1" }).value("Tag1"), QString("#ffa503"));
+    EXPECT_FALSE(dbusCalled);
+}
+
 TEST_F(UT_TagManager, addTagsForFiles)
 {
     stub.set_lamda(&TagHelper::qureyColorByDisplayName, []() { __DBG_STUB_INVOKE__ return QColor("red"); });
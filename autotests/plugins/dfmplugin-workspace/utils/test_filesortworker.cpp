@@ -441,6 +441,47 @@ TEST_F(FileSortWorkerTest, HandleResort_ValidArguments_Resorts)
     worker->handleResort(order, role, isMixDirAndFile);
 }
 
+TEST_F(FileSortWorkerTest, HandleResort_SizeAndTime_SortsByKeys)
+{
+    stub.set_lamda(&InfoFactory::create<FileInfo>,
+                   [](const QUrl &, Global::CreateFileInfoType, QString *) -> QSharedPointer<FileInfo> {
+                       __DBG_STUB_INVOKE__
+                       return nullptr;
+                   });
+
+    auto makeSortInfo = [this](const QString &name, qint64 size, qint64 modified, bool isDir) {
+        auto sortInfo = QSharedPointer<dfmbase::SortFileInfo>::create();
+        sortInfo->setUrl(QUrl::fromLocalFile(testUrl.path() + "/" + name));
+        sortInfo->setSize(size);
+        sortInfo->setLastModifiedTime(modified);
+        sortInfo->setDir(isDir);
+        sortInfo->setFile(!isDir);
+        return sortInfo;
+    };
+    auto childNames = [this]() {
+        QStringList names;
+        for (const auto &url : worker->getChildrenUrls())
+            names << url.fileName();
+        return names;
+    };
+
+    worker->handleWatcherAddChildren({ makeSortInfo("b.txt", 300, 20, false),
+                                       makeSortInfo("a.txt", 100, 30, false),
+                                       makeSortInfo("c.txt", 200, 10, false),
+                                       makeSortInfo("dir", 0, 40, true) });
+    ASSERT_EQ(worker->getChildrenUrls().size(), 4);
+
+    worker->handleResort(Qt::AscendingOrder, DFMBASE_NAMESPACE::Global::ItemRoles::kItemFileSizeRole, false);
+    EXPECT_EQ(childNames(), QStringList({ "dir", "a.txt", "c.txt", "b.txt" }));
+
+    // 只改变顺序时目录仍然在前
+    worker->handleResort(Qt::DescendingOrder, DFMBASE_NAMESPACE::Global::ItemRoles::kItemFileSizeRole, false);
+    EXPECT_EQ(childNames(), QStringList({ "dir", "b.txt", "c.txt", "a.txt" }));
+
+    worker->handleResort(Qt::DescendingOrder, DFMBASE_NAMESPACE::Global::ItemRoles::kItemFileLastModifiedRole, false);
+    EXPECT_EQ(childNames(), QStringList({ "dir", "a.txt", "b.txt", "c.txt" }));
+}
+
 TEST_F(FileSortWorkerTest, HandleReGrouping_ValidArguments_ReGroups)
 {
     // Test handling regrouping
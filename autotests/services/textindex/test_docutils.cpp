@@ -11,6 +11,10 @@
 #include <QMimeDatabase>
 #include <DTextEncoding>
 #include <optional>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
 
 #include "utils/docutils.h"
 
@@ -50,6 +54,59 @@ protected:
         return testDir + "/" + relativePath;
     }
 
+    // DocParser 每次解析耗时 kParseMs，并记录同时在解析的最大线程数
+    void stubSlowDocParser()
+    {
+        running = 0;
+        maxRunning = 0;
+
+        stub.set_lamda(ADDR(DocUtils, isHtmlStyleDocument), [](const QString &) -> bool {
+            __DBG_STUB_INVOKE__
+            return false;
+        });
+        stub.set_lamda(ADDR(DocUtils, getFileEncoding), [](const QString &) -> QString {
+            __DBG_STUB_INVOKE__
+            return "utf-8";
+        });
+        using ConvertFunc = std::string (*)(const std::string &);
+        stub.set_lamda(static_cast<ConvertFunc>(&DocParser::convertFile), [](const std::string &) -> std::string {
+            __DBG_STUB_INVOKE__
+            const int now = ++running;
+            int prev = maxRunning.load();
+            while (now > prev && !maxRunning.compare_exchange_weak(prev, now)) { }
+            std::this_thread::sleep_for(std::chrono::milliseconds(kParseMs));
+            --running;
+            return "content";
+        });
+    }
+
+    // workers 个线程各自提取 filesPerWorker 个文件，返回总耗时（毫秒）并通过 peak 返回最大并发数
+    qint64 extractConcurrently(const QString &suffix, int workers, int filesPerWorker, int *peak)
+    {
+        stubSlowDocParser();
+        for (int i = 0; i < workers * filesPerWorker; ++i)
+            createTestFile(QString("scale_%1.%2").arg(i).arg(suffix), "content");
+
+        const auto begin = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int w = 0; w < workers; ++w) {
+            threads.emplace_back([this, w, filesPerWorker, suffix]() {
+                for (int i = 0; i < filesPerWorker; ++i)
+                    DocUtils::extractFileContent(getTestFilePath(QString("scale_%1.%2").arg(w * filesPerWorker + i).arg(suffix)));
+            });
+        }
+        for (auto &t : threads)
+            t.join();
+        const auto elapsed = std::chrono::steady_clock::now() - begin;
+
+        *peak = maxRunning.load();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+    }
+
+    static constexpr int kParseMs = 50;
+    static inline std::atomic<int> running { 0 };
+    static inline std::atomic<int> maxRunning { 0 };
+
     std::unique_ptr<QTemporaryDir> tempDir;
     QString testDir;
 
@@ -419,3 +476,41 @@ TEST_F(UT_DocUtils, ExtractFileContent_WithMaxBytes_PassesToDocParser)
     EXPECT_TRUE(result.has_value());
     EXPECT_EQ(result.value(), "Truncated content");
 }
+
+TEST_F(UT_DocUtils, ExtractFileContent_PlainText_ThroughputScalesWithWorkers)
+{
+    const int kFilesPerWorker = 4;
+    int peak = 0;
+
+    const qint64 single = extractConcurrently("txt", 1, kFilesPerWorker, &peak);
+    EXPECT_EQ(peak, 1);
+
+    // 纯文本不加锁，4 个线程处理 4 倍的文件耗时应明显少于串行所需的 4 倍时间
+    const qint64 parallel = extractConcurrently("txt", 4, kFilesPerWorker, &peak);
+    EXPECT_GT(peak, 1);
+    EXPECT_LT(parallel, single * 2);
+}
+
+TEST_F(UT_DocUtils, ExtractFileContent_NonReentrantBackend_Serialized)
+{
+    int peak = 0;
+    const qint64 elapsed = extractConcurrently("doc", 4, 2, &peak);
+
+    EXPECT_EQ(peak, 1);
+    EXPECT_GE(elapsed, 8 * kParseMs);
+}
+
+TEST_F(UT_DocUtils, ExtractFileContent_DifferentBackends_RunConcurrently)
+{
+    stubSlowDocParser();
+    createTestFile("a.doc", "content");
+    createTestFile("b.pdf", "content");
+
+    // doc 和 pdf 使用不同的解析后端，互不阻塞
+    std::thread first([this]() { DocUtils::extractFileContent(getTestFilePath("a.doc")); });
+    std::thread second([this]() { DocUtils::extractFileContent(getTestFilePath("b.pdf")); });
+    first.join();
+    second.join();
+
+    EXPECT_EQ(maxRunning.load(), 2);
+}
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QSet>
+#include <QThread>
+
+#include "task/extractionpipeline.h"
+
+#include <atomic>
+
+SERVICETEXTINDEX_USE_NAMESPACE
+using namespace Lucene;
+
+namespace {
+DocumentPtr makeDocument(const QString &path)
+{
+    DocumentPtr doc = newLucene<Document>();
+    doc->add(newLucene<Field>(L"path", path.toStdWString(), Field::STORE_YES, Field::INDEX_NOT_ANALYZED));
+    return doc;
+}
+}   // namespace
+
+class UT_ExtractionPipeline : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        state.start();
+    }
+
+    TaskState state;
+};
+
+TEST_F(UT_ExtractionPipeline, ResolveWorkerCount_Configured)
+{
+    EXPECT_EQ(ExtractionPipeline::resolveWorkerCount(3, 0), 3);
+}
+
+TEST_F(UT_ExtractionPipeline, ResolveWorkerCount_Auto)
+{
+    const int count = ExtractionPipeline::resolveWorkerCount(0, 0);
+    EXPECT_GE(count, 1);
+    EXPECT_LE(count, 4);
+}
+
+TEST_F(UT_ExtractionPipeline, ResolveWorkerCount_LimitedByCpuQuota)
+{
+    EXPECT_EQ(ExtractionPipeline::resolveWorkerCount(8, 50), 1);
+    EXPECT_EQ(ExtractionPipeline::resolveWorkerCount(8, 250), 2);
+}
+
+TEST_F(UT_ExtractionPipeline, Submit_AllDocumentsWrittenOnCallingThread)
+{
+    QThread *caller = QThread::currentThread();
+    QSet<QString> written;
+    bool writtenOnCaller = true;
+
+    ExtractionPipeline pipeline(
+            3, state,
+            [](const QString &path) { return makeDocument(path); },
+            [&](const QString &path, const DocumentPtr &doc) {
+                writtenOnCaller = writtenOnCaller && QThread::currentThread() == caller;
+                EXPECT_EQ(QString::fromStdWString(doc->get(L"path")), path);
+                written.insert(path);
+            });
+
+    for (int i = 0; i < 200; ++i)
+        EXPECT_TRUE(pipeline.submit(QString("/tmp/file_%1.txt").arg(i)));
+    pipeline.finish();
+
+    EXPECT_EQ(written.size(), 200);
+    EXPECT_TRUE(writtenOnCaller);
+}
+
+TEST_F(UT_ExtractionPipeline, Submit_NullDocumentSkipped)
+{
+    int writeCount = 0;
+    ExtractionPipeline pipeline(
+            2, state,
+            [](const QString &path) { return path.endsWith(".bad") ? DocumentPtr() : makeDocument(path); },
+            [&writeCount](const QString &, const DocumentPtr &) { writeCount++; });
+
+    pipeline.submit("/tmp/a.txt");
+    pipeline.submit("/tmp/b.bad");
+    pipeline.submit("/tmp/c.txt");
+    pipeline.finish();
+
+    EXPECT_EQ(writeCount, 2);
+}
+
+TEST_F(UT_ExtractionPipeline, Submit_StoppedTaskRejectsFiles)
+{
+    std::atomic_int extractCount { 0 };
+    ExtractionPipeline pipeline(
+            2, state,
+            [&extractCount](const QString &path) {
+                extractCount++;
+                return makeDocument(path);
+            },
+            [](const QString &, const DocumentPtr &) {});
+
+    state.stop();
+    EXPECT_FALSE(pipeline.submit("/tmp/a.txt"));
+    pipeline.finish();
+    EXPECT_EQ(extractCount.load(), 0);
+}
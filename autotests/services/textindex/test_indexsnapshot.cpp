@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "utils/indexsnapshot.h"
+
+#include <lucene++/LuceneHeaders.h>
+
+SERVICETEXTINDEX_USE_NAMESPACE
+using namespace Lucene;
+
+class UT_IndexSnapshot : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        state.start();
+        directory = newLucene<RAMDirectory>();
+        IndexWriterPtr writer = newLucene<IndexWriter>(directory, newLucene<StandardAnalyzer>(LuceneVersion::LUCENE_CURRENT),
+                                                       true, IndexWriter::MaxFieldLengthUNLIMITED);
+        addDocument(writer, "/home/test/a.txt", 100);
+        addDocument(writer, "/home/test/b.txt", 200);
+        addDocument(writer, "/home/test/deleted.txt", 300);
+        writer->deleteDocuments(newLucene<Term>(L"path", L"/home/test/deleted.txt"));
+        writer->close();
+
+        reader = IndexReader::open(directory, true);
+    }
+
+    void TearDown() override
+    {
+        reader->close();
+        directory->close();
+    }
+
+    void addDocument(const IndexWriterPtr &writer, const QString &path, qint64 modified)
+    {
+        DocumentPtr doc = newLucene<Document>();
+        doc->add(newLucene<Field>(L"path", path.toStdWString(), Field::STORE_YES, Field::INDEX_NOT_ANALYZED));
+        doc->add(newLucene<Field>(L"modified", QString::number(modified).toStdWString(),
+                                  Field::STORE_YES, Field::INDEX_NOT_ANALYZED));
+        doc->add(newLucene<Field>(L"contents", L"large contents", Field::STORE_YES, Field::INDEX_ANALYZED));
+        writer->addDocument(doc);
+    }
+
+    TaskState state;
+    RAMDirectoryPtr directory;
+    IndexReaderPtr reader;
+};
+
+TEST_F(UT_IndexSnapshot, Load_SkipsDeletedDocuments)
+{
+    IndexSnapshot snapshot;
+    ASSERT_TRUE(snapshot.load(reader, state));
+    EXPECT_EQ(snapshot.size(), 2);
+}
+
+TEST_F(UT_IndexSnapshot, Load_StoppedTask_ReturnsFalse)
+{
+    IndexSnapshot snapshot;
+    state.stop();
+    EXPECT_FALSE(snapshot.load(reader, state));
+}
+
+TEST_F(UT_IndexSnapshot, Check_ReportsFileState)
+{
+    IndexSnapshot snapshot;
+    ASSERT_TRUE(snapshot.load(reader, state));
+
+    EXPECT_EQ(snapshot.check("/home/test/a.txt", 100), IndexSnapshot::FileState::Unchanged);
+    EXPECT_EQ(snapshot.check("/home/test/b.txt", 250), IndexSnapshot::FileState::Modified);
+    EXPECT_EQ(snapshot.check("/home/test/new.txt", 100), IndexSnapshot::FileState::New);
+    EXPECT_EQ(snapshot.check("/home/test/deleted.txt", 300), IndexSnapshot::FileState::New);
+}
+
+TEST_F(UT_IndexSnapshot, UnvisitedDocIds_OnlyNotSeenDocuments)
+{
+    IndexSnapshot snapshot;
+    ASSERT_TRUE(snapshot.load(reader, state));
+    EXPECT_EQ(snapshot.unvisitedDocIds().size(), 2);
+
+    snapshot.check("/home/test/a.txt", 100);
+    const QList<int32_t> docIds = snapshot.unvisitedDocIds();
+    ASSERT_EQ(docIds.size(), 1);
+    EXPECT_EQ(QString::fromStdWString(reader->document(docIds.first())->get(L"path")), QString("/home/test/b.txt"));
+}
+
+TEST_F(UT_IndexSnapshot, PathKey_DistinctPaths)
+{
+    EXPECT_EQ(IndexSnapshot::pathKey("/home/test/a.txt"), IndexSnapshot::pathKey("/home/test/a.txt"));
+    EXPECT_NE(IndexSnapshot::pathKey("/home/test/a.txt"), IndexSnapshot::pathKey("/home/test/b.txt"));
+}
+
+TEST_F(UT_IndexSnapshot, Load_DuplicatedPath_ReportsUnknown)
+{
+    IndexWriterPtr writer = newLucene<IndexWriter>(directory, newLucene<StandardAnalyzer>(LuceneVersion::LUCENE_CURRENT),
+                                                   false, IndexWriter::MaxFieldLengthUNLIMITED);
+    addDocument(writer, "/home/test/a.txt", 150);
+    writer->close();
+    reader->close();
+    reader = IndexReader::open(directory, true);
+
+    IndexSnapshot snapshot;
+    ASSERT_TRUE(snapshot.load(reader, state));
+    EXPECT_EQ(snapshot.check("/home/test/a.txt", 100), IndexSnapshot::FileState::Unknown);
+    EXPECT_EQ(snapshot.unvisitedDocIds().size(), 3);
+}
@@ -189,6 +189,24 @@ TEST_F(UT_IndexTask, ThrottleCpuUsage_SilentMode_SetsCpuQuota)
     EXPECT_EQ(lastCpuQuotaPercentage, mockCpuLimitPercent);
 }
 
+TEST_F(UT_IndexTask, ThrottleCpuUsage_SilentMode_PassesQuotaToHandler)
+{
+    int seenQuota = -1;
+    auto handler = [&seenQuota](const QString &, TaskState &state) -> HandlerResult {
+        seenQuota = state.cpuQuotaPercent();
+        return HandlerResult { true, false, false, false };
+    };
+
+    IndexTask silentTask(IndexTask::Type::Create, "/test/path", handler);
+    silentTask.setSilent(true);
+    silentTask.start();
+    EXPECT_EQ(seenQuota, mockCpuLimitPercent);
+
+    IndexTask normalTask(IndexTask::Type::Create, "/test/path", handler);
+    normalTask.start();
+    EXPECT_EQ(seenQuota, 0);
+}
+
 TEST_F(UT_IndexTask, ThrottleCpuUsage_NonSilentMode_SkipsCpuThrottling)
 {
     auto handler = [this](const QString &, TaskState &) -> HandlerResult {
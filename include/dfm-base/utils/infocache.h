@@ -19,6 +19,21 @@ namespace dfmbase {
 class InfoCachePrivate;
 class InfoCache;
 
+// fileinfo 缓存的命中和淘汰统计
+struct InfoCacheStatistics
+{
+    quint64 hits { 0 };
+    quint64 misses { 0 };
+    quint64 evictions { 0 };   // 超出缓存数量被淘汰的个数，不包含主动移除和超时移除
+    int size { 0 };
+
+    double hitRate() const
+    {
+        const quint64 total = hits + misses;
+        return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+    }
+};
+
 // 异步缓存和移除
 class CacheWorker : public QObject
 {
@@ -45,7 +60,6 @@ class TimeToUpdateCache : public QObject
 public:
     ~TimeToUpdateCache() override;
 public Q_SLOTS:
-    void updateInfoTime(const QUrl url);
     void dealRemoveInfo();
     void updateWatcherTime(const QList<QUrl> &urls, const bool add);
 private:
@@ -69,7 +83,6 @@ public:
 Q_SIGNALS:
     void cacheRemoveCaches(const QList<QUrl> &key);
     void cacheDisconnectWatcher(const QMap<QUrl, FileInfoPointer> infos);
-    void cacheUpdateInfoTime(const QUrl url);
 
 private:
     explicit InfoCache(QObject *parent = nullptr);
@@ -77,13 +90,12 @@ private:
     bool cacheDisable(const QString &scheme);
     void setCacheDisbale(const QString &scheme, bool disable = true);
     FileInfoPointer getCacheInfo(const QUrl &url);
+    InfoCacheStatistics statistics() const;
     void stop();
     void cacheInfo(const QUrl url, const FileInfoPointer info);
     void disconnectWatcher(const QMap<QUrl, FileInfoPointer> infos);
     void removeCaches(const QList<QUrl> urls);
-    bool updateSortTimeWorker(const QUrl url);
     void timeRemoveCache();
-    void removeInfosTimeWorker(const QList<QUrl> urls);
     void updateSortTimeWatcherWorker(const QList<QUrl> &urls, const bool add);
 
 private Q_SLOTS:
@@ -110,6 +122,7 @@ public:
     bool cacheDisable(const QString &scheme);
     void setCacheDisbale(const QString &scheme, bool disable = true);
     FileInfoPointer getCacheInfo(const QUrl &url);
+    InfoCacheStatistics statistics() const;
 Q_SIGNALS:
     void cacheFileInfo(const QUrl url, const FileInfoPointer info);
     void removeCacheFileInfo(const QList<QUrl> &urls);
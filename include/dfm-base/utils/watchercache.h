@@ -23,6 +23,8 @@ class WatcherCache : public QObject
     friend InfoCache;
 Q_SIGNALS:
     void fileDelete(const QUrl &url);
+    // 缓存的监视器报告的任意变化（创建、删除、属性/内容变化、重命名的新旧路径）
+    void fileChanged(const QUrl &url);
     void updateWatcherTime(const QList<QUrl> &url, const bool add);
 
 public:
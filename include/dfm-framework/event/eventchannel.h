@@ -8,10 +8,14 @@
 #include <dfm-framework/dfm_framework_global.h>
 #include <dfm-framework/event/eventhelper.h>
 #include <dfm-framework/event/invokehelper.h>
+#include <dfm-framework/event/eventtable.h>
 
 #include <QFuture>
 #include <QReadWriteLock>
 
+#include <memory>
+#include <typeinfo>
+
 DPF_BEGIN_NAMESPACE
 
 class EventChannelFuture
@@ -69,13 +73,77 @@ public:
             EventHelper<decltype(method)> helper = (EventHelper<decltype(method)>(obj, method));
             return helper.invoke(args);
         };
+
+        // 同时保留一份不经过 QVariant 的直接调用，供 EventChannelHandle 使用
+        using Typed = TypedInvokeHelper<Func>;
+        if constexpr (Typed::kTypeable) {
+            typedConn = std::make_shared<std::function<typename Typed::Signature>>(Typed::bind(obj, method));
+            typedSignature = &typeid(typename Typed::Signature);
+        } else {
+            typedConn.reset();
+            typedSignature = nullptr;
+        }
+    }
+
+    template<class Signature>
+    inline std::shared_ptr<std::function<Signature>> typedReceiver() const
+    {
+        if (!typedSignature || *typedSignature != typeid(Signature))
+            return nullptr;
+        return std::static_pointer_cast<std::function<Signature>>(typedConn);
     }
 
 private:
     Connector conn;
+    std::shared_ptr<void> typedConn;
+    const std::type_info *typedSignature { nullptr };
     QMutex receiverMutex;
 };
 
+class EventChannelManager;
+
+/*!
+ * \brief Typed handle of a slot event
+ * 事件类型解析成功后即缓存，调用时按 EventType 直接查表；
+ * 若接收者的签名与 Signature 一致则直接调用，不经过 QVariant 装箱/拆箱，
+ * 否则退回到 EventChannel::send 的 QVariant 路径。
+ * 用法:
+ *   static auto handle { dpfSlotChannel->resolve<QString(quint64, QUrl)>("dfmplugin_xxx", "slot_Xxx") };
+ *   QString ret = handle(winId, url);
+ */
+template<class Signature>
+class EventChannelHandle;
+
+template<class R, class... Args>
+class EventChannelHandle<R(Args...)>
+{
+public:
+    using Signature = R(const REMOVE_CONST_REF(Args) &...);
+
+    EventChannelHandle() = default;
+    EventChannelHandle(EventChannelManager *manager, EventType type)
+        : manager(manager), type(type) { }
+    EventChannelHandle(EventChannelManager *manager, const QString &space, const QString &topic)
+        : manager(manager), space(space), topic(topic), type(EventConverter::convert(space, topic)) { }
+
+    inline bool isValid() const { return manager && isValidEventType(eventType()); }
+    inline EventType eventType() const
+    {
+        // 目标插件可能晚于调用方加载，未解析成功时再次尝试
+        if (Q_UNLIKELY(!isValidEventType(type) && !topic.isEmpty()))
+            type = EventConverter::convert(space, topic);
+        return type;
+    }
+
+    inline R operator()(const REMOVE_CONST_REF(Args) &...args) const;
+
+private:
+    EventChannelManager *manager { nullptr };
+    QString space;
+    QString topic;
+    mutable EventType type { EventTypeScope::kInValid };
+};
+
 class EventChannelManager
 {
 public:
@@ -112,6 +180,27 @@ public:
     bool disconnect(const QString &space, const QString &topic);
     bool disconnect(const EventType &type);
 
+    template<class Signature>
+    inline EventChannelHandle<Signature> resolve(const QString &space, const QString &topic)
+    {
+        Q_ASSERT(topic.startsWith(kSlotStrategePrefix));
+        return EventChannelHandle<Signature>(this, space, topic);
+    }
+
+    template<class Signature>
+    inline EventChannelHandle<Signature> resolve(EventType type)
+    {
+        if (!isValidEventType(type))
+            qCWarning(logDPF) << "Event " << type << "is invalid";
+        return EventChannelHandle<Signature>(this, type);
+    }
+
+    inline QSharedPointer<EventChannel> channel(EventType type)
+    {
+        QReadLocker guard(&rwLock);
+        return channelMap.value(type);
+    }
+
     template<class T, class... Args>
     inline QVariant push(const QString &space, const QString &topic, T param, Args &&... args)
     {
@@ -192,13 +281,36 @@ public:
 
 private:
     using ChannelPtr = QSharedPointer<EventChannel>;
-    using EventChannelMap = QMap<EventType, ChannelPtr>;
+    using EventChannelMap = EventTable<EventChannel>;
 
 private:
     EventChannelMap channelMap;
     QReadWriteLock rwLock;
 };
 
+template<class R, class... Args>
+inline R EventChannelHandle<R(Args...)>::operator()(const REMOVE_CONST_REF(Args) &...args) const
+{
+    const EventType type { eventType() };
+    threadEventAlert(type);
+    auto channel { manager ? manager->channel(type) : QSharedPointer<EventChannel>() };
+    if (Q_UNLIKELY(!channel)) {
+        if constexpr (std::is_void<R>::value)
+            return;
+        else
+            return R();
+    }
+
+    if (auto receiver = channel->template typedReceiver<Signature>())
+        return (*receiver)(args...);
+
+    // 接收者签名不一致（如带有输出参数），走 QVariant 路径
+    if constexpr (std::is_void<R>::value)
+        channel->send(args...);
+    else
+        return channel->send(args...).template value<R>();
+}
+
 DPF_END_NAMESPACE
 
 #endif   // EVENTCHANNEL_H
@@ -8,6 +8,7 @@
 #include <dfm-framework/dfm_framework_global.h>
 #include <dfm-framework/event/eventhelper.h>
 #include <dfm-framework/event/invokehelper.h>
+#include <dfm-framework/event/eventtable.h>
 
 #include <QVariant>
 #include <QFuture>
@@ -336,7 +337,7 @@ protected:
 
 private:
     using DispatcherPtr = QSharedPointer<EventDispatcher>;
-    using EventDispatcherMap = QMap<EventType, DispatcherPtr>;
+    using EventDispatcherMap = EventTable<EventDispatcher>;
     using GlobalEventFilterMap = QMap<QObject *, GlobalFilter>;
 
 private:
@@ -14,6 +14,7 @@
 #include <QThread>
 #include <QCoreApplication>
 
+#include <functional>
 #include <mutex>
 
 DPF_BEGIN_NAMESPACE
@@ -500,6 +501,35 @@ protected:
     Func f;
 };
 
+/*
+ * typed invoker, call the member function directly without QVariant boxing
+ * the signature is normalized to R(const Arg &...), so the caller and the receiver
+ * match as long as the decayed argument types are the same.
+ * receivers with non-const reference arguments (out params) are not typeable
+ */
+template<class Handler>
+struct TypedInvokeHelper
+{
+    static constexpr bool kTypeable = false;
+};
+
+template<class Result, class T, class... Args>
+struct TypedInvokeHelper<Result (T::*)(Args...)>
+{
+    using Signature = Result(const REMOVE_CONST_REF(Args) &...);
+    using Func = Result (T::*)(Args...);
+    static constexpr bool kTypeable = !((std::is_reference<Args>::value
+                                         && !std::is_const<typename std::remove_reference<Args>::type>::value)
+                                        || ...);
+
+    static std::function<Signature> bind(T *self, Func func)
+    {
+        return [self, func](const REMOVE_CONST_REF(Args) &...args) -> Result {
+            return (self->*func)(args...);
+        };
+    }
+};
+
 /*
  * cast member function to void *
  */
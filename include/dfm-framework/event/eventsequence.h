@@ -8,6 +8,7 @@
 #include <dfm-framework/dfm_framework_global.h>
 #include <dfm-framework/event/eventhelper.h>
 #include <dfm-framework/event/invokehelper.h>
+#include <dfm-framework/event/eventtable.h>
 
 #include <QMutex>
 #include <QReadWriteLock>
@@ -184,7 +185,7 @@ protected:
 
 private:
     using SequencePtr = QSharedPointer<EventSequence>;
-    using EventSequenceMap = QMap<EventType, SequencePtr>;
+    using EventSequenceMap = EventTable<EventSequence>;
 
 private:
     EventSequenceMap sequenceMap;
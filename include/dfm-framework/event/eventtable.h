@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef EVENTTABLE_H
+#define EVENTTABLE_H
+
+#include <dfm-framework/dfm_framework_global.h>
+#include <dfm-framework/event/eventhelper.h>
+
+#include <QSharedPointer>
+
+#include <vector>
+
+DPF_BEGIN_NAMESPACE
+
+/*!
+ * \brief Flat table of event objects indexed by EventType
+ * EventType 是连续分配的小整数（well known: [0, 10000)，custom: 从 10001 递增），
+ * 直接用数组下标查找，代替 QMap 的二分查找。表按需增长，只在写锁下修改，
+ * 调用方负责加锁（与原先的 QMap 用法一致）。
+ */
+template<class T>
+class EventTable
+{
+public:
+    using Pointer = QSharedPointer<T>;
+
+    inline bool contains(EventType type) const
+    {
+        return isValidEventType(type) && static_cast<size_t>(type) < table.size() && table[type];
+    }
+
+    inline Pointer value(EventType type) const
+    {
+        return contains(type) ? table[type] : Pointer();
+    }
+
+    inline Pointer &operator[](EventType type)
+    {
+        Q_ASSERT(isValidEventType(type));
+        if (static_cast<size_t>(type) >= table.size())
+            table.resize(type + 1);
+        return table[type];
+    }
+
+    inline void insert(EventType type, const Pointer &ptr)
+    {
+        (*this)[type] = ptr;
+    }
+
+    inline int remove(EventType type)
+    {
+        if (!contains(type))
+            return 0;
+        table[type].reset();
+        return 1;
+    }
+
+private:
+    std::vector<Pointer> table;
+};
+
+DPF_END_NAMESPACE
+
+#endif   // EVENTTABLE_H
@@ -9,18 +9,49 @@
 
 #include <QString>
 #include <QtSql>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QSet>
+#include <QSharedPointer>
+#include <QThreadStorage>
 
 DFMBASE_BEGIN_NAMESPACE
 
+// 每个线程独占的连接信息，只在所属线程中访问，不需要加锁
+struct SqliteThreadConnections
+{
+    QHash<QString, QString> connectionNames;   // database name -> connection name
+    QSet<QString> suspectConnections;   // 出错过的连接，下次使用前先做健康检查
+    // connection name + sql -> prepared query，按最近使用顺序淘汰；语句由共享指针持有，
+    // 被淘汰或丢弃时正在使用它的调用方仍持有引用，不会被提前释放
+    QHash<QString, QSharedPointer<QSqlQuery>> statements;
+    QList<QString> statementOrder;   // 最近使用的在末尾
+    int maxStatements;
+
+    SqliteThreadConnections();
+    QSharedPointer<QSqlQuery> statement(const QString &key);
+    void insertStatement(const QString &key, const QSharedPointer<QSqlQuery> &query);
+    void dropStatements(const QString &connectionName);
+    void clearStatements();
+};
+
 class SqliteConnectionPoolPrivate
 {
 public:
     SqliteConnectionPoolPrivate();
     QString makeConnectionName(const QString &databaseName);
     QSqlDatabase createConnection(const QString &databaseName, const QString &connectionName);
+    bool isWalEnabled(const QString &databaseName);
+    void tuneConnection(QSqlDatabase &db);
+    bool checkConnection(QSqlDatabase &db);
+    SqliteThreadConnections *threadConnections();
 
 public:
     QString connectionName;
+    QThreadStorage<SqliteThreadConnections *> connections;
+    QMutex walMutex;
+    QSet<QString> walDatabases;
 };
 
 DFMBASE_END_NAMESPACE
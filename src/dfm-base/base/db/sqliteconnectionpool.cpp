@@ -15,6 +15,62 @@ DFMBASE_USE_NAMESPACE
 
 static constexpr char kDatabaseType[] { "QSQLITE" };
 static constexpr char kTestSql[] { "SELECT 1" };
+static constexpr char kConnectOptions[] { "QSQLITE_BUSY_TIMEOUT=3000" };
+static constexpr int kMaxCachedStatements { 64 };
+
+// 只用于调用过 enableWal() 的数据库：WAL 下读写互不阻塞，synchronous=NORMAL 在 WAL 模式下
+// 仍能保证数据库一致性，mmap 让读取直接走页缓存，减少 read() 系统调用
+static const char *const kWalTuneSqls[] {
+    "PRAGMA journal_mode=WAL;",
+    "PRAGMA synchronous=NORMAL;",
+    "PRAGMA mmap_size=67108864;"
+};
+
+SqliteThreadConnections::SqliteThreadConnections()
+    : maxStatements(kMaxCachedStatements)
+{
+}
+
+QSharedPointer<QSqlQuery> SqliteThreadConnections::statement(const QString &key)
+{
+    const auto &query = statements.value(key);
+    if (query) {
+        statementOrder.removeOne(key);
+        statementOrder.append(key);
+    }
+    return query;
+}
+
+void SqliteThreadConnections::insertStatement(const QString &key, const QSharedPointer<QSqlQuery> &query)
+{
+    if (statements.contains(key))
+        statementOrder.removeOne(key);
+    statements.insert(key, query);
+    statementOrder.append(key);
+
+    // 只移出缓存，仍在使用中的语句由调用方持有的引用保活
+    while (statementOrder.size() > maxStatements)
+        statements.remove(statementOrder.takeFirst());
+}
+
+void SqliteThreadConnections::dropStatements(const QString &connectionName)
+{
+    const QString &prefix = connectionName + QChar('\n');
+    for (auto it = statementOrder.begin(); it != statementOrder.end();) {
+        if (it->startsWith(prefix)) {
+            statements.remove(*it);
+            it = statementOrder.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void SqliteThreadConnections::clearStatements()
+{
+    statements.clear();
+    statementOrder.clear();
+}
 
 SqliteConnectionPoolPrivate::SqliteConnectionPoolPrivate()
 {
@@ -33,8 +89,10 @@ QSqlDatabase SqliteConnectionPoolPrivate::createConnection(const QString &databa
 
     QSqlDatabase db = QSqlDatabase::addDatabase(kDatabaseType, connectionName);
     db.setDatabaseName(databaseName);
+    db.setConnectOptions(kConnectOptions);
 
     if (db.open()) {
+        tuneConnection(db);
         qCInfo(logDFMBase) << "SQLite connection created successfully - name:" << connectionName 
                            << "database:" << databaseName << "serial number:" << (++sn);
         return db;
@@ -45,6 +103,52 @@ QSqlDatabase SqliteConnectionPoolPrivate::createConnection(const QString &databa
     }
 }
 
+bool SqliteConnectionPoolPrivate::isWalEnabled(const QString &databaseName)
+{
+    QMutexLocker locker(&walMutex);
+    return walDatabases.contains(databaseName);
+}
+
+void SqliteConnectionPoolPrivate::tuneConnection(QSqlDatabase &db)
+{
+    if (!isWalEnabled(db.databaseName()))
+        return;
+
+    QSqlQuery query(db);
+    for (const char *sql : kWalTuneSqls) {
+        if (!query.exec(sql))
+            qCWarning(logDFMBase) << "Failed to tune SQLite connection:" << sql << "error:" << query.lastError().text();
+    }
+}
+
+bool SqliteConnectionPoolPrivate::checkConnection(QSqlDatabase &db)
+{
+    qCDebug(logDFMBase) << "Testing SQLite connection after error - connection:" << db.connectionName()
+                        << "test query:" << kTestSql;
+    {
+        QSqlQuery query(kTestSql, db);
+        if (query.lastError().type() == QSqlError::NoError)
+            return true;
+    }
+
+    threadConnections()->dropStatements(db.connectionName());
+    db.close();
+    if (!db.open()) {
+        qCCritical(logDFMBase) << "Failed to reopen SQLite database connection - connection:"
+                               << db.connectionName() << "error:" << db.lastError().text();
+        return false;
+    }
+    tuneConnection(db);
+    return true;
+}
+
+SqliteThreadConnections *SqliteConnectionPoolPrivate::threadConnections()
+{
+    if (!connections.hasLocalData())
+        connections.setLocalData(new SqliteThreadConnections);
+    return connections.localData();
+}
+
 SqliteConnectionPool::SqliteConnectionPool(QObject *parent)
     : QObject(parent), d(new SqliteConnectionPoolPrivate)
 {
@@ -65,23 +169,36 @@ QSqlDatabase SqliteConnectionPool::openConnection(const QString &databaseName)
     assert(!databaseName.isEmpty());
     assert(QUrl::fromLocalFile(databaseName).isValid());
 
-    QString baseConnectionName = "conn_" + QString::number(quint64(QThread::currentThread()), 16);
-    QString fullConnectionName = baseConnectionName + "_" + d->makeConnectionName(databaseName);
+    // 连接名只在线程第一次打开该数据库时计算
+    SqliteThreadConnections *conns = d->threadConnections();
+    QString fullConnectionName = conns->connectionNames.value(databaseName);
+    if (fullConnectionName.isEmpty()) {
+        QString baseConnectionName = "conn_" + QString::number(quint64(QThread::currentThread()), 16);
+        fullConnectionName = baseConnectionName + "_" + d->makeConnectionName(databaseName);
+        conns->connectionNames.insert(databaseName, fullConnectionName);
+    }
 
     if (QSqlDatabase::contains(fullConnectionName)) {
-        QSqlDatabase existingDb = QSqlDatabase::database(fullConnectionName);
-        qCDebug(logDFMBase) << "Testing existing SQLite connection - connection:" << fullConnectionName 
-                            << "test query:" << kTestSql;
-        QSqlQuery query(kTestSql, existingDb);
-        if (query.lastError().type() != QSqlError::NoError && !existingDb.open()) {
-            qCCritical(logDFMBase) << "Failed to open existing SQLite database connection - connection:" 
-                                   << fullConnectionName << "error:" << existingDb.lastError().text();
+        QSqlDatabase existingDb = QSqlDatabase::database(fullConnectionName, false);
+        const bool suspect = conns->suspectConnections.remove(fullConnectionName);
+        if (!existingDb.isOpen()) {
+            conns->dropStatements(fullConnectionName);
+            if (!existingDb.open()) {
+                qCCritical(logDFMBase) << "Failed to open existing SQLite database connection - connection:"
+                                       << fullConnectionName << "error:" << existingDb.lastError().text();
+                return QSqlDatabase();
+            }
+            d->tuneConnection(existingDb);
+        } else if (suspect && !d->checkConnection(existingDb)) {
             return QSqlDatabase();
         }
-        qCDebug(logDFMBase) << "Reusing existing SQLite connection:" << fullConnectionName;
         return existingDb;
     } else {
         if (qApp != nullptr) {
+            // 线程结束前在本线程内释放预编译语句，之后才能安全地移除连接
+            QObject::connect(QThread::currentThread(), &QThread::finished, [this] {
+                d->threadConnections()->clearStatements();
+            });
             QObject::connect(QThread::currentThread(), &QThread::finished, qApp, [fullConnectionName] {
                 if (QSqlDatabase::contains(fullConnectionName)) {
                     QSqlDatabase::removeDatabase(fullConnectionName);
@@ -94,3 +211,55 @@ QSqlDatabase SqliteConnectionPool::openConnection(const QString &databaseName)
         return d->createConnection(databaseName, fullConnectionName);
     }
 }
+
+/*!
+ * \brief 返回当前线程连接上缓存的预编译语句，语句按 SQL 文本做 LRU 缓存。
+ * 只应传入使用占位符绑定参数的 SQL，拼接了字面值的 SQL 每次文本都不同，缓存不会命中。
+ * 返回的共享指针在语句被移出缓存后仍然有效，调用方执行并读取结果后需要调用 finish() 重置语句，
+ * 且不能跨线程使用。同一条 SQL 的缓存语句正在执行（嵌套调用）时返回一条不缓存的新语句。
+ */
+QSharedPointer<QSqlQuery> SqliteConnectionPool::preparedQuery(const QString &databaseName, const QString &sql)
+{
+    QSqlDatabase db { openConnection(databaseName) };
+    if (!db.isValid() || !db.isOpen())
+        return nullptr;
+
+    SqliteThreadConnections *conns = d->threadConnections();
+    const QString &key = db.connectionName() + QChar('\n') + sql;
+    const auto &cached = conns->statement(key);
+    if (cached && !cached->isActive())
+        return cached;
+
+    QSharedPointer<QSqlQuery> query(new QSqlQuery(db));
+    query->setForwardOnly(true);
+    if (!query->prepare(sql)) {
+        qCWarning(logDFMBase).noquote() << "Failed to prepare SQL:" << sql << "error:" << query->lastError().text().trimmed();
+        return nullptr;
+    }
+
+    if (!cached)
+        conns->insertStatement(key, query);
+    return query;
+}
+
+/*!
+ * \brief 为数据库开启 WAL、synchronous=NORMAL 和 mmap，需要在第一次打开连接前调用。
+ * WAL 模式会写入数据库文件并额外生成 -wal/-shm 文件，只适合本机上由少数进程访问的数据库，
+ * 因此默认不开启，由数据库的所有者按需选择。
+ */
+void SqliteConnectionPool::enableWal(const QString &databaseName)
+{
+    QMutexLocker locker(&d->walMutex);
+    d->walDatabases.insert(databaseName);
+}
+
+/*!
+ * \brief 标记当前线程的连接出现过错误，下次打开时先做一次健康检查
+ */
+void SqliteConnectionPool::reportError(const QString &databaseName)
+{
+    SqliteThreadConnections *conns = d->threadConnections();
+    const QString &connectionName = conns->connectionNames.value(databaseName);
+    if (!connectionName.isEmpty())
+        conns->suspectConnections.insert(connectionName);
+}
@@ -8,6 +8,7 @@
 #include <dfm-base/dfm_base_global.h>
 
 #include <QObject>
+#include <QSharedPointer>
 #include <QtSql>
 
 DFMBASE_BEGIN_NAMESPACE
@@ -21,6 +22,9 @@ class SqliteConnectionPool : public QObject
 public:
     static SqliteConnectionPool &instance();
     QSqlDatabase openConnection(const QString &databaseName);
+    QSharedPointer<QSqlQuery> preparedQuery(const QString &databaseName, const QString &sql);
+    void enableWal(const QString &databaseName);
+    void reportError(const QString &databaseName);
 
 private:
     explicit SqliteConnectionPool(QObject *parent = nullptr);
@@ -83,17 +83,14 @@ public:
 
         QString fmtFields;
         QString fmtValues;
+        QVariantList values;
 
-        auto serializeValue = [&entity](const QString &field) -> QString {
+        // 值通过占位符绑定，同一张表的插入语句文本不变，可以复用连接池缓存的预编译语句
+        auto bindValue = [&entity](const QString &field) -> QVariant {
             QVariant &&variant { entity.property(field.toLocal8Bit().data()) };
-            QString &&typeStr { SqliteHelper::typeString(variant.type()) };
-            QString out;
-            if (typeStr.contains("TEXT")) {
-                SerializationHelper::serialize(&out, variant.toString());
-            } else {
-                SerializationHelper::serialize(&out, variant);
-            }
-            return out;
+            if (SqliteHelper::typeString(variant.type()).contains("TEXT"))
+                return variant.toString();
+            return variant;
         };
 
         int startIndex { 1 };
@@ -102,7 +99,8 @@ public:
 
         for (int i = startIndex; i != fieldNames.size(); ++i) {
             fmtFields += (fieldNames[i] + ",");
-            fmtValues += (serializeValue(fieldNames[i]) + ",");
+            fmtValues += "?,";
+            values.append(bindValue(fieldNames[i]));
         }
 
         if (fmtFields.endsWith(","))
@@ -112,12 +110,13 @@ public:
 
         Q_ASSERT(!fmtFields.isEmpty() && !fmtValues.isEmpty());
         int lastId { -1 };
-        if (!excute("INSERT INTO " + SqliteHelper::tableName<T>()
-                            + "(" + fmtFields + ") VALUES (" + fmtValues + ");",
-                    [&lastId](QSqlQuery *query) {
-                        Q_ASSERT(query);
-                        lastId = query->lastInsertId().toInt();
-                    }))
+        if (!excutePrepared("INSERT INTO " + SqliteHelper::tableName<T>()
+                                    + "(" + fmtFields + ") VALUES (" + fmtValues + ");",
+                            values,
+                            [&lastId](QSqlQuery *query) {
+                                Q_ASSERT(query);
+                                lastId = query->lastInsertId().toInt();
+                            }))
             return -1;
 
         return lastId;
@@ -170,6 +169,12 @@ public:
         return SqliteHelper::excute(databaseName, sql, &lastExcutedSql, fn);
     }
 
+    // 反复执行的语句使用占位符和 bindValues，避免每次拼接出不同的 SQL 文本
+    inline bool excutePrepared(const QString &sql, const QVariantList &bindValues, std::function<void(QSqlQuery *)> fn = nullptr)
+    {
+        return SqliteHelper::excutePrepared(databaseName, sql, bindValues, &lastExcutedSql, fn);
+    }
+
     inline QString lastQuery() const
     {
         return lastExcutedSql;
@@ -457,6 +457,7 @@ public:
         }
         if (query.lastError().type() != QSqlError::NoError) {
             qCWarning(logDFMBase).noquote() << "SQL Error: " << query.lastError().text().trimmed();
+            SqliteConnectionPool::instance().reportError(databaseName);
             ret = false;
         }
 
@@ -465,6 +466,41 @@ public:
 
         return ret;
     }
+
+    // sql 使用 "?" 占位符，bindValues 按顺序绑定；语句由连接池按 SQL 文本缓存，反复执行时只编译一次
+    static inline bool excutePrepared(const QString &databaseName, const QString &sql, const QVariantList &bindValues,
+                                      QString *lastQuery = nullptr, std::function<void(QSqlQuery *)> fn = nullptr)
+    {
+        auto &pool = SqliteConnectionPool::instance();
+        // 持有共享指针，fn 中嵌套的调用淘汰或丢弃缓存时语句仍然有效
+        QSharedPointer<QSqlQuery> query { pool.preparedQuery(databaseName, sql) };
+        if (!query) {
+            pool.reportError(databaseName);
+            return false;
+        }
+
+        for (int i = 0; i < bindValues.size(); ++i)
+            query->bindValue(i, bindValues.at(i));
+        query->exec();
+
+        bool ret { true };
+        if (lastQuery) {
+            *lastQuery = query->lastQuery();
+            qCInfo(logDFMBase).noquote() << "SQL Query:" << *lastQuery;
+        }
+        if (query->lastError().type() != QSqlError::NoError) {
+            qCWarning(logDFMBase).noquote() << "SQL Error: " << query->lastError().text().trimmed();
+            pool.reportError(databaseName);
+            ret = false;
+        }
+
+        if (fn)
+            fn(query.data());
+
+        // 重置缓存的语句，释放它持有的读锁，下次可以直接重新执行
+        query->finish();
+        return ret;
+    }
 };
 
 DFMBASE_END_NAMESPACE
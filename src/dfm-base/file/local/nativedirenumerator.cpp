@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "nativedirenumerator.h"
+
+#include <QFile>
+
+#include <cerrno>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace dfmbase;
+
+namespace {
+// 一次 getdents64 最多读取的字节数，约可容纳数千个目录项
+constexpr int kDirentBufferSize { 256 * 1024 };
+// 排序和显示需要的字段，不查询 btime、inode 等
+constexpr unsigned int kStatxMask { STATX_TYPE | STATX_MODE | STATX_SIZE | STATX_ATIME | STATX_MTIME | STATX_CTIME };
+
+struct LinuxDirent64
+{
+    quint64 d_ino;
+    qint64 d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+}   // namespace
+
+void NativeDirEnumerator::Batch::clear()
+{
+    names.clear();
+    entries.clear();
+}
+
+QString NativeDirEnumerator::Batch::fileName(const Entry &entry) const
+{
+    return QFile::decodeName(QByteArray::fromRawData(names.constData() + entry.nameOffset, entry.nameLength));
+}
+
+NativeDirEnumerator::NativeDirEnumerator(const QString &dirPath)
+    : dirPath(QFile::encodeName(dirPath))
+{
+}
+
+NativeDirEnumerator::~NativeDirEnumerator()
+{
+    close();
+}
+
+bool NativeDirEnumerator::open()
+{
+    close();
+    dirFd = ::open(dirPath.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+        lastError = errno;
+        // 无权限的目录在遍历中很常见，不作为警告输出
+        if (lastError == EACCES)
+            qCDebug(logDFMBase) << "native enumerator: permission denied:" << dirPath;
+        else
+            qCWarning(logDFMBase) << "native enumerator: open dir failed:" << dirPath << std::strerror(lastError);
+        return false;
+    }
+
+    buffer.resize(kDirentBufferSize);
+    bufferPos = bufferEnd = 0;
+    reachedEnd = false;
+    lastError = 0;
+    return true;
+}
+
+void NativeDirEnumerator::close()
+{
+    if (dirFd >= 0) {
+        ::close(dirFd);
+        dirFd = -1;
+    }
+}
+
+void NativeDirEnumerator::setHiddenNames(const QSet<QString> &names)
+{
+    hiddenNames = names;
+}
+
+void NativeDirEnumerator::setTypeOnly(bool typeOnly)
+{
+    this->typeOnly = typeOnly;
+}
+
+int NativeDirEnumerator::error() const
+{
+    return lastError;
+}
+
+bool NativeDirEnumerator::fillBuffer()
+{
+    long ret = 0;
+    do {
+        ret = ::syscall(SYS_getdents64, dirFd, buffer.data(), static_cast<size_t>(buffer.size()));
+    } while (ret < 0 && errno == EINTR);
+
+    if (ret < 0) {
+        lastError = errno;
+        qCWarning(logDFMBase) << "native enumerator: getdents64 failed:" << dirPath << std::strerror(lastError);
+        reachedEnd = true;
+        return false;
+    }
+
+    bufferPos = 0;
+    bufferEnd = static_cast<int>(ret);
+    reachedEnd = ret == 0;
+    return !reachedEnd;
+}
+
+bool NativeDirEnumerator::statEntry(const char *name, Entry *entry) const
+{
+    struct statx stx;
+    if (::statx(dirFd, name, AT_SYMLINK_NOFOLLOW | AT_STATX_DONT_SYNC, kStatxMask, &stx) != 0)
+        return false;
+
+    entry->isSymlink = S_ISLNK(stx.stx_mode);
+    if (entry->isSymlink) {
+        // 与 FollowSymlinks 的遍历结果一致，类型和大小取链接目标的；目标不存在时保留链接自身的信息
+        struct statx target;
+        if (::statx(dirFd, name, AT_STATX_DONT_SYNC, kStatxMask, &target) == 0)
+            stx = target;
+    }
+
+    entry->isDir = S_ISDIR(stx.stx_mode);
+    entry->isFile = S_ISREG(stx.stx_mode);
+    entry->size = static_cast<qint64>(stx.stx_size);
+    entry->lastRead = stx.stx_atime.tv_sec;
+    entry->lastModified = stx.stx_mtime.tv_sec;
+    entry->changed = stx.stx_ctime.tv_sec;
+    // 与 dfm-io 一致按当前进程的有效身份判断权限（含属组、其他用户、ACL 和只读挂载），不能只看属主位
+    entry->readable = ::faccessat(dirFd, name, R_OK, AT_EACCESS) == 0;
+    entry->writable = ::faccessat(dirFd, name, W_OK, AT_EACCESS) == 0;
+    entry->executable = ::faccessat(dirFd, name, X_OK, AT_EACCESS) == 0;
+    return true;
+}
+
+bool NativeDirEnumerator::nextBatch(Batch *batch, int maxCount)
+{
+    Q_ASSERT(batch);
+    batch->clear();
+    if (dirFd < 0)
+        return false;
+
+    batch->entries.reserve(maxCount);
+    while (batch->entries.size() < maxCount) {
+        if (bufferPos >= bufferEnd && (reachedEnd || !fillBuffer()))
+            break;
+
+        const auto *dirent = reinterpret_cast<const LinuxDirent64 *>(buffer.constData() + bufferPos);
+        bufferPos += dirent->d_reclen;
+
+        const char *name = dirent->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+            continue;
+
+        Entry entry;
+        if (typeOnly && dirent->d_type != DT_UNKNOWN) {
+            entry.isDir = dirent->d_type == DT_DIR;
+            entry.isFile = dirent->d_type == DT_REG;
+            entry.isSymlink = dirent->d_type == DT_LNK;
+        } else if (!statEntry(name, &entry)) {
+            // 文件在遍历过程中被删除时 statx 失败，直接跳过
+            continue;
+        }
+
+        const int nameLength = static_cast<int>(std::strlen(name));
+        entry.nameOffset = batch->names.size();
+        entry.nameLength = nameLength;
+        batch->names.append(name, nameLength + 1);
+
+        entry.isHidden = name[0] == '.'
+                || (!hiddenNames.isEmpty() && hiddenNames.contains(batch->fileName(entry)));
+        batch->entries.append(entry);
+    }
+
+    return !batch->entries.isEmpty();
+}
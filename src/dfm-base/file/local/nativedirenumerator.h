@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef NATIVEDIRENUMERATOR_H
+#define NATIVEDIRENUMERATOR_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QByteArray>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+namespace dfmbase {
+
+/**
+ * @brief 本地目录的原生遍历
+ *
+ * 通过 getdents64 将目录项读入复用的缓冲区，再对每一项调用 statx，只查询排序和显示需要的字段。
+ * 结果按批输出，一批中的条目连续存放，文件名统一存放在批次的 names 缓冲区中，
+ * 不为每个条目单独分配 QUrl/QString，由调用方在交给界面前再转换。
+ *
+ * 只用于本地文件系统，不处理名称过滤等 QDir 过滤条件（"." 和 ".." 总是被跳过）。
+ */
+class NativeDirEnumerator
+{
+    Q_DISABLE_COPY(NativeDirEnumerator)
+
+public:
+    struct Entry
+    {
+        int nameOffset { 0 };
+        int nameLength { 0 };
+        qint64 size { 0 };
+        qint64 lastRead { 0 };   // 秒
+        qint64 lastModified { 0 };
+        qint64 changed { 0 };   // st_ctime，与 dfm-io 的 create 字段一致
+        bool isDir { false };
+        bool isFile { false };
+        bool isSymlink { false };
+        bool isHidden { false };
+        bool readable { false };
+        bool writable { false };
+        bool executable { false };
+    };
+
+    struct Batch
+    {
+        QByteArray names;   // 以 '\0' 分隔的文件名（本地 8 位编码）
+        QVector<Entry> entries;
+
+        void clear();
+        QString fileName(const Entry &entry) const;
+    };
+
+    explicit NativeDirEnumerator(const QString &dirPath);
+    ~NativeDirEnumerator();
+
+    bool open();
+    void close();
+    // 读取最多 maxCount 个条目，没有更多条目或出错时返回 false
+    bool nextBatch(Batch *batch, int maxCount);
+
+    void setHiddenNames(const QSet<QString> &names);
+    // 只需要文件类型时（如搜索）直接使用 d_type，仅在文件系统不提供类型时才调用 statx；
+    // 此模式下符号链接不会被跟随，大小和时间字段为 0
+    void setTypeOnly(bool typeOnly);
+    int error() const;
+
+private:
+    bool fillBuffer();
+    bool statEntry(const char *name, Entry *entry) const;
+
+    QByteArray dirPath;
+    int dirFd { -1 };
+    int lastError { 0 };
+    QSet<QString> hiddenNames;
+    bool typeOnly { false };
+
+    QByteArray buffer;   // getdents64 缓冲区，整个遍历过程中复用
+    int bufferPos { 0 };
+    int bufferEnd { 0 };
+    bool reachedEnd { false };
+};
+
+}   // namespace dfmbase
+
+#endif   // NATIVEDIRENUMERATOR_H
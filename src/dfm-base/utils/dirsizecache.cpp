@@ -0,0 +1,330 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dirsizecache.h"
+
+#include <dfm-base/base/standardpaths.h>
+#include <dfm-base/base/configs/dconfig/dconfigmanager.h>
+#include <dfm-base/utils/watchercache.h>
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <algorithm>
+#include <mutex>
+
+#include <linux/magic.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+
+using namespace dfmbase;
+
+namespace {
+constexpr quint32 kCacheMagic { 0x44465343 };   // "DFSC"
+constexpr quint32 kCacheVersion { 1 };
+}   // namespace
+
+bool DirSizeCache::isEnabled()
+{
+    using namespace GlobalDConfDefines;
+    return DConfigManager::instance()->value(ConfigPath::kDefaultCfgPath, BaseConfig::kDirSizeCacheEnable, false).toBool();
+}
+
+DirSizeCache *DirSizeCache::instance()
+{
+    static DirSizeCache ins(StandardPaths::location(StandardPaths::kCachePath) + "/dirsize.cache");
+    static std::once_flag connected;
+    std::call_once(connected, []() {
+        if (!qApp)
+            return;
+        ins.autoSave = true;
+        // WatcherCache 属于主线程，FileScanner 可能在其他线程中创建，统一到主线程中连接
+        QMetaObject::invokeMethod(qApp, []() {
+            QObject::connect(&WatcherCache::instance(), &WatcherCache::fileChanged, qApp, [](const QUrl &url) {
+                // 事件可能很密集，stat 放到线程池中执行，不阻塞主线程
+                if (url.isLocalFile())
+                    ins.invalidateLater(url.toLocalFile());
+            });
+            QObject::connect(qApp, &QCoreApplication::aboutToQuit, qApp, []() {
+                ins.save();
+            });
+        });
+    });
+    return &ins;
+}
+
+bool DirSizeCache::isSupportedFileSystem(int fd)
+{
+    // 只信任 inode 稳定、目录修改时间可靠的本地文件系统；网络、FUSE 等文件系统的 inode
+    // 可能在重新挂载后变化或复用，目录修改时间也不一定随条目增删更新
+    struct statfs fsStat;
+    if (fstatfs(fd, &fsStat) != 0)
+        return false;
+
+    switch (fsStat.f_type) {
+    case EXT4_SUPER_MAGIC:   // 与 ext2/ext3 相同
+    case XFS_SUPER_MAGIC:
+    case BTRFS_SUPER_MAGIC:
+    case TMPFS_MAGIC:
+        return true;
+    default:
+        return false;
+    }
+}
+
+DirSizeCache::DirSizeCache(const QString &cacheFilePath, int maxCount)
+    : filePath(cacheFilePath), maxCount(qMax(1, maxCount))
+{
+}
+
+DirSizeCache::~DirSizeCache()
+{
+}
+
+bool DirSizeCache::find(quint64 device, quint64 inode, qint64 mtime, Record *record)
+{
+    ensureLoaded();
+
+    QReadLocker locker(&lock);
+    auto it = records.constFind({ device, inode });
+    if (it == records.cend() || it->mtime != mtime)
+        return false;
+    if (QDateTime::currentSecsSinceEpoch() - it->checkedAt > kMaxRecordAge)
+        return false;
+
+    *record = it.value();
+    return true;
+}
+
+void DirSizeCache::insert(quint64 device, quint64 inode, const Record &record, quint64 epoch)
+{
+    ensureLoaded();
+
+    // 修改时间距读取时间过近时，读取之后同一时间戳精度内的修改不会改变修改时间，不写入
+    if (record.mtime >= (record.checkedAt - kUnstableWindow) * 1000000000)
+        return;
+
+    QWriteLocker locker(&lock);
+    if (epoch < forgottenBefore || invalidatedAt.value({ device, inode }) > epoch)
+        return;
+
+    records.insert({ device, inode }, record);
+    dirty = true;
+}
+
+quint64 DirSizeCache::epoch() const
+{
+    return invalidations.load();
+}
+
+void DirSizeCache::invalidate(const QString &path)
+{
+    if (path.isEmpty())
+        return;
+
+    // 文件的增删改只影响所在目录的记录；上层目录的记录只描述自身的直接条目，不受影响
+    struct stat statBuf;
+    const QString &parent = QFileInfo(path).path();
+    if (::stat(QFile::encodeName(parent).constData(), &statBuf) == 0)
+        invalidate(statBuf.st_dev, statBuf.st_ino);
+    if (::stat(QFile::encodeName(path).constData(), &statBuf) == 0 && S_ISDIR(statBuf.st_mode))
+        invalidate(statBuf.st_dev, statBuf.st_ino);
+}
+
+void DirSizeCache::invalidateLater(const QString &path)
+{
+    if (path.isEmpty())
+        return;
+
+    QMutexLocker locker(&pendingMutex);
+    const bool scheduled = !pendingPaths.isEmpty();
+    pendingPaths.insert(path);
+    if (scheduled)
+        return;
+
+    QThreadPool::globalInstance()->start([this]() {
+        QSet<QString> paths;
+        {
+            QMutexLocker locker(&pendingMutex);
+            paths.swap(pendingPaths);
+        }
+        for (const QString &path : std::as_const(paths))
+            invalidate(path);
+    });
+}
+
+void DirSizeCache::invalidate(quint64 device, quint64 inode)
+{
+    QWriteLocker locker(&lock);
+    // 正在进行的遍历只关心读取开始后的失效，表过大时清空并拒绝更早开始的遍历的写入
+    if (invalidatedAt.size() >= kMaxInvalidatedKeys) {
+        invalidatedAt.clear();
+        forgottenBefore = invalidations.load();
+    }
+    invalidatedAt.insert({ device, inode }, ++invalidations);
+    if (records.remove({ device, inode }) > 0)
+        dirty = true;
+}
+
+void DirSizeCache::clear()
+{
+    QWriteLocker locker(&lock);
+    invalidatedAt.clear();
+    forgottenBefore = ++invalidations;
+    records.clear();
+    loaded = true;
+    dirty = true;
+}
+
+int DirSizeCache::count()
+{
+    ensureLoaded();
+
+    QReadLocker locker(&lock);
+    return records.count();
+}
+
+bool DirSizeCache::save()
+{
+    QMutexLocker saveLocker(&saveMutex);
+    QHash<QPair<quint64, quint64>, Record> snapshot;
+    {
+        QWriteLocker locker(&lock);
+        if (!dirty)
+            return true;
+        prune();
+        dirty = false;
+        snapshot = records;   // 隐式共享，写文件时不持有锁
+    }
+
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(logDFMBase) << "DirSizeCache: failed to open cache file:" << filePath << file.errorString();
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kCacheMagic << kCacheVersion << qint32(snapshot.count());
+    for (auto it = snapshot.cbegin(); it != snapshot.cend(); ++it) {
+        const Record &rec = it.value();
+        out << it.key().first << it.key().second
+            << rec.mtime << rec.checkedAt << rec.totalSize << rec.allocatedSize << rec.progressSize
+            << qint32(rec.fileCount) << rec.subdirs << rec.linkedFiles;
+    }
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qCWarning(logDFMBase) << "DirSizeCache: failed to write cache file:" << filePath;
+        return false;
+    }
+
+    qCDebug(logDFMBase) << "DirSizeCache: saved" << snapshot.count() << "records to" << filePath;
+    return true;
+}
+
+void DirSizeCache::requestSave()
+{
+    if (!autoSave || saveRequested.exchange(true))
+        return;
+
+    // 写文件可能耗时较长，不放在遍历线程或主线程中执行
+    QMetaObject::invokeMethod(qApp, [this]() {
+        QTimer::singleShot(kSaveDelay, qApp, [this]() {
+            saveRequested = false;
+            QThreadPool::globalInstance()->start([this]() { save(); });
+        });
+    });
+}
+
+void DirSizeCache::ensureLoaded()
+{
+    {
+        QReadLocker locker(&lock);
+        if (loaded)
+            return;
+    }
+
+    QWriteLocker locker(&lock);
+    if (loaded)
+        return;
+    loaded = true;
+    if (!load())
+        records.clear();
+}
+
+bool DirSizeCache::load()
+{
+    QFile file(filePath);
+    if (!file.exists())
+        return true;
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(logDFMBase) << "DirSizeCache: failed to open cache file:" << filePath << file.errorString();
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint32 count = 0;
+    in >> magic >> version >> count;
+    if (magic != kCacheMagic || version != kCacheVersion || count < 0) {
+        qCWarning(logDFMBase) << "DirSizeCache: ignore incompatible cache file:" << filePath;
+        return false;
+    }
+
+    records.reserve(qMin(count, maxCount));
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        quint64 device = 0;
+        quint64 inode = 0;
+        qint32 fileCount = 0;
+        Record rec;
+        in >> device >> inode
+           >> rec.mtime >> rec.checkedAt >> rec.totalSize >> rec.allocatedSize >> rec.progressSize
+           >> fileCount >> rec.subdirs >> rec.linkedFiles;
+        rec.fileCount = fileCount;
+        records.insert({ device, inode }, rec);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qCWarning(logDFMBase) << "DirSizeCache: ignore corrupted cache file:" << filePath;
+        return false;
+    }
+
+    qCDebug(logDFMBase) << "DirSizeCache: loaded" << records.count() << "records from" << filePath;
+    return true;
+}
+
+void DirSizeCache::prune()
+{
+    if (records.count() <= maxCount)
+        return;
+
+    // 超出容量时淘汰最久未读取的记录，留出四分之一的空间
+    QList<qint64> times;
+    times.reserve(records.count());
+    for (const Record &rec : std::as_const(records))
+        times.append(rec.checkedAt);
+
+    const int keep = maxCount - maxCount / 4;
+    auto nth = times.begin() + (times.count() - keep);
+    std::nth_element(times.begin(), nth, times.end());
+    const qint64 threshold = *nth;
+    for (auto it = records.begin(); it != records.end();) {
+        if (it->checkedAt < threshold)
+            it = records.erase(it);
+        else
+            ++it;
+    }
+
+    qCDebug(logDFMBase) << "DirSizeCache: pruned records older than" << threshold << ", remaining:" << records.count();
+}
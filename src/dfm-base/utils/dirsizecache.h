@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DIRSIZECACHE_H
+#define DIRSIZECACHE_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QByteArrayList>
+#include <QHash>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QString>
+
+#include <atomic>
+
+namespace dfmbase {
+
+/**
+ * @brief 本地目录大小的持久化缓存
+ *
+ * 以目录的（设备号, inode）为键，记录目录直接包含的条目的统计（文件数、大小、
+ * 磁盘占用、多链接文件）以及子目录名。目录的修改时间（纳秒）与记录不一致时记录失效，
+ * 增删、重命名条目都会更新目录的修改时间。FileScanner 遍历时对未变化的目录只做一次
+ * fstatat，不再读取目录和查询其中的文件，只有变化的子树会重新遍历。
+ *
+ * 原地修改文件内容不会改变目录的修改时间：已打开目录的监视器（WatcherCache）报告的
+ * 变化会使所在目录的记录失效，其他情况由记录的有效期兜底。
+ *
+ * 只用于 inode 稳定的本地文件系统（见 isSupportedFileSystem()）；修改时间距读取时间过近的
+ * 目录不写入，避免时间戳精度内紧接着的修改与记录的修改时间相同。
+ *
+ * 缓存默认关闭，由 dconfig 配置 dfm.scanner.sizecache 开启。可在多个线程中使用。
+ * instance() 返回的缓存由 requestSave() 延迟写回，并在程序退出时写回。
+ */
+class DirSizeCache
+{
+    Q_DISABLE_COPY(DirSizeCache)
+
+public:
+    struct Record
+    {
+        qint64 mtime { 0 };   // 目录修改时间（纳秒）
+        qint64 checkedAt { 0 };   // 读取目录的时间（秒），超过有效期后不再使用
+        qint64 totalSize { 0 };   // 以下统计不含多链接文件
+        qint64 allocatedSize { 0 };
+        qint64 progressSize { 0 };
+        int fileCount { 0 };
+        QByteArrayList subdirs;
+        QByteArrayList linkedFiles;   // st_nlink > 1 的文件名，其他链接可能已修改内容，使用时重新查询并去重
+    };
+
+    static bool isEnabled();
+    static DirSizeCache *instance();
+    // fd 所在的文件系统是否可以使用缓存
+    static bool isSupportedFileSystem(int fd);
+
+    explicit DirSizeCache(const QString &cacheFilePath, int maxCount = kDefaultMaxCount);
+    ~DirSizeCache();
+
+    // 只返回修改时间一致且未过期的记录
+    bool find(quint64 device, quint64 inode, qint64 mtime, Record *record);
+    // epoch 为开始读取目录前 epoch() 的值，期间该目录被标记失效时不写入，避免保存读取过程中被修改的目录；
+    // 其他目录的失效不影响写入
+    void insert(quint64 device, quint64 inode, const Record &record, quint64 epoch);
+    quint64 epoch() const;
+
+    // 使路径所在目录及路径本身（若为目录）的记录失效，需要 stat，不应在主线程中调用
+    void invalidate(const QString &path);
+    // 在线程池中执行 invalidate(path)，尚未处理的路径合并为一次任务
+    void invalidateLater(const QString &path);
+    void invalidate(quint64 device, quint64 inode);
+    void clear();
+    int count();
+
+    // 有修改时写回磁盘
+    bool save();
+    // 延迟一段时间后在线程池中写回，期间的多次请求合并为一次；只对 instance() 有效
+    void requestSave();
+
+    static constexpr int kDefaultMaxCount { 200000 };
+    static constexpr qint64 kMaxRecordAge { 24 * 3600 };
+    static constexpr qint64 kUnstableWindow { 2 };   // 秒
+    static constexpr int kSaveDelay { 30 * 1000 };   // 毫秒
+    static constexpr int kMaxInvalidatedKeys { 4096 };
+
+private:
+    void ensureLoaded();
+    bool load();
+    void prune();
+
+    const QString filePath;
+    const int maxCount;
+    QHash<QPair<quint64, quint64>, Record> records;
+    QReadWriteLock lock;
+    QMutex saveMutex;   // 保证写文件的顺序与快照的顺序一致
+    bool loaded { false };
+    bool dirty { false };
+    bool autoSave { false };
+    std::atomic<quint64> invalidations { 0 };   // 失效序号，epoch() 返回当前值
+    QHash<QPair<quint64, quint64>, quint64> invalidatedAt;   // 目录最近一次失效时的序号
+    quint64 forgottenBefore { 0 };   // 更早的失效序号已被清理，epoch 小于它的写入无法判断，一律不写入
+    std::atomic_bool saveRequested { false };
+    QMutex pendingMutex;
+    QSet<QString> pendingPaths;   // 等待 invalidateLater 处理的路径
+};
+
+}   // namespace dfmbase
+
+#endif   // DIRSIZECACHE_H
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "elidetextlayout.h"
+#include "elidetextlayoutcache.h"
 
 #include <QPainter>
 #include <QtMath>
@@ -31,12 +32,11 @@ ElideTextLayout::ElideTextLayout(const QString &text)
 
 ElideTextLayout::~ElideTextLayout()
 {
-    delete document;
-    document = nullptr;
 }
 
 void ElideTextLayout::setText(const QString &text)
 {
+    detachDocument();
     document->setPlainText(text);
 }
 
@@ -283,81 +283,62 @@ QList<QPair<int, int>> ElideTextLayout::calculateElideHighlightMatches(
 
 QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elideMode, QPainter *painter, const QBrush &background, QStringList *textLines)
 {
-    QList<QRectF> ret;
+    if (!cacheEnabled) {
+        QScopedPointer<ElideTextLayoutResult> result(createLayoutResult(rect.size(), elideMode));
+        return result ? drawLayoutResult(*result, rect.topLeft(), painter, background, textLines) : QList<QRectF>();
+    }
+
+    auto cache = ElideTextLayoutCache::instance();
+    const QString &key = cacheKey(rect.size(), elideMode);
+    const ElideTextLayoutResult *result = cache->find(key);
+    QScopedPointer<ElideTextLayoutResult> uncached;
+    if (!result) {
+        ElideTextLayoutResult *created = createLayoutResult(rect.size(), elideMode);
+        if (!created)
+            return {};
+
+        result = cache->insert(key, created);
+        if (result) {
+            documentShared = true;
+        } else {
+            uncached.reset(created);
+            result = created;
+        }
+    }
+
+    return drawLayoutResult(*result, rect.topLeft(), painter, background, textLines);
+}
+
+ElideTextLayoutResult *ElideTextLayout::createLayoutResult(const QSizeF &size, Qt::TextElideMode elideMode)
+{
+    // 同一对象再次排版时不能改动已在缓存中的 document
+    detachDocument();
+
     QTextLayout *lay = document->firstBlock().layout();
     if (!lay) {
         qCWarning(logDFMBase) << "invaild block" << document->firstBlock().text();
-        return ret;
+        return nullptr;
     }
 
+    auto result = new ElideTextLayoutResult;
+    result->document = document;
+
     initLayoutOption(lay);
     int textLineHeight = attribute<int>(kLineHeight);
-    QSizeF size = rect.size();
-    QPointF offset = rect.topLeft();
+    QPointF offset(0, 0);
     qreal curHeight = 0;
 
-    // for draw background.
-    QRectF lastLineRect;
     QString elideText;
-    QString curText = text();
-    bool paintLineWithHighlight = enableHighlight && highlightColor.isValid() && !highlightKeywords.isEmpty();
+    const QString curText = text();
 
     // 预处理整个文本中的所有关键词匹配位置
-    QList<QPair<int, int>> allMatches; // 保存所有匹配位置: <开始位置, 长度>
-    if (paintLineWithHighlight) {
-        allMatches = findKeywordMatches(curText);
-    }
+    if (highlightActive())
+        result->matches = findKeywordMatches(curText);
 
-    // 一个更新后的匹配列表，用于处理elideText情况
-    QList<QPair<int, int>> currentMatches = allMatches;
-
-    auto processLine = [this, &ret, painter, &lastLineRect, background, textLineHeight, &curText, textLines,
-                        paintLineWithHighlight, &currentMatches](QTextLine &line) {
+    auto appendLine = [result, textLineHeight](const QTextLine &line, const QString &lineText, bool elided) {
         QRectF lRect = line.naturalTextRect();
         lRect.setHeight(textLineHeight);
-
-        ret.append(lRect);
-        if (textLines) {
-            const auto &t = curText.mid(line.textStart(), line.textLength());
-            textLines->append(t);
-        }
-
-        // draw
-        if (painter) {
-            // draw background
-            if (background.style() != Qt::NoBrush) {
-                lastLineRect = drawLineBackground(painter, lRect, lastLineRect, background);
-            }
-
-            // 获取当前行的文本范围
-            int lineStart = line.textStart();
-            int lineEnd = lineStart + line.textLength();
-
-            // 检查当前行是否需要高亮显示（检查是否有任何关键词与当前行有重叠）
-            bool needHighlight = false;
-            if (paintLineWithHighlight) {
-                for (const auto &match : currentMatches) {
-                    int matchStart = match.first;
-                    int matchEnd = matchStart + match.second;
-
-                    // 如果匹配区域与当前行有任何重叠
-                    if (matchEnd > lineStart && matchStart < lineEnd) {
-                        needHighlight = true;
-                        break;
-                    }
-                }
-            }
-
-            if (!paintLineWithHighlight || !needHighlight) {
-                // draw text line without highlight
-                line.draw(painter, QPoint(0, 0));
-                return;
-            }
-
-            // 获取当前行文本
-            QString lineText = curText.mid(lineStart, line.textLength());
-            drawTextWithHighlight(painter, line, lineText, lRect, lineStart, currentMatches);
-        }
+        result->lines.append({ lRect, lineText, line.textStart(), elided });
     };
 
     {
@@ -374,7 +355,7 @@ QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elid
                 if (nextLine.isValid()) {
                     // elide current line.
                     QFontMetrics fm(lay->font());
-                    QString originalText = text().mid(line.textStart());
+                    QString originalText = curText.mid(line.textStart());
                     elideText = fm.elidedText(originalText, elideMode, qRound(size.width()));
 
                     // 判断文本是否被省略以及省略位置
@@ -388,16 +369,15 @@ QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elid
                             elidePos = 0;
                     }
 
-                    curText = elideText;
-
-                    // 如果有省略，需要处理高亮匹配位置
-                    if (isElided && paintLineWithHighlight) {
+                    // 省略行的高亮匹配位置基于省略后的文本
+                    result->elideMatches = result->matches;
+                    if (isElided && highlightActive()) {
                         // 重新计算省略文本中的高亮匹配位置
-                        currentMatches = calculateElideHighlightMatches(
+                        result->elideMatches = calculateElideHighlightMatches(
                             elideText,
                             elidePos,
                             elideMode,
-                            allMatches,
+                            result->matches,
                             line.textStart()
                         );
                     }
@@ -406,7 +386,7 @@ QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elid
                 // next line is empty.
             }
 
-            processLine(line);
+            appendLine(line, curText.mid(line.textStart(), line.textLength()), false);
 
             // next line
             line = lay->createLine();
@@ -418,30 +398,152 @@ QList<QRectF> ElideTextLayout::layout(const QRectF &rect, Qt::TextElideMode elid
 
     // process last elided line.
     if (!elideText.isEmpty()) {
-        QTextLayout newlay;
-        newlay.setFont(lay->font());
+        result->elideLayout.reset(new QTextLayout);
+        QTextLayout *newlay = result->elideLayout.data();
+        newlay->setFont(lay->font());
         {
             auto oldWrap = static_cast<QTextOption::WrapMode>(attribute<uint>(kWrapMode));
             setAttribute(kWrapMode, static_cast<uint>(QTextOption::NoWrap));
-            initLayoutOption(&newlay);
+            initLayoutOption(newlay);
 
             // restore
             setAttribute(kWrapMode, oldWrap);
         }
 
-        newlay.setText(elideText);
-        newlay.beginLayout();
-        auto line = newlay.createLine();
+        newlay->setText(elideText);
+        newlay->beginLayout();
+        auto line = newlay->createLine();
         line.setLineWidth(size.width() - 1);
         line.setPosition(offset);
+        newlay->endLayout();
+
+        appendLine(line, elideText.mid(line.textStart(), line.textLength()), true);
+    }
+
+    return result;
+}
+
+QList<QRectF> ElideTextLayout::drawLayoutResult(const ElideTextLayoutResult &result, const QPointF &offset, QPainter *painter,
+                                                const QBrush &background, QStringList *textLines)
+{
+    QList<QRectF> ret;
+    // for draw background.
+    QRectF lastLineRect;
+    QTextLayout *lay = result.document->firstBlock().layout();
+    const bool paintLineWithHighlight = highlightActive();
+
+    for (int i = 0; i < result.lines.size(); ++i) {
+        const auto &info = result.lines.at(i);
+        const QRectF &lRect = info.rect.translated(offset);
+
+        ret.append(lRect);
+        if (textLines)
+            textLines->append(info.text);
+
+        // draw
+        if (!painter)
+            continue;
+
+        // draw background
+        if (background.style() != Qt::NoBrush)
+            lastLineRect = drawLineBackground(painter, lRect, lastLineRect, background);
+
+        const QTextLine &line = info.elided ? result.elideLayout->lineAt(0) : lay->lineAt(i);
+        const auto &currentMatches = info.elided ? result.elideMatches : result.matches;
+
+        // 获取当前行的文本范围
+        int lineStart = info.textStart;
+        int lineEnd = lineStart + info.text.length();
 
-        processLine(line);
-        newlay.endLayout();
+        // 检查当前行是否需要高亮显示（检查是否有任何关键词与当前行有重叠）
+        bool needHighlight = false;
+        if (paintLineWithHighlight) {
+            for (const auto &match : currentMatches) {
+                int matchStart = match.first;
+                int matchEnd = matchStart + match.second;
+
+                // 如果匹配区域与当前行有任何重叠
+                if (matchEnd > lineStart && matchStart < lineEnd) {
+                    needHighlight = true;
+                    break;
+                }
+            }
+        }
+
+        if (!paintLineWithHighlight || !needHighlight) {
+            // draw text line without highlight
+            line.draw(painter, offset);
+            continue;
+        }
+
+        drawTextWithHighlight(painter, line, info.text, lRect, lineStart, currentMatches, offset);
     }
 
     return ret;
 }
 
+QString ElideTextLayout::cacheKey(const QSizeF &size, Qt::TextElideMode elideMode) const
+{
+    static constexpr QChar kSeparator { 0x1f };
+
+    QString key = text();
+    key += kSeparator;
+
+    // 扩展插件（如标记）插入的内联对象：记录位置、类型和属性
+    const QTextBlock &block = document->firstBlock();
+    for (auto it = block.begin(); !it.atEnd(); ++it) {
+        const QTextFragment &fragment = it.fragment();
+        const QTextCharFormat &format = fragment.charFormat();
+        if (format.objectType() == QTextFormat::NoObject)
+            continue;
+
+        key += QString::number(fragment.position()) + ':' + QString::number(format.objectType());
+        const auto &properties = format.properties();
+        for (auto prop = properties.cbegin(); prop != properties.cend(); ++prop) {
+            key += ',' + QString::number(prop.key()) + '=';
+            const QVariant &value = prop.value();
+            if (value.typeId() != QMetaType::QString && value.canConvert<QVariantList>()) {
+                const QVariantList &values = value.value<QVariantList>();
+                for (const QVariant &v : values)
+                    key += v.toString() + ';';
+            } else {
+                key += value.toString();
+            }
+        }
+    }
+    key += kSeparator;
+
+    key += attribute<QFont>(kFont).key();
+    key += kSeparator + QString::number(attribute<qreal>(kLineHeight));
+    key += kSeparator + QString::number(attribute<uint>(kAlignment));
+    key += kSeparator + QString::number(attribute<uint>(kWrapMode));
+    key += kSeparator + QString::number(attribute<int>(kTextDirection));
+    key += kSeparator + QString::number(size.width()) + 'x' + QString::number(size.height());
+    key += kSeparator + QString::number(elideMode);
+
+    if (highlightActive()) {
+        key += kSeparator + highlightColor.name(QColor::HexArgb);
+        key += kSeparator + highlightKeywords.join(kSeparator);
+    }
+
+    return key;
+}
+
+bool ElideTextLayout::highlightActive() const
+{
+    return enableHighlight && highlightColor.isValid() && !highlightKeywords.isEmpty();
+}
+
+void ElideTextLayout::detachDocument()
+{
+    if (!documentShared)
+        return;
+
+    // 缓存中的排版结果仍引用原 document，修改前复制一份
+    document.reset(document->clone());
+    documentShared = false;
+}
+
 QRectF ElideTextLayout::drawLineBackground(QPainter *painter, const QRectF &curLineRect, QRectF lastLineRect, const QBrush &brush) const
 {
     const qreal backgroundRadius = attribute<qreal>(kBackgroundRadius);
@@ -501,11 +603,12 @@ QRectF ElideTextLayout::drawLineBackground(QPainter *painter, const QRectF &curL
 }
 
 void ElideTextLayout::drawTextWithHighlight(QPainter *painter, const QTextLine &line, const QString &lineText,
-                                           const QRectF &rect, int lineStartPos, const QList<QPair<int, int>> &allMatches)
+                                           const QRectF &rect, int lineStartPos, const QList<QPair<int, int>> &allMatches,
+                                           const QPointF &offset)
 {
     if (allMatches.isEmpty()) {
         // 如果没有匹配项，直接绘制普通文本
-        line.draw(painter, QPoint(0, 0));
+        line.draw(painter, offset);
         return;
     }
 
@@ -549,7 +652,7 @@ void ElideTextLayout::drawTextWithHighlight(QPainter *painter, const QTextLine &
         tempLayout.draw(painter, QPointF(0, 0));
     } else {
         tempLayout.endLayout();
-        line.draw(painter, QPoint(0, 0));
+        line.draw(painter, offset);
     }
 
     painter->restore();
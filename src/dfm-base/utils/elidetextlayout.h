@@ -9,6 +9,7 @@
 #include <QBrush>
 #include <QVariant>
 #include <QTextLine>
+#include <QSharedPointer>
 
 class QPainter;
 class QTextDocument;
@@ -16,6 +17,8 @@ class QTextLayout;
 
 namespace dfmbase {
 
+struct ElideTextLayoutResult;
+
 class ElideTextLayout
 {
 public:
@@ -35,7 +38,13 @@ public:
     QList<QRectF> layout(const QRectF &rect, Qt::TextElideMode elideMode, QPainter *painter = nullptr, const QBrush &background = Qt::NoBrush, QStringList *textLines = nullptr);
 public:
     inline QTextDocument *documentHandle() {
-        return document;
+        detachDocument();
+        return document.data();
+    }
+
+    // 启用后排版结果进入 ElideTextLayoutCache，相同文本和参数的重绘直接复用
+    inline void setCacheEnabled(bool enable) {
+        cacheEnabled = enable;
     }
 
     inline void setAttribute(Attribute attr, const QVariant &value) {
@@ -65,10 +74,19 @@ public:
 protected:
     QRectF drawLineBackground(QPainter *painter, const QRectF &curLineRect, QRectF lastLineRect, const QBrush &brush) const;
     void drawTextWithHighlight(QPainter *painter, const QTextLine &line, const QString &lineText, 
-                              const QRectF &rect, int lineStartPos, const QList<QPair<int, int>> &allMatches);
+                              const QRectF &rect, int lineStartPos, const QList<QPair<int, int>> &allMatches,
+                              const QPointF &offset = QPointF());
     virtual void initLayoutOption(QTextLayout *lay);
 
 private:
+    // 在 (0, 0) 处完成分行和省略，不绘制
+    ElideTextLayoutResult *createLayoutResult(const QSizeF &size, Qt::TextElideMode elideMode);
+    QList<QRectF> drawLayoutResult(const ElideTextLayoutResult &result, const QPointF &offset, QPainter *painter,
+                                   const QBrush &background, QStringList *textLines);
+    QString cacheKey(const QSizeF &size, Qt::TextElideMode elideMode) const;
+    bool highlightActive() const;
+    void detachDocument();
+
     // 查找文本中所有关键词匹配的位置
     QList<QPair<int, int>> findKeywordMatches(const QString &text) const;
 
@@ -87,12 +105,16 @@ private:
         Qt::TextElideMode elideMode) const;
 
 protected:
-    QTextDocument *document { nullptr };
+    QSharedPointer<QTextDocument> document;
     QMap<Attribute, QVariant> attributes {};
 
     QStringList highlightKeywords {};  // 需要高亮的关键字
     QColor highlightColor { QColor() };     // 高亮颜色
     bool enableHighlight { false };      // 是否启用高亮
+
+private:
+    bool cacheEnabled { false };
+    bool documentShared { false };   // document 已交给缓存，修改前需要复制
 };
 }
 
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "elidetextlayoutcache.h"
+
+#include <QGuiApplication>
+
+#include <mutex>
+
+using namespace dfmbase;
+
+ElideTextLayoutCache *ElideTextLayoutCache::instance()
+{
+    static ElideTextLayoutCache ins;
+    static std::once_flag connected;
+    std::call_once(connected, []() {
+        if (!qGuiApp)
+            return;
+        // 字体变化后所有排版结果都失效；退出前释放，避免在 QGuiApplication 析构后再析构 QTextDocument
+        QObject::connect(qGuiApp, &QGuiApplication::fontChanged, qGuiApp, []() { ins.clear(); });
+        QObject::connect(qGuiApp, &QCoreApplication::aboutToQuit, qGuiApp, []() { ins.clear(); });
+    });
+    return &ins;
+}
+
+ElideTextLayoutCache::ElideTextLayoutCache(int maxCount)
+    : cache(maxCount)
+{
+}
+
+const ElideTextLayoutResult *ElideTextLayoutCache::find(const QString &key) const
+{
+    return cache.object(key);
+}
+
+const ElideTextLayoutResult *ElideTextLayoutCache::insert(const QString &key, ElideTextLayoutResult *result)
+{
+    // 容量为 0 时不接管 result，由调用方自行释放
+    if (cache.maxCost() <= 0)
+        return nullptr;
+
+    cache.insert(key, result);
+    return cache.object(key);
+}
+
+void ElideTextLayoutCache::clear()
+{
+    if (!cache.isEmpty())
+        qCDebug(logDFMBase) << "Clear text layout cache, count:" << cache.count();
+    cache.clear();
+}
+
+int ElideTextLayoutCache::count() const
+{
+    return cache.count();
+}
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ELIDETEXTLAYOUTCACHE_H
+#define ELIDETEXTLAYOUTCACHE_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QCache>
+#include <QRectF>
+#include <QSharedPointer>
+#include <QTextLayout>
+#include <QTextDocument>
+
+namespace dfmbase {
+
+/**
+ * @brief ElideTextLayout 一次排版（分行 + 省略）的结果
+ *
+ * 行的位置相对于 (0, 0)，绘制时整体平移到目标矩形。document 中保留了
+ * 扩展插件插入的内联对象（如标记圆点），绘制时仍由其 documentLayout 处理。
+ */
+struct ElideTextLayoutResult
+{
+    struct Line
+    {
+        QRectF rect;
+        QString text;
+        int textStart { 0 };
+        bool elided { false };   // 为 true 时取 elideLayout 的第一行
+    };
+
+    QSharedPointer<QTextDocument> document;
+    QSharedPointer<QTextLayout> elideLayout;
+    QList<Line> lines;
+    QList<QPair<int, int>> matches;   // 未省略行的高亮位置（原文坐标）
+    QList<QPair<int, int>> elideMatches;   // 省略行的高亮位置（省略后文本坐标）
+};
+
+/**
+ * @brief 文件名排版结果的进程内缓存
+ *
+ * 以（文本及内联对象、字体、行高、对齐、换行、方向、区域大小、省略方式、高亮关键字）为键，
+ * 桌面和文管的图标视图在重绘时复用已排好的行，避免每次绘制都重新分行、塑形。
+ * 超出容量时按最近最少使用淘汰；系统字体变化时整体清空，缩放级别变化时由视图清空。
+ * 只在 GUI 线程使用。
+ */
+class ElideTextLayoutCache
+{
+    Q_DISABLE_COPY(ElideTextLayoutCache)
+
+public:
+    static ElideTextLayoutCache *instance();
+
+    explicit ElideTextLayoutCache(int maxCount = kDefaultMaxCount);
+
+    // 返回的指针在下一次 insert/clear 之前有效；insert 成功后接管 result
+    const ElideTextLayoutResult *find(const QString &key) const;
+    const ElideTextLayoutResult *insert(const QString &key, ElideTextLayoutResult *result);
+    void clear();
+    int count() const;
+
+    static constexpr int kDefaultMaxCount { 2048 };
+
+private:
+    mutable QCache<QString, ElideTextLayoutResult> cache;
+};
+
+}
+
+#endif   // ELIDETEXTLAYOUTCACHE_H
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "filescanner.h"
+#include "dirsizecache.h"
 
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/interfaces/fileinfo.h>
@@ -12,10 +13,19 @@
 
 #include <QTimer>
 #include <QCoreApplication>
+#include <QDateTime>
 #include <QDebug>
 #include <QQueue>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <vector>
 
 #include <dirent.h>
+#include <fcntl.h>
 #include <unistd.h>
 
 DFMBASE_USE_NAMESPACE
@@ -49,6 +59,7 @@ public:
 
     // 选项
     FileScanner::ScanOptions options { FileScanner::ScanOption::NoOption };
+    int maxThreadCount { 0 };
 };
 
 FileScannerPrivate::FileScannerPrivate(FileScanner *qq)
@@ -80,6 +91,8 @@ void FileScannerPrivate::startWorker(const QList<QUrl> &urls)
     // 设置参数
     worker->setUrls(urls);
     worker->setOptions(options);
+    worker->setMaxThreadCount(maxThreadCount);
+    worker->setSizeCache(DirSizeCache::isEnabled() ? DirSizeCache::instance() : nullptr);
 
     // 连接信号
     connect(worker, &ScannerWorker::resultReady, this, &FileScannerPrivate::onWorkerResultReady);
@@ -155,6 +168,11 @@ FileScanner::ScanOptions FileScanner::options() const
     return d->options;
 }
 
+void FileScanner::setMaxThreadCount(int count)
+{
+    d->maxThreadCount = count;
+}
+
 FileScanner::ScanResult FileScanner::result() const
 {
     return d->lastResult;
@@ -183,6 +201,434 @@ void FileScanner::stop()
     d->stopWorker();
 }
 
+//===================================================================
+// ScannerWorker::LocalWalker - 本地目录并行遍历
+//===================================================================
+static constexpr int kMaxWalkerThreads { 16 };
+// 工作线程自己的待遍历目录达到该数量时才启动其他遍历线程，小目录不必付出线程开销
+static constexpr int kParallelThreshold { 8 };
+// 单个目录中每处理这么多条目汇总一次，大目录也能持续更新进度
+static constexpr int kFlushInterval { 1024 };
+
+// /proc、/sys、/dev 下的目录增删条目时不一定更新修改时间，不使用目录大小缓存
+static bool isVirtualFsPath(const QByteArray &path)
+{
+    for (const char *prefix : { "/proc", "/sys", "/dev" }) {
+        const int len = static_cast<int>(strlen(prefix));
+        if (path.startsWith(prefix) && (path.size() == len || path.at(len) == '/'))
+            return true;
+    }
+    return false;
+}
+
+/*
+ * 每个线程有自己的目录队列：自己从队尾取（深度优先，打开的目录少），
+ * 空闲时从其他线程的队头窃取（靠近根部，子树更大）。
+ * 子目录用 openat 相对父目录 fd 打开，条目用 fstatat 相对目录 fd 查询，不拼接完整路径；
+ * 父目录 fd 由子任务共享持有，最后一个子目录打开后关闭。
+ * 第 0 号线程即 ScannerWorker 所在线程，负责发送进度。
+ * 使用目录大小缓存时，修改时间未变的目录直接累加缓存的统计并继续检查其子目录，不再读取目录。
+ */
+class ScannerWorker::LocalWalker
+{
+public:
+    LocalWalker(ScannerWorker *worker, int threadCount);
+
+    void addSource(const QByteArray &path);
+    void run();
+    FileScanner::ScanResult result() const;
+
+    int sourceDirCount() const { return sourceDirs.load(); }
+    int usedThreadCount() const { return helpersStarted ? threadCount : 1; }
+    int cachedDirCount() const { return cachedDirs.load(); }
+
+private:
+    struct DirHandle
+    {
+        ~DirHandle()
+        {
+            if (fd >= 0)
+                ::close(fd);
+        }
+
+        int fd { -1 };
+        QByteArray path;   // 仅用于日志和特殊文件判断
+    };
+
+    struct DirTask
+    {
+        std::shared_ptr<DirHandle> parent;   // 为空时 name 为源目录的完整路径
+        QByteArray name;
+        bool isSource { false };
+    };
+
+    struct TaskQueue
+    {
+        QMutex mutex;
+        std::deque<DirTask> tasks;
+    };
+
+    void walk(int index);
+    bool takeTask(int index, DirTask *task);
+    void pushTask(int index, DirTask &&task);
+    void processDirectory(int index, const DirTask &task);
+    void applyRecord(int index, const std::shared_ptr<DirHandle> &handle,
+                     const DirSizeCache::Record &record, FileScanner::ScanResult *local);
+    void flush(FileScanner::ScanResult *local);
+    void reportProgress();
+    void startHelpers();
+
+private:
+    ScannerWorker *worker { nullptr };
+    const int threadCount;
+    const bool singleDepth;
+    const qint64 pageSize;
+    const FileScanner::ScanResult base;   // 源路径中的文件
+    DirSizeCache *const cache;
+
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::atomic<int> pendingTasks { 0 };   // 已入队但未处理完的目录
+    std::atomic<int> sleepingThreads { 0 };
+    std::atomic<int> sourceDirs { 0 };
+    std::atomic<int> cachedDirs { 0 };
+    QMutex sleepMutex;
+    QWaitCondition sleepCondition;
+    bool helpersStarted { false };   // 只在第 0 号线程访问
+    QThreadPool pool;
+
+    std::atomic<qint64> totalSize { 0 };
+    std::atomic<qint64> allocatedSize { 0 };
+    std::atomic<qint64> progressSize { 0 };
+    std::atomic<int> fileCount { 0 };
+    std::atomic<int> directoryCount { 0 };
+};
+
+ScannerWorker::LocalWalker::LocalWalker(ScannerWorker *worker, int threadCount)
+    : worker(worker),
+      threadCount(qMax(1, threadCount)),
+      singleDepth(worker->options & FileScanner::ScanOption::SingleDepth),
+      pageSize(worker->memoryPageSize),
+      base(worker->currentResult),
+      cache(singleDepth ? nullptr : worker->sizeCache)
+{
+    for (int i = 0; i < this->threadCount; ++i)
+        queues.emplace_back(new TaskQueue);
+}
+
+void ScannerWorker::LocalWalker::addSource(const QByteArray &path)
+{
+    DirTask task;
+    task.name = path;
+    task.isSource = true;
+    pushTask(0, std::move(task));
+}
+
+void ScannerWorker::LocalWalker::run()
+{
+    walk(0);
+
+    // 停止时其他线程也会在当前目录处理完后退出
+    pool.waitForDone();
+}
+
+FileScanner::ScanResult ScannerWorker::LocalWalker::result() const
+{
+    FileScanner::ScanResult ret = base;
+    ret.totalSize += totalSize.load();
+    ret.allocatedSize += allocatedSize.load();
+    ret.progressSize += progressSize.load();
+    ret.fileCount += fileCount.load();
+    ret.directoryCount += directoryCount.load();
+    return ret;
+}
+
+void ScannerWorker::LocalWalker::walk(int index)
+{
+    DirTask task;
+    while (!worker->shouldStop()) {
+        if (!takeTask(index, &task)) {
+            if (pendingTasks.load() == 0)
+                break;
+
+            if (index == 0)
+                reportProgress();
+
+            // 其他线程可能马上产生新的子目录，短暂等待后重试
+            QMutexLocker locker(&sleepMutex);
+            if (pendingTasks.load() == 0)
+                break;
+            sleepingThreads++;
+            sleepCondition.wait(&sleepMutex, 50);
+            sleepingThreads--;
+            continue;
+        }
+
+        processDirectory(index, task);
+        task = DirTask();
+
+        if (--pendingTasks == 0) {
+            QMutexLocker locker(&sleepMutex);
+            sleepCondition.wakeAll();
+        }
+
+        if (index == 0) {
+            if (!helpersStarted && threadCount > 1) {
+                QMutexLocker locker(&queues[0]->mutex);
+                if (queues[0]->tasks.size() >= kParallelThreshold) {
+                    locker.unlock();
+                    startHelpers();
+                }
+            }
+            reportProgress();
+        }
+    }
+}
+
+bool ScannerWorker::LocalWalker::takeTask(int index, DirTask *task)
+{
+    {
+        TaskQueue *own = queues[index].get();
+        QMutexLocker locker(&own->mutex);
+        if (!own->tasks.empty()) {
+            *task = std::move(own->tasks.back());
+            own->tasks.pop_back();
+            return true;
+        }
+    }
+
+    for (int i = 1; i < threadCount; ++i) {
+        TaskQueue *other = queues[(index + i) % threadCount].get();
+        QMutexLocker locker(&other->mutex);
+        if (!other->tasks.empty()) {
+            *task = std::move(other->tasks.front());
+            other->tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ScannerWorker::LocalWalker::pushTask(int index, DirTask &&task)
+{
+    // 先计数再入队，保证 pendingTasks 为 0 时确实没有剩余目录
+    pendingTasks++;
+    {
+        QMutexLocker locker(&queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+
+    if (sleepingThreads.load() > 0)
+        sleepCondition.wakeOne();
+}
+
+void ScannerWorker::LocalWalker::processDirectory(int index, const DirTask &task)
+{
+    FileScanner::ScanResult local;
+
+    QByteArray path;
+    if (task.parent) {
+        path = task.parent->path;
+        if (!path.endsWith('/'))
+            path += '/';
+        path += task.name;
+    } else {
+        path = task.name;
+    }
+
+    // 先计数目录本身（无论是否能读取内容）
+    local.directoryCount++;
+    local.progressSize += pageSize;
+
+    // 记录成功处理的源目录（用于最终扣除）
+    if (task.isSource)
+        sourceDirs++;
+
+    // 子目录已由 readdir/fstatat 确认不是符号链接，O_NOFOLLOW 防止期间被替换为链接；源目录允许是指向目录的链接
+    int flags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+    if (task.parent)
+        flags |= O_NOFOLLOW;
+    const int fd = ::openat(task.parent ? task.parent->fd : AT_FDCWD, task.name.constData(), flags);
+    if (fd < 0) {
+        // 目录读取失败（权限不足），但目录已计数
+        qCWarning(logDFMBase) << "ScannerWorker: Failed to read directory contents:" << path << ":" << strerror(errno);
+        flush(&local);
+        return;
+    }
+
+    auto handle = std::make_shared<DirHandle>();
+    handle->fd = fd;
+    handle->path = path;
+
+    // 先取 epoch 再读取目录，读取期间本目录被监视器报告变化时不写入缓存
+    const quint64 epoch = cache ? cache->epoch() : 0;
+    struct stat dirStat;
+    const bool cacheable = cache && !isVirtualFsPath(path) && DirSizeCache::isSupportedFileSystem(fd)
+            && fstat(fd, &dirStat) == 0;
+    const qint64 mtime = cacheable ? qint64(dirStat.st_mtim.tv_sec) * 1000000000 + dirStat.st_mtim.tv_nsec : 0;
+    DirSizeCache::Record record;
+    if (cacheable && cache->find(dirStat.st_dev, dirStat.st_ino, mtime, &record)) {
+        cachedDirs++;
+        applyRecord(index, handle, record, &local);
+        flush(&local);
+        return;
+    }
+
+    DIR *dir = fdopendir(::dup(fd));
+    if (!dir) {
+        qCWarning(logDFMBase) << "ScannerWorker: Failed to read directory contents:" << path << ":" << strerror(errno);
+        flush(&local);
+        return;
+    }
+
+    // 跳过特殊系统文件 /proc/kcore 和 /dev/core
+    const char *specialFile = nullptr;
+    if (path == "/proc")
+        specialFile = "kcore";
+    else if (path == "/dev")
+        specialFile = "core";
+
+    // 记录只包含本目录的直接条目，读取不完整时不写入
+    bool complete = cacheable;
+    record.checkedAt = QDateTime::currentSecsSinceEpoch();
+    int processed = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (worker->shouldStop()) {
+            complete = false;
+            break;
+        }
+
+        const char *name = entry->d_name;
+        // 跳过 "." 和 ".."
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+            continue;
+
+        // 目录和符号链接不需要大小，d_type 可用时省去一次 fstatat
+        unsigned char type = entry->d_type;
+        struct stat statBuf;
+        if (type == DT_UNKNOWN || type == DT_REG) {
+            if (fstatat(fd, name, &statBuf, AT_SYMLINK_NOFOLLOW) != 0) {
+                // 部分条目可能无法访问，但继续处理其他条目
+                qCDebug(logDFMBase) << "ScannerWorker: fstatat failed for:" << path << name;
+                complete = false;
+                continue;
+            }
+            type = IFTODT(statBuf.st_mode);
+        }
+
+        switch (type) {
+        case DT_DIR:
+            if (singleDepth) {
+                // SingleDepth 模式：计数但不递归
+                local.directoryCount++;
+                local.progressSize += pageSize;
+            } else {
+                DirTask child;
+                child.parent = handle;
+                child.name = QByteArray(name);
+                if (cacheable)
+                    record.subdirs.append(child.name);
+                pushTask(index, std::move(child));
+            }
+            break;
+        case DT_REG:
+            if (specialFile && qstrcmp(name, specialFile) == 0) {
+                qCDebug(logDFMBase) << "ScannerWorker: Skipping special file:" << path << name;
+                break;
+            }
+            worker->processRegularFile(statBuf, &local);
+            if (cacheable) {
+                // 多链接文件可能经其他链接被修改，重放时重新查询，其余文件直接累加
+                if (statBuf.st_nlink > 1) {
+                    record.linkedFiles.append(QByteArray(name));
+                } else {
+                    record.fileCount++;
+                    record.totalSize += statBuf.st_size;
+                    record.allocatedSize += static_cast<qint64>(statBuf.st_blocks) * 512;
+                    record.progressSize += statBuf.st_size;
+                }
+            }
+            break;
+        case DT_LNK:
+            worker->processSymlink(&local);
+            record.fileCount++;
+            record.progressSize += pageSize;
+            break;
+        default:
+            // 其他特殊文件类型（socket、FIFO、字符设备、块设备等）
+            // 只计数，不计大小
+            local.fileCount++;
+            record.fileCount++;
+            break;
+        }
+
+        if (++processed % kFlushInterval == 0) {
+            flush(&local);
+            if (index == 0)
+                reportProgress();
+        }
+    }
+
+    closedir(dir);
+    flush(&local);
+
+    if (complete) {
+        record.mtime = mtime;
+        cache->insert(dirStat.st_dev, dirStat.st_ino, record, epoch);
+    }
+}
+
+void ScannerWorker::LocalWalker::applyRecord(int index, const std::shared_ptr<DirHandle> &handle,
+                                             const DirSizeCache::Record &record, FileScanner::ScanResult *local)
+{
+    local->fileCount += record.fileCount;
+    local->totalSize += record.totalSize;
+    local->allocatedSize += record.allocatedSize;
+    local->progressSize += record.progressSize;
+
+    // 多链接文件可能在其他目录中已统计或经其他链接修改，与读取目录时一样查询并去重
+    struct stat statBuf;
+    for (const QByteArray &name : record.linkedFiles) {
+        if (fstatat(handle->fd, name.constData(), &statBuf, AT_SYMLINK_NOFOLLOW) == 0 && S_ISREG(statBuf.st_mode))
+            worker->processRegularFile(statBuf, local);
+    }
+
+    // 子目录仍需逐个检查修改时间
+    for (const QByteArray &name : record.subdirs) {
+        DirTask child;
+        child.parent = handle;
+        child.name = name;
+        pushTask(index, std::move(child));
+    }
+}
+
+void ScannerWorker::LocalWalker::flush(FileScanner::ScanResult *local)
+{
+    totalSize += local->totalSize;
+    allocatedSize += local->allocatedSize;
+    progressSize += local->progressSize;
+    fileCount += local->fileCount;
+    directoryCount += local->directoryCount;
+    local->clear();
+}
+
+void ScannerWorker::LocalWalker::reportProgress()
+{
+    worker->currentResult = result();
+    worker->emitProgress();
+}
+
+void ScannerWorker::LocalWalker::startHelpers()
+{
+    helpersStarted = true;
+    pool.setMaxThreadCount(threadCount - 1);
+    for (int i = 1; i < threadCount; ++i)
+        pool.start([this, i]() { walk(i); });
+
+    qCDebug(logDFMBase) << "ScannerWorker: Started" << threadCount - 1 << "helper walker threads";
+}
+
 //===================================================================
 // ScannerWorker - 工作对象
 //===================================================================
@@ -206,6 +652,16 @@ void ScannerWorker::setOptions(FileScanner::ScanOptions options)
     this->options = options;
 }
 
+void ScannerWorker::setMaxThreadCount(int count)
+{
+    maxThreadCount = count;
+}
+
+void ScannerWorker::setSizeCache(DirSizeCache *cache)
+{
+    sizeCache = cache;
+}
+
 void ScannerWorker::start()
 {
     qCDebug(logDFMBase) << "ScannerWorker: Starting work";
@@ -237,11 +693,10 @@ void ScannerWorker::stop()
 
 void ScannerWorker::scanLocalPaths()
 {
-    qCDebug(logDFMBase) << "ScannerWorker: Scanning local paths using opendir/readdir";
+    qCDebug(logDFMBase) << "ScannerWorker: Scanning local paths using openat/fstatat";
 
     // ========== 初始化阶段 ==========
-    int processedSourceDirs = 0;   // 实际成功处理的源目录数
-    QStack<ScanContext> dirStack;
+    QList<QByteArray> sourceDirs;
 
     // 准备源路径
     for (const QUrl &url : urls) {
@@ -251,17 +706,13 @@ void ScannerWorker::scanLocalPaths()
         if (lstat(path.toUtf8().constData(), &statBuf) == 0) {
             // 判断是否为目录（包括指向目录的符号链接）
             if (isDirectoryPath(path, statBuf)) {
-                ScanContext ctx;
-                ctx.fullPath = path;
-                ctx.depth = 0;
-                ctx.isSourcePath = true;
-                dirStack.push(ctx);
+                sourceDirs.append(path.toUtf8());
             } else if (S_ISREG(statBuf.st_mode)) {
                 // 普通文件
-                processRegularFile(path, statBuf);
+                processRegularFile(statBuf, &currentResult);
             } else if (S_ISLNK(statBuf.st_mode)) {
                 // 符号链接
-                processSymlink(path);
+                processSymlink(&currentResult);
             } else {
                 // 其他特殊文件类型（socket、FIFO、字符设备、块设备等）
                 // 只计数，不计大小
@@ -273,97 +724,28 @@ void ScannerWorker::scanLocalPaths()
     }
 
     // ========== 遍历阶段 ==========
-    while (!dirStack.isEmpty() && !shouldStop()) {
-        ScanContext ctx = dirStack.pop();
-        const QString &dirPath = ctx.fullPath;
-
-        // 先计数目录本身（无论是否能读取内容）
-        currentResult.directoryCount++;
-        currentResult.progressSize += memoryPageSize;
-
-        // 记录成功处理的源目录（用于最终扣除）
-        if (ctx.isSourcePath) {
-            processedSourceDirs++;
-        }
-
-        // 读取目录内容
-        QList<DirEntry> entries;
-        bool readSuccess = readDirectoryEntries(dirPath, &entries);
-
-        if (!readSuccess) {
-            // 目录读取失败（权限不足），但目录已计数
-            qCWarning(logDFMBase) << "ScannerWorker: Failed to read directory contents:" << dirPath;
-            continue;   // 无法读取内容，跳过条目处理
-        }
-
-        // 处理每个条目
-        for (const DirEntry &entry : entries) {
-            if (shouldStop()) {
-                break;
-            }
-
-            QString entryPath = dirPath + "/" + QString::fromUtf8(entry.name);
-
-            // 跳过特殊系统文件
-            if (entry.statOk && S_ISREG(entry.statBuf.st_mode)) {
-                static const QSet<QString> kSpecialSystemFiles {
-                    "/proc/kcore",
-                    "/dev/core"
-                };
-                if (kSpecialSystemFiles.contains(entryPath)) {
-                    qCDebug(logDFMBase) << "ScannerWorker: Skipping special file:" << entryPath;
-                    continue;
-                }
-            }
-
-            // lstat 失败处理：部分条目可能无法访问，但继续处理其他条目
-            if (!entry.statOk) {
-                qCDebug(logDFMBase) << "ScannerWorker: lstat failed for:" << entryPath;
-                continue;
-            }
-
-            // 根据类型处理条目
-            if (S_ISDIR(entry.statBuf.st_mode)) {
-                // 子目录
-                bool isSingleDepth = options & FileScanner::ScanOption::SingleDepth;
-                if (isSingleDepth) {
-                    // SingleDepth 模式：计数但不递归
-                    currentResult.directoryCount++;
-                    currentResult.progressSize += memoryPageSize;
-                } else {
-                    // 递归模式：压栈
-                    ScanContext childCtx;
-                    childCtx.fullPath = entryPath;
-                    childCtx.depth = ctx.depth + 1;
-                    childCtx.isSourcePath = false;
-                    dirStack.push(childCtx);
-                }
-            } else if (S_ISREG(entry.statBuf.st_mode)) {
-                // 常规文件
-                processRegularFile(entryPath, entry.statBuf);
-            } else if (S_ISLNK(entry.statBuf.st_mode)) {
-                // 符号链接
-                processSymlink(entryPath);
-            } else {
-                // 其他特殊文件类型（socket、FIFO、字符设备、块设备等）
-                // 只计数，不计大小
-                currentResult.fileCount++;
-            }
-
-            // 定期发送进度
-            emitProgress();
-        }
-    }
+    const int threadCount = maxThreadCount > 0 ? maxThreadCount
+                                               : qBound(1, QThread::idealThreadCount(), kMaxWalkerThreads);
+    LocalWalker walker(this, threadCount);
+    for (const QByteArray &dir : sourceDirs)
+        walker.addSource(dir);
+    walker.run();
+    currentResult = walker.result();
+    if (sizeCache)
+        sizeCache->requestSave();
 
     // ========== 最终处理 ==========
     // 默认排除源目录本身（只扣除成功处理的源目录）
     if (!(options & FileScanner::ScanOption::IncludeSource)) {
-        currentResult.directoryCount -= processedSourceDirs;
+        currentResult.directoryCount -= walker.sourceDirCount();
     }
 
     qCDebug(logDFMBase) << "ScannerWorker: Local scan completed - files:" << currentResult.fileCount
                         << "dirs:" << currentResult.directoryCount
-                        << "size:" << currentResult.totalSize;
+                        << "size:" << currentResult.totalSize
+                        << "allocated:" << currentResult.allocatedSize
+                        << "threads:" << walker.usedThreadCount()
+                        << "cached dirs:" << walker.cachedDirCount();
 }
 
 void ScannerWorker::scanOtherProtocols()
@@ -473,17 +855,16 @@ bool ScannerWorker::shouldStop() const
     return stopped.load();
 }
 
-bool ScannerWorker::isInodeProcessed(quint64 device, quint64 inode)
+bool ScannerWorker::markInodeProcessed(quint64 device, quint64 inode)
 {
-    return processedInodes.value(device).contains(inode);
-}
+    // 只有 st_nlink > 1 的文件才会走到这里，数量很少，一把锁即可
+    QMutexLocker locker(&inodeMutex);
+    QSet<quint64> &inodes = processedInodes[device];
+    if (inodes.contains(inode))
+        return false;
 
-void ScannerWorker::markInodeProcessed(quint64 device, quint64 inode)
-{
-    if (!processedInodes.contains(device)) {
-        processedInodes.insert(device, QSet<quint64>());
-    }
-    processedInodes[device].insert(inode);
+    inodes.insert(inode);
+    return true;
 }
 
 void ScannerWorker::emitProgress(bool force)
@@ -501,64 +882,24 @@ void ScannerWorker::emitProgress(bool force)
     }
 }
 
-bool ScannerWorker::readDirectoryEntries(const QString &path, QList<DirEntry> *entries)
+void ScannerWorker::processRegularFile(const struct stat &statBuf, FileScanner::ScanResult *result)
 {
-    Q_ASSERT(entries);
-    entries->clear();
-
-    QByteArray pathUtf8 = path.toUtf8();
-    DIR *dir = opendir(pathUtf8.constData());
-    if (!dir) {
-        qCWarning(logDFMBase) << "ScannerWorker: opendir failed for" << path << ":" << strerror(errno);
-        return false;
-    }
-
-    struct dirent *entry;
-    while ((entry = readdir(dir)) != nullptr) {
-        // 跳过 "." 和 ".."
-        if (entry->d_name[0] == '.' && (entry->d_name[1] == '\0' || (entry->d_name[1] == '.' && entry->d_name[2] == '\0'))) {
-            continue;
-        }
-
-        DirEntry dirEntry;
-        dirEntry.name = entry->d_name;
-        dirEntry.d_type = entry->d_type;
-
-        QString fullPath = path + "/" + QString::fromUtf8(entry->d_name);
-        dirEntry.statOk = (lstat(fullPath.toUtf8().constData(), &dirEntry.statBuf) == 0);
-
-        entries->append(dirEntry);
-    }
+    result->fileCount++;
+    result->progressSize += statBuf.st_size;
 
-    closedir(dir);
-    return true;
-}
+    // 硬链接去重：inode 已统计过时只计数
+    if (statBuf.st_nlink > 1 && !markInodeProcessed(statBuf.st_dev, statBuf.st_ino))
+        return;
 
-void ScannerWorker::processRegularFile(const QString &path, const struct stat &statBuf)
-{
-    // 硬链接去重
-    if (statBuf.st_nlink > 1) {
-        if (!isInodeProcessed(statBuf.st_dev, statBuf.st_ino)) {
-            markInodeProcessed(statBuf.st_dev, statBuf.st_ino);
-            currentResult.totalSize += statBuf.st_size;
-            currentResult.fileCount++;
-        } else {
-            // 硬链接已统计，只计数
-            currentResult.fileCount++;
-        }
-    } else {
-        // st_nlink == 1，直接处理
-        currentResult.totalSize += statBuf.st_size;
-        currentResult.fileCount++;
-    }
-    currentResult.progressSize += statBuf.st_size;
+    result->totalSize += statBuf.st_size;
+    result->allocatedSize += static_cast<qint64>(statBuf.st_blocks) * 512;
 }
 
-void ScannerWorker::processSymlink(const QString &path)
+void ScannerWorker::processSymlink(FileScanner::ScanResult *result)
 {
     // 符号链接只计数，不跟随（不计入大小）
-    currentResult.fileCount++;
-    currentResult.progressSize += memoryPageSize;   // 估算符号链接大小
+    result->fileCount++;
+    result->progressSize += memoryPageSize;   // 估算符号链接大小
 }
 
 bool ScannerWorker::isDirectoryPath(const QString &path, const struct stat &lstatBuf)
@@ -12,9 +12,12 @@
 #include <QThread>
 #include <QScopedPointer>
 #include <QAtomicInt>
+#include <QElapsedTimer>
 #include <QHash>
+#include <QMutex>
 #include <QSet>
-#include <QStack>
+
+#include <atomic>
 
 #include <sys/stat.h>
 #include <dirent.h>
@@ -23,15 +26,19 @@ namespace dfmbase {
 
 class FileScannerPrivate;
 class ScannerWorker;
+class DirSizeCache;
 
 /**
  * @brief 文件扫描器
  *
  * 提供异步的文件/目录统计功能，包括：
  * - 文件数量统计
- * - 总大小计算
+ * - 总大小（文件内容大小）与磁盘占用大小计算，硬链接只统计一次
  * - 进度通知
  *
+ * 本地目录由多个线程并行遍历，目录较少时只使用工作线程本身。
+ * 开启目录大小缓存（DirSizeCache）后，未变化的目录直接使用缓存的统计。
+ *
  * 使用示例：
  * @code
  * auto scanner = new FileScanner(this);
@@ -68,12 +75,13 @@ public:
     struct ScanResult
     {
         qint64 totalSize { 0 };   ///< 总大小（字节）
+        qint64 allocatedSize { 0 };   ///< 文件实际占用的磁盘空间（字节，仅本地文件）
         qint64 progressSize { 0 };   ///< 进度大小（用于显示）
         int fileCount { 0 };   ///< 文件数量
         int directoryCount { 0 };   ///< 目录数量
 
         bool isValid() const { return fileCount >= 0 && directoryCount >= 0; }
-        void clear() { totalSize = progressSize = fileCount = directoryCount = 0; }
+        void clear() { totalSize = allocatedSize = progressSize = fileCount = directoryCount = 0; }
     };
 
     /**
@@ -101,6 +109,14 @@ public:
      */
     ScanOptions options() const;
 
+    /**
+     * @brief 设置遍历本地目录的最大线程数
+     * @param count 线程数，1 表示只在工作线程中遍历；小于 1 时使用默认值（CPU 核数，最多 16）
+     *
+     * 必须在 start() 之前调用
+     */
+    void setMaxThreadCount(int count);
+
     /**
      * @brief 获取最新结果
      *
@@ -166,6 +182,9 @@ public:
 
     void setUrls(const QList<QUrl> &urls);
     void setOptions(FileScanner::ScanOptions options);
+    void setMaxThreadCount(int count);
+    // 为空时不使用缓存；SingleDepth 模式下不使用缓存
+    void setSizeCache(DirSizeCache *cache);
 
 public Q_SLOTS:
     /**
@@ -192,54 +211,27 @@ Q_SIGNALS:
     void finished();
 
 private:
+    class LocalWalker;
+
     /**
      * @brief 扫描本地文件路径
      *
-     * 使用 opendir/readdir 进行遍历
+     * 源路径在工作线程中处理，目录交给 LocalWalker 并行遍历
      */
     void scanLocalPaths();
 
-    /**
-     * @brief 目录项结构（用于批量读取）
-     */
-    struct DirEntry
-    {
-        QByteArray name;   // 文件名（UTF-8）
-        struct stat statBuf;   // lstat 结果
-        bool statOk;   // lstat 是否成功
-        unsigned char d_type;   // dirent.d_type (DT_DIR, DT_LNK 等)
-    };
-
-    /**
-     * @brief 遍历上下文
-     */
-    struct ScanContext
-    {
-        QString fullPath;   // 当前完整路径
-        int depth;   // 当前深度（0 = 源目录）
-        bool isSourcePath;   // 是否为源路径
-    };
-
-    /**
-     * @brief 读取目录条目
-     * @param path 目录路径
-     * @param entries 输出参数，目录条目列表
-     * @return 是否成功
-     */
-    bool readDirectoryEntries(const QString &path, QList<DirEntry> *entries);
-
     /**
      * @brief 处理常规文件
-     * @param path 文件路径
      * @param statBuf lstat 结果
+     * @param result 累加到的结果
      */
-    void processRegularFile(const QString &path, const struct stat &statBuf);
+    void processRegularFile(const struct stat &statBuf, FileScanner::ScanResult *result);
 
     /**
      * @brief 处理符号链接
-     * @param path 链接路径
+     * @param result 累加到的结果
      */
-    void processSymlink(const QString &path);
+    void processSymlink(FileScanner::ScanResult *result);
 
     /**
      * @brief 判断路径是否为目录（跟随符号链接）
@@ -262,17 +254,13 @@ private:
     bool shouldStop() const;
 
     /**
-     * @brief 检查 inode 是否已处理
+     * @brief 标记 inode 为已处理
+     * @return inode 此前未处理时返回 true
      *
      * 使用 device + inode 组合避免硬链接重复统计
-     * 只对 st_nlink > 1 的文件调用此方法
-     */
-    bool isInodeProcessed(quint64 device, quint64 inode);
-
-    /**
-     * @brief 标记 inode 为已处理
+     * 只对 st_nlink > 1 的文件调用此方法，线程安全
      */
-    void markInodeProcessed(quint64 device, quint64 inode);
+    bool markInodeProcessed(quint64 device, quint64 inode);
 
     /**
      * @brief 发送进度通知
@@ -283,6 +271,8 @@ private:
 private:
     QList<QUrl> urls;
     FileScanner::ScanOptions options { FileScanner::ScanOption::NoOption };
+    int maxThreadCount { 0 };
+    DirSizeCache *sizeCache { nullptr };
 
     // 当前结果（工作线程独占，无需锁）
     FileScanner::ScanResult currentResult;
@@ -297,8 +287,9 @@ private:
     // 内存页大小
     qint64 memoryPageSize { 4096 };
 
-    // inode 去重 - 只对 st_nlink > 1 的文件存储
+    // inode 去重 - 只对 st_nlink > 1 的文件存储，遍历线程共享
     // QHash<device, QSet<inode>>
+    QMutex inodeMutex;
     QHash<quint64, QSet<quint64>> processedInodes;
 };
 
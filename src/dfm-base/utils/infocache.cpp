@@ -17,11 +17,117 @@ static constexpr int kCacheFileWatcherCount = 5000;
 static constexpr int kRotationTrainingTime = (60 * 1000);
 // remove cache time limit
 static constexpr int kCacheRemoveTime = (60 * (60 * 1000));
+// 超过这么多个轮询周期没有访问的缓存会被移除
+static constexpr int kCacheExpireTicks = kCacheRemoveTime / kRotationTrainingTime;
 
 namespace dfmbase {
+void InfoCacheShard::setCapacity(int capacity)
+{
+    this->capacity = qMax(1, capacity);
+    slots.reset(new InfoCacheSlot[static_cast<size_t>(this->capacity)]);
+    index.reserve(this->capacity);
+}
+
+FileInfoPointer InfoCacheShard::get(const QUrl &url, int tick)
+{
+    QReadLocker rlk(&lock);
+    const int pos = index.value(url, -1);
+    if (pos < 0)
+        return nullptr;
+
+    auto &slot = slots[pos];
+    slot.referenced.store(true, std::memory_order_relaxed);
+    slot.lastTick.store(tick, std::memory_order_relaxed);
+    return slot.info;
+}
+
+bool InfoCacheShard::insert(const QUrl &url, const FileInfoPointer &info, int tick, QMap<QUrl, FileInfoPointer> *evicted)
+{
+    QWriteLocker wlk(&lock);
+    if (index.contains(url))
+        return false;
+
+    int pos = -1;
+    if (!freeSlots.isEmpty())
+        pos = freeSlots.takeLast();
+    else if (used < capacity)
+        pos = used++;
+    else
+        pos = evictOne(evicted);
+
+    auto &slot = slots[pos];
+    slot.url = url;
+    slot.info = info;
+    // 新加入的缓存不设置访问位，只访问一次的文件优先被淘汰
+    slot.referenced.store(false, std::memory_order_relaxed);
+    slot.lastTick.store(tick, std::memory_order_relaxed);
+    index.insert(url, pos);
+    return true;
+}
+
+int InfoCacheShard::evictOne(QMap<QUrl, FileInfoPointer> *evicted)
+{
+    // 调用时所有槽位都被占用，转一圈内一定能找到访问位为 false 的槽位
+    forever {
+        auto &slot = slots[hand];
+        const int pos = hand;
+        hand = (hand + 1) % capacity;
+        if (slot.referenced.exchange(false, std::memory_order_relaxed))
+            continue;
+
+        index.remove(slot.url);
+        if (evicted)
+            evicted->insert(slot.url, slot.info);
+        slot.url = QUrl();
+        slot.info.reset();
+        return pos;
+    }
+}
+
+FileInfoPointer InfoCacheShard::take(const QUrl &url)
+{
+    QWriteLocker wlk(&lock);
+    const int pos = index.value(url, -1);
+    if (pos < 0)
+        return nullptr;
+    index.remove(url);
+
+    auto &slot = slots[pos];
+    FileInfoPointer info = slot.info;
+    slot.url = QUrl();
+    slot.info.reset();
+    slot.referenced.store(false, std::memory_order_relaxed);
+    freeSlots.append(pos);
+    return info;
+}
+
+QList<QUrl> InfoCacheShard::expiredUrls(int tick, int expireTicks)
+{
+    QList<QUrl> urls;
+    QReadLocker rlk(&lock);
+    for (auto it = index.cbegin(); it != index.cend(); ++it) {
+        if (tick - slots[it.value()].lastTick.load(std::memory_order_relaxed) >= expireTicks)
+            urls.append(it.key());
+    }
+    return urls;
+}
+
+int InfoCacheShard::size() const
+{
+    QReadLocker rlk(&lock);
+    return index.size();
+}
+
 InfoCachePrivate::InfoCachePrivate(InfoCache *qq)
     : q(qq)
 {
+    for (auto &shard : shards)
+        shard.setCapacity(kCacheFileinfoCount / kShardCount);
+}
+
+InfoCacheShard &InfoCachePrivate::shardOf(const QUrl &url)
+{
+    return shards[qHash(url) % kShardCount];
 }
 
 InfoCachePrivate::~InfoCachePrivate()
@@ -135,18 +241,6 @@ void InfoCache::cacheInfo(const QUrl url, const FileInfoPointer info)
     if (!info || d->cacheWorkerStoped)
         return;
 
-    {
-        QReadLocker rlk(&d->mianLock);
-        if (d->mainCache.contains(url))
-            return;
-    }
-
-    {
-        QReadLocker rlk(&d->copyLock);
-        if (d->copyCache.contains(url))
-            return;
-    }
-
     // 获取监视器，监听当前的file的改变 当没有缓存加入监视器后，这里的watcher就会析构，如果启动了就要停止监控，这个是代理
     //  代理就将启动的缓存了监视关闭了。本来没有缓存的监视器监视就没有意义
     //  if (!WatcherCache::instance().cacheDisable(url.scheme())) {
@@ -171,41 +265,15 @@ void InfoCache::cacheInfo(const QUrl url, const FileInfoPointer info)
     //     }
     // }
 
-    // 插入到主和副的所有缓存中
-    d->status = kCacheCopy;
-    {
-        QWriteLocker wlk(&d->mianLock);
-        d->mainCache.insert(url, info);
-    }
-    d->status = kCacheMain;
-    {
-        QWriteLocker wlk(&d->copyLock);
-        d->copyCache.insert(url, info);
+    // 分片已满时按 CLOCK 淘汰，超出数量的限制在插入时就处理掉
+    QMap<QUrl, FileInfoPointer> evicted;
+    if (!d->shardOf(url).insert(url, info, d->clockTick.load(std::memory_order_relaxed), &evicted))
+        return;
+
+    if (!evicted.isEmpty()) {
+        d->evictions.fetch_add(static_cast<quint64>(evicted.size()), std::memory_order_relaxed);
+        disconnectWatcher(evicted);
     }
-    // 使用线程处理加入时间序列问题
-    emit cacheUpdateInfoTime(url);
-}
-/*!
- * \brief insertSortTime 处理当前文件的移除时间
- *
- * \param qint64 文件info的当前时间
- *
- * \param QString 文件的url
- *
- * \return
- */
-bool InfoCache::updateSortTimeWorker(const QUrl url)
-{
-    Q_D(InfoCache);
-    if (d->cacheWorkerStoped)
-        return false;
-    auto time = QDateTime::currentMSecsSinceEpoch();
-    auto key = QString::number(time) + QString("-") + url.toString();
-    if (d->urlTimeSortHash.contains(url))
-        d->timeToUrlMap.remove(d->urlTimeSortHash.value(url));
-    d->timeToUrlMap.insert(key, url);
-    d->urlTimeSortHash.insert(url, key);
-    return d->timeToUrlMap.count() > kCacheFileinfoCount;
 }
 
 void InfoCache::stop()
@@ -228,31 +296,17 @@ void InfoCache::removeCaches(const QList<QUrl> urls)
     if (d->cacheWorkerStoped || urls.size() <= 0)
         return;
 
-    // 读取主缓存，插入到
-    d->status = kCacheCopy;
     QMap<QUrl, FileInfoPointer> infos;
-    {
-        QWriteLocker wlk(&d->mianLock);
-        for (const auto &url : urls) {
-            auto info = d->mainCache.take(url);
-            if (info)
-                infos.insert(url, d->mainCache.take(url));
-        }
+    for (const auto &url : urls) {
+        auto info = d->shardOf(url).take(url);
+        if (info)
+            infos.insert(url, info);
     }
     if (d->cacheWorkerStoped)
         return;
     // 断开监视器监视
     if (infos.size() > 0)
         emit cacheDisconnectWatcher(infos);
-
-    // 设置读取主缓存和插入到主缓存中
-    d->status = kCacheMain;
-    {
-        QWriteLocker wlk(&d->copyLock);
-        for (const auto &url : urls) {
-            d->copyCache.remove(url);
-        }
-    }
 }
 /*!
  * \brief getCacheInfo 获取文件
@@ -264,23 +318,27 @@ void InfoCache::removeCaches(const QList<QUrl> urls)
 FileInfoPointer InfoCache::getCacheInfo(const QUrl &url)
 {
     Q_D(InfoCache);
-    // 要异步线程重置计时器 todo 开辟一个可控制的线程来处理时间排序的问题
-    // 读取副缓存和临时缓存返回
-    FileInfoPointer info(nullptr);
-    if (d->status == kCacheMain) {   // 可以读取主缓存返回
-        QReadLocker wlk(&d->mianLock);
-        info = d->mainCache.value(url);
-    } else {
-        QReadLocker wlk(&d->copyLock);
-        info = d->copyCache.value(url);
-    }
-    // 异步线程或者信号更新时间
-    // 使用线程处理加入时间序列问题
+    // 命中时只在分片的读锁内更新访问位和访问周期，不再发信号排队更新时间
+    FileInfoPointer info = d->shardOf(url).get(url, d->clockTick.load(std::memory_order_relaxed));
     if (info)
-        emit cacheUpdateInfoTime(url);
+        d->hits.fetch_add(1, std::memory_order_relaxed);
+    else
+        d->misses.fetch_add(1, std::memory_order_relaxed);
 
     return info;
 }
+
+InfoCacheStatistics InfoCache::statistics() const
+{
+    Q_D(const InfoCache);
+    InfoCacheStatistics stat;
+    stat.hits = d->hits.load(std::memory_order_relaxed);
+    stat.misses = d->misses.load(std::memory_order_relaxed);
+    stat.evictions = d->evictions.load(std::memory_order_relaxed);
+    for (const auto &shard : d->shards)
+        stat.size += shard.size();
+    return stat;
+}
 /*!
  * \brief refreshFileInfo 刷新缓存fileinfo
  *
@@ -345,43 +403,19 @@ void InfoCache::removeWatcherTimeInfo(const QList<QUrl> &urls)
 void InfoCache::timeRemoveCache()
 {
     Q_D(InfoCache);
-    // 取出哪些url的时间超出了u
-    qint64 delCount = d->urlTimeSortHash.size() < kCacheFileinfoCount ? 0 : d->urlTimeSortHash.size() - kCacheFileinfoCount;
+    // 数量的限制在插入时已经处理，这里只移除长时间没有访问的缓存
+    const int tick = d->clockTick.fetch_add(1, std::memory_order_relaxed) + 1;
     QList<QUrl> delList;
-    foreach (const auto time, d->timeToUrlMap.keys()) {
+    for (auto &shard : d->shards) {
         if (d->cacheWorkerStoped)
             return;
-
-        if (time < QString::number(QDateTime::currentDateTime().toMSecsSinceEpoch() - kCacheRemoveTime)) {
-            delList.append(d->timeToUrlMap.value(time));
-            continue;
-        }
-
-        if (delList.size() >= delCount) {
-            break;
-        }
-
-        delList.append(d->timeToUrlMap.value(time));
-    }
-    for (auto url : delList) {
-        if (d->urlTimeSortHash.contains(url)) {
-            d->timeToUrlMap.remove(d->urlTimeSortHash.take(url));
-        }
+        delList.append(shard.expiredUrls(tick, kCacheExpireTicks));
     }
     // 发送异步消息 告诉移除线程创建移除线程移除，考虑是否是使用线程一直还是使用临时线程（使用临时线程）
     if (delList.size() > 0 && !d->cacheWorkerStoped)
         emit cacheRemoveCaches(delList);
 }
 
-void InfoCache::removeInfosTimeWorker(const QList<QUrl> urls)
-{
-    for (auto url : urls) {
-        if (d->urlTimeSortHash.contains(url)) {
-            d->timeToUrlMap.remove(d->urlTimeSortHash.take(url));
-        }
-    }
-}
-
 void InfoCache::updateSortTimeWatcherWorker(const QList<QUrl> &urls, const bool add)
 {
     Q_ASSERT(qApp->thread() != QThread::currentThread());
@@ -390,7 +424,7 @@ void InfoCache::updateSortTimeWatcherWorker(const QList<QUrl> &urls, const bool
     if (add)
         return addWatcherTimeInfo(urls);
 
-    removeInfosTimeWorker(urls);
+    removeWatcherTimeInfo(urls);
 }
 
 void InfoCache::fileAttributeChanged(const QUrl url)
@@ -456,6 +490,11 @@ FileInfoPointer InfoCacheController::getCacheInfo(const QUrl &url)
     return InfoCache::instance().getCacheInfo(url);
 }
 
+InfoCacheStatistics InfoCacheController::statistics() const
+{
+    return InfoCache::instance().statistics();
+}
+
 InfoCacheController::InfoCacheController(QObject *parent)
     : QObject(parent), thread(new QThread), worker(new CacheWorker), removeTimer(new QTimer), threadUpdate(new QThread), workerUpdate(new TimeToUpdateCache)
 {
@@ -467,8 +506,6 @@ void InfoCacheController::init()
     removeTimer->moveToThread(qApp->thread());
     connect(removeTimer.data(), &QTimer::timeout, workerUpdate.data(),
             &TimeToUpdateCache::dealRemoveInfo, Qt::QueuedConnection);
-    connect(&InfoCache::instance(), &InfoCache::cacheUpdateInfoTime, workerUpdate.data(),
-            &TimeToUpdateCache::updateInfoTime, Qt::QueuedConnection);
     connect(this, &InfoCacheController::cacheFileInfo, worker.data(), &CacheWorker::cacheInfo, Qt::QueuedConnection);
     connect(this, &InfoCacheController::removeCacheFileInfo, worker.data(), &CacheWorker::removeCaches, Qt::QueuedConnection);
     connect(&InfoCache::instance(), &InfoCache::cacheRemoveCaches, worker.data(), &CacheWorker::removeCaches, Qt::QueuedConnection);
@@ -488,13 +525,6 @@ TimeToUpdateCache::~TimeToUpdateCache()
 {
 }
 
-void TimeToUpdateCache::updateInfoTime(const QUrl url)
-{
-    Q_ASSERT(qApp->thread() != QThread::currentThread());
-    if (InfoCache::instance().updateSortTimeWorker(url))
-        InfoCache::instance().timeRemoveCache();
-}
-
 void TimeToUpdateCache::dealRemoveInfo()
 {
     Q_ASSERT(qApp->thread() != QThread::currentThread());
@@ -11,12 +11,47 @@
 #include <QMutex>
 #include <QTimer>
 #include <QMap>
+#include <QVector>
+
+#include <atomic>
+#include <memory>
 
 namespace dfmbase {
-enum CacheInfoStatus : uint8_t {
-    kCacheMain = 0,   // 1.正常状态 插入(同时插入主和副缓存hash)， 读取主缓存hash， 删除主缓存hash
-    kCacheCopy,
+
+// 缓存槽位，命中时只修改原子变量，不需要写锁
+struct InfoCacheSlot
+{
+    QUrl url;
+    FileInfoPointer info { nullptr };
+    std::atomic_bool referenced { false };   // CLOCK 访问位
+    std::atomic_int lastTick { 0 };   // 最后一次访问时的轮询周期
 };
+
+// 一个分片：固定数量的槽位 + CLOCK 指针，淘汰为均摊 O(1)
+class InfoCacheShard
+{
+public:
+    void setCapacity(int capacity);
+
+    FileInfoPointer get(const QUrl &url, int tick);
+    // 返回 false 表示已经缓存过；分片已满时淘汰的 info 放入 evicted
+    bool insert(const QUrl &url, const FileInfoPointer &info, int tick, QMap<QUrl, FileInfoPointer> *evicted);
+    FileInfoPointer take(const QUrl &url);
+    QList<QUrl> expiredUrls(int tick, int expireTicks);
+    int size() const;
+
+private:
+    int evictOne(QMap<QUrl, FileInfoPointer> *evicted);
+
+    mutable QReadWriteLock lock;
+    QHash<QUrl, int> index;
+    std::unique_ptr<InfoCacheSlot[]> slots;
+    QVector<int> freeSlots;
+    int capacity { 0 };
+    int used { 0 };
+    int hand { 0 };
+};
+
 class InfoCachePrivate
 {
     friend class InfoCache;
@@ -24,15 +59,14 @@ class InfoCachePrivate
     InfoCache *const q;
     DThreadList<QString> disableCahceSchemes;
 
-    QAtomicInt status { kCacheMain };   // 当前状态缓存的状态
-    QHash<QUrl, FileInfoPointer> mainCache;   // 主信息缓存
-    QHash<QUrl, FileInfoPointer> copyCache;   // 副信息缓存
-    QReadWriteLock mianLock;
-    QReadWriteLock copyLock;
+    // 按 url 的哈希分片，不同分片的读写互不影响
+    static constexpr int kShardCount = 16;
+    InfoCacheShard shards[kShardCount];
+    std::atomic_int clockTick { 0 };   // 每个轮询周期加一，用于超时移除
 
-    // 时间排序url,利用map的有序性，来处理时间到了要移除的url
-    QHash<QUrl, QString> urlTimeSortHash;
-    QMap<QString, QUrl> timeToUrlMap;
+    std::atomic<quint64> hits { 0 };
+    std::atomic<quint64> misses { 0 };
+    std::atomic<quint64> evictions { 0 };
 
     // 时间排序url,利用map的有序性，来处理时间到了要移除的url
     QHash<QUrl, QString> urlTimeSortWatcherHash;
@@ -42,6 +76,8 @@ class InfoCachePrivate
 public:
     explicit InfoCachePrivate(InfoCache *qq);
     virtual ~InfoCachePrivate();
+
+    InfoCacheShard &shardOf(const QUrl &url);
 };
 }
 
@@ -76,7 +76,7 @@ qint64 getEffectiveSize(const SortInfoPointer &info)
     return size;
 }
 
-bool compareStringForMimeType(const QString &str1, const QString &str2)
+int mimeTypeRank(const QString &displayType)
 {
     // 使用立即执行的lambda表达式初始化静态哈希表，确保只执行一次。
     static const QHash<QString, int> typeRankMap = [] {
@@ -98,16 +98,16 @@ bool compareStringForMimeType(const QString &str1, const QString &str2)
     // 缓存 "Unknown" 类型的排名，用于处理未识别的类型
     static const int unknownRank = typeRankMap.value("Unknown");
 
-    // --- 为 str1 提取主类型并获取排名 ---
-    int spacePos1 = str1.indexOf(' ');
     // 如果没有空格，整个字符串是主类型；否则，取空格前部分
-    const QString majorType1 = (spacePos1 == -1) ? str1 : str1.left(spacePos1);
-    const int rank1 = typeRankMap.value(majorType1, unknownRank);
+    const int spacePos = displayType.indexOf(' ');
+    const QString majorType = (spacePos == -1) ? displayType : displayType.left(spacePos);
+    return typeRankMap.value(majorType, unknownRank);
+}
 
-    // --- 为 str2 提取主类型并获取排名 ---
-    int spacePos2 = str2.indexOf(' ');
-    const QString majorType2 = (spacePos2 == -1) ? str2 : str2.left(spacePos2);
-    const int rank2 = typeRankMap.value(majorType2, unknownRank);
+bool compareStringForMimeType(const QString &str1, const QString &str2)
+{
+    const int rank1 = mimeTypeRank(str1);
+    const int rank2 = mimeTypeRank(str2);
 
     // --- 比较 ---
     if (rank1 != rank2) {
@@ -15,6 +15,8 @@ bool compareString(const QString &str1, const QString &str2, Qt::SortOrder order
 bool compareStringForFileName(const QString &str1, const QString &str2);
 bool compareStringForTime(const QString &str1, const QString &str2);
 bool compareStringForMimeType(const QString &str1, const QString &str2);
+// 类型显示名的主类型排名，目录最前，未知类型最后
+int mimeTypeRank(const QString &displayType);
 bool compareForSize(const SortInfoPointer info1, const SortInfoPointer info2);
 bool compareForSize(const qint64 size1, const qint64 size2);
 
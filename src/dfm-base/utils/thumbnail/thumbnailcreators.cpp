@@ -25,6 +25,8 @@
 #include <QImage>
 #include <QBuffer>
 
+#include <vector>
+
 // use original poppler api
 #include <poppler/cpp/poppler-document.h>
 #include <poppler/cpp/poppler-image.h>
@@ -38,6 +40,45 @@ static constexpr char kFormat[] { ".png" };
 using namespace dfmbase;
 DFMGLOBAL_USE_NAMESPACE
 
+// 让解码器直接输出目标尺寸（JPEG 会按 DCT 缩放解码），避免先解码整张大图再缩放
+static void setReaderScaledSize(QImageReader *reader, int size)
+{
+    const QSize &imageSize = reader->size();
+    if (imageSize.isValid() && (imageSize.width() > size || imageSize.height() > size))
+        reader->setScaledSize(imageSize.scaled(size, size, Qt::KeepAspectRatio));
+}
+
+// 选择不小于目标尺寸的最小内嵌缩略图，没有合适的缩略图时返回 nullptr
+static heif_image_handle *heifThumbnailHandle(heif_image_handle *primary, int maxSize)
+{
+    const int count = heif_image_handle_get_number_of_thumbnails(primary);
+    if (count <= 0)
+        return nullptr;
+
+    std::vector<heif_item_id> ids(static_cast<size_t>(count));
+    heif_image_handle_get_list_of_thumbnail_IDs(primary, ids.data(), count);
+
+    heif_image_handle *best = nullptr;
+    int bestSide = 0;
+    for (heif_item_id id : ids) {
+        heif_image_handle *thumb = nullptr;
+        if (heif_image_handle_get_thumbnail(primary, id, &thumb).code != heif_error_Ok || !thumb)
+            continue;
+
+        const int side = qMax(heif_image_handle_get_width(thumb), heif_image_handle_get_height(thumb));
+        if (side >= maxSize && (!best || side < bestSide)) {
+            if (best)
+                heif_image_handle_release(best);
+            best = thumb;
+            bestSide = side;
+        } else {
+            heif_image_handle_release(thumb);
+        }
+    }
+
+    return best;
+}
+
 QImage decodeHeifThumbnail(const QString &filePath, int maxSize)
 {
     heif_context *ctx = heif_context_alloc();
@@ -53,14 +94,20 @@ QImage decodeHeifThumbnail(const QString &filePath, int maxSize)
         return {};
     }
 
-    heif_image_handle *handle = nullptr;
-    err = heif_context_get_primary_image_handle(ctx, &handle);
+    heif_image_handle *primary = nullptr;
+    err = heif_context_get_primary_image_handle(ctx, &primary);
     if (err.code != heif_error_Ok) {
         qWarning() << "HEIF: Failed to get image handle:" << filePath << "Error:" << err.message;
         heif_context_free(ctx);
         return {};
     }
 
+    // 相机拍摄的 HEIC 一般带有内嵌缩略图，够大时直接解码缩略图，不再解码整张图片
+    heif_image_handle *thumbnail = heifThumbnailHandle(primary, maxSize);
+    heif_image_handle *handle = thumbnail ? thumbnail : primary;
+    if (thumbnail)
+        qCDebug(logDFMBase) << "thumbnail: decoding embedded HEIF thumbnail for:" << filePath;
+
     heif_image *img = nullptr;
 
     // Check for alpha channel and decode appropriately
@@ -68,11 +115,19 @@ QImage decodeHeifThumbnail(const QString &filePath, int maxSize)
     heif_colorspace cs = heif_colorspace_RGB;
     heif_chroma chroma = hasAlpha ? heif_chroma_interleaved_RGBA : heif_chroma_interleaved_RGB;
 
+    auto release = [&]() {
+        if (img)
+            heif_image_release(img);
+        if (thumbnail)
+            heif_image_handle_release(thumbnail);
+        heif_image_handle_release(primary);
+        heif_context_free(ctx);
+    };
+
     err = heif_decode_image(handle, &img, cs, chroma, nullptr);
     if (err.code != heif_error_Ok || !img) {
         qWarning() << "HEIF: Failed to decode image:" << filePath << "Error:" << err.message;
-        heif_image_handle_release(handle);
-        heif_context_free(ctx);
+        release();
         return {};
     }
 
@@ -81,9 +136,7 @@ QImage decodeHeifThumbnail(const QString &filePath, int maxSize)
 
     if (width <= 0 || height <= 0) {
         qWarning() << "HEIF: Invalid image dimensions:" << width << "x" << height;
-        heif_image_release(img);
-        heif_image_handle_release(handle);
-        heif_context_free(ctx);
+        release();
         return {};
     }
 
@@ -91,29 +144,25 @@ QImage decodeHeifThumbnail(const QString &filePath, int maxSize)
     const uint8_t *data = heif_image_get_plane_readonly(img, heif_channel_interleaved, &stride);
     if (!data || stride <= 0) {
         qWarning() << "HEIF: Failed to get image plane data.";
-        heif_image_release(img);
-        heif_image_handle_release(handle);
-        heif_context_free(ctx);
+        release();
         return {};
     }
 
     QImage::Format format = hasAlpha ? QImage::Format_RGBA8888 : QImage::Format_RGB888;
     QImage image(data, width, height, stride, format);
 
-    // Copy image to detach from HEIF buffer
-    QImage finalImage = image.copy();
-
-    // Optionally scale if larger than requested thumbnail size
-    if (finalImage.width() > maxSize || finalImage.height() > maxSize) {
-        finalImage = finalImage.scaled(maxSize, maxSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    // 直接从 HEIF 缓冲区缩放，不再先复制一份整图；无需缩放时复制以脱离 HEIF 缓冲区
+    QImage finalImage;
+    if (width > maxSize || height > maxSize) {
+        finalImage = image.scaled(maxSize, maxSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    } else {
+        finalImage = image.copy();
     }
 
-    heif_image_release(img);
-    heif_image_handle_release(handle);
-    heif_context_free(ctx);
-
+    release();
     return finalImage;
 }
+
 QImage ThumbnailCreators::defaultThumbnailCreator(const QString &filePath, ThumbnailSize size)
 {
     qCDebug(logDFMBase) << "thumbnail: using default creator for:" << filePath << "size:" << size;
@@ -346,9 +395,12 @@ QImage ThumbnailCreators::imageThumbnailCreator(const QString &filePath, Thumbna
     qCDebug(logDFMBase) << "thumbnail: image file size:" << imageSize << "for:" << filePath;
 
     const QString &defaultMime = DMimeDatabase().mimeTypeForFile(QUrl::fromLocalFile(filePath)).name();
-    if (imageSize.width() > size || imageSize.height() > size || defaultMime == DFMGLOBAL_NAMESPACE::Mime::kTypeImageSvgXml) {
-        qCDebug(logDFMBase) << "thumbnail: scaling image from" << imageSize << "to fit size:" << size;
-        reader.setScaledSize(reader.size().scaled(size, size, Qt::KeepAspectRatio));
+    if (defaultMime == DFMGLOBAL_NAMESPACE::Mime::kTypeImageSvgXml) {
+        // 矢量图按目标尺寸渲染，小图也需要放大
+        reader.setScaledSize(imageSize.scaled(size, size, Qt::KeepAspectRatio));
+    } else {
+        qCDebug(logDFMBase) << "thumbnail: decoding image" << imageSize << "at size:" << size;
+        setReaderScaledSize(&reader, size);
     }
 
     reader.setAutoTransform(true);
@@ -452,31 +504,39 @@ QImage ThumbnailCreators::pdfThumbnailCreator(const QString &filePath, Thumbnail
         return img;
     }
 
+    // 按页面尺寸计算渲染 DPI，整页直接渲染到缩略图大小，避免先渲染大图再缩放
+    const poppler::rectf &pageRect = page->page_rect();
+    const double longSide = qMax(pageRect.width(), pageRect.height());
+    const double dpi = longSide > 0 ? 72.0 * size / longSide : 72.0;
+
     poppler::page_renderer pr;
     pr.set_render_hint(poppler::page_renderer::antialiasing, true);
     pr.set_render_hint(poppler::page_renderer::text_antialiasing, true);
 
-    poppler::image imageData = pr.render_page(page.data(), 72, 72, -1, -1, -1, size);
+    poppler::image imageData = pr.render_page(page.data(), dpi, dpi);
     if (!imageData.is_valid()) {
         qCWarning(logDFMBase) << "thumbnail: PDF page rendering failed:" << filePath;
         return img;
     }
 
+    uchar *data = reinterpret_cast<uchar *>(imageData.data());
+    const int bytesPerLine = imageData.bytes_per_row();
     poppler::image::format_enum format = imageData.format();
     switch (format) {
     case poppler::image::format_invalid:
         qCWarning(logDFMBase) << "thumbnail: PDF rendered image has invalid format:" << filePath;
         break;
     case poppler::image::format_mono:
-        img = QImage(reinterpret_cast<uchar *>(imageData.data()), imageData.width(), imageData.height(), QImage::Format_Mono);
+        img = QImage(data, imageData.width(), imageData.height(), bytesPerLine, QImage::Format_Mono);
         qCDebug(logDFMBase) << "thumbnail: PDF rendered as mono format:" << filePath;
         break;
     case poppler::image::format_rgb24:
-        img = QImage(reinterpret_cast<uchar *>(imageData.data()), imageData.width(), imageData.height(), QImage::Format_ARGB6666_Premultiplied);
+        // poppler 的 rgb24 每像素 4 字节（0xffRRGGBB）
+        img = QImage(data, imageData.width(), imageData.height(), bytesPerLine, QImage::Format_RGB32);
         qCDebug(logDFMBase) << "thumbnail: PDF rendered as RGB24 format:" << filePath;
         break;
     case poppler::image::format_argb32:
-        img = QImage(reinterpret_cast<uchar *>(imageData.data()), imageData.width(), imageData.height(), QImage::Format_ARGB32);
+        img = QImage(data, imageData.width(), imageData.height(), bytesPerLine, QImage::Format_ARGB32);
         qCDebug(logDFMBase) << "thumbnail: PDF rendered as ARGB32 format:" << filePath;
         break;
     default:
@@ -485,8 +545,12 @@ QImage ThumbnailCreators::pdfThumbnailCreator(const QString &filePath, Thumbnail
     }
 
     if (!img.isNull()) {
-        img = img.scaled(QSize(size, size), Qt::KeepAspectRatio, Qt::SmoothTransformation);
-        qCDebug(logDFMBase) << "thumbnail: PDF thumbnail created successfully for:" << filePath;
+        // imageData 析构后缓冲区失效，需要复制一份
+        if (img.width() > size || img.height() > size)
+            img = img.scaled(QSize(size, size), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        else
+            img = img.copy();
+        qCDebug(logDFMBase) << "thumbnail: PDF thumbnail created successfully for:" << filePath << "dpi:" << dpi;
     }
 
     return img;
@@ -601,10 +665,12 @@ QImage ThumbnailCreators::pptxThumbnailCreator(const QString &filePath, Thumbnai
     QString thumbnailPath = extractPath + "/docProps/thumbnail.jpeg";
     if (QFile::exists(thumbnailPath)) {
         qCDebug(logDFMBase) << "thumbnail: found built-in thumbnail in docProps:" << thumbnailPath;
+        QImageReader reader(thumbnailPath);
+        setReaderScaledSize(&reader, size);
         QImage thumbnail;
-        if (thumbnail.load(thumbnailPath)) {
+        if (reader.read(&thumbnail)) {
             qCDebug(logDFMBase) << "thumbnail: PPTX thumbnail loaded successfully from docProps/thumbnail.jpeg";
-            return thumbnail.scaled(size, size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+            return thumbnail;
         } else {
             qCWarning(logDFMBase) << "thumbnail: failed to load built-in thumbnail:" << thumbnailPath;
         }
@@ -12,20 +12,29 @@
 #include <dfm-base/base/device/deviceproxymanager.h>
 
 #include <QGuiApplication>
+#include <QSet>
+
+#include <algorithm>
 
 using namespace dfmbase;
 DFMGLOBAL_USE_NAMESPACE
 
-static constexpr int kMaxCountLimit { 50 };
-static constexpr int kPushInterval { 100 };   // ms
+static constexpr int kMaxWorkerCount { 8 };
 
 ThumbnailFactory::ThumbnailFactory(QObject *parent)
-    : QObject(parent),
-      thread(new QThread),
-      worker(new ThumbnailWorker)
+    : QObject(parent)
 {
     qCInfo(logDFMBase) << "thumbnail: ThumbnailFactory initializing with" << QThread::idealThreadCount() << "ideal thread count";
 
+    // 留一个核心给界面线程
+    const int workerCount = qBound(1, QThread::idealThreadCount() - 1, kMaxWorkerCount);
+    for (int i = 0; i < workerCount; ++i) {
+        WorkerSlot slot;
+        slot.thread.reset(new QThread);
+        slot.worker.reset(new ThumbnailWorker);
+        workers.append(slot);
+    }
+
     registerThumbnailCreator(Mime::kTypeImageVDjvu, ThumbnailCreators::djvuThumbnailCreator);
     registerThumbnailCreator(Mime::kTypeImageVDMultipage, ThumbnailCreators::djvuThumbnailCreator);
     registerThumbnailCreator(Mime::kTypeTextPlain, ThumbnailCreators::textThumbnailCreator);
@@ -44,7 +53,10 @@ ThumbnailFactory::ThumbnailFactory(QObject *parent)
 ThumbnailFactory::~ThumbnailFactory()
 {
     qCInfo(logDFMBase) << "thumbnail: ThumbnailFactory destructor called";
-    if (thread->isRunning())
+    const bool running = std::any_of(workers.cbegin(), workers.cend(), [](const WorkerSlot &slot) {
+        return slot.thread->isRunning();
+    });
+    if (running)
         onAboutToQuit();
 }
 
@@ -52,20 +64,21 @@ void ThumbnailFactory::init()
 {
     Q_ASSERT(qApp->thread() == QThread::currentThread());
 
-    taskPushTimer.setSingleShot(true);
-    taskPushTimer.setInterval(kPushInterval);
-    connect(&taskPushTimer, &QTimer::timeout, this, &ThumbnailFactory::pushTask);
     connect(this, &ThumbnailFactory::thumbnailJob, this, &ThumbnailFactory::doJoinThumbnailJob, Qt::QueuedConnection);
     connect(qApp, &QGuiApplication::aboutToQuit, this, &ThumbnailFactory::onAboutToQuit);
 
-    connect(this, &ThumbnailFactory::addTask, worker.data(), &ThumbnailWorker::onTaskAdded, Qt::QueuedConnection);
-    connect(worker.data(), &ThumbnailWorker::thumbnailCreateFinished, this, &ThumbnailFactory::produceFinished, Qt::QueuedConnection);
-    connect(worker.data(), &ThumbnailWorker::thumbnailCreateFailed, this, &ThumbnailFactory::produceFailed, Qt::QueuedConnection);
+    for (int i = 0; i < workers.size(); ++i) {
+        const auto &slot = workers.at(i);
+        connect(slot.worker.data(), &ThumbnailWorker::thumbnailCreateFinished, this, &ThumbnailFactory::produceFinished, Qt::QueuedConnection);
+        connect(slot.worker.data(), &ThumbnailWorker::thumbnailCreateFailed, this, &ThumbnailFactory::produceFailed, Qt::QueuedConnection);
+        connect(
+                slot.worker.data(), &ThumbnailWorker::taskProcessed, this, [this, i] { onWorkerIdle(i); }, Qt::QueuedConnection);
 
-    worker->moveToThread(thread.data());
-    thread->start();
+        slot.worker->moveToThread(slot.thread.data());
+        slot.thread->start();
+    }
 
-    qCInfo(logDFMBase) << "thumbnail: ThumbnailFactory initialized, worker thread started";
+    qCInfo(logDFMBase) << "thumbnail: ThumbnailFactory initialized," << workers.size() << "worker threads started";
 }
 
 void ThumbnailFactory::joinThumbnailJob(const QUrl &url, ThumbnailSize size)
@@ -81,9 +94,14 @@ void ThumbnailFactory::joinThumbnailJob(const QUrl &url, ThumbnailSize size)
 bool ThumbnailFactory::registerThumbnailCreator(const QString &mimeType, ThumbnailCreator creator)
 {
     Q_ASSERT(creator);
-    bool success = worker->registerCreator(mimeType, creator);
+    // 每个工作线程各自持有一份生成函数，互不影响
+    bool success = true;
+    for (const auto &slot : std::as_const(workers))
+        success = slot.worker->registerCreator(mimeType, creator) && success;
     if (success) {
         qCDebug(logDFMBase) << "thumbnail: registered creator for mime type:" << mimeType;
+        // 新的生成函数可能支持之前失败或不支持的文件
+        ThumbnailIndex::instance()->clearFailures();
     } else {
         qCWarning(logDFMBase) << "thumbnail: failed to register creator for mime type:" << mimeType;
     }
@@ -92,46 +110,118 @@ bool ThumbnailFactory::registerThumbnailCreator(const QString &mimeType, Thumbna
 
 void ThumbnailFactory::onAboutToQuit()
 {
-    qCInfo(logDFMBase) << "thumbnail: application about to quit, stopping worker and thread";
-    worker->stop();
-    thread->quit();
-    bool finished = thread->wait(3000);
-    if (!finished) {
-        qCWarning(logDFMBase) << "thumbnail: worker thread did not finish within 3 seconds, forcing termination";
-        thread->terminate();
-        thread->wait(1000);
-    } else {
-        qCInfo(logDFMBase) << "thumbnail: worker thread stopped gracefully";
+    qCInfo(logDFMBase) << "thumbnail: application about to quit, stopping workers and threads";
+    taskQueue.clear();
+    pendingTasks.clear();
+    runningTasks.clear();
+
+    for (const auto &slot : std::as_const(workers)) {
+        slot.worker->stop();
+        slot.thread->quit();
     }
+
+    for (const auto &slot : std::as_const(workers)) {
+        bool finished = slot.thread->wait(3000);
+        if (!finished) {
+            qCWarning(logDFMBase) << "thumbnail: worker thread did not finish within 3 seconds, forcing termination";
+            slot.thread->terminate();
+            slot.thread->wait(1000);
+        }
+    }
+    qCInfo(logDFMBase) << "thumbnail: worker threads stopped";
 }
 
-void ThumbnailFactory::pushTask()
+void ThumbnailFactory::updateTaskPriority(const QUrl &dir, const QList<QUrl> &visible, const QList<QUrl> &prefetch)
 {
-    auto map = std::move(taskMap);
-    qCDebug(logDFMBase) << "thumbnail: pushing" << map.size() << "tasks to worker thread";
-    emit addTask(map);
+    Q_ASSERT(qApp->thread() == QThread::currentThread());
+
+    QSet<QUrl> hinted;
+    for (const auto &url : prefetch) {
+        setTaskPriority(url, TaskPriority::kPrefetch);
+        hinted.insert(url);
+    }
+    for (const auto &url : visible) {
+        setTaskPriority(url, TaskPriority::kVisible);
+        hinted.insert(url);
+    }
+
+    // 已经滚出视图的任务排到最后，其他视图再次提示时会重新提升
+    QList<QUrl> outOfView;
+    for (auto it = pendingTasks.cbegin(); it != pendingTasks.cend(); ++it) {
+        if (!hinted.contains(it.key()) && UniversalUtils::urlEquals(UrlRoute::urlParent(it.key()), dir))
+            outOfView.append(it.key());
+    }
+
+    for (const auto &url : std::as_const(outOfView))
+        setTaskPriority(url, TaskPriority::kOutOfView);
+
+    if (!outOfView.isEmpty())
+        qCDebug(logDFMBase) << "thumbnail: lowered" << outOfView.size() << "tasks scrolled out of view in:" << dir;
 }
 
-void ThumbnailFactory::doJoinThumbnailJob(const QUrl &url, ThumbnailSize size)
+void ThumbnailFactory::enqueueTask(const QUrl &url, PendingTask task, TaskPriority priority)
 {
-    if (FileUtils::containsCopyingFileUrl(url)) {
-        qCDebug(logDFMBase) << "thumbnail: skipping file being copied:" << url;
+    task.order = qMakePair(static_cast<int>(priority), -(++taskSequence));
+    taskQueue.insert(task.order, url);
+    pendingTasks.insert(url, task);
+}
+
+void ThumbnailFactory::setTaskPriority(const QUrl &url, TaskPriority priority)
+{
+    auto it = pendingTasks.find(url);
+    if (it == pendingTasks.end() || it->order.first == static_cast<int>(priority))
         return;
+
+    taskQueue.remove(it->order);
+    it->order.first = static_cast<int>(priority);
+    taskQueue.insert(it->order, url);
+}
+
+void ThumbnailFactory::dispatchTasks()
+{
+    for (auto &slot : workers) {
+        if (taskQueue.isEmpty())
+            return;
+        if (!slot.runningUrl.isEmpty())
+            continue;
+
+        const QUrl url = taskQueue.take(taskQueue.firstKey());
+        const auto task = pendingTasks.take(url);
+        slot.runningUrl = url;
+        runningTasks.insert(url);
+
+        // 每次只投递一个任务，剩下的任务可以随视图滚动调整顺序
+        ThumbnailWorker::ThumbnailTaskMap map;
+        map.insert(url, task.size);
+        auto worker = slot.worker;
+        QMetaObject::invokeMethod(
+                worker.data(), [worker, map] { worker->onTaskAdded(map); }, Qt::QueuedConnection);
     }
+}
 
-    if (taskMap.contains(url)) {
+void ThumbnailFactory::onWorkerIdle(int index)
+{
+    if (index < 0 || index >= workers.size())
         return;
-    }
 
-    if (taskMap.isEmpty()) {
-        taskPushTimer.start();
-    }
+    runningTasks.remove(workers[index].runningUrl);
+    workers[index].runningUrl.clear();
+    dispatchTasks();
+}
 
-    taskMap.insert(url, size);
+void ThumbnailFactory::doJoinThumbnailJob(const QUrl &url, ThumbnailSize size)
+{
+    if (FileUtils::containsCopyingFileUrl(url)) {
+        qCDebug(logDFMBase) << "thumbnail: skipping file being copied:" << url;
+        return;
+    }
 
-    if (taskMap.size() < kMaxCountLimit)
+    if (pendingTasks.contains(url) || runningTasks.contains(url)) {
         return;
+    }
 
-    qCDebug(logDFMBase) << "thumbnail: task queue reached limit" << kMaxCountLimit << ", pushing immediately";
-    pushTask();
+    PendingTask task;
+    task.size = size;
+    enqueueTask(url, task, TaskPriority::kNormal);
+    dispatchTasks();
 }
@@ -12,6 +12,9 @@
 #include <dfm-base/interfaces/fileinfo.h>
 
 #include <QTimer>
+#include <QMap>
+#include <QHash>
+#include <QSet>
 
 namespace dfmbase {
 
@@ -25,7 +28,18 @@ public:
         return &ins;
     }
 
+    // 任务优先级，数值越小越先生成；同一优先级内后加入的先生成
+    enum class TaskPriority : uint8_t {
+        kVisible = 0,   // 当前可见的文件
+        kPrefetch,   // 即将滚动到的文件
+        kNormal,   // 没有视图提示的任务
+        kOutOfView,   // 已滚出视图的文件
+    };
+
     void joinThumbnailJob(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+    // 视图滚动后更新 dir 下等待中任务的优先级，既不可见也不在预取范围内的任务降到最低，
+    // 同一目录可能还显示在其他标签页或窗口中，这里不取消任何任务
+    void updateTaskPriority(const QUrl &dir, const QList<QUrl> &visible, const QList<QUrl> &prefetch);
     using ThumbnailCreator = std::function<QImage(const QString &, DFMGLOBAL_NAMESPACE::ThumbnailSize)>;
     bool registerThumbnailCreator(const QString &mimeType, ThumbnailCreator creator);
 
@@ -33,11 +47,9 @@ Q_SIGNALS:
     void produceFinished(const QUrl &src, const QString &thumb);
     void produceFailed(const QUrl &src);
 
-    void addTask(const ThumbnailWorker::ThumbnailTaskMap &taskMap);
     void thumbnailJob(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
 private Q_SLOTS:
     void onAboutToQuit();
-    void pushTask();
     void doJoinThumbnailJob(const QUrl &url, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
 
 protected:
@@ -46,10 +58,31 @@ protected:
     void init();
 
 private:
-    ThumbnailWorker::ThumbnailTaskMap taskMap;
-    QSharedPointer<QThread> thread { nullptr };
-    QSharedPointer<ThumbnailWorker> worker { nullptr };
-    QTimer taskPushTimer;
+    struct PendingTask
+    {
+        DFMGLOBAL_NAMESPACE::ThumbnailSize size;
+        QPair<int, qint64> order;   // 在 taskQueue 中的键
+    };
+
+    struct WorkerSlot
+    {
+        QSharedPointer<QThread> thread { nullptr };
+        QSharedPointer<ThumbnailWorker> worker { nullptr };
+        QUrl runningUrl;   // 正在生成的文件，为空表示空闲
+    };
+
+    void enqueueTask(const QUrl &url, PendingTask task, TaskPriority priority);
+    void setTaskPriority(const QUrl &url, TaskPriority priority);
+    void dispatchTasks();
+    void onWorkerIdle(int index);
+
+    // 按 (优先级, -加入序号) 排序，begin() 就是下一个要生成的任务
+    QMap<QPair<int, qint64>, QUrl> taskQueue;
+    QHash<QUrl, PendingTask> pendingTasks;
+    // 已交给工作线程的文件，生成结束前同一文件的新请求直接丢弃，避免多个线程同时生成
+    QSet<QUrl> runningTasks;
+    qint64 taskSequence { 0 };
+    QList<WorkerSlot> workers;
 };
 }   // namespace dfmbase
 
@@ -18,8 +18,7 @@
 
 #include <QImageReader>
 #include <QDir>
-
-#include <sys/stat.h>
+#include <QFileInfo>
 
 #include <sys/stat.h>
 
@@ -29,6 +28,29 @@ static constexpr char kFormat[] { ".png" };
 using namespace dfmbase;
 DFMGLOBAL_USE_NAMESPACE
 
+struct ThumbnailSource
+{
+    QString filePath;
+    QByteArray md5Hex;   // 缩略图文件名，参见 freedesktop 缩略图规范
+    qint64 mtime { 0 };
+    qint64 fileSize { 0 };
+};
+
+static bool thumbnailSource(const FileInfoPointer &fileInfo, ThumbnailSource *source)
+{
+    if (!fileInfo)
+        return false;
+
+    source->filePath = fileInfo->pathOf(PathInfoType::kFilePath);
+    if (source->filePath.isEmpty())
+        return false;
+
+    source->md5Hex = ThumbnailHelper::dataToMd5Hex(QUrl::fromLocalFile(source->filePath).toString(QUrl::FullyEncoded).toLocal8Bit());
+    source->mtime = fileInfo->timeOf(TimeInfoType::kLastModifiedSecond).toLongLong();
+    source->fileSize = fileInfo->size();
+    return true;
+}
+
 ThumbnailHelper::ThumbnailHelper()
 {
     initMimeTypeSupport();
@@ -117,6 +139,11 @@ bool ThumbnailHelper::canGenerateThumbnail(const QUrl &url)
     qint64 limit = sizeLimit(mime);
     if (fileSize > limit && !mime.name().startsWith("video/")) {
         qCDebug(logDFMBase) << "thumbnail: file size" << fileSize << "exceeds limit" << limit << "for mime type:" << mime.name() << "file:" << url;
+        ThumbnailSource source;
+        if (thumbnailSource(info, &source)) {
+            for (auto size : { ThumbnailSize::kSmall, ThumbnailSize::kNormal, ThumbnailSize::kLarge })
+                ThumbnailIndex::instance()->update(source.md5Hex, size, source.mtime, source.fileSize, ThumbnailIndex::State::kUnsupported);
+        }
         return false;
     }
 
@@ -214,17 +241,19 @@ QString ThumbnailHelper::saveThumbnail(const QUrl &url, const QImage &img, Thumb
     }
 
     const QString &fileUrl = url.toString(QUrl::FullyEncoded);
-    const QString &thumbnailName = ThumbnailHelper::dataToMd5Hex(fileUrl.toLocal8Bit()) + kFormat;
+    const QByteArray &md5Hex = ThumbnailHelper::dataToMd5Hex(fileUrl.toLocal8Bit());
+    const QString &thumbnailName = md5Hex + kFormat;
     const QString &thumbnailPath = ThumbnailHelper::sizeToFilePath(size);
     const QString &thumbnailFilePath = DFMIO::DFMUtils::buildFilePath(thumbnailPath.toStdString().c_str(), thumbnailName.toStdString().c_str(), nullptr);
     const qint64 fileModify = info->timeOf(TimeInfoType::kLastModifiedSecond).toLongLong();
+    const qint64 fileSize = info->size();
 
     makePath(thumbnailPath);
 
     qCDebug(logDFMBase) << "thumbnail: saving thumbnail to:" << thumbnailFilePath << "for file:" << url;
 
     QMetaObject::invokeMethod(
-            QCoreApplication::instance(), [img, thumbnailFilePath, fileUrl, fileModify]() {
+            QCoreApplication::instance(), [img, thumbnailFilePath, fileUrl, fileModify, fileSize, md5Hex, size]() {
                 Q_ASSERT(QThread::currentThread() == qApp->thread());
                 QImage tmpImg = img;
                 tmpImg.setText(QT_STRINGIFY(Thumb::URL), fileUrl);
@@ -233,6 +262,7 @@ QString ThumbnailHelper::saveThumbnail(const QUrl &url, const QImage &img, Thumb
                     qCWarning(logDFMBase) << "thumbnail: failed to save thumbnail file:" << thumbnailFilePath << "for:" << fileUrl;
                 } else {
                     qCDebug(logDFMBase) << "thumbnail: successfully saved thumbnail:" << thumbnailFilePath;
+                    ThumbnailIndex::instance()->update(md5Hex, size, fileModify, fileSize, ThumbnailIndex::State::kOk);
                 }
             },
             Qt::QueuedConnection);
@@ -269,10 +299,14 @@ QImage ThumbnailHelper::thumbnailImage(const QUrl &fileUrl, ThumbnailSize size)
         return {};
     }
 
+    ThumbnailSource source;
+    thumbnailSource(fileInfo, &source);
+
     QImageReader ir(thumbnail, QByteArray(kFormat).mid(1));
     if (!ir.canRead()) {
         qCWarning(logDFMBase) << "thumbnail: cannot read cached thumbnail, deleting:" << thumbnail;
         LocalFileHandler().deleteFileRecursive(QUrl::fromLocalFile(thumbnail));
+        ThumbnailIndex::instance()->remove(source.md5Hex, size);
         return {};
     }
     ir.setAutoDetectImageFormat(false);
@@ -282,20 +316,56 @@ QImage ThumbnailHelper::thumbnailImage(const QUrl &fileUrl, ThumbnailSize size)
     if (!image.isNull() && image.text(QT_STRINGIFY(Thumb::MTime)).toInt() != static_cast<int>(fileModify)) {
         qCDebug(logDFMBase) << "thumbnail: cached thumbnail is outdated, deleting:" << thumbnail;
         LocalFileHandler().deleteFileRecursive(QUrl::fromLocalFile(thumbnail));
+        ThumbnailIndex::instance()->remove(source.md5Hex, size);
         return {};
     }
 
     if (!image.isNull()) {
         image.setText(QT_STRINGIFY(Thumb::Path), thumbnail);
+        // 记录已校验过的缩略图，下次无需再打开 PNG
+        ThumbnailIndex::instance()->update(source.md5Hex, size, source.mtime, source.fileSize, ThumbnailIndex::State::kOk);
     }
 
     return image;
 }
 
+ThumbnailIndex::State ThumbnailHelper::indexedState(const QUrl &fileUrl, ThumbnailSize size, QString *thumbPath)
+{
+    ThumbnailSource source;
+    if (!thumbnailSource(InfoFactory::create<FileInfo>(fileUrl), &source))
+        return ThumbnailIndex::State::kUnknown;
+
+    auto state = ThumbnailIndex::instance()->state(source.md5Hex, size, source.mtime, source.fileSize);
+    if (state != ThumbnailIndex::State::kOk)
+        return state;
+
+    // 缩略图可能被其他程序清理，确认文件仍然存在（只 stat，不读取内容）
+    const QString &thumbnail = sizeToFilePath(size) + "/" + source.md5Hex + kFormat;
+    if (!QFileInfo::exists(thumbnail)) {
+        qCDebug(logDFMBase) << "thumbnail: indexed thumbnail no longer exists:" << thumbnail;
+        ThumbnailIndex::instance()->remove(source.md5Hex, size);
+        return ThumbnailIndex::State::kUnknown;
+    }
+
+    if (thumbPath)
+        *thumbPath = thumbnail;
+    return state;
+}
+
+void ThumbnailHelper::updateIndexedState(const QUrl &fileUrl, ThumbnailSize size, ThumbnailIndex::State state)
+{
+    ThumbnailSource source;
+    if (thumbnailSource(InfoFactory::create<FileInfo>(fileUrl), &source))
+        ThumbnailIndex::instance()->update(source.md5Hex, size, source.mtime, source.fileSize, state);
+}
+
 void ThumbnailHelper::setSizeLimit(const QMimeType &mime, qint64 size)
 {
-    if (mime.isValid() && !sizeLimitHash.contains(mime))
+    if (mime.isValid() && !sizeLimitHash.contains(mime)) {
         sizeLimitHash.insert(mime, size);
+        // 之前因超出大小限制记录的不支持可能已不再成立
+        ThumbnailIndex::instance()->clearFailures();
+    }
 }
 
 qint64 ThumbnailHelper::sizeLimit(const QMimeType &mime)
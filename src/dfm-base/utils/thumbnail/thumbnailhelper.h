@@ -9,6 +9,7 @@
 #include <dfm-base/dfm_global_defines.h>
 
 #include <dfm-base/mimetype/dmimedatabase.h>
+#include <dfm-base/utils/thumbnail/thumbnailindex.h>
 
 #include <QUrl>
 #include <QMimeType>
@@ -29,6 +30,9 @@ public:
 
     QString saveThumbnail(const QUrl &url, const QImage &img, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
     static QImage thumbnailImage(const QUrl &fileUrl, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+    // 查询缩略图索引而不打开 PNG 文件，返回 kOk 时 thumbPath 为有效的缩略图路径
+    static ThumbnailIndex::State indexedState(const QUrl &fileUrl, DFMGLOBAL_NAMESPACE::ThumbnailSize size, QString *thumbPath = nullptr);
+    static void updateIndexedState(const QUrl &fileUrl, DFMGLOBAL_NAMESPACE::ThumbnailSize size, ThumbnailIndex::State state);
 
     static const QStringList &defaultThumbnailDirs();
     static QString sizeToFilePath(DFMGLOBAL_NAMESPACE::ThumbnailSize size);
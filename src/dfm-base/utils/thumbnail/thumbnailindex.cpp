@@ -0,0 +1,224 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "thumbnailindex.h"
+
+#include <dfm-base/base/standardpaths.h>
+
+#include <QDir>
+#include <QFileInfo>
+
+#include <cstring>
+
+using namespace dfmbase;
+DFMGLOBAL_USE_NAMESPACE
+
+namespace {
+constexpr char kIndexMagic[8] { 'D', 'F', 'M', 'T', 'H', 'I', 'D', 'X' };
+constexpr quint32 kIndexVersion { 2 };   // 2: 索引文件只保存成功的记录
+constexpr int kDigestLength { 16 };
+// 线性探测的最大次数，超过后覆盖首个槽位
+constexpr quint32 kMaxProbe { 8 };
+}   // namespace
+
+struct ThumbnailIndex::Header
+{
+    char magic[8];
+    quint32 version;
+    quint32 slotCount;
+};
+
+struct ThumbnailIndex::Entry
+{
+    uchar digest[kDigestLength];
+    qint64 mtime;
+    qint64 fileSize;
+    quint16 size;
+    quint8 state;
+    quint8 reserved;
+    quint32 check;   // 校验值，用于发现被截断或并发写坏的记录
+};
+
+static quint32 entryChecksum(const uchar *digest, qint64 mtime, qint64 fileSize, quint16 size, quint8 state)
+{
+    // FNV-1a
+    quint32 hash = 2166136261u;
+    auto mix = [&hash](const void *data, size_t len) {
+        const uchar *p = static_cast<const uchar *>(data);
+        for (size_t i = 0; i < len; ++i) {
+            hash ^= p[i];
+            hash *= 16777619u;
+        }
+    };
+    mix(digest, kDigestLength);
+    mix(&mtime, sizeof(mtime));
+    mix(&fileSize, sizeof(fileSize));
+    mix(&size, sizeof(size));
+    mix(&state, sizeof(state));
+    return hash;
+}
+
+ThumbnailIndex *ThumbnailIndex::instance()
+{
+    static ThumbnailIndex ins(StandardPaths::location(StandardPaths::kCachePath) + "/thumbnail.index");
+    return &ins;
+}
+
+ThumbnailIndex::ThumbnailIndex(const QString &indexFilePath, quint32 slotCount)
+    : file(indexFilePath)
+{
+    if (!open(qMax<quint32>(slotCount, kMaxProbe))) {
+        qCWarning(logDFMBase) << "thumbnail: index unavailable, fallback to probing thumbnail files:" << indexFilePath;
+        file.close();
+        header = nullptr;
+        entries = nullptr;
+    }
+}
+
+ThumbnailIndex::~ThumbnailIndex()
+{
+    QWriteLocker locker(&lock);
+    if (header)
+        file.unmap(reinterpret_cast<uchar *>(header));
+    file.close();
+}
+
+bool ThumbnailIndex::isValid() const
+{
+    return header && entries;
+}
+
+bool ThumbnailIndex::open(quint32 slotCount)
+{
+    QDir().mkpath(QFileInfo(file.fileName()).absolutePath());
+    if (!file.open(QIODevice::ReadWrite))
+        return false;
+
+    const qint64 expectedSize = static_cast<qint64>(sizeof(Header)) + static_cast<qint64>(sizeof(Entry)) * slotCount;
+    bool reset = file.size() != expectedSize;
+    if (reset && !file.resize(expectedSize))
+        return false;
+
+    uchar *data = file.map(0, expectedSize);
+    if (!data)
+        return false;
+
+    header = reinterpret_cast<Header *>(data);
+    entries = reinterpret_cast<Entry *>(data + sizeof(Header));
+
+    reset = reset || std::memcmp(header->magic, kIndexMagic, sizeof(kIndexMagic)) != 0
+            || header->version != kIndexVersion || header->slotCount != slotCount;
+    if (reset) {
+        qCInfo(logDFMBase) << "thumbnail: rebuilding thumbnail index:" << file.fileName();
+        std::memset(data, 0, static_cast<size_t>(expectedSize));
+        std::memcpy(header->magic, kIndexMagic, sizeof(kIndexMagic));
+        header->version = kIndexVersion;
+        header->slotCount = slotCount;
+    }
+
+    return true;
+}
+
+ThumbnailIndex::Entry *ThumbnailIndex::findSlot(const QByteArray &digest, quint16 size, bool forWrite) const
+{
+    quint32 home = 0;
+    std::memcpy(&home, digest.constData(), sizeof(home));
+    home = (home ^ (static_cast<quint32>(size) * 0x9e3779b9u)) % header->slotCount;
+
+    Entry *freeSlot = nullptr;
+    for (quint32 i = 0; i < kMaxProbe; ++i) {
+        Entry *entry = entries + (home + i) % header->slotCount;
+        if (entry->size == size && std::memcmp(entry->digest, digest.constData(), kDigestLength) == 0)
+            return entry;
+        if (!freeSlot && entry->state == static_cast<quint8>(State::kUnknown))
+            freeSlot = entry;
+    }
+
+    if (!forWrite)
+        return nullptr;
+
+    return freeSlot ? freeSlot : entries + home;
+}
+
+ThumbnailIndex::State ThumbnailIndex::state(const QByteArray &md5Hex, ThumbnailSize size, qint64 mtime, qint64 fileSize) const
+{
+    const QByteArray &digest = QByteArray::fromHex(md5Hex);
+    if (digest.size() != kDigestLength)
+        return State::kUnknown;
+
+    QReadLocker locker(&lock);
+    auto it = failures.constFind({ digest, static_cast<quint16>(size) });
+    if (it != failures.cend())
+        return it->mtime == mtime && it->fileSize == fileSize ? it->state : State::kUnknown;
+
+    if (!isValid())
+        return State::kUnknown;
+
+    const Entry *entry = findSlot(digest, static_cast<quint16>(size), false);
+    if (!entry || entry->mtime != mtime || entry->fileSize != fileSize)
+        return State::kUnknown;
+
+    if (entry->check != entryChecksum(entry->digest, entry->mtime, entry->fileSize, entry->size, entry->state))
+        return State::kUnknown;
+
+    return entry->state == static_cast<quint8>(State::kOk) ? State::kOk : State::kUnknown;
+}
+
+void ThumbnailIndex::update(const QByteArray &md5Hex, ThumbnailSize size, qint64 mtime, qint64 fileSize, State state)
+{
+    const QByteArray &digest = QByteArray::fromHex(md5Hex);
+    if (digest.size() != kDigestLength)
+        return;
+
+    QWriteLocker locker(&lock);
+    if (state != State::kOk) {
+        // 失败和不支持不落盘：生成失败可能是暂时的，不应跨越重启一直跳过
+        if (isValid()) {
+            Entry *entry = findSlot(digest, static_cast<quint16>(size), false);
+            if (entry)
+                std::memset(entry, 0, sizeof(Entry));
+        }
+        if (failures.size() >= kMaxFailureCount)
+            failures.clear();
+        failures.insert({ digest, static_cast<quint16>(size) }, { mtime, fileSize, state });
+        return;
+    }
+
+    failures.remove({ digest, static_cast<quint16>(size) });
+    if (!isValid())
+        return;
+
+    Entry *entry = findSlot(digest, static_cast<quint16>(size), true);
+    std::memcpy(entry->digest, digest.constData(), kDigestLength);
+    entry->mtime = mtime;
+    entry->fileSize = fileSize;
+    entry->size = static_cast<quint16>(size);
+    entry->state = static_cast<quint8>(state);
+    entry->reserved = 0;
+    entry->check = entryChecksum(entry->digest, mtime, fileSize, entry->size, entry->state);
+}
+
+void ThumbnailIndex::remove(const QByteArray &md5Hex, ThumbnailSize size)
+{
+    const QByteArray &digest = QByteArray::fromHex(md5Hex);
+    if (digest.size() != kDigestLength)
+        return;
+
+    QWriteLocker locker(&lock);
+    failures.remove({ digest, static_cast<quint16>(size) });
+    if (!isValid())
+        return;
+
+    Entry *entry = findSlot(digest, static_cast<quint16>(size), false);
+    if (entry)
+        std::memset(entry, 0, sizeof(Entry));
+}
+
+void ThumbnailIndex::clearFailures()
+{
+    QWriteLocker locker(&lock);
+    if (!failures.isEmpty())
+        qCDebug(logDFMBase) << "thumbnail: cleared" << failures.size() << "failed or unsupported records";
+    failures.clear();
+}
@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef THUMBNAILINDEX_H
+#define THUMBNAILINDEX_H
+
+#include <dfm-base/dfm_base_global.h>
+#include <dfm-base/dfm_global_defines.h>
+
+#include <QFile>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+
+namespace dfmbase {
+
+/**
+ * @brief 缩略图元数据索引
+ *
+ * 以 freedesktop 缩略图文件名所用的 URL MD5 为键，记录源文件生成缩略图时的
+ * 修改时间、大小以及结果（成功/失败/不支持）。成功的记录写入通过 mmap 映射到内存的
+ * 索引文件；失败和不支持只在本次运行内记住，下次启动会重新尝试，
+ * 生成函数或大小限制变化时由 clearFailures() 清除。
+ *
+ * 索引只是磁盘缩略图的加速层：源文件的修改时间或大小变化后记录自动失效，
+ * 成功的记录仍会确认 PNG 文件存在，因此其他程序清理缩略图目录也不会返回错误的结果。
+ * 表满时直接覆盖旧记录，丢失的记录会退回到读取 PNG 校验的流程。
+ */
+class ThumbnailIndex
+{
+    Q_DISABLE_COPY(ThumbnailIndex)
+
+public:
+    enum class State : quint8 {
+        kUnknown = 0,
+        kOk,
+        kFailed,
+        kUnsupported
+    };
+
+    static ThumbnailIndex *instance();
+
+    explicit ThumbnailIndex(const QString &indexFilePath, quint32 slotCount = kDefaultSlotCount);
+    ~ThumbnailIndex();
+
+    bool isValid() const;
+
+    // md5Hex 即缩略图文件名（不含后缀），mtime 和 fileSize 不匹配时返回 kUnknown
+    State state(const QByteArray &md5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size, qint64 mtime, qint64 fileSize) const;
+    void update(const QByteArray &md5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size, qint64 mtime, qint64 fileSize, State state);
+    void remove(const QByteArray &md5Hex, DFMGLOBAL_NAMESPACE::ThumbnailSize size);
+    // 清除本次运行记录的失败和不支持，生成函数或大小限制变化后需要重新尝试
+    void clearFailures();
+
+    static constexpr quint32 kDefaultSlotCount { 1 << 16 };
+    static constexpr int kMaxFailureCount { 8192 };
+
+private:
+    struct Header;
+    struct Entry;
+    struct Failure
+    {
+        qint64 mtime { 0 };
+        qint64 fileSize { 0 };
+        State state { State::kUnknown };
+    };
+
+    bool open(quint32 slotCount);
+    Entry *findSlot(const QByteArray &digest, quint16 size, bool forWrite) const;
+
+    QFile file;
+    Header *header { nullptr };
+    Entry *entries { nullptr };
+    QHash<QPair<QByteArray, quint16>, Failure> failures;
+    mutable QReadWriteLock lock;
+};
+
+}   // namespace dfmbase
+
+#endif   // THUMBNAILINDEX_H
@@ -81,6 +81,8 @@ QString ThumbnailWorkerPrivate::createThumbnail(const QUrl &url, Global::Thumbna
 
     if (img.isNull()) {
         qCWarning(logDFMBase) << "thumbnail: failed to generate thumbnail for file:" << url;
+        // 文件未变化前不再重复尝试
+        thumbHelper.updateIndexedState(url, size, ThumbnailIndex::State::kFailed);
         return "";
     }
 
@@ -125,7 +127,7 @@ void ThumbnailWorkerPrivate::startDelayWork()
         delayTimer->setInterval(2 * 1000);
         delayTimer->setSingleShot(true);
         q->connect(
-                delayTimer, &QTimer::timeout, q, [this] { q->onTaskAdded(delayTaskMap); }, Qt::QueuedConnection);
+                delayTimer, &QTimer::timeout, q, [this] { q->processTasks(delayTaskMap); }, Qt::QueuedConnection);
         qCDebug(logDFMBase) << "thumbnail: delay timer initialized with 2 second interval";
     }
 
@@ -164,13 +166,19 @@ void ThumbnailWorker::stop()
 }
 
 void ThumbnailWorker::onTaskAdded(const ThumbnailTaskMap &taskMap)
+{
+    processTasks(taskMap);
+    Q_EMIT taskProcessed();
+}
+
+void ThumbnailWorker::processTasks(const ThumbnailTaskMap &taskMap)
 {
     if (d->isStoped) {
         qCDebug(logDFMBase) << "thumbnail: worker is stopped, ignoring" << taskMap.size() << "tasks";
         return;
     }
 
-    qCInfo(logDFMBase) << "thumbnail: processing" << taskMap.size() << "thumbnail tasks";
+    qCDebug(logDFMBase) << "thumbnail: processing" << taskMap.size() << "thumbnail tasks";
 
     QMapIterator<QUrl, Global::ThumbnailSize> iter(taskMap);
     while (iter.hasNext()) {
@@ -180,6 +188,19 @@ void ThumbnailWorker::onTaskAdded(const ThumbnailTaskMap &taskMap)
             continue;
         }
 
+        // 索引命中时无需打开 PNG 校验
+        QString thumbPath;
+        const auto state = ThumbnailHelper::indexedState(fileUrl, iter.value(), &thumbPath);
+        if (state == ThumbnailIndex::State::kOk) {
+            Q_EMIT thumbnailCreateFinished(iter.key(), thumbPath);
+            continue;
+        }
+        if (state == ThumbnailIndex::State::kFailed || state == ThumbnailIndex::State::kUnsupported) {
+            qCDebug(logDFMBase) << "thumbnail: skip file that failed or is unsupported before:" << fileUrl;
+            Q_EMIT thumbnailCreateFailed(iter.key());
+            continue;
+        }
+
         const auto &img = d->thumbHelper.thumbnailImage(fileUrl, iter.value());
         if (!img.isNull()) {
             Q_EMIT thumbnailCreateFinished(iter.key(), img.text(QT_STRINGIFY(Thumb::Path)));
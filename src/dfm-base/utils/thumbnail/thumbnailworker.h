@@ -34,8 +34,12 @@ public Q_SLOTS:
 Q_SIGNALS:
     void thumbnailCreateFinished(const QUrl &url, const QString &thumbnail);
     void thumbnailCreateFailed(const QUrl &url);
+    // onTaskAdded 投递的任务处理完毕，可以接收新的任务
+    void taskProcessed();
 
 private:
+    friend class ThumbnailWorkerPrivate;
+    void processTasks(const ThumbnailTaskMap &taskMap);
     void createThumbnail(const QUrl &url, Global::ThumbnailSize size);
 
 private:
@@ -78,6 +78,13 @@ void WatcherCache::cacheWatcher(const QUrl &url, const QSharedPointer<AbstractFi
     if (watcher.isNull())
         return;
     connect(watcher.data(), &AbstractFileWatcher::fileDeleted, this, &WatcherCache::fileDelete);
+    connect(watcher.data(), &AbstractFileWatcher::fileDeleted, this, &WatcherCache::fileChanged);
+    connect(watcher.data(), &AbstractFileWatcher::fileAttributeChanged, this, &WatcherCache::fileChanged);
+    connect(watcher.data(), &AbstractFileWatcher::subfileCreated, this, &WatcherCache::fileChanged);
+    connect(watcher.data(), &AbstractFileWatcher::fileRename, this, [this](const QUrl &oldUrl, const QUrl &newUrl) {
+        emit fileChanged(oldUrl);
+        emit fileChanged(newUrl);
+    });
     d->watchers.insert(url, watcher);
     emit updateWatcherTime({ url }, true);
 }
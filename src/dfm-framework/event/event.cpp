@@ -103,9 +103,8 @@ void Event::registerEventType(EventStratege stratege, const QString &space, cons
 
 EventType Event::eventType(const QString &space, const QString &topic)
 {
-    QStringList splits { topic.split("_") };
-    Q_ASSERT(splits.size() > 0);
-    QString prefix { splits.first().toLower() };
+    // 只取第一个 '_' 之前的前缀，不必拆分整个 topic
+    QString prefix { topic.left(topic.indexOf('_')).toLower() };
     if (!d->prefixKeys.contains(prefix))
         return EventTypeScope::kInValid;
     EventStratege stratege { d->prefixMap.value(prefix) };
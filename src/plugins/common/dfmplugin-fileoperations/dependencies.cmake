@@ -14,6 +14,7 @@ function(dfm_setup_fileoperations_dependencies target_name)
     find_package(Qt6 REQUIRED COMPONENTS Core DBus)
     find_package(PkgConfig REQUIRED)
     pkg_check_modules(zlib REQUIRED zlib IMPORTED_TARGET)
+    pkg_check_modules(liburing QUIET liburing IMPORTED_TARGET)
     
     # Apply default plugin configuration first
     dfm_apply_default_plugin_config(${target_name})
@@ -24,6 +25,15 @@ function(dfm_setup_fileoperations_dependencies target_name)
         Qt6::DBus
         PkgConfig::zlib
     )
+
+    # io_uring copy engine is optional, fall back to read/write loop without it
+    if(liburing_FOUND)
+        target_link_libraries(${target_name} PRIVATE PkgConfig::liburing)
+        target_compile_definitions(${target_name} PRIVATE DFM_ENABLE_IO_URING)
+        message(STATUS "DFM: liburing found, io_uring copy engine enabled")
+    else()
+        message(STATUS "DFM: liburing not found, io_uring copy engine disabled")
+    endif()
     
     # Configure config.h if needed
     if(EXISTS "${DFM_APP_SOURCE_DIR}/config.h.in")
@@ -29,7 +29,9 @@
 
 DPFILEOPERATIONS_USE_NAMESPACE
 
-std::atomic_bool AbstractWorker::bigFileCopy { false };
+bool AbstractWorker::bigFileCopy { false };
+QMutex AbstractWorker::bigFileCopyMutex;
+QWaitCondition AbstractWorker::bigFileCopyFinished;
 
 /*!
  * \brief setWorkArgs 设置当前任务的参数
@@ -112,6 +114,11 @@ void AbstractWorker::stop()
     }
 
     waitCondition.wakeAll();
+    {
+        // 唤醒正在等待其他任务大文件拷贝结束的线程，由它检查停止状态后退出
+        QMutexLocker locker(&bigFileCopyMutex);
+        bigFileCopyFinished.wakeAll();
+    }
 }
 /*!
  * \brief AbstractWorker::pause paused task
@@ -352,6 +359,10 @@ void AbstractWorker::endWork()
     fmInfo() << "Work completed - job type:" << static_cast<int>(jobType)
              << "completed files:" << completeSourceFiles.count()
              << "time elapsed:" << timeElapsed.elapsed() << "ms";
+    if (workData && (workData->cloneFileCount > 0 || workData->offloadFileCount > 0))
+        fmInfo() << "Copy fast path - cloned files:" << workData->cloneFileCount
+                 << "cloned size:" << workData->cloneFileSize
+                 << "server side copied files:" << workData->offloadFileCount;
 
     if (statisticsFilesSizeJob) {
         statisticsFilesSizeJob->stop();
@@ -477,6 +488,9 @@ void AbstractWorker::resumeAllThread()
     for (auto worker : threadCopyWorker) {
         worker->resume();
     }
+    for (auto worker : chunkCopyWorker) {
+        worker->resume();
+    }
 }
 
 void AbstractWorker::resumeThread(const QList<quint64> &errorIds)
@@ -488,6 +502,9 @@ void AbstractWorker::resumeThread(const QList<quint64> &errorIds)
         if (!errorIds.contains(quintptr(worker.data())))
             worker->resume();
     }
+    for (auto worker : chunkCopyWorker) {
+        worker->resume();
+    }
 }
 
 void AbstractWorker::pauseAllThread()
@@ -499,6 +516,9 @@ void AbstractWorker::pauseAllThread()
     for (auto worker : threadCopyWorker) {
         worker->pause();
     }
+    for (auto worker : chunkCopyWorker) {
+        worker->pause();
+    }
 }
 
 void AbstractWorker::stopAllThread()
@@ -509,6 +529,9 @@ void AbstractWorker::stopAllThread()
     for (auto worker : threadCopyWorker) {
         worker->stop();
     }
+    for (auto worker : chunkCopyWorker) {
+        worker->stop();
+    }
 
     stop();
 }
@@ -619,14 +642,7 @@ AbstractWorker::AbstractWorker(QObject *parent)
  */
 QString AbstractWorker::formatFileName(const QString &fileName)
 {
-    // 获取目标文件的文件系统，是vfat格式是否要特殊处理，以前的文管处理的
-    if (workData && workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kDontFormatFileName)) {
-        return fileName;
-    }
-
-    const QString &fs_type = QStorageInfo(targetUrl.path()).fileSystemType();
-
-    if (fs_type == "vfat") {
+    if (needFormatFileName()) {
         QString new_name = fileName;
 
         return new_name.replace(QRegularExpression("[\"*:<>?\\|]"), "_");
@@ -635,6 +651,20 @@ QString AbstractWorker::formatFileName(const QString &fileName)
     return fileName;
 }
 
+/*!
+ * \brief AbstractWorker::needFormatFileName Whether formatFileName may change names on the target
+ * \return true if the target is vfat and the job does not keep names as they are
+ */
+bool AbstractWorker::needFormatFileName()
+{
+    // 获取目标文件的文件系统，是vfat格式是否要特殊处理，以前的文管处理的
+    if (workData && workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kDontFormatFileName))
+        return false;
+
+    const QString &fs_type = QStorageInfo(targetUrl.path()).fileSystemType();
+    return fs_type == "vfat";
+}
+
 void AbstractWorker::saveOperations()
 {
     if (!isConvert && !completeTargetFiles.isEmpty()) {
@@ -39,9 +39,8 @@ class AbstractWorker : public QObject
 
 public:
     enum class CountWriteSizeType : quint8 {
-        kTidType,   // Read thread IO write size 使用 /pric/[pid]/task/[tid]/io 文件中的的 writeBytes 字段的值作为判断已写入数据的依据
-        kWriteBlockType,   // Read write block device write block size
-        kCustomizeType
+        kWriteBlockType,   // Read write block device write block size, fallback for block device sync accounting
+        kCustomizeType   // Bytes counted by copy threads into WorkerData::currentWriteSize
     };
 
     enum class SyncType {
@@ -140,6 +139,7 @@ protected:
     void initHandleConnects(const JobHandlePointer handle);
     explicit AbstractWorker(QObject *parent = nullptr);
     QString formatFileName(const QString &fileName);
+    bool needFormatFileName();
     void saveOperations();
     bool isStopped();
     JobInfoPointer createCopyJobInfo(const QUrl &from, const QUrl &to,
@@ -198,10 +198,15 @@ public:
     QWaitCondition waitCondition;
     QMutex mutex;
     QVector<QSharedPointer<DoCopyFileWorker>> threadCopyWorker;
+    // 大文件分块拷贝专用，与线程池中排队的小文件任务互不共享状态，不需要先等线程池空闲
+    QVector<QSharedPointer<DoCopyFileWorker>> chunkCopyWorker;
     int threadCount { 4 };
     std::atomic_bool retry { false };
     QSharedPointer<QThreadPool> threadPool { nullptr };
-    static std::atomic_bool bigFileCopy;
+    // 所有任务同一时间只拷贝一个大文件，bigFileCopy 由 bigFileCopyMutex 保护，结束或停止时唤醒等待者
+    static bool bigFileCopy;
+    static QMutex bigFileCopyMutex;
+    static QWaitCondition bigFileCopyFinished;
     QAtomicInteger<qint64> bigFileSize { 0 };   // bigger than this is big file
     QElapsedTimer *speedtimer { nullptr };   // time eslape
     std::atomic_int64_t elapsed { 0 };
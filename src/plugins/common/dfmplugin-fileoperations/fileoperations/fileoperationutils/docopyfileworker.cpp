@@ -18,13 +18,30 @@
 #include <QWaitCondition>
 #include <QMutex>
 #include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 #include <fcntl.h>
 #include <zlib.h>
 #include <sys/mman.h>
+#include <sys/uio.h>
+#include <sys/ioctl.h>
+#include <sys/vfs.h>
+#include <linux/fs.h>
+#include <linux/magic.h>
 #include <unistd.h>
 
+#ifdef DFM_ENABLE_IO_URING
+#    include <liburing.h>
+#endif
+
 static const quint32 kMaxBufferLength { 1024 * 1024 * 1 };
+static const int kIoUringQueueDepth { 8 };   // requests in flight for one file
+static const qint64 kIoUringMinFileSize { kMaxBufferLength * 4 };   // small files gain nothing from pipelining
+static const qint64 kMinChunkSize { 64 * 1024 * 1024 };   // smallest range of a chunk parallel copy
+static const size_t kOffloadBlockSize { 1024 * 1024 * 1024 };   // copy_file_range length for server side copy
+static const __fsword_t kCifsMagicNumber { static_cast<__fsword_t>(0xFF534D42) };
+static const __fsword_t kSmb2MagicNumber { static_cast<__fsword_t>(0xFE534D42) };
 
 DPFILEOPERATIONS_USE_NAMESPACE
 USING_IO_NAMESPACE
@@ -76,9 +93,10 @@ void DoCopyFileWorker::operateAction(const AbstractJobHandler::SupportAction act
     currentAction = action;
     resume();
 }
-void DoCopyFileWorker::doFileCopy(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo)
+void DoCopyFileWorker::doFileCopy(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, const bool tryClone)
 {
-    doDfmioFileCopy(fromInfo, toInfo, nullptr);
+    if (!tryClone || !doCloneFile(fromInfo, toInfo))
+        doDfmioFileCopy(fromInfo, toInfo, nullptr);
     workData->completeFileCount++;
 }
 
@@ -134,9 +152,8 @@ bool DoCopyFileWorker::doDfmioFileCopy(const DFileInfoPointer fromInfo,
     fileOps.removeOneByLock(op);
     auto fromSize = fromInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong();
     if (!actionOperating(action, fromSize <= 0 ? FileUtils::getMemoryPageSize() : fromSize, skip))
-        workData->currentWriteSize -= workData->everyFileWriteSize.value(fromUrl);
+        workData->currentWriteSize -= data->lastWriteSize;
 
-    workData->everyFileWriteSize.remove(fromUrl);
     delete data;
     toInfo->initQuerier();
     if (toInfo->exists())
@@ -153,8 +170,33 @@ void DoCopyFileWorker::progressCallback(int64_t current, int64_t total, void *pr
     assert(data->data);
     if (total <= 0)
         data->data->zeroOrlinkOrDirWriteSize += FileUtils::getMemoryPageSize();
-    data->data->currentWriteSize += (current - data->data->everyFileWriteSize.value(data->copyFile));
-    data->data->everyFileWriteSize.insert(data->copyFile, current);
+    // every copy owns its ProgressData, only the shared counter is touched
+    data->data->currentWriteSize += (current - data->lastWriteSize);
+    data->lastWriteSize = current;
+}
+
+/*!
+ * \brief DoCopyFileWorker::isIoUringAvailable Check once whether the kernel allows io_uring
+ * io_uring may be compiled out, disabled by sysctl or blocked by seccomp
+ * \return true if a ring can be created
+ */
+bool DoCopyFileWorker::isIoUringAvailable()
+{
+#ifdef DFM_ENABLE_IO_URING
+    static const bool available = [] {
+        struct io_uring ring;
+        int ret = io_uring_queue_init(2, &ring, 0);
+        if (ret < 0) {
+            fmInfo() << "io_uring is unavailable, big files are copied by read/write loop - error:" << strerror(-ret);
+            return false;
+        }
+        io_uring_queue_exit(&ring);
+        return true;
+    }();
+    return available;
+#else
+    return false;
+#endif
 }
 
 /*!
@@ -212,6 +254,13 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFilePractically(const DFileInfo
     // read ahead source file
     readAheadSourceFile(fromInfo);
 
+    // Overlap source reads and target writes when io_uring is usable
+    if (workData->useIoUringCopy) {
+        auto nextDo = doCopyFileWithIoUring(fromInfo, toInfo, skip);
+        if (nextDo != NextDo::kDoCopyFallback)
+            return nextDo;
+    }
+
     // Check if we should use O_DIRECT mode (safe sync mode for local to external device)
     // Use the existing isSourceFileLocal and isTargetFileLocal from base worker
     bool useDirectMode = workData->exBlockSyncEveryWrite && !workData->isTargetFileLocal;
@@ -421,6 +470,273 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileWithDirectIO(const DFileInf
     return NextDo::kDoCopyNext;
 }
 
+/*!
+ * \brief DoCopyFileWorker::doCopyFileWithIoUring Copy file with several reads and writes in flight through io_uring
+ * Each slot owns an aligned buffer and cycles read -> write -> read, so the source device keeps
+ * reading while the target device is still writing the previous chunks.
+ * \param fromInfo Source file info
+ * \param toInfo Target file info
+ * \param skip Skip flag
+ * \return NextDo status, kDoCopyFallback if io_uring can not be used for this file
+ */
+DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileWithIoUring(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip)
+{
+#ifdef DFM_ENABLE_IO_URING
+    const qint64 fromSize = fromInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong();
+    if (!isIoUringAvailable() || fromSize < kIoUringMinFileSize)
+        return NextDo::kDoCopyFallback;
+
+    // 完整性校验（adler32）和预分配目标文件大小只在 doCopyFileTraditional 中实现
+    if (workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyIntegrityChecking)
+        || workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyResizeDestinationFile))
+        return NextDo::kDoCopyFallback;
+
+    struct Slot
+    {
+        char *buffer { nullptr };
+        off_t offset { 0 };
+        size_t length { 0 };
+        size_t done { 0 };
+        bool writing { false };
+    };
+
+    const QString &destPath = toInfo->uri().path();
+    int srcFd = openFileBySys(fromInfo, toInfo, O_RDONLY, skip);
+    if (srcFd < 0)
+        return NextDo::kDoCopyErrorAddCancel;
+
+    const bool useDirectMode = workData->exBlockSyncEveryWrite && !workData->isTargetFileLocal;
+    FileWriter writer = openDestinationFile(destPath, useDirectMode ? WriteMode::Direct : WriteMode::Normal);
+    if (writer.fd < 0) {
+        close(srcFd);
+        auto action = doHandleErrorAndWait(fromInfo->uri(), toInfo->uri(),
+                                           AbstractJobHandler::JobErrorType::kOpenError, true);
+        return actionToNextDo(action, fromSize, skip);
+    }
+    // 以下失败时回退到其他拷贝方式，它们都以 O_TRUNC 重新打开目标文件
+    auto closeFiles = [&]() {
+        close(srcFd);
+        close(writer.fd);
+    };
+
+    struct io_uring ring;
+    int ret = io_uring_queue_init(kIoUringQueueDepth * 2, &ring, 0);
+    if (ret < 0) {
+        fmWarning() << "io_uring init failed, fallback to normal copy - error:" << strerror(-ret);
+        closeFiles();
+        return NextDo::kDoCopyFallback;
+    }
+
+    // 缓冲区按实际打开的目标文件的对齐要求分配（O_DIRECT 需要）
+    const size_t chunkSize = kMaxBufferLength;
+    QVector<Slot> slots(kIoUringQueueDepth);
+    QVector<iovec> iovecs;
+    for (auto &slot : slots) {
+        slot.buffer = allocateAlignedBuffer(chunkSize, writer.alignment);
+        if (!slot.buffer)
+            break;
+        iovecs.append({ slot.buffer, chunkSize });
+    }
+    auto releaseRing = [&]() {
+        io_uring_queue_exit(&ring);
+        for (auto &slot : slots)
+            free(slot.buffer);
+    };
+    if (iovecs.size() != slots.size()) {
+        releaseRing();
+        closeFiles();
+        return NextDo::kDoCopyFallback;
+    }
+    // 注册缓冲区可以省去每次请求的内存锁定，但可能超出 RLIMIT_MEMLOCK 而注册失败
+    const bool fixedBuffers = io_uring_register_buffers(&ring, iovecs.data(), static_cast<unsigned>(iovecs.size())) == 0;
+
+    bool directModeActive = (writer.mode == WriteMode::Direct);
+
+    int inFlight = 0;
+    int pending = 0;
+    off_t nextOffset = 0;
+    qint64 copied = 0;
+    qint64 written = 0;
+    bool success = true;
+
+    auto queueOp = [&](int index) {
+        io_uring_sqe *sqe = io_uring_get_sqe(&ring);
+        // ring 的容量是槽位数的两倍，每个槽位同时最多只有一个请求
+        Q_ASSERT(sqe);
+        Slot &slot = slots[index];
+        char *data = slot.buffer + slot.done;
+        const unsigned length = static_cast<unsigned>(slot.length - slot.done);
+        const __u64 offset = static_cast<__u64>(slot.offset) + slot.done;
+        if (slot.writing) {
+            if (fixedBuffers)
+                io_uring_prep_write_fixed(sqe, writer.fd, data, length, offset, index);
+            else
+                io_uring_prep_write(sqe, writer.fd, data, length, offset);
+        } else {
+            if (fixedBuffers)
+                io_uring_prep_read_fixed(sqe, srcFd, data, length, offset, index);
+            else
+                io_uring_prep_read(sqe, srcFd, data, length, offset);
+        }
+        io_uring_sqe_set_data(sqe, reinterpret_cast<void *>(static_cast<uintptr_t>(index)));
+        ++inFlight;
+        ++pending;
+    };
+    auto startRead = [&](int index) {
+        if (nextOffset >= fromSize)
+            return;
+        Slot &slot = slots[index];
+        slot.offset = nextOffset;
+        slot.length = static_cast<size_t>(qMin(static_cast<qint64>(chunkSize), fromSize - nextOffset));
+        slot.done = 0;
+        slot.writing = false;
+        nextOffset += static_cast<off_t>(slot.length);
+        queueOp(index);
+    };
+    auto drainInFlight = [&]() {
+        io_uring_submit(&ring);
+        while (inFlight > 0) {
+            io_uring_cqe *cqe = nullptr;
+            if (io_uring_wait_cqe(&ring, &cqe) < 0)
+                continue;
+            io_uring_cqe_seen(&ring, cqe);
+            --inFlight;
+        }
+        pending = 0;
+    };
+
+    while (copied < fromSize) {
+        if (inFlight == 0) {
+            // 此时所有槽位都空闲，可以安全地阻塞等待暂停结束或停止
+            if (state == kPaused) {
+                if (!handlePauseResume(writer, destPath, skip)) {
+                    // 等待前已经关闭了目标文件
+                    writer.fd = -1;
+                    success = false;
+                    break;
+                }
+                directModeActive = (writer.mode == WriteMode::Direct);
+            }
+            if (isStopped()) {
+                success = false;
+                break;
+            }
+            for (int i = 0; i < slots.size(); ++i)
+                startRead(i);
+            if (inFlight == 0) {
+                success = false;
+                break;
+            }
+        }
+
+        if (pending > 0) {
+            io_uring_submit(&ring);
+            pending = 0;
+        }
+
+        io_uring_cqe *cqe = nullptr;
+        ret = io_uring_wait_cqe(&ring, &cqe);
+        if (ret == -EINTR)
+            continue;
+        if (ret < 0) {
+            fmWarning() << "io_uring wait failed - file:" << destPath << "error:" << strerror(-ret);
+            success = false;
+            break;
+        }
+        const int index = static_cast<int>(reinterpret_cast<uintptr_t>(io_uring_cqe_get_data(cqe)));
+        const int res = cqe->res;
+        io_uring_cqe_seen(&ring, cqe);
+        --inFlight;
+
+        Slot &slot = slots[index];
+        if (res > 0) {
+            slot.done += static_cast<size_t>(res);
+            if (slot.writing) {
+                written += res;
+                workData->currentWriteSize += res;
+            }
+            if (slot.done < slot.length) {
+                // 读写不完整，继续处理本块剩余的部分
+                queueOp(index);
+            } else if (!slot.writing) {
+                slot.writing = true;
+                slot.done = 0;
+                queueOp(index);
+            } else {
+                copied += static_cast<qint64>(slot.length);
+                // 暂停或停止时不再提交新的读请求，等待已提交的请求全部完成
+                if (state == kNormal)
+                    startRead(index);
+            }
+            continue;
+        }
+
+        const int errorCode = res < 0 ? -res : 0;
+        if (errorCode == EINTR || errorCode == EAGAIN) {
+            queueOp(index);
+            continue;
+        }
+        if (slot.writing && directModeActive && errorCode == EINVAL) {
+            // 文件末尾未对齐的部分，与 doCopyFileWithDirectIO 一样去掉 O_DIRECT 后继续写入
+            int flags = fcntl(writer.fd, F_GETFL);
+            if (flags != -1 && fcntl(writer.fd, F_SETFL, flags & ~O_DIRECT) == 0) {
+                fmDebug() << "O_DIRECT write failed in io_uring copy, removing O_DIRECT flag - file:" << destPath;
+                directModeActive = false;
+                queueOp(index);
+                continue;
+            }
+        }
+
+        // 读取返回 0 说明拷贝过程中源文件被截断
+        const QString &errorMsg = errorCode != 0 ? QString(strerror(errorCode)) : tr("Unexpected end of file");
+        fmWarning() << "io_uring copy" << (slot.writing ? "write" : "read") << "error - from:" << fromInfo->uri()
+                    << "to:" << toInfo->uri() << "offset:" << slot.offset + static_cast<off_t>(slot.done) << "error:" << errorMsg;
+        // 显示对话框期间其他请求继续执行，完成事件保留在 ring 中
+        auto jobError = errorCode != 0 ? mapSystemErrorToJobError(errorCode, slot.writing)
+                                       : AbstractJobHandler::JobErrorType::kReadError;
+        auto action = doHandleErrorAndWait(fromInfo->uri(), toInfo->uri(), jobError, slot.writing, errorMsg);
+        if (action == AbstractJobHandler::SupportAction::kRetryAction && !isStopped()) {
+            checkRetry();
+            queueOp(index);
+            continue;
+        }
+
+        drainInFlight();
+        actionOperating(action, fromSize - written, skip);
+        success = false;
+        break;
+    }
+
+    if (inFlight > 0)
+        drainInFlight();
+
+    releaseRing();
+    close(srcFd);
+    if (writer.fd >= 0)
+        close(writer.fd);
+
+    if (!success) {
+        fmWarning() << "io_uring copy failed - from:" << fromInfo->uri() << "to:" << toInfo->uri();
+        return NextDo::kDoCopyErrorAddCancel;
+    }
+
+    setTargetPermissions(fromInfo->uri(), toInfo->uri());
+
+    if (!stateCheck())
+        return NextDo::kDoCopyErrorAddCancel;
+
+    toInfo->refresh();
+    FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileAdded, toInfo->uri());
+
+    return NextDo::kDoCopyNext;
+#else
+    Q_UNUSED(fromInfo);
+    Q_UNUSED(toInfo);
+    Q_UNUSED(skip);
+    return NextDo::kDoCopyFallback;
+#endif
+}
+
 /*!
  * \brief DoCopyFileWorker::doCopyFileTraditional Traditional copy implementation using DFMIO
  * \param fromInfo Source file info
@@ -538,8 +854,20 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileByRange(const DFileInfoPoin
         FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileAdded, toInfo->uri());
         return NextDo::kDoCopyNext;
     }
+    // btrfs/XFS share the extents of the source, no data is moved
+    if (tryCloneFile(sourcFd, targetFd, fromSize)) {
+        setTargetPermissions(fromInfo->uri(), toInfo->uri());
+        if (!stateCheck())
+            return NextDo::kDoCopyErrorAddCancel;
+        FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileAdded, toInfo->uri());
+        return NextDo::kDoCopyNext;
+    }
     // 循环读取和写入文件，拷贝
     size_t blockSize = static_cast<size_t>(fromSize > kMaxBufferLength ? kMaxBufferLength : fromSize);
+    // NFS/CIFS copy on the server side, hand over as much as possible in one call
+    const bool offload = supportCopyOffload(targetFd);
+    if (offload)
+        blockSize = qMin(kOffloadBlockSize, static_cast<size_t>(fromSize));
     off_t offset_in = 0;
     off_t offset_out = 0;
     size_t total = static_cast<size_t>(fromSize);
@@ -578,6 +906,9 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileByRange(const DFileInfoPoin
         if (!actionOperating(action, fromSize - offset_out, skip))
             return NextDo::kDoCopyErrorAddCancel;
     } while (offset_out != fromSize);
+    // only count the files the server really copied
+    if (offload)
+        workData->offloadFileCount++;
     // 对文件加权
     setTargetPermissions(fromInfo->uri(), toInfo->uri());
     if (!stateCheck())
@@ -587,6 +918,235 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileByRange(const DFileInfoPoin
     return NextDo::kDoCopyNext;
 }
 
+/*!
+ * \brief DoCopyFileWorker::doCopyFileByChunks Split one big file into ranges and copy them concurrently
+ * The target is sized up front, every chunk worker then copies its own range with ranged
+ * copy_file_range (or pread/pwrite) on shared fds. Progress still goes into the job's
+ * currentWriteSize, so the file is reported as one item.
+ * \param fromInfo Source file info
+ * \param toInfo Target file info
+ * \param pool Thread pool running the chunks
+ * \param chunkWorkers Workers copying the chunks, one chunk for each worker at most
+ * \param skip Skip flag
+ * \return NextDo status, kDoCopyFallback if the file is not worth splitting
+ */
+DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileByChunks(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo,
+                                                              QThreadPool *pool,
+                                                              const QVector<QSharedPointer<DoCopyFileWorker>> &chunkWorkers,
+                                                              bool *skip)
+{
+    if (isStopped())
+        return NextDo::kDoCopyErrorAddCancel;
+
+    const qint64 fromSize = fromInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong();
+    const int chunkCount = static_cast<int>(qMin(static_cast<qint64>(chunkWorkers.size()), fromSize / kMinChunkSize));
+    if (!pool || chunkCount < 2)
+        return NextDo::kDoCopyFallback;
+
+    emit currentTask(fromInfo->uri(), toInfo->uri());
+
+    int sourceFd = openFileBySys(fromInfo, toInfo, O_RDONLY, skip);
+    if (sourceFd < 0)
+        return NextDo::kDoCopyErrorAddCancel;
+    FinallyUtil releaseSc([&] {
+        close(sourceFd);
+    });
+    int targetFd = openFileBySys(fromInfo, toInfo, O_CREAT | O_WRONLY | O_TRUNC, skip, false);
+    if (targetFd < 0)
+        return NextDo::kDoCopyErrorAddCancel;
+    FinallyUtil releaseTg([&] {
+        close(targetFd);
+    });
+
+    if (tryCloneFile(sourceFd, targetFd, fromSize)) {
+        setTargetPermissions(fromInfo->uri(), toInfo->uri());
+        if (!stateCheck())
+            return NextDo::kDoCopyErrorAddCancel;
+        FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileAdded, toInfo->uri());
+        return NextDo::kDoCopyNext;
+    }
+
+    // size the target first, chunks must not race on extending the file
+    if (ftruncate(targetFd, fromSize) != 0) {
+        fmWarning() << "Resize target file for chunk copy failed, fallback - file:" << toInfo->uri() << "error:" << strerror(errno);
+        // the fallback creates the target itself, do not leave the empty file created here in its way
+        ::unlink(toInfo->uri().path().toLocal8Bit().constData());
+        return NextDo::kDoCopyFallback;
+    }
+
+    qint64 chunkSize = (fromSize + chunkCount - 1) / chunkCount;
+    chunkSize = ((chunkSize + kMaxBufferLength - 1) / kMaxBufferLength) * kMaxBufferLength;
+
+    std::vector<qint64> offsets;
+    std::vector<qint64> lengths;
+    for (int i = 0; i < chunkCount; ++i) {
+        const qint64 offset = i * chunkSize;
+        const qint64 length = qMin(chunkSize, fromSize - offset);
+        if (length <= 0)
+            break;
+        offsets.push_back(offset);
+        lengths.push_back(length);
+    }
+
+    // chunks never show dialogs: the first failing chunk records its error and stops the others,
+    // the error is reported once here and a retry resumes every chunk where it stopped
+    qint64 totalCopied = 0;
+    forever {
+        std::atomic_bool abort { false };
+        ChunkError error;
+        std::vector<qint64> copiedSizes(offsets.size(), 0);
+        QList<QFuture<NextDo>> futures;
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            if (lengths[i] <= 0)
+                continue;
+            const auto &chunkWorker = chunkWorkers.at(static_cast<int>(i));
+            const qint64 offset = offsets[i];
+            const qint64 length = lengths[i];
+            qint64 *copied = &copiedSizes[i];
+            futures.append(QtConcurrent::run(pool, [=, &abort, &error]() {
+                return chunkWorker->doCopyFileRangeChunk(sourceFd, targetFd, fromInfo, toInfo,
+                                                         offset, length, abort, copied, &error);
+            }));
+        }
+
+        bool failed = false;
+        for (auto &future : futures) {
+            future.waitForFinished();
+            failed = failed || future.result() != NextDo::kDoCopyNext;
+        }
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            offsets[i] += copiedSizes[i];
+            lengths[i] -= copiedSizes[i];
+            totalCopied += copiedSizes[i];
+        }
+
+        if (!failed)
+            break;
+
+        fmWarning() << "Chunk copy failed - from:" << fromInfo->uri() << "to:" << toInfo->uri() << "copied:" << totalCopied;
+        // stopped or paused into stop, nothing to report
+        if (!error.claimed || isStopped())
+            return NextDo::kDoCopyErrorAddCancel;
+
+        auto action = doHandleErrorAndWait(fromInfo->uri(), toInfo->uri(),
+                                           mapSystemErrorToJobError(error.code, error.isWrite),
+                                           error.isWrite, strerror(error.code));
+        if (action == AbstractJobHandler::SupportAction::kRetryAction && !isStopped()) {
+            checkRetry();
+            continue;
+        }
+
+        actionOperating(action, fromSize - totalCopied, skip);
+        return NextDo::kDoCopyErrorAddCancel;
+    }
+
+    setTargetPermissions(fromInfo->uri(), toInfo->uri());
+    if (!stateCheck())
+        return NextDo::kDoCopyErrorAddCancel;
+
+    toInfo->refresh();
+    FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileAdded, toInfo->uri());
+    return NextDo::kDoCopyNext;
+}
+
+/*!
+ * \brief DoCopyFileWorker::doCopyFileRangeChunk Copy one range of a file for doCopyFileByChunks
+ * Only positional I/O is used, the file offsets of the shared fds are never touched.
+ * \param srcFd Opened source fd
+ * \param dstFd Opened target fd
+ * \param fromInfo Source file info
+ * \param toInfo Target file info
+ * \param offset Start of the range
+ * \param length Length of the range
+ * \param abort Set when a chunk failed, stop copying as soon as possible
+ * \param copied Output parameter: bytes of the range written
+ * \param error The first error of all chunks, reported by doCopyFileByChunks
+ * \return NextDo status
+ */
+DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileRangeChunk(const int srcFd, const int dstFd,
+                                                                const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo,
+                                                                const qint64 offset, const qint64 length,
+                                                                std::atomic_bool &abort, qint64 *copied, ChunkError *error)
+{
+    off_t inOffset = offset;
+    off_t outOffset = offset;
+    const off_t end = offset + length;
+    bool useCopyRange = true;
+    QScopedArrayPointer<char> buffer;
+
+    while (outOffset < end) {
+        if (abort || !stateCheck())
+            return NextDo::kDoCopyErrorAddCancel;
+
+        const size_t blockSize = static_cast<size_t>(qMin(static_cast<qint64>(kMaxBufferLength), static_cast<qint64>(end - outOffset)));
+        ssize_t result = -1;
+        bool isWrite = true;
+        if (useCopyRange) {
+            result = copy_file_range(srcFd, &inOffset, dstFd, &outOffset, blockSize, 0);
+            if (result < 0 && shouldFallbackFromCopyFileRange(errno)) {
+                fmDebug() << "copy_file_range unsupported for chunk, use pread/pwrite - error:" << strerror(errno);
+                useCopyRange = false;
+                buffer.reset(new char[kMaxBufferLength]);
+                continue;
+            }
+            if (result == 0) {
+                // source file has been truncated
+                errno = EIO;
+                result = -1;
+                isWrite = false;
+            }
+        } else {
+            result = pread(srcFd, buffer.data(), blockSize, inOffset);
+            isWrite = false;
+            if (result == 0) {
+                errno = EIO;
+                result = -1;
+            }
+            ssize_t writeSize = 0;
+            while (result > 0 && writeSize < result) {
+                ssize_t ret = pwrite(dstFd, buffer.data() + writeSize, static_cast<size_t>(result - writeSize), outOffset + writeSize);
+                if (ret < 0 && errno == EINTR)
+                    continue;
+                if (ret < 0) {
+                    result = -1;
+                    isWrite = true;
+                    break;
+                }
+                writeSize += ret;
+            }
+            if (result > 0) {
+                inOffset += result;
+                outOffset += result;
+            }
+        }
+
+        if (result > 0) {
+            workData->currentWriteSize += result;
+            if (copied)
+                *copied += result;
+            continue;
+        }
+
+        if (errno == EINTR)
+            continue;
+
+        const int savedErrno = errno;
+        fmWarning() << "Chunk copy error - from:" << fromInfo->uri() << "to:" << toInfo->uri()
+                    << "offset:" << outOffset << "error:" << strerror(savedErrno);
+        // only the first error is kept, the futures are joined before it is read
+        if (error && !error->claimed.exchange(true)) {
+            error->code = savedErrno;
+            error->isWrite = isWrite;
+        }
+
+        // tell the other chunks of this file to stop
+        abort = true;
+        return NextDo::kDoCopyErrorAddCancel;
+    }
+
+    return NextDo::kDoCopyNext;
+}
+
 bool DoCopyFileWorker::stateCheck()
 {
     if (state == kPaused)
@@ -1254,6 +1814,86 @@ bool DoCopyFileWorker::shouldFallbackFromCopyFileRange(int errorCode) const
     }
 }
 
+/*!
+ * \brief DoCopyFileWorker::tryCloneFile Make the target share the extents of the source by FICLONE
+ * The whole size is reported to the progress at once, the clone is finished when the ioctl returns.
+ * \param srcFd Opened source fd
+ * \param dstFd Opened target fd
+ * \param fromSize Size of the source file
+ * \return true if the file has been cloned
+ */
+bool DoCopyFileWorker::tryCloneFile(const int srcFd, const int dstFd, const qint64 fromSize)
+{
+    if (fromSize <= 0 || workData->cloneUnsupported)
+        return false;
+
+    if (ioctl(dstFd, FICLONE, srcFd) != 0) {
+        const int savedErrno = errno;
+        // EXDEV or EINVAL depends on the source file, only stop trying when the file system can not clone at all
+        if (savedErrno == EOPNOTSUPP || savedErrno == ENOTTY)
+            workData->cloneUnsupported = true;
+        fmDebug() << "FICLONE not used - error:" << strerror(savedErrno);
+        return false;
+    }
+
+    workData->currentWriteSize += fromSize;
+    workData->cloneFileCount++;
+    workData->cloneFileSize += fromSize;
+    return true;
+}
+
+/*!
+ * \brief DoCopyFileWorker::doCloneFile Copy a small file by FICLONE, without any error dialog
+ * On failure the file is left to the normal copy, which overwrites the empty target created here.
+ * \param fromInfo Source file info
+ * \param toInfo Target file info
+ * \return true if the file has been cloned
+ */
+bool DoCopyFileWorker::doCloneFile(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo)
+{
+    const qint64 fromSize = fromInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong();
+    if (fromSize <= 0 || workData->cloneUnsupported || !stateCheck())
+        return false;
+
+    int srcFd = open(fromInfo->uri().path().toLocal8Bit().constData(), O_RDONLY);
+    if (srcFd < 0)
+        return false;
+    FinallyUtil releaseSc([&] {
+        close(srcFd);
+    });
+    int dstFd = open(toInfo->uri().path().toLocal8Bit().constData(), O_CREAT | O_WRONLY | O_TRUNC, 0666);
+    if (dstFd < 0)
+        return false;
+    FinallyUtil releaseTg([&] {
+        close(dstFd);
+    });
+
+    emit currentTask(fromInfo->uri(), toInfo->uri());
+    if (!tryCloneFile(srcFd, dstFd, fromSize))
+        return false;
+
+    setTargetPermissions(fromInfo->uri(), toInfo->uri());
+    toInfo->initQuerier();
+    FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileAdded, toInfo->uri());
+    return true;
+}
+
+/*!
+ * \brief DoCopyFileWorker::supportCopyOffload Check whether copy_file_range is done by the server of the target
+ * \param dstFd Opened target fd
+ * \return true if the target is on NFS or CIFS/SMB
+ */
+bool DoCopyFileWorker::supportCopyOffload(const int dstFd) const
+{
+    struct statfs fs;
+    if (fstatfs(dstFd, &fs) != 0)
+        return false;
+
+    return fs.f_type == NFS_SUPER_MAGIC
+            || fs.f_type == kCifsMagicNumber
+            || fs.f_type == kSmb2MagicNumber;
+}
+
 /*!
  * \brief DoCopyFileWorker::mapSystemErrorToJobError Map system errno to JobErrorType
  * \param systemErrno System error number
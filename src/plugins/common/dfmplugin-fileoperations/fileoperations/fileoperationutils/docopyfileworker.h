@@ -16,11 +16,13 @@
 #include <dfm-io/doperator.h>
 
 #include <QObject>
+#include <QVector>
 
 #include <fcntl.h>
 
 class QWaitCondition;
 class QMutex;
+class QThreadPool;
 USING_IO_NAMESPACE
 DPFILEOPERATIONS_BEGIN_NAMESPACE
 DFMBASE_USE_NAMESPACE
@@ -47,6 +49,7 @@ public:
     {
         QUrl copyFile;
         QSharedPointer<WorkerData> data { nullptr };
+        qint64 lastWriteSize { 0 };   // size reported by the last callback of this file
     };
 
     enum class WriteMode {
@@ -64,6 +67,14 @@ public:
             : fd(fd), mode(mode), alignment(4096) { }   // 4K alignment for O_DIRECT
     };
 
+    // first error of a chunked copy, chunks only record it and doCopyFileByChunks reports it once
+    struct ChunkError
+    {
+        std::atomic_bool claimed { false };
+        int code { 0 };
+        bool isWrite { false };
+    };
+
 public:
     explicit DoCopyFileWorker(const QSharedPointer<WorkerData> &data, QObject *parent = nullptr);
     ~DoCopyFileWorker() override;
@@ -78,14 +89,27 @@ public:
     // O_DIRECT copy for safe sync mode
     [[nodiscard]] NextDo doCopyFileWithDirectIO(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo,
                                                 bool *skip);
+    // io_uring pipelined copy, return kDoCopyFallback when io_uring can not be used
+    [[nodiscard]] NextDo doCopyFileWithIoUring(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo,
+                                               bool *skip);
     // Traditional DFMIO copy
     [[nodiscard]] NextDo doCopyFileTraditional(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo,
                                                bool *skip);
     // normal copy
     [[nodiscard]] NextDo doCopyFileByRange(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo,
                                            bool *skip);
-    // small file copy
-    void doFileCopy(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo);
+    // big file copy, ranges of one file are copied concurrently by chunkWorkers on pool
+    [[nodiscard]] NextDo doCopyFileByChunks(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo,
+                                            QThreadPool *pool,
+                                            const QVector<QSharedPointer<DoCopyFileWorker>> &chunkWorkers,
+                                            bool *skip);
+    // copy [offset, offset + length) of an opened file, safe to run on several threads with the same fds
+    [[nodiscard]] NextDo doCopyFileRangeChunk(const int srcFd, const int dstFd,
+                                              const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo,
+                                              const qint64 offset, const qint64 length,
+                                              std::atomic_bool &abort, qint64 *copied, ChunkError *error);
+    // small file copy, tryClone when source and target are on the same file system
+    void doFileCopy(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, const bool tryClone = false);
     // copy file by dfmio
     bool doDfmioFileCopy(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip);
 signals:
@@ -147,10 +171,14 @@ private:   // file copy
     bool handlePauseResume(FileWriter &writer, const QString &dest, bool *skip);
     NextDo actionToNextDo(AbstractJobHandler::SupportAction action, qint64 size, bool *skip);
     bool shouldFallbackFromCopyFileRange(int errorCode) const;
+    bool tryCloneFile(const int srcFd, const int dstFd, const qint64 fromSize);
+    bool doCloneFile(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo);
+    bool supportCopyOffload(const int dstFd) const;
     AbstractJobHandler::JobErrorType mapSystemErrorToJobError(int systemErrno, bool isWriteError);
 
 public:
     static void progressCallback(int64_t current, int64_t total, void *progressData);
+    static bool isIoUringAvailable();
 
 private:
     QSharedPointer<QWaitCondition> waitCondition { nullptr };
@@ -7,6 +7,7 @@
 #include "filenameutils.h"
 #include "fileoperations/fileoperationutils/fileoperationsutils.h"
 #include "workerdata.h"
+#include "smallfilebatchcopier.h"
 
 #include <dfm-base/interfaces/abstractdiriterator.h>
 #include <dfm-base/base/schemefactory.h>
@@ -14,6 +15,7 @@
 #include <dfm-base/base/device/deviceproxymanager.h>
 #include <dfm-base/file/local/localfilehandler.h>
 #include <dfm-base/utils/protocolutils.h>
+#include <dfm-base/utils/finallyutil.h>
 
 #include <dfm-io/dfmio_utils.h>
 #include <dfm-io/denumerator.h>
@@ -27,7 +29,6 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <zlib.h>
-#include <syscall.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
 #include <sys/sysmacros.h>
@@ -38,6 +39,11 @@
 DPFILEOPERATIONS_USE_NAMESPACE
 USING_IO_NAMESPACE
 
+static constexpr double kSpeedSmoothingFactor { 0.3 };   // weight of the newest sample in the speed EWMA
+static constexpr qint64 kChunkParallelCopySize { 512 * 1024 * 1024 };   // split files bigger than this across the thread pool
+static constexpr qint64 kSmallFileBatchSize { 128 * 1024 };   // files not bigger than this are copied by directory batch
+static constexpr qint64 kSmallFileBatchArenaSize { 8 * 1024 * 1024 };   // buffer shared by one batch group
+
 /*!
  * \brief 为文件操作准备替换目标
  *
@@ -124,6 +130,8 @@ FileOperateBaseWorker::FileOperateBaseWorker(QObject *parent)
 
 FileOperateBaseWorker::~FileOperateBaseWorker()
 {
+    if (targetSysStatFd >= 0)
+        close(targetSysStatFd);
 }
 /*!
  * \brief FileOperateBaseWorker::doHandleErrorAndWait Handle the error and block waiting for the error handling operation to return
@@ -176,9 +184,20 @@ void FileOperateBaseWorker::emitSpeedUpdatedNotify(const qint64 &writSize)
         elTime += elapsed;
     }
 
-    qint64 speed = currentState == AbstractJobHandler::JobState::kRunningState
-            ? writSize * 1000 / (elTime)
-            : 0;
+    qint64 speed = 0;
+    if (currentState == AbstractJobHandler::JobState::kRunningState) {
+        if (lastSpeedSampleTime <= 0 || elTime <= lastSpeedSampleTime || writSize < lastSpeedSampleSize) {
+            // first sample or the job restarted counting, start from the average speed
+            smoothedSpeed = static_cast<double>(writSize) * 1000 / elTime;
+        } else {
+            const double currentSpeed = static_cast<double>(writSize - lastSpeedSampleSize) * 1000
+                    / (elTime - lastSpeedSampleTime);
+            smoothedSpeed = kSpeedSmoothingFactor * currentSpeed + (1 - kSpeedSmoothingFactor) * smoothedSpeed;
+        }
+        lastSpeedSampleSize = writSize;
+        lastSpeedSampleTime = elTime;
+        speed = static_cast<qint64>(smoothedSpeed);
+    }
     info->insert(AbstractJobHandler::NotifyInfoKey::kJobtypeKey, QVariant::fromValue(jobType));
     info->insert(AbstractJobHandler::NotifyInfoKey::kJobStateKey, QVariant::fromValue(currentState));
     info->insert(AbstractJobHandler::NotifyInfoKey::kSpeedKey, QVariant::fromValue(speed));
@@ -701,16 +720,25 @@ bool FileOperateBaseWorker::checkAndCopyFile(const DFileInfoPointer fromInfo, co
 
     // 使用统一的判断接口（替换原来的内联判断）
     if (shouldUseMultiThreadCopy(fromInfo)) {
-        while (bigFileCopy && !isStopped()) {
-            QThread::msleep(10);
+        if (fromSize >= kChunkParallelCopySize) {
+            if (!beginBigFileCopy())
+                return false;
+            FinallyUtil finished([this]() { endBigFileCopy(); });
+            return doCopyLocalByChunks(fromInfo, toInfo, skip);
         }
-        if (fromSize > bigFileSize && FileUtils::isSameMountPoint(fromInfo->uri(), targetUrl)) {
-            bigFileCopy = true;
-            auto result = doCopyLocalByRange(fromInfo, toInfo, skip);
-            bigFileCopy = false;
-            return result;
+        // the mount lookup is skipped once the target file system refused FICLONE
+        const bool sameMount = (fromSize > bigFileSize || !workData->cloneUnsupported)
+                && FileUtils::isSameMountPoint(fromInfo->uri(), targetUrl);
+        if (fromSize > bigFileSize && sameMount) {
+            if (!beginBigFileCopy())
+                return false;
+            FinallyUtil finished([this]() { endBigFileCopy(); });
+            return doCopyLocalByRange(fromInfo, toInfo, skip);
         }
-        return doCopyLocalFile(fromInfo, toInfo);
+        if (!waitBigFileCopy())
+            return false;
+        // small files on the same file system try FICLONE first as well
+        return doCopyLocalFile(fromInfo, toInfo, sameMount);
     }
 
     // copy other file or cut file
@@ -791,6 +819,11 @@ bool FileOperateBaseWorker::checkAndCopyDir(const DFileInfoPointer &fromInfo, co
         return false;
     }
 
+    // 小文件先按目录批量复制，剩下的文件（目标已存在、出错等）再逐个处理
+    QSet<QByteArray> batchCopied;
+    if (shouldUseSmallFileBatch(fromInfo))
+        batchCopied = doCopySmallFilesBatch(fromInfo, toInfo);
+
     bool self = true;
     iterator->setProperty("QueryAttributes", "standard::name");
     while (iterator->hasNext()) {
@@ -799,6 +832,8 @@ bool FileOperateBaseWorker::checkAndCopyDir(const DFileInfoPointer &fromInfo, co
         }
 
         const QUrl &url = iterator->next();
+        if (!batchCopied.isEmpty() && batchCopied.contains(SmallFileBatchCopier::fileName(url)))
+            continue;
         DFileInfoPointer info(new DFileInfo(url));
         info->initQuerier();
         bool ok = doCopyFile(info, toInfo, skip);
@@ -871,6 +906,92 @@ bool FileOperateBaseWorker::shouldUseMultiThreadCopy(const DFileInfoPointer &fro
     return true;
 }
 
+/*!
+ * \brief FileOperateBaseWorker::shouldUseSmallFileBatch 判断目录下的小文件是否可以批量复制
+ *
+ * 批量复制直接使用系统调用读写本地文件，只用于本地到本地的复制；
+ * 回收站中的文件需要还原原始名称，不走批量复制。
+ *
+ * \param fromInfo 源目录信息
+ * \return true 表示先批量复制目录下的小文件
+ */
+bool FileOperateBaseWorker::shouldUseSmallFileBatch(const DFileInfoPointer &fromInfo) const
+{
+    if (!workData->useSmallFileBatchCopy)
+        return false;
+
+    if (jobType != AbstractJobHandler::JobType::kCopyType)
+        return false;
+
+    if (!isSourceFileLocal || !isTargetFileLocal)
+        return false;
+
+    return !FileUtils::isTrashFile(fromInfo->uri());
+}
+
+/*!
+ * \brief FileOperateBaseWorker::doCopySmallFilesBatch 批量复制目录下的小文件
+ *
+ * 一次读出整个目录并批量获取文件属性，把小文件读入同一块内存后集中写出，
+ * 省去逐个文件的 DFileInfo 查询和预读。doCheckFile 中的检查在这里对应为：
+ * 源文件只取普通文件，目标冲突由 O_EXCL 排除，名称需要格式化的文件和空间不足时
+ * 剩下的文件都留给原流程；写出前同样追踪未完成文件并设置目标的预期大小。
+ *
+ * \param fromInfo 源目录信息
+ * \param toInfo 目标目录信息（已创建）
+ * \return 已经复制完成的文件名（文件系统原始编码），调用方不再处理这些文件
+ */
+QSet<QByteArray> FileOperateBaseWorker::doCopySmallFilesBatch(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo)
+{
+    QSet<QByteArray> copied;
+    SmallFileBatchCopier copier(fromInfo->uri().path(), toInfo->uri().path());
+
+    // 目标为 vfat 时名称中的非法字符需要替换，这些文件按原流程处理
+    const bool formatNames = needFormatFileName();
+    const auto accept = [this, formatNames](const QByteArray &name) {
+        if (!formatNames)
+            return true;
+        const QString &fileName = QFile::decodeName(name);
+        return formatFileName(fileName) == fileName;
+    };
+    if (!copier.scan(kSmallFileBatchSize, accept) || copier.entries().isEmpty())
+        return copied;
+    // 与逐个拷贝时 setTargetPermissions 的判断一致
+    copier.setPreserveAttributes(DeviceUtils::supportSetPermissionsDevice(toInfo->uri()));
+
+    const QString targetDir = toInfo->uri().path();
+    const auto targetUrlOf = [&targetDir](const SmallFileBatchCopier::Entry &entry) {
+        return QUrl::fromLocalFile(targetDir + "/" + QFile::decodeName(entry.name));
+    };
+    const auto names = copier.copy(
+            kSmallFileBatchArenaSize,
+            [this]() { return stateCheck(); },
+            [this, &targetUrlOf](const SmallFileBatchCopier::Entry &entry) {
+                const QUrl &url = targetUrlOf(entry);
+                cleanupManager.trackIncompleteFile(url);
+                setExpectedSizeForTarget(url, entry.size);
+            },
+            [this, &targetUrlOf](const SmallFileBatchCopier::Entry &entry) {
+                if (entry.size <= 0)
+                    workData->zeroOrlinkOrDirWriteSize += FileUtils::getMemoryPageSize();
+                else
+                    workData->currentWriteSize += entry.size;
+                workData->completeFileCount++;
+
+                const QUrl &url = targetUrlOf(entry);
+                cleanupManager.confirmCompleted(url);
+                FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileAdded, url);
+                emit fileAdded(url);
+            });
+
+    for (const QByteArray &name : names)
+        copied.insert(name);
+
+    fmDebug() << "Batch copied" << copied.size() << "of" << copier.entries().size()
+              << "small files in" << fromInfo->uri();
+    return copied;
+}
+
 /*!
  * \brief FileOperateBaseWorker::applyAllPendingReplacements 批量应用所有待处理的替换
  *
@@ -906,15 +1027,47 @@ bool FileOperateBaseWorker::applyAllPendingReplacements()
     return allSuccess;
 }
 
+/*!
+ * \brief FileOperateBaseWorker::waitBigFileCopy Wait until no job is copying a big file
+ * \return false if the job was stopped while waiting
+ */
+bool FileOperateBaseWorker::waitBigFileCopy()
+{
+    QMutexLocker locker(&bigFileCopyMutex);
+    while (bigFileCopy && !isStopped())
+        bigFileCopyFinished.wait(&bigFileCopyMutex);
+    return !isStopped();
+}
+
+/*!
+ * \brief FileOperateBaseWorker::beginBigFileCopy Wait for the running big file copy and mark this one as running
+ * \return false if the job was stopped while waiting, endBigFileCopy must not be called then
+ */
+bool FileOperateBaseWorker::beginBigFileCopy()
+{
+    QMutexLocker locker(&bigFileCopyMutex);
+    while (bigFileCopy && !isStopped())
+        bigFileCopyFinished.wait(&bigFileCopyMutex);
+    if (isStopped())
+        return false;
+    bigFileCopy = true;
+    return true;
+}
+
+void FileOperateBaseWorker::endBigFileCopy()
+{
+    QMutexLocker locker(&bigFileCopyMutex);
+    bigFileCopy = false;
+    bigFileCopyFinished.wakeAll();
+}
+
 void FileOperateBaseWorker::waitThreadPoolOver()
 {
-    // wait all thread start
-    if (!isStopped() && threadPool) {
-        QThread::msleep(10);
-    }
-    // wait thread pool copy local file or copy big file over
-    while (threadPool && threadPool->activeThreadCount() > 0) {
-        QThread::msleep(10);
+    // wait thread pool copy local file over, the last task wakes us up
+    {
+        QMutexLocker locker(&copyTaskMutex);
+        while (pendingCopyTasks > 0)
+            copyTaskFinished.wait(&copyTaskMutex);
     }
 
     // 等待完成后，批量执行所有延迟的替换操作
@@ -950,7 +1103,10 @@ void FileOperateBaseWorker::initCopyWay()
         initThreadCopy();
     }
 
-    copyTid = (countWriteType == CountWriteSizeType::kTidType) ? syscall(SYS_gettid) : -1;
+    workData->useIoUringCopy = FileOperationsUtils::ioUringCopy() && DoCopyFileWorker::isIoUringAvailable();
+    fmDebug() << "io_uring copy engine:" << (workData->useIoUringCopy ? "enabled" : "disabled");
+
+    workData->useSmallFileBatchCopy = FileOperationsUtils::smallFileBatchCopy();
 }
 
 /*!
@@ -1046,6 +1202,10 @@ void FileOperateBaseWorker::initThreadCopy()
         connect(copy.data(), &DoCopyFileWorker::currentTask, this, &FileOperateBaseWorker::emitCurrentTaskNotify, Qt::DirectConnection);
         connect(copy.data(), &DoCopyFileWorker::retryErrSuccess, this, &FileOperateBaseWorker::retryErrSuccess, Qt::DirectConnection);
         threadCopyWorker.append(copy);
+
+        QSharedPointer<DoCopyFileWorker> chunk(new DoCopyFileWorker(workData));
+        connect(chunk.data(), &DoCopyFileWorker::retryErrSuccess, this, &FileOperateBaseWorker::retryErrSuccess, Qt::DirectConnection);
+        chunkCopyWorker.append(chunk);
     }
 
     threadPool.reset(new QThreadPool);
@@ -1075,13 +1235,22 @@ QUrl FileOperateBaseWorker::createNewTargetUrl(const DFileInfoPointer &toInfo, c
     return newTargetUrl;
 }
 
-bool FileOperateBaseWorker::doCopyLocalFile(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo)
+bool FileOperateBaseWorker::doCopyLocalFile(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, const bool tryClone)
 {
     if (!stateCheck())
         return false;
 
-    threadPool->start([this, fromInfo, toInfo]() {
-        threadCopyWorker[threadCopyFileCount % threadCount]->doFileCopy(fromInfo, toInfo);
+    {
+        QMutexLocker locker(&copyTaskMutex);
+        ++pendingCopyTasks;
+    }
+    threadPool->start([this, fromInfo, toInfo, tryClone]() {
+        FinallyUtil finished([this]() {
+            QMutexLocker locker(&copyTaskMutex);
+            if (--pendingCopyTasks == 0)
+                copyTaskFinished.wakeAll();
+        });
+        threadCopyWorker[threadCopyFileCount % threadCount]->doFileCopy(fromInfo, toInfo, tryClone);
     });
 
     threadCopyFileCount++;
@@ -1090,7 +1259,7 @@ bool FileOperateBaseWorker::doCopyLocalFile(const DFileInfoPointer fromInfo, con
 
 bool FileOperateBaseWorker::doCopyLocalByRange(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip)
 {
-    waitThreadPoolOver();
+    // 在当前线程中拷贝，不占用线程池，排队中的小文件任务继续执行
     initSignalCopyWorker();
     const QString &targetUrl = toInfo->uri().toString();
 
@@ -1126,6 +1295,35 @@ bool FileOperateBaseWorker::doCopyLocalByRange(const DFileInfoPointer fromInfo,
     }
 }
 
+/*!
+ * \brief FileOperateBaseWorker::doCopyLocalByChunks Copy one big local file with all threads of the pool
+ * \param fromInfo File information of source file
+ * \param toInfo File information of target file
+ * \param skip Output parameter: whether skip
+ * \return Whether the file is copied successfully
+ */
+bool FileOperateBaseWorker::doCopyLocalByChunks(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip)
+{
+    // the chunks run on dedicated workers and only their own jobs are waited for,
+    // small files already queued in the pool keep going
+    initSignalCopyWorker();
+    const QUrl &targetFileUrl = toInfo->uri();
+
+    FileUtils::cacheCopyingFileUrl(targetFileUrl);
+    DoCopyFileWorker::NextDo nextDo = copyOtherFileWorker->doCopyFileByChunks(fromInfo, toInfo, threadPool.data(),
+                                                                              chunkCopyWorker, skip);
+    FileUtils::removeCopyingFileUrl(targetFileUrl);
+
+    if (nextDo == DoCopyFileWorker::NextDo::kDoCopyFallback) {
+        fmDebug() << "Chunk copy not used, fallback to single thread copy - from:" << fromInfo->uri();
+        if (FileUtils::isSameMountPoint(fromInfo->uri(), targetUrl))
+            return doCopyLocalByRange(fromInfo, toInfo, skip);
+        return doCopyLocalFile(fromInfo, toInfo);
+    }
+
+    return nextDo == DoCopyFileWorker::NextDo::kDoCopyNext;
+}
+
 bool FileOperateBaseWorker::doCopyOtherFile(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip)
 {
     initSignalCopyWorker();
@@ -1335,20 +1533,13 @@ qint64 FileOperateBaseWorker::getWriteDataSize()
     if (!workData)
         return writeSize;
 
-    if (CountWriteSizeType::kTidType == countWriteType) {
-        writeSize = getTidWriteSize();
-
-        if (writeSize > workData->currentWriteSize && workData->currentWriteSize > 0) {
-            writeSize = workData->currentWriteSize;
-        }
-        if (writeSize <= 0)
-            writeSize = workData->currentWriteSize;
-    } else if (CountWriteSizeType::kCustomizeType == countWriteType) {
-        writeSize = workData->currentWriteSize;
-    } else if (CountWriteSizeType::kWriteBlockType == countWriteType) {
+    if (CountWriteSizeType::kWriteBlockType == countWriteType) {
         qint64 currentSectorsWritten = getSectorsWritten() + workData->blockRenameWriteSize;
         if (currentSectorsWritten > targetDeviceStartSectorsWritten)
             writeSize = (currentSectorsWritten - targetDeviceStartSectorsWritten) * targetLogicSectorSize;
+    } else {
+        // copy threads count written bytes atomically, nothing to read from the kernel
+        writeSize = workData->currentWriteSize;
     }
 
     writeSize += (workData->skipWriteSize + workData->zeroOrlinkOrDirWriteSize);
@@ -1356,56 +1547,37 @@ qint64 FileOperateBaseWorker::getWriteDataSize()
     return writeSize;
 }
 
-qint64 FileOperateBaseWorker::getTidWriteSize()
-{
-    QFile file(QStringLiteral("/proc/self/task/%1/io").arg(copyTid));
-
-    if (!file.open(QIODevice::ReadOnly)) {
-        fmWarning() << "Failed on open the" << file.fileName() << ", will be not update the job speed and progress";
-
-        return 0;
-    }
-
-    const QByteArray &line_head = QByteArrayLiteral("write_bytes: ");
-    const QByteArray &all_data = file.readAll();
-
-    file.close();
-
-    QTextStream text_stream(all_data);
-
-    while (!text_stream.atEnd()) {
-        const QByteArray &line = text_stream.readLine().toLatin1();
-
-        if (line.startsWith(line_head)) {
-            bool ok = false;
-            qint64 size = line.mid(line_head.size()).toLongLong(&ok);
-
-            if (!ok) {
-                fmWarning() << "Failed to convert to qint64, line string=" << line;
-
-                return 0;
-            }
-            return size;
-        }
-    }
-
-    fmWarning() << "Failed to find \"" << line_head << "\" from the" << file.fileName();
-
-    return 0;
-}
-
+/*!
+ * \brief FileOperateBaseWorker::getSectorsWritten Read the written sectors of the target block device
+ * The stat file is opened once and re-read from offset 0 on each tick.
+ * \return sectors written, 0 if not available
+ */
 qint64 FileOperateBaseWorker::getSectorsWritten()
 {
-    QByteArray data;
-    QFile file(targetSysDevPath + "/stat");
+    if (targetSysStatFd < 0) {
+        if (targetSysDevPath.isEmpty())
+            return 0;
+        targetSysStatFd = open(QString(targetSysDevPath + "/stat").toLocal8Bit().constData(), O_RDONLY | O_CLOEXEC);
+        if (targetSysStatFd < 0)
+            return 0;
+    }
 
-    if (file.open(QIODevice::ReadOnly)) {
-        data = file.readAll();
-        file.close();
-        return data.simplified().split(' ').value(6).toLongLong();
-    } else {
+    char buffer[256] = { 0 };
+    const ssize_t size = pread(targetSysStatFd, buffer, sizeof(buffer) - 1, 0);
+    if (size <= 0)
         return 0;
-    }
+
+    // the 7th field is "write sectors"
+    const char *field = buffer;
+    char *end = nullptr;
+    qint64 value = 0;
+    for (int i = 0; i < 7; ++i) {
+        value = strtoll(field, &end, 10);
+        if (end == field)
+            return 0;
+        field = end;
+    }
+    return value;
 }
 
 void FileOperateBaseWorker::determineCountProcessType()
@@ -13,6 +13,7 @@
 #include <dfm-base/utils/threadcontainer.h>
 
 #include <QTime>
+#include <QSet>
 
 class QObject;
 
@@ -67,7 +68,6 @@ public:
     void setAllDirPermisson();
     void determineCountProcessType();
     qint64 getWriteDataSize();
-    qint64 getTidWriteSize();
     qint64 getSectorsWritten();
     AbstractJobHandler::SupportAction doHandleErrorAndWait(const QUrl &from, const QUrl &to,
                                                            const AbstractJobHandler::JobErrorType &error,
@@ -91,6 +91,9 @@ public:
 
 protected:
     void waitThreadPoolOver();
+    bool waitBigFileCopy();
+    bool beginBigFileCopy();
+    void endBigFileCopy();
     void initCopyWay();
     bool shouldUseBlockWriteType() const;
     QUrl trashInfo(const DFileInfoPointer &fromInfo);
@@ -100,6 +103,8 @@ protected:
 
     // 判断是否应该使用多线程本地复制（统一的判断接口）
     bool shouldUseMultiThreadCopy(const DFileInfoPointer &fromInfo) const;
+    // 判断目录是否可以走小文件批量复制
+    bool shouldUseSmallFileBatch(const DFileInfoPointer &fromInfo) const;
 
 protected Q_SLOTS:
     void emitErrorNotify(const QUrl &from, const QUrl &to, const AbstractJobHandler::JobErrorType &error,
@@ -111,9 +116,11 @@ private:
     void initThreadCopy();
     void initSignalCopyWorker();
     QUrl createNewTargetUrl(const DFileInfoPointer &toInfo, const QString &fileName);
-    bool doCopyLocalFile(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo);
+    bool doCopyLocalFile(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, const bool tryClone = false);
     bool doCopyOtherFile(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip);
     bool doCopyLocalByRange(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip);
+    bool doCopyLocalByChunks(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip);
+    QSet<QByteArray> doCopySmallFilesBatch(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo);
     void setExpectedSizeForTarget(const QUrl &targetUrl, qint64 size);
 
     // 延迟替换机制：批量应用所有待处理的替换
@@ -132,15 +139,22 @@ private:
 protected:
     DFileInfoPointer targetInfo { nullptr };   // target file infor pointer
     CountWriteSizeType countWriteType { CountWriteSizeType::kCustomizeType };   // get write size type
-    long copyTid = { -1 };   // 使用 /pric/[pid]/task/[tid]/io 文件中的的 writeBytes 字段的值作为判断已写入数据的依据
     qint64 targetDeviceStartSectorsWritten { 0 };   // 记录任务开始时目标磁盘设备已写入扇区数
     QString targetSysDevPath;   // /sys/dev/block/x:x
+    int targetSysStatFd { -1 };   // kept open fd of targetSysDevPath/stat, re-read by pread on every tick
+    qint64 lastSpeedSampleSize { 0 };   // write size of the last speed sample
+    qint64 lastSpeedSampleTime { 0 };   // elapsed ms of the last speed sample
+    double smoothedSpeed { 0 };   // EWMA of the write speed, bytes per second
     qint16 targetLogicSectorSize { 512 };   // 目标设备逻辑扇区大小
     qint8 targetIsRemovable { 1 };   // 目标磁盘设备是不是可移除或者热插拔设备
     DirPermissonList dirPermissonList;   // dir set Permisson list
     FileCleanupManager cleanupManager;   // 管理不完整文件的清理
 
     std::atomic_int threadCopyFileCount { 0 };
+    // 已投递到线程池但尚未结束的拷贝任务，由 copyTaskMutex 保护
+    int pendingCopyTasks { 0 };
+    QMutex copyTaskMutex;
+    QWaitCondition copyTaskFinished;
     QList<DFileInfoPointer> cutAndDeleteFiles;
 
     // 延迟替换：待处理的替换上下文队列（主线程访问，无需锁）
@@ -31,6 +31,8 @@ inline constexpr char kFileOperations[] { "org.deepin.dde.file-manager.operation
 inline constexpr char kFileBigSize[] { "file.operation.bigfilesize" };
 inline constexpr char kBlockEverySync[] { "file.operation.blockeverysync" };
 inline constexpr char kBroadcastPaste[] { "file.operation.broadcastpastevent" };
+inline constexpr char kIoUringCopy[] { "file.operation.iouringcopy" };
+inline constexpr char kSmallFileBatchCopy[] { "file.operation.smallfilebatchcopy" };
 
 /*!
  * \brief FileOperationsUtils::statisticsFilesSize 使用c库统计文件大小
@@ -167,6 +169,16 @@ bool FileOperationsUtils::blockSync()
     return sync;
 }
 
+bool FileOperationsUtils::ioUringCopy()
+{
+    return DConfigManager::instance()->value(kFileOperations, kIoUringCopy, true).toBool();
+}
+
+bool FileOperationsUtils::smallFileBatchCopy()
+{
+    return DConfigManager::instance()->value(kFileOperations, kSmallFileBatchCopy, true).toBool();
+}
+
 QUrl FileOperationsUtils::parentUrl(const QUrl &url)
 {
     auto parent = url.adjusted(QUrl::StripTrailingSlash);
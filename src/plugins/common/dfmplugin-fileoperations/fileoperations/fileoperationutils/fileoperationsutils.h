@@ -73,6 +73,8 @@ private:
     static bool isFileOnDisk(const QUrl &url);
     static qint64 bigFileSize();
     static bool blockSync();
+    static bool ioUringCopy();
+    static bool smallFileBatchCopy();
     static QUrl parentUrl(const QUrl &url);
     static bool canBroadcastPaste();
 };
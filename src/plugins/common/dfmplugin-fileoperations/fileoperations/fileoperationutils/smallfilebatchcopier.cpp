@@ -0,0 +1,246 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "smallfilebatchcopier.h"
+#include "dfm-base/dfm_log_defines.h"
+
+#include <QFile>
+#include <QVector>
+
+#include <memory>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <sys/syscall.h>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+namespace {
+// getdents64 返回的目录项布局，glibc 较老的版本没有导出 getdents64 的声明
+struct LinuxDirent64
+{
+    ino64_t d_ino;
+    off64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+constexpr size_t kDirentBufferSize { 64 * 1024 };
+}   // namespace
+
+SmallFileBatchCopier::SmallFileBatchCopier(const QString &sourceDir, const QString &targetDir)
+{
+    sourceFd = ::open(QFile::encodeName(sourceDir).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    targetFd = ::open(QFile::encodeName(targetDir).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+}
+
+SmallFileBatchCopier::~SmallFileBatchCopier()
+{
+    if (sourceFd >= 0)
+        ::close(sourceFd);
+    if (targetFd >= 0)
+        ::close(targetFd);
+}
+
+bool SmallFileBatchCopier::scan(qint64 sizeLimit, const NameFilter &accept)
+{
+    candidates.clear();
+    if (sourceFd < 0 || targetFd < 0)
+        return false;
+
+    std::unique_ptr<char[]> buffer(new char[kDirentBufferSize]);
+    while (true) {
+        const long nread = ::syscall(SYS_getdents64, sourceFd, buffer.get(), kDirentBufferSize);
+        if (nread < 0) {
+            fmWarning() << "Batch copy: read directory failed, errno:" << errno;
+            candidates.clear();
+            return false;
+        }
+        if (nread == 0)
+            break;
+
+        for (long pos = 0; pos < nread;) {
+            auto dirent = reinterpret_cast<LinuxDirent64 *>(buffer.get() + pos);
+            pos += dirent->d_reclen;
+
+            // 目录项类型已知且不是普通文件时不需要 statx
+            if (dirent->d_type != DT_REG && dirent->d_type != DT_UNKNOWN)
+                continue;
+
+            struct statx stx;
+            if (::statx(sourceFd, dirent->d_name, AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT,
+                        STATX_TYPE | STATX_MODE | STATX_SIZE | STATX_ATIME | STATX_MTIME, &stx)
+                != 0)
+                continue;
+            if (!S_ISREG(stx.stx_mode) || static_cast<qint64>(stx.stx_size) > sizeLimit)
+                continue;
+
+            Entry entry;
+            entry.name = QByteArray(dirent->d_name);
+            if (accept && !accept(entry.name))
+                continue;
+            entry.size = static_cast<qint64>(stx.stx_size);
+            entry.mode = stx.stx_mode;
+            entry.atime = { static_cast<time_t>(stx.stx_atime.tv_sec), static_cast<long>(stx.stx_atime.tv_nsec) };
+            entry.mtime = { static_cast<time_t>(stx.stx_mtime.tv_sec), static_cast<long>(stx.stx_mtime.tv_nsec) };
+            candidates.append(entry);
+        }
+    }
+
+    return true;
+}
+
+QList<QByteArray> SmallFileBatchCopier::copy(qint64 arenaSize, const ContinueCheck &canContinue,
+                                             const EntryCallback &aboutToWrite, const EntryCallback &copied)
+{
+    QList<QByteArray> done;
+    if (candidates.isEmpty() || sourceFd < 0 || targetFd < 0)
+        return done;
+
+    // 一块内存区供所有分组复用
+    std::unique_ptr<char[]> arena(new char[static_cast<size_t>(arenaSize)]);
+    QVector<qint64> offsets;
+    QVector<bool> readOk;
+
+    int groupBegin = 0;
+    while (groupBegin < candidates.size()) {
+        if (canContinue && !canContinue())
+            break;
+
+        // 组内文件依次排布在内存区中，单个文件至少独占一组
+        int groupEnd = groupBegin;
+        qint64 used = 0;
+        offsets.clear();
+        while (groupEnd < candidates.size()
+               && (groupEnd == groupBegin || used + candidates.at(groupEnd).size <= arenaSize)) {
+            if (candidates.at(groupEnd).size > arenaSize)
+                break;
+            offsets.append(used);
+            used += candidates.at(groupEnd).size;
+            ++groupEnd;
+        }
+        if (groupEnd == groupBegin) {
+            // 文件比内存区还大，交给原流程
+            ++groupBegin;
+            continue;
+        }
+
+        // 空间不足时停止批量拷贝，剩下的文件由原流程提示
+        struct statvfs vfs;
+        if (::fstatvfs(targetFd, &vfs) != 0
+            || static_cast<qint64>(vfs.f_bavail) * static_cast<qint64>(vfs.f_frsize) < used) {
+            fmInfo() << "Batch copy: not enough free space for" << used << "bytes, leave the rest";
+            break;
+        }
+
+        // 读阶段
+        readOk.fill(false, groupEnd - groupBegin);
+        for (int i = groupBegin; i < groupEnd; ++i)
+            readOk[i - groupBegin] = readEntry(candidates.at(i), arena.get() + offsets.at(i - groupBegin));
+
+        // 写阶段
+        for (int i = groupBegin; i < groupEnd; ++i) {
+            if (canContinue && !canContinue())
+                return done;
+            if (!readOk.at(i - groupBegin))
+                continue;
+            const Entry &entry = candidates.at(i);
+            if (aboutToWrite)
+                aboutToWrite(entry);
+            if (!writeEntry(entry, arena.get() + offsets.at(i - groupBegin)))
+                continue;
+            done.append(entry.name);
+            if (copied)
+                copied(entry);
+        }
+
+        groupBegin = groupEnd;
+    }
+
+    return done;
+}
+
+QByteArray SmallFileBatchCopier::fileName(const QUrl &url)
+{
+    // 不能用 QFile::decodeName 比较：非 UTF-8 的文件名解码后与 url 中的名称不一致
+    return QByteArray::fromPercentEncoding(url.fileName(QUrl::FullyEncoded).toLatin1());
+}
+
+bool SmallFileBatchCopier::readEntry(const Entry &entry, char *buffer) const
+{
+    int fd = ::openat(sourceFd, entry.name.constData(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+    if (fd < 0)
+        return false;
+
+    qint64 total = 0;
+    bool ok = true;
+    while (total < entry.size) {
+        const ssize_t n = ::read(fd, buffer + total, static_cast<size_t>(entry.size - total));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0) {
+            // 读失败或文件在扫描后变小
+            ok = false;
+            break;
+        }
+        total += n;
+    }
+
+    // 文件在扫描后变大，按原流程重新拷贝
+    if (ok) {
+        char probe;
+        ssize_t n = 0;
+        do {
+            n = ::read(fd, &probe, 1);
+        } while (n < 0 && errno == EINTR);
+        ok = (n == 0);
+    }
+
+    ::close(fd);
+    return ok;
+}
+
+bool SmallFileBatchCopier::writeEntry(const Entry &entry, const char *buffer) const
+{
+    // O_EXCL：目标已存在时留给原流程处理冲突；不保留属性时与逐个拷贝一样按 umask 创建
+    const mode_t createMode = preserveAttributes ? 0600 : 0666;
+    int fd = ::openat(targetFd, entry.name.constData(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, createMode);
+    if (fd < 0)
+        return false;
+
+    qint64 total = 0;
+    bool ok = true;
+    while (total < entry.size) {
+        const ssize_t n = ::write(fd, buffer + total, static_cast<size_t>(entry.size - total));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0) {
+            ok = false;
+            break;
+        }
+        total += n;
+    }
+
+    if (ok && preserveAttributes) {
+        // 权限为0000时，源文件已经被删除，无需修改新建的文件的权限为0000
+        const mode_t permissions = entry.mode & 07777;
+        if (permissions != 0)
+            ::fchmod(fd, permissions);
+        const struct timespec times[2] = { entry.atime, entry.mtime };
+        ::futimens(fd, times);
+    }
+
+    if (::close(fd) != 0)
+        ok = false;
+
+    if (!ok)
+        ::unlinkat(targetFd, entry.name.constData(), 0);
+    return ok;
+}
+
+DPFILEOPERATIONS_END_NAMESPACE
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SMALLFILEBATCHCOPIER_H
+#define SMALLFILEBATCHCOPIER_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QUrl>
+
+#include <functional>
+
+#include <sys/types.h>
+#include <time.h>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/**
+ * 目录级小文件批量拷贝
+ *
+ * 职责：一次性读出整个目录（getdents64 + statx），把小普通文件按组读入同一块内存区，
+ * 再集中写出并设置权限和时间。
+ *
+ * 只处理“确定不会出错”的文件：目标已存在、空间不足、读写失败、大小变化等情况都不在这里处理，
+ * 而是留给调用方按原有的逐个文件流程处理，由那里负责弹出冲突和错误对话框。
+ */
+class SmallFileBatchCopier
+{
+public:
+    struct Entry
+    {
+        QByteArray name;   // 文件名（文件系统原始编码）
+        qint64 size { 0 };
+        mode_t mode { 0 };
+        struct timespec atime {};
+        struct timespec mtime {};
+    };
+
+    // 返回 false 的文件不批量拷贝，留给原流程
+    using NameFilter = std::function<bool(const QByteArray &)>;
+    // 返回 false 时停止批量拷贝（暂停/停止时使用）
+    using ContinueCheck = std::function<bool()>;
+    // 每个文件创建前、写完后回调
+    using EntryCallback = std::function<void(const Entry &)>;
+
+    SmallFileBatchCopier(const QString &sourceDir, const QString &targetDir);
+    ~SmallFileBatchCopier();
+
+    /**
+     * 扫描源目录，收集不大于 sizeLimit 且通过 accept 的普通文件。
+     * 这里不检查目标，目标已存在的文件在写出时由 O_EXCL 排除
+     * \return 是否成功打开了两个目录并读取了源目录
+     */
+    bool scan(qint64 sizeLimit, const NameFilter &accept = nullptr);
+    const QList<Entry> &entries() const { return candidates; }
+
+    /**
+     * 按组拷贝扫描到的文件，每组读入不超过 arenaSize 的数据后集中写出
+     * \return 拷贝成功的文件名，其余文件由调用方按原流程处理
+     */
+    QList<QByteArray> copy(qint64 arenaSize, const ContinueCheck &canContinue,
+                           const EntryCallback &aboutToWrite, const EntryCallback &copied);
+
+    /**
+     * 是否把源文件的权限和时间设置到目标上，与 DoCopyFileWorker::setTargetPermissions 的判断一致，
+     * 目标不支持设置权限（如 MTP）时关闭，新文件使用默认权限
+     */
+    void setPreserveAttributes(bool preserve) { preserveAttributes = preserve; }
+
+    // 迭代器返回的 url 中的文件名（文件系统原始编码），与 Entry::name 比较
+    static QByteArray fileName(const QUrl &url);
+
+private:
+    bool readEntry(const Entry &entry, char *buffer) const;
+    bool writeEntry(const Entry &entry, const char *buffer) const;
+
+    int sourceFd { -1 };
+    int targetFd { -1 };
+    bool preserveAttributes { true };
+    QList<Entry> candidates;
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // SMALLFILEBATCHCOPIER_H
@@ -59,13 +59,18 @@ public:
     std::atomic_bool isBlockDevice { false };
     std::atomic_bool isSourceFileLocal { false };   // source file on local device
     std::atomic_bool isTargetFileLocal { false };   // target file on local device
+    std::atomic_bool useIoUringCopy { false };   // copy big file by io_uring pipeline
+    std::atomic_bool useSmallFileBatchCopy { false };   // copy small files of a directory in batch
     std::atomic_int64_t currentWriteSize { 0 };
     QAtomicInteger<qint64> zeroOrlinkOrDirWriteSize { 0 };   // The copy size is 0. The write statistics size of the linked file and directory
     QAtomicInteger<qint64> blockRenameWriteSize { 0 };   // The copy size is 0. The write statistics size of the linked file and directory
     QAtomicInteger<qint64> skipWriteSize { 0 };   // 跳过的文件大
     QAtomicInteger<qint64> completeFileCount { 0 };   // copy complete file count
+    QAtomicInteger<qint64> cloneFileCount { 0 };   // files copied by FICLONE, no data moved
+    QAtomicInteger<qint64> cloneFileSize { 0 };   // size of the files copied by FICLONE
+    QAtomicInteger<qint64> offloadFileCount { 0 };   // files copied by whole file copy_file_range on network file system
+    std::atomic_bool cloneUnsupported { false };   // target file system refused FICLONE, do not try again
     std::atomic_bool singleThread { true };
-    DThreadMap<QUrl, qint64> everyFileWriteSize;
     DThreadList<QSharedPointer<DPFILEOPERATIONS_NAMESPACE::WorkerData::BlockFileCopyInfo>> blockCopyInfoQueue;
 };
 DPFILEOPERATIONS_END_NAMESPACE
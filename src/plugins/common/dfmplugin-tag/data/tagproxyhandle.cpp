@@ -112,6 +112,20 @@ QVariantMap TagProxyHandle::getTagsThroughFile(const QStringList &value)
     return data.toMap();
 }
 
+QVariantMap TagProxyHandle::getTagsOfFiles(const QStringList &paths)
+{
+    if (paths.isEmpty())
+        return {};
+
+    auto &&reply = d->tagDBusInterface->QueryTagsOfFiles(paths);
+    reply.waitForFinished();
+    if (!reply.isValid()) {
+        fmWarning() << "getTagsOfFiles failed :" << reply.error();
+        return {};
+    }
+    return reply.value();
+}
+
 QVariant TagProxyHandle::getSameTagsOfDiffFiles(const QStringList &value)
 {
     auto &&reply = d->tagDBusInterface->Query(int(QueryOpts::kTagIntersectionOfFiles), value);
@@ -22,6 +22,7 @@ public:
 
     QVariantMap getAllTags();
     QVariantMap getTagsThroughFile(const QStringList &value);
+    QVariantMap getTagsOfFiles(const QStringList &paths);
     QVariant getSameTagsOfDiffFiles(const QStringList &value);
     QVariantMap getFilesThroughTag(const QStringList &value);
     QVariantMap getTagsColor(const QStringList &value);
@@ -96,20 +96,28 @@ void FileTagCache::loadFileTagsFromDatabase()
 {
     fmInfo() << "Start initilize FileTagCache";
     // 加载数据库所有文件标记,和标记属性到缓存
-    if (!TagProxyHandle::instance()->isValid())
-        fmWarning() << "tagService is inValid";
-    d->fileTagsCache = TagProxyHandle::instance()->getAllFileWithTags();
+    // 服务尚未启动时保持未加载状态，查询直接走服务；服务注册后 tagServiceRegistered 会触发重新加载
+    if (!TagProxyHandle::instance()->isValid()) {
+        fmWarning() << "tagService is inValid, FileTagCache will be loaded when the service is registered";
+        return;
+    }
+    const auto &fileTags = TagProxyHandle::instance()->getAllFileWithTags();
     const auto &tagsColor = TagProxyHandle::instance()->getAllTags();
+    // 加载回收站标记数据
+    const auto &trashFileTags = TagProxyHandle::instance()->getAllTrashFileTags();
+
+    QWriteLocker locker(&d->lock);
+    d->fileTagsCache = fileTags;
     auto it = tagsColor.begin();
     for (; it != tagsColor.end(); ++it)
         d->tagProperty.insert(it.key(), QColor(it.value().toString()));
-
-    // 加载回收站标记数据
-    d->trashFileTagsCache = TagProxyHandle::instance()->getAllTrashFileTags();
+    d->trashFileTagsCache = trashFileTags;
+    d->loaded = true;
 }
 
 void FileTagCache::addTags(const QVariantMap &tags)
 {
+    QWriteLocker locker(&d->lock);
     auto it = tags.begin();
     for (; it != tags.end(); ++it) {
         if (d->tagProperty.contains(it.key()))
@@ -121,6 +129,7 @@ void FileTagCache::addTags(const QVariantMap &tags)
 void FileTagCache::deleteTags(const QStringList &tags)
 {
     QVariantMap map {};
+    QWriteLocker locker(&d->lock);
     for (const QString &tag : tags) {
         d->tagProperty.remove(tag);
 
@@ -136,12 +145,14 @@ void FileTagCache::deleteTags(const QStringList &tags)
         }
     }
 
+    locker.unlock();
     if (!map.isEmpty())
         untaggeFiles(map);
 }
 
 void FileTagCache::changeTagColor(const QVariantMap &tagAndColorName)
 {
+    QWriteLocker locker(&d->lock);
     auto it = tagAndColorName.begin();
     for (; it != tagAndColorName.end(); ++it) {
         if (d->tagProperty.contains(it.key()))
@@ -151,6 +162,7 @@ void FileTagCache::changeTagColor(const QVariantMap &tagAndColorName)
 
 void FileTagCache::changeTagName(const QVariantMap &oldAndNew)
 {
+    QWriteLocker locker(&d->lock);
     auto it = oldAndNew.begin();
     for (; it != oldAndNew.end(); ++it) {
         const QString &oldName { it.key() };
@@ -165,6 +177,7 @@ void FileTagCache::changeTagName(const QVariantMap &oldAndNew)
 
 void FileTagCache::changeFilesTagName(const QString &oldName, const QString &newName)
 {
+    QWriteLocker locker(&d->lock);
     std::for_each(d->fileTagsCache.begin(), d->fileTagsCache.end(), [oldName, newName](QVariant &var) {
         QStringList tagNames { var.toStringList() };
         auto result { std::find(tagNames.begin(), tagNames.end(), oldName) };
@@ -178,6 +191,7 @@ void FileTagCache::changeFilesTagName(const QString &oldName, const QString &new
 
 void FileTagCache::taggeFiles(const QVariantMap &fileAndTags)
 {
+    QWriteLocker locker(&d->lock);
     auto it = fileAndTags.begin();
     for (; it != fileAndTags.end(); ++it) {
         if (!d->fileTagsCache.contains(it.key())) {
@@ -209,6 +223,7 @@ void FileTagCache::reloadTrashFileTagsCache()
 
 void FileTagCache::untaggeFiles(const QVariantMap &fileAndTags)
 {
+    QWriteLocker locker(&d->lock);
     auto it = fileAndTags.begin();
     for (; it != fileAndTags.end(); ++it) {
         if (d->fileTagsCache.contains(it.key())) {
@@ -231,6 +246,11 @@ FileTagCache::~FileTagCache()
 {
 }
 
+bool FileTagCache::isLoaded() const
+{
+    return d->loaded;
+}
+
 /**
  * @brief A single file gets its own tags, and multiple files are their intersection
  * @param paths is a collection of file paths
@@ -276,6 +296,16 @@ QHash<QString, QStringList> FileTagCache::findChildren(const QString &parentPath
     return children;
 }
 
+FileTagCache::TagColorMap FileTagCache::getAllTags() const
+{
+    QReadLocker rlk(&d->lock);
+    TagColorMap tagsColor;
+    for (auto it = d->tagProperty.cbegin(); it != d->tagProperty.cend(); ++it)
+        tagsColor.insert(it.key(), it.value());
+
+    return tagsColor;
+}
+
 FileTagCache::TagColorMap FileTagCache::getTagsColor(const QStringList &tags) const
 {
     if (tags.isEmpty())
@@ -297,6 +327,11 @@ FileTagCacheController &FileTagCacheController::instance()
     return cacheController;
 }
 
+bool FileTagCacheController::isLoaded() const
+{
+    return FileTagCache::instance().isLoaded();
+}
+
 QStringList FileTagCacheController::getTagsByFiles(const QStringList &paths)
 {
     return FileTagCache::instance().getTagsByFiles(paths);
@@ -307,6 +342,11 @@ QStringList FileTagCacheController::getTagsByFile(const QString &path)
     return FileTagCache::instance().getTagsByFiles({ path });
 }
 
+QMap<QString, QColor> FileTagCacheController::getCacheAllTags()
+{
+    return FileTagCache::instance().getAllTags();
+}
+
 QMap<QString, QColor> FileTagCacheController::getCacheTagsColor(const QStringList &tags)
 {
     return FileTagCache::instance().getTagsColor(tags);
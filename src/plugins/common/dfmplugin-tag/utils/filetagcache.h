@@ -49,7 +49,9 @@ public:
     virtual ~FileTagCache() override;
 
     //query
+    bool isLoaded() const;
     QStringList getTagsByFiles(const QStringList &paths) const;
+    TagColorMap getAllTags() const;
     TagColorMap getTagsColor(const QStringList &tags) const;
     QHash<QString, QStringList> findChildren(const QString &parentPath) const;
 
@@ -82,8 +84,10 @@ public:
     static FileTagCacheController &instance();
 
     //query
+    bool isLoaded() const;
     QStringList getTagsByFiles(const QStringList &paths);
     QStringList getTagsByFile(const QString &path);
+    QMap<QString, QColor> getCacheAllTags();
     QMap<QString, QColor> getCacheTagsColor(const QStringList &tags);
     QHash<QString, QStringList> findChildren(const QString &parentPath) const;
 
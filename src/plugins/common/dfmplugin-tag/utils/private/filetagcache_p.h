@@ -11,6 +11,8 @@
 #include <QMutex>
 #include <QHash>
 
+#include <atomic>
+
 namespace dfmplugin_tag {
 class FileTagCachePrivate
 {
@@ -21,6 +23,7 @@ class FileTagCachePrivate
     QHash<QString, QColor> tagProperty;   // tag name -> QColor
     QHash<QString, QVariant> trashFileTagsCache;   // "path:inode" -> tag name list
     QReadWriteLock lock;
+    std::atomic_bool loaded { false };
 
 public:
     explicit FileTagCachePrivate(FileTagCache *qq);
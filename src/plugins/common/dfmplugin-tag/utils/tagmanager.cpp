@@ -246,6 +246,10 @@ QString TagManager::getTagIconName(const QString &tag) const
 
 TagManager::TagColorMap TagManager::getAllTags()
 {
+    // 缓存由标记服务的变更信号保持同步，加载完成后不必再走 DBus
+    if (FileTagCacheIns.isLoaded())
+        return FileTagCacheIns.getCacheAllTags();
+
     const auto &dataMap = TagProxyHandleIns->getAllTags();
     TagColorMap result;
     auto it = dataMap.begin();
@@ -261,6 +265,9 @@ TagManager::TagColorMap TagManager::getTagsColor(const QStringList &tags) const
     if (tags.isEmpty())
         return {};
 
+    if (FileTagCacheIns.isLoaded())
+        return FileTagCacheIns.getCacheTagsColor(tags);
+
     const auto &dataMap = TagProxyHandleIns->getTagsColor(tags);
     TagColorMap result;
     auto it = dataMap.begin();
@@ -286,7 +293,23 @@ QStringList TagManager::getTagsByUrls(const QList<QUrl> &urls) const
         paths.append(url.path());
     }
 
-    return FileTagCacheIns.getTagsByFiles(paths);
+    if (FileTagCacheIns.isLoaded() || paths.isEmpty())
+        return FileTagCacheIns.getTagsByFiles(paths);
+
+    // 缓存尚未加载完成（如标记服务后启动），一次批量查询所有文件的标记，而不是逐个文件请求
+    const auto &fileTags = TagProxyHandleIns->getTagsOfFiles(paths);
+    QStringList sameTags = fileTags.value(paths.first()).toStringList();
+    for (const auto &path : paths) {
+        if (sameTags.isEmpty())
+            break;
+        const QStringList &tags = fileTags.value(path).toStringList();
+        sameTags.erase(std::remove_if(sameTags.begin(), sameTags.end(), [&tags](const QString &tag) {
+                           return !tags.contains(tag);
+                       }),
+                       sameTags.end());
+    }
+
+    return sameTags;
 }
 
 QStringList TagManager::getFilesByTag(const QString &tag)
@@ -328,8 +351,10 @@ bool TagManager::setTagsForFiles(const QStringList &tags, const QList<QUrl> &fil
     if (!dirtyTagNames.isEmpty())
         result = TagManager::instance()->removeTagsOfFiles(dirtyTagNames, realUrls) || result;
 
+    // 按需要新增的标记分组，同组文件一次提交，避免逐个文件调用 DBus
+    QMap<QStringList, QList<QUrl>> filesOfNewTags;
     for (const QUrl &url : TagHelper::commonUrls(realUrls)) {
-        QStringList tagsOfFile = TagManager::instance()->getTagsByUrls({ url });
+        const QStringList &tagsOfFile = TagManager::instance()->getTagsByUrls({ url });
         QStringList newTags;
 
         for (const QString &tag : tags) {
@@ -337,12 +362,13 @@ bool TagManager::setTagsForFiles(const QStringList &tags, const QList<QUrl> &fil
                 newTags.append(tag);
         }
 
-        if (!newTags.isEmpty()) {
-            tagsOfFile.append(newTags);
-            result = TagManager::instance()->addTagsForFiles(newTags, { url }) || result;
-        }
+        if (!newTags.isEmpty())
+            filesOfNewTags[newTags].append(url);
     }
 
+    for (auto it = filesOfNewTags.cbegin(); it != filesOfNewTags.cend(); ++it)
+        result = TagManager::instance()->addTagsForFiles(it.key(), it.value()) || result;
+
     return result;
 }
 
@@ -526,8 +552,15 @@ QMap<QString, QString> TagManager::getTagsColorName(const QStringList &tags) con
     if (tags.isEmpty())
         return {};
 
-    const auto &dataMap = TagProxyHandleIns->getTagsColor(tags);
     QMap<QString, QString> result;
+    if (FileTagCacheIns.isLoaded()) {
+        const auto &tagsColor = FileTagCacheIns.getCacheTagsColor(tags);
+        for (auto it = tagsColor.cbegin(); it != tagsColor.cend(); ++it)
+            result[it.key()] = it.value().name();
+        return result;
+    }
+
+    const auto &dataMap = TagProxyHandleIns->getTagsColor(tags);
     auto it = dataMap.begin();
     for (; it != dataMap.end(); ++it)
         result[it.key()] = it.value().toString();
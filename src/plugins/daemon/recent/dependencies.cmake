@@ -9,6 +9,7 @@ function(dfm_setup_daemon_recent_dependencies target_name)
     find_package(Qt6 COMPONENTS
         Core
         DBus
+        Concurrent
         REQUIRED)
     
     # Add DBus adaptor
@@ -23,5 +24,6 @@ function(dfm_setup_daemon_recent_dependencies target_name)
     target_link_libraries(${target_name} PRIVATE
         Qt6::Core
         Qt6::DBus
+        Qt6::Concurrent
     )
 endfunction() 
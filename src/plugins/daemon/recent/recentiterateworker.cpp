@@ -17,17 +17,39 @@
 #include <QFile>
 #include <QXmlStreamReader>
 #include <QUrl>
+#include <QSet>
+#include <QtConcurrent>
 
 SERVERRECENTMANAGER_BEGIN_NAMESPACE
 DFMBASE_USE_NAMESPACE
 using namespace GlobalServerDefines;
 
+namespace {
+// 需要检查的书签少于该数量时直接在当前线程检查
+static constexpr int kParallelCheckThreshold { 64 };
+
+// xbel 由其他进程整体重写，写到一半时读到的内容缺少结束标签
+bool isCompleteXbel(const QByteArray &content)
+{
+    static constexpr char kEndTag[] { "</xbel>" };
+    static constexpr int kEndTagLen { sizeof(kEndTag) - 1 };
+
+    qsizetype end = content.size();
+    while (end > 0 && QChar::isSpace(uchar(content.at(end - 1))))
+        --end;
+
+    return end >= kEndTagLen && qstrncmp(content.constData() + end - kEndTagLen, kEndTag, kEndTagLen) == 0;
+}
+}   // namespace
+
 RecentIterateWorker::RecentIterateWorker(QObject *parent)
     : QObject(parent)
 {
 }
 
-// 对 xbel 的增删改都会触发本函数重新扫描 xbel 文件
+// 对 xbel 的增删改都会触发本函数重新扫描 xbel 文件。
+// 只缓存 <bookmark> 开始标签的解析结果，内容未变化的标签不再解析；
+// 书签指向的文件可能在两次重载之间被删除或所在设备被卸载，每次重载都重新检查所有文件是否存在。
 void RecentIterateWorker::onRequestReload(const QString &xbelPath, qint64 timestamp)
 {
     // Q_ASSERT(qApp->thread() != QThread::currentThread());
@@ -36,49 +58,75 @@ void RecentIterateWorker::onRequestReload(const QString &xbelPath, qint64 timest
     });
 
     QFile file(xbelPath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!file.open(QIODevice::ReadOnly)) {
         fmCritical() << "[RecentIterateWorker::onRequestReload] Failed to open recent file:" << xbelPath;
         return;
     }
     fmDebug() << "[RecentIterateWorker::onRequestReload] Successfully opened recent file:" << xbelPath;
 
-    QStringList curPathList;
-    const QStringList cachedPathList = itemsInfo.keys();
-
-    QXmlStreamReader reader(&file);
-    while (!reader.atEnd() && !reader.hasError()) {
-        if (reader.readNext() == QXmlStreamReader::EndDocument)
-            continue;
+    const QByteArray content = file.readAll();
+    if (!isCompleteXbel(content)) {
+        fmCritical() << "[RecentIterateWorker::onRequestReload] Error reading recent XML file:" << xbelPath
+                     << "error: incomplete document";
+        return;
+    }
 
-        if (!reader.isStartElement() || reader.name() != QString("bookmark"))
+    const QList<QByteArray> tags = bookmarkTags(content);
+    QHash<QByteArray, BookmarkRecord> cache;
+    QList<BookmarkRecord> records;
+    cache.reserve(tags.size());
+    records.reserve(tags.size());
+    int parsedCount = 0;
+    for (const QByteArray &tag : tags) {
+        auto itor = bookmarkCache.constFind(tag);
+        if (itor != bookmarkCache.constEnd()) {
+            cache.insert(itor.key(), itor.value());
+            records.append(itor.value());
             continue;
+        }
 
-        processBookmarkElement(reader, curPathList);
+        QXmlStreamReader reader(tag);
+        while (!reader.atEnd() && !reader.isStartElement())
+            reader.readNext();
+        const BookmarkRecord &record = parseBookmark(reader);
+        // tag 引用 content 中的数据，缓存时需要深拷贝
+        cache.insert(QByteArray(tag.constData(), tag.size()), record);
+        records.append(record);
+        ++parsedCount;
     }
+    bookmarkCache = cache;
 
-    if (reader.hasError()) {
-        fmCritical() << "[RecentIterateWorker::onRequestReload] Error reading recent XML file:" << xbelPath
-                     << "error:" << reader.errorString();
-        return;
-    }
+    checkBookmarks(records);
+
+    QStringList curPathList;
+    const QStringList cachedPathList = itemsInfo.keys();
+    for (const BookmarkRecord &record : std::as_const(records))
+        commitBookmark(record, curPathList);
 
     fmInfo() << "[RecentIterateWorker::onRequestReload] Successfully processed recent file:" << xbelPath
-             << "current items:" << curPathList.size() << "cached items:" << cachedPathList.size();
+             << "current items:" << curPathList.size() << "cached items:" << cachedPathList.size()
+             << "parsed bookmarks:" << parsedCount << "of" << records.size();
 
     removeOutdatedItems(cachedPathList, curPathList);
 }
 
-void RecentIterateWorker::processBookmarkElement(QXmlStreamReader &reader, QStringList &curPathList)
+RecentIterateWorker::BookmarkRecord RecentIterateWorker::parseBookmark(QXmlStreamReader &reader)
 {
-    // Q_ASSERT(qApp->thread() != QThread::currentThread());
-
-    const QString location = reader.attributes().value("href").toString();
+    BookmarkRecord record;
+    record.location = reader.attributes().value("href").toString();
     const QString readTime = reader.attributes().value("modified").toString();
+    record.modified = QDateTime::fromString(readTime, Qt::ISODate).toSecsSinceEpoch();
+    return record;
+}
 
-    if (location.isEmpty())
+// 可能在线程池中并发调用
+void RecentIterateWorker::checkBookmark(BookmarkRecord &record)
+{
+    record.path.clear();
+    if (record.location.isEmpty())
         return;
 
-    const QUrl url(location);
+    const QUrl url(record.location);
     if (!url.isLocalFile())
         return;
     if (ProtocolUtils::isRemoteFile(url))
@@ -88,21 +136,74 @@ void RecentIterateWorker::processBookmarkElement(QXmlStreamReader &reader, QStri
     if (!info.exists() || !info.isFile())
         return;
 
-    const auto bindPath = FileUtils::bindPathTransform(info.absoluteFilePath(), false);
-    qint64 readTimeSecs = QDateTime::fromString(readTime, Qt::ISODate).toSecsSinceEpoch();
+    record.path = FileUtils::bindPathTransform(info.absoluteFilePath(), false);
+}
+
+void RecentIterateWorker::checkBookmarks(QList<BookmarkRecord> &records)
+{
+    if (records.size() < kParallelCheckThreshold) {
+        for (BookmarkRecord &record : records)
+            checkBookmark(record);
+        return;
+    }
+
+    // 文件可能位于较慢的存储上，分批在线程池中检查
+    QtConcurrent::blockingMap(records, [](BookmarkRecord &record) {
+        checkBookmark(record);
+    });
+}
+
+// 返回 content 中每个 <bookmark> 开始标签（含 '<' 和 '>'），不拷贝数据
+QList<QByteArray> RecentIterateWorker::bookmarkTags(const QByteArray &content)
+{
+    static constexpr char kTagBegin[] { "<bookmark" };
+    static constexpr int kTagBeginLen { sizeof(kTagBegin) - 1 };
+
+    QList<QByteArray> tags;
+    qsizetype from = 0;
+    while ((from = content.indexOf(kTagBegin, from)) >= 0) {
+        const qsizetype after = from + kTagBeginLen;
+        if (after >= content.size())
+            break;
+
+        // 跳过 <bookmark:applications> 等同前缀的元素
+        const char next = content.at(after);
+        if (!QChar::isSpace(uchar(next)) && next != '>' && next != '/') {
+            from = after;
+            continue;
+        }
+
+        const qsizetype end = content.indexOf('>', after);
+        if (end < 0)
+            break;
+
+        tags.append(QByteArray::fromRawData(content.constData() + from, end - from + 1));
+        from = end + 1;
+    }
+
+    return tags;
+}
+
+void RecentIterateWorker::commitBookmark(const BookmarkRecord &record, QStringList &curPathList)
+{
+    if (record.path.isEmpty())
+        return;
+
+    const QString &bindPath = record.path;
+    const qint64 readTimeSecs = record.modified;
 
     curPathList.append(bindPath);
     if (itemsInfo.contains(bindPath)) {
         if (itemsInfo[bindPath].modified != readTimeSecs) {
-            fmDebug() << "[RecentIterateWorker::processBookmarkElement] Item modified:" << bindPath
+            fmDebug() << "[RecentIterateWorker::commitBookmark] Item modified:" << bindPath
                       << "old time:" << itemsInfo[bindPath].modified << "new time:" << readTimeSecs;
             itemsInfo[bindPath].modified = readTimeSecs;
             emit itemChanged(bindPath, itemsInfo[bindPath]);
         }
     } else {
-        fmDebug() << "[RecentIterateWorker::processBookmarkElement] New item added:" << bindPath
+        fmDebug() << "[RecentIterateWorker::commitBookmark] New item added:" << bindPath
                   << "modified time:" << readTimeSecs;
-        RecentItem item { location, readTimeSecs };
+        RecentItem item { record.location, readTimeSecs };
         itemsInfo.insert(bindPath, item);
         emit itemAdded(bindPath, item);
     }
@@ -112,9 +213,10 @@ void RecentIterateWorker::removeOutdatedItems(const QStringList &cachedPathList,
 {
     // Q_ASSERT(qApp->thread() != QThread::currentThread());
 
+    const QSet<QString> curPaths(curPathList.cbegin(), curPathList.cend());
     QStringList removedPathList;
     for (const auto &cachedPath : cachedPathList) {
-        if (!curPathList.contains(cachedPath)) {
+        if (!curPaths.contains(cachedPath)) {
             itemsInfo.remove(cachedPath);
             removedPathList << cachedPath;
         }
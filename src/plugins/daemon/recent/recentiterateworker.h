@@ -10,6 +10,7 @@
 #include <DRecentManager>
 
 #include <QObject>
+#include <QHash>
 #include <QXmlStreamReader>
 
 SERVERRECENTMANAGER_BEGIN_NAMESPACE
@@ -34,11 +35,27 @@ Q_SIGNALS:
     void itemChanged(const QString &path, const RecentItem &item);
 
 private:
-    void processBookmarkElement(QXmlStreamReader &reader, QStringList &curPathList);
+    // 一个 <bookmark> 开始标签的解析结果，path 由每次重载时的检查填写
+    struct BookmarkRecord
+    {
+        QString location;
+        QString path;   // 为空表示不是存在的本地文件
+        qint64 modified { 0 };
+    };
+
     void removeOutdatedItems(const QStringList &cachedPathList, const QStringList &curPathList);
 
+    static BookmarkRecord parseBookmark(QXmlStreamReader &reader);
+    static void checkBookmark(BookmarkRecord &record);
+    static QList<QByteArray> bookmarkTags(const QByteArray &content);
+    static void checkBookmarks(QList<BookmarkRecord> &records);
+    void commitBookmark(const BookmarkRecord &record, QStringList &curPathList);
+
 private:
     QMap<QString, RecentItem> itemsInfo;
+
+    // 上一次重载时各开始标签的解析结果，以开始标签原文为键
+    QHash<QByteArray, BookmarkRecord> bookmarkCache;
 };
 
 SERVERRECENTMANAGER_END_NAMESPACE
@@ -21,6 +21,7 @@
 #include <QDebug>
 #include <QProcess>
 #include <QVariant>
+#include <QSqlError>
 
 DFMBASE_USE_NAMESPACE
 DAEMONPTAG_BEGIN_NAMESPACE
@@ -28,6 +29,12 @@ DAEMONPTAG_BEGIN_NAMESPACE
 static constexpr char kTagTableFileTags[] = "file_tags";
 static constexpr char kTagTableTagProperty[] = "tag_property";
 static constexpr char kTagTableTrashFileTags[] = "trash_file_tags";
+static constexpr char kFileTagsPathIndex[] = "idx_file_tags_filePath";
+
+// 旧版本 SQLite 的 SQLITE_MAX_VARIABLE_NUMBER 为 999，单条语句的占位符个数不超过它
+static constexpr int kMaxBindCount { 500 };
+// 不足的部分用最后一个路径补齐，这样每个连接只需要预编译这几种语句
+static constexpr int kBindBuckets[] { 1, 8, 64, kMaxBindCount };
 
 TagDbHandler *TagDbHandler::instance()
 {
@@ -89,20 +96,22 @@ QVariantMap TagDbHandler::getTagsByUrls(const QStringList &urlList)
         return {};
     }
 
-    // query
-    const auto &field = Expression::Field<FileTagInfo>;
-    QVariantMap allFileTags;
-    for (auto &path : urlList) {
-        const auto &beanList = handle->query<FileTagInfo>().where(field("filePath") == path).toBeans();
-
-        QStringList fileTags;
-        for (auto oneBean : beanList)
-            fileTags.append(oneBean->getTagName());
-
-        if (!fileTags.isEmpty())
-            allFileTags.insert(path, fileTags);
+    // 按块执行 IN (...) 查询，避免每个文件一次往返
+    QHash<QString, QStringList> fileTags;
+    for (int start = 0; start < urlList.size(); start += kMaxBindCount) {
+        if (!queryTagsOfFiles(urlList.mid(start, kMaxBindCount), &fileTags)) {
+            // 部分结果会被调用方当成其余文件没有标记，失败时整体返回空
+            lastErr = "query tags of files failed!";
+            fmWarning() << "TagDbHandler::getTagsByUrls: Query failed at offset" << start;
+            finally.dismiss();
+            return {};
+        }
     }
 
+    QVariantMap allFileTags;
+    for (auto it = fileTags.cbegin(); it != fileTags.cend(); ++it)
+        allFileTags.insert(it.key(), it.value());
+
     fmDebug() << "TagDbHandler::getTagsByUrls: Retrieved tags for" << allFileTags.size() << "out of" << urlList.size() << "requested files";
     return allFileTags;
 }
@@ -120,6 +129,10 @@ QVariant TagDbHandler::getSameTagsOfDiffUrls(const QStringList &urlList)
 
     QMap<QString, int> tagCount;
     const auto &allTags = getTagsByUrls(urlList);
+    if (!lastErr.isEmpty()) {
+        finally.dismiss();
+        return {};
+    }
     auto it = allTags.begin();
     for (; it != allTags.end(); ++it) {
         const auto tempTags = it.value().toStringList();
@@ -364,9 +377,9 @@ bool TagDbHandler::deleteFiles(const QStringList &urls)
 
     fmInfo() << "TagDbHandler::deleteFiles: Deleting tag information for" << urls.size() << "files";
 
-    auto field = Expression::Field<FileTagInfo>;
+    const QString &sql = QString("DELETE FROM %1 WHERE filePath = ?;").arg(kTagTableFileTags);
     for (const auto &url : urls) {
-        if (!handle->remove<FileTagInfo>(field("filePath") == url)) {
+        if (!handle->excutePrepared(sql, { url })) {
             fmCritical() << "TagDbHandler::deleteFiles: Failed to delete tag information for file:" << url;
             return false;
         }
@@ -491,10 +504,12 @@ void TagDbHandler::initialize()
         fmInfo() << "TagDbHandler::initialize: Created database directory:" << dbPath;
     }
 
-    const auto &dbFilePath = DFMUtils::buildFilePath(dbPath.toLocal8Bit(),
-                                                     Global::DataBase::kDfmDBName,
-                                                     nullptr);
+    dbFilePath = DFMUtils::buildFilePath(dbPath.toLocal8Bit(),
+                                         Global::DataBase::kDfmDBName,
+                                         nullptr);
     handle.reset(new SqliteHandle(dbFilePath));
+    // 标记数据库由本服务长期持有，批量打标记时的写入与界面的查询并发，使用 WAL 避免互相阻塞
+    SqliteConnectionPool::instance().enableWal(dbFilePath);
     QSqlDatabase db { SqliteConnectionPool::instance().openConnection(dbFilePath) };
     if (!db.isValid() || db.isOpenError()) {
         fmCritical() << "TagDbHandler::initialize: Failed to open tag database:" << dbFilePath;
@@ -508,6 +523,12 @@ void TagDbHandler::initialize()
         fmDebug() << "TagDbHandler::initialize: Table created or verified:" << kTagTableFileTags;
     }
 
+    // 按路径查询标记是最频繁的操作，没有索引时每次都是全表扫描
+    if (!handle->excute(QString("CREATE INDEX IF NOT EXISTS %1 ON %2 (filePath);")
+                                .arg(kFileTagsPathIndex, kTagTableFileTags))) {
+        fmWarning() << "TagDbHandler::initialize: Failed to create index:" << kFileTagsPathIndex;
+    }
+
     if (!createTable(kTagTableTagProperty)) {
         fmCritical() << "TagDbHandler::initialize: Failed to create table:" << kTagTableTagProperty;
     } else {
@@ -620,6 +641,51 @@ bool TagDbHandler::tagFile(const QString &file, const QVariant &tags)
     return true;
 }
 
+bool TagDbHandler::queryTagsOfFiles(const QStringList &paths, QHash<QString, QStringList> *fileTags)
+{
+    Q_ASSERT(fileTags);
+    Q_ASSERT(paths.size() <= kMaxBindCount);
+    if (paths.isEmpty())
+        return true;
+
+    int bindCount { kMaxBindCount };
+    for (int bucket : kBindBuckets) {
+        if (bucket >= paths.size()) {
+            bindCount = bucket;
+            break;
+        }
+    }
+
+    QStringList placeholders;
+    placeholders.reserve(bindCount);
+    for (int i = 0; i < bindCount; ++i)
+        placeholders.append("?");
+
+    // 预编译语句由连接池按 SQL 文本缓存，同一占位符个数的查询只编译一次
+    const QString &sql = QString("SELECT filePath, tagName FROM %1 WHERE filePath IN (%2) ORDER BY fileIndex;")
+                                 .arg(kTagTableFileTags, placeholders.join(','));
+    QSharedPointer<QSqlQuery> query = SqliteConnectionPool::instance().preparedQuery(dbFilePath, sql);
+    if (!query)
+        return false;
+
+    for (int i = 0; i < bindCount; ++i)
+        query->bindValue(i, paths.at(qMin(i, paths.size() - 1)));
+
+    if (!query->exec()) {
+        fmWarning() << "TagDbHandler::queryTagsOfFiles: Failed to execute query:" << query->lastError().text();
+        query->finish();
+        SqliteConnectionPool::instance().reportError(dbFilePath);
+        return false;
+    }
+
+    while (query->next())
+        (*fileTags)[query->value(0).toString()].append(query->value(1).toString());
+
+    // 及时重置语句，避免长时间持有读锁
+    query->finish();
+    return true;
+}
+
 bool TagDbHandler::removeSpecifiedTagOfFile(const QString &url, const QVariant &val)
 {
     DFMBASE_NAMESPACE::FinallyUtil finally([&]() { lastErr.clear(); });
@@ -630,11 +696,11 @@ bool TagDbHandler::removeSpecifiedTagOfFile(const QString &url, const QVariant &
         return false;
     }
 
-    auto field = Expression::Field<FileTagInfo>;
+    const QString &sql = QString("DELETE FROM %1 WHERE filePath = ? AND tagName = ?;").arg(kTagTableFileTags);
     const auto tempTags = val.toStringList();
     int suc = tempTags.count();
     for (const auto &tag : tempTags) {
-        if (!handle->remove<FileTagInfo>((field("filePath") == url) && (field("tagName") == tag))) {
+        if (!handle->excutePrepared(sql, { url, tag })) {
             fmCritical() << "TagDbHandler::removeSpecifiedTagOfFile: Failed to remove tag from file - file:" << url << "tag:" << tag;
             break;
         }
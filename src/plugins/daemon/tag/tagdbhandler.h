@@ -10,6 +10,7 @@
 #include <dfm-base/base/db/sqlitehandle.h>
 
 #include <QObject>
+#include <QHash>
 
 DAEMONPTAG_BEGIN_NAMESPACE
 
@@ -77,6 +78,7 @@ private:
     bool changeTagColor(const QString &tagName, const QString &newTagColor);
     bool changeTagNameWithFile(const QString &tagName, const QString &newName);
     bool changeFilePath(const QString &oldPath, const QString &newPath);
+    bool queryTagsOfFiles(const QStringList &paths, QHash<QString, QStringList> *fileTags);
 
 Q_SIGNALS:
     void newTagsAdded(const QVariantMap &newTags);
@@ -90,6 +92,7 @@ Q_SIGNALS:
 private:
     QScopedPointer<DFMBASE_NAMESPACE::SqliteHandle> handle;
     QString lastErr;
+    QString dbFilePath;
 };
 
 DAEMONPTAG_END_NAMESPACE
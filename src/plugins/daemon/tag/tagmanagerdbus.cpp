@@ -61,6 +61,15 @@ QDBusVariant TagManagerDBus::Query(int opt, const QStringList value)
     return dbusVar;
 }
 
+QVariantMap TagManagerDBus::QueryTagsOfFiles(const QStringList &paths)
+{
+    // 直接返回 a{sv}，客户端一次调用即可拿到整页文件的标记，无需再解析 QDBusVariant
+    if (paths.isEmpty())
+        return {};
+
+    return TagDbHandler::instance()->getTagsByUrls(paths);
+}
+
 bool TagManagerDBus::Insert(int opt, const QVariantMap value)
 {
     InsertOpts insetOpt { opt };
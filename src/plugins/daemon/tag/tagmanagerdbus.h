@@ -20,6 +20,7 @@ public:
 
 public Q_SLOTS:
     QDBusVariant Query(int opt, const QStringList value = {});
+    QVariantMap QueryTagsOfFiles(const QStringList &paths);
     bool Insert(int opt, const QVariantMap value);
     bool Delete(int opt, const QVariantMap value);
     bool Update(int opt, const QVariantMap value);
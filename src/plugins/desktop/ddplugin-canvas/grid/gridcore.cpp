@@ -6,6 +6,7 @@
 #include "displayconfig.h"
 
 #include <QHashFunctions>
+#include <QtAlgorithms>
 
 uint qHash(const QPoint &key, uint seed)
 {
@@ -14,12 +15,70 @@ uint qHash(const QPoint &key, uint seed)
 
 using namespace ddplugin_canvas;
 
+void GridOccupancy::reset(const QSize &sz, const QHash<QPoint, QString> &used)
+{
+    size = sz;
+    cursor = 0;
+    bits.fill(0, (qMax(0, slotCount()) + 63) / 64);
+    for (auto itor = used.begin(); itor != used.end(); ++itor)
+        set(itor.key());
+    snapshot = used;
+}
+
+void GridOccupancy::set(const QPoint &pos)
+{
+    if (!CanvasGridSpecialist::isValid(pos, size))
+        return;
+
+    const int s = slot(pos);
+    bits[s >> 6] |= quint64(1) << (s & 63);
+}
+
+void GridOccupancy::unset(const QPoint &pos)
+{
+    if (!CanvasGridSpecialist::isValid(pos, size))
+        return;
+
+    const int s = slot(pos);
+    bits[s >> 6] &= ~(quint64(1) << (s & 63));
+    if (s < cursor)
+        cursor = s;
+}
+
+int GridOccupancy::nextVoid(int from)
+{
+    const int total = slotCount();
+    const int start = qMax(from, cursor);
+    const int first = start >> 6;
+    for (int word = first; word < bits.size(); ++word) {
+        quint64 free = ~bits.at(word);
+        if (word == first)
+            free &= ~quint64(0) << (start & 63);
+        if (!free)
+            continue;
+
+        const int s = (word << 6) + qCountTrailingZeroBits(free);
+        if (s >= total)
+            break;
+
+        // 从头查找时顺便推进 cursor，下次跳过前面已占满的部分
+        if (from <= cursor)
+            cursor = s;
+        return s;
+    }
+
+    if (from <= cursor)
+        cursor = qMax(0, total);
+    return -1;
+}
+
 GridCore::GridCore()
 {
 }
 
 GridCore::GridCore(const GridCore &other)
     : surfaces(other.surfaces), posItem(other.posItem), itemPos(other.itemPos), overload(other.overload)
+    , occupancies(other.occupancies)
 {
 }
 
@@ -45,38 +104,34 @@ bool GridCore::applay(GridCore *core)
     posItem = core->posItem;
     itemPos = core->itemPos;
     overload = core->overload;
+    occupancies = core->occupancies;
     return true;
 }
 
 void GridCore::insert(int index, const QPoint &pos, const QString &it)
 {
     itemPos[index].insert(it, pos);
-    posItem[index].insert(pos, it);
+    occupy(index, pos, it);
 }
 
 void GridCore::remove(int index, const QString &it)
 {
     auto pos = itemPos[index].take(it);
-    posItem[index].remove(pos);
+    release(index, pos);
 }
 
 void GridCore::remove(int index, const QPoint &pos)
 {
-    QString it = posItem[index].take(pos);
+    QString it = release(index, pos);
     itemPos[index].remove(it);
 }
 
 QList<QPoint> GridCore::voidPos(int index) const
 {
     QList<QPoint> ret;
-    const QSize &size = surfaces.value(index, QSize(0, 0));
-    const QHash<QPoint, QString> &usedPos = posItem.value(index);
-    for (int x = 0; x < size.width(); ++x)
-        for (int y = 0; y < size.height(); ++y) {
-            QPoint pos(x, y);
-            if (!usedPos.contains(pos))
-                ret.append(pos);
-        }
+    GridOccupancy &occ = occupancy(index);
+    for (int slot = occ.nextVoid(0); slot >= 0; slot = occ.nextVoid(slot + 1))
+        ret.append(occ.point(slot));
 
     return ret;
 }
@@ -84,23 +139,18 @@ QList<QPoint> GridCore::voidPos(int index) const
 bool GridCore::findVoidPos(GridPos &pos) const
 {
     for (int idx : surfaceIndex()) {
-        const QHash<QPoint, QString> &usedPos = posItem.value(idx);
-        const QSize &size = surfaces.value(idx);
-
         // no void pos
         if (isFull(idx))
             continue;
 
         // find first void pos.
-        for (int x = 0; x < size.width(); ++x)
-            for (int y = 0; y < size.height(); ++y) {
-                QPoint curPos(x, y);
-                if (!usedPos.contains(curPos)) {
-                    pos.first = idx;
-                    pos.second = curPos;
-                    return true;
-                }
-            }
+        GridOccupancy &occ = occupancy(idx);
+        int slot = occ.nextVoid(0);
+        if (slot >= 0) {
+            pos.first = idx;
+            pos.second = occ.point(slot);
+            return true;
+        }
     }
 
     return false;
@@ -144,11 +194,58 @@ void GridCore::removeAll(const QStringList &items)
             if (!itemPos[index].contains(it))
                 continue;
             auto pos = itemPos[index].take(it);
-            posItem[index].remove(pos);
+            release(index, pos);
         }
     }
 }
 
+GridOccupancy &GridCore::occupancy(int index) const
+{
+    GridOccupancy &occ = occupancies[index];
+    const QSize &size = surfaceSize(index);
+    const QHash<QPoint, QString> &used = posItem.value(index);
+
+    // 屏幕大小变化或 posItem 被直接改写过，按当前数据重建
+    if (occ.size != size || !occ.snapshot.isSharedWith(used))
+        occ.reset(size, used);
+
+    return occ;
+}
+
+int GridCore::nextVoidSlot(int index, int from) const
+{
+    return occupancy(index).nextVoid(from);
+}
+
+void GridCore::occupy(int index, const QPoint &pos, const QString &it)
+{
+    GridOccupancy &occ = occupancy(index);
+
+    // 先放开快照，避免修改 posItem 时因共享而复制整张哈希表
+    occ.snapshot = {};
+    QHash<QPoint, QString> &used = posItem[index];
+    used.insert(pos, it);
+    occ.set(pos);
+    occ.snapshot = used;
+}
+
+QString GridCore::release(int index, const QPoint &pos)
+{
+    GridOccupancy &occ = occupancy(index);
+
+    occ.snapshot = {};
+    QHash<QPoint, QString> &used = posItem[index];
+    QString it;
+    auto itor = used.find(pos);
+    if (itor != used.end()) {
+        it = itor.value();
+        used.erase(itor);
+        occ.unset(pos);
+    }
+    occ.snapshot = used;
+    return it;
+}
+
 MoveGridOper::MoveGridOper(GridCore *core)
     : GridCore(*core)
 {
@@ -246,18 +343,20 @@ QStringList AppendOper::appendAfter(QStringList items, int index, const QPoint &
     if (items.isEmpty())
         return items;
 
-    QList<QPoint> posList = voidPos(index);
-    for (const QPoint &pos : posList) {
-        if ((pos.x() > begin.x())
-            || (pos.x() == begin.x() && pos.y() >= begin.y())
-            || DisplayConfig::instance()->autoAlign()) {
-            // all items is appenped
-            if (items.isEmpty())
-                return items;
+    // slot 按先列后行编号，begin 之后的空位即 slot 不小于 begin 的空位；自动排列时从头开始
+    int from = 0;
+    if (!DisplayConfig::instance()->autoAlign()) {
+        const int height = surfaceSize(index).height();
+        from = qMax(0, begin.x() * height + qBound(0, begin.y(), height));
+    }
 
-            QString &&item = items.takeFirst();
-            insert(index, pos, item);
-        }
+    for (int slot = nextVoidSlot(index, from); slot >= 0; slot = nextVoidSlot(index, slot + 1)) {
+        // all items is appenped
+        if (items.isEmpty())
+            return items;
+
+        QString &&item = items.takeFirst();
+        insert(index, occupancy(index).point(slot), item);
     }
 
     return items;
@@ -266,14 +365,13 @@ QStringList AppendOper::appendAfter(QStringList items, int index, const QPoint &
 void AppendOper::append(QStringList items)
 {
     for (int idx : surfaceIndex()) {
-        auto posList = voidPos(idx);
-        for (const QPoint &pos : posList) {
+        for (int slot = nextVoidSlot(idx, 0); slot >= 0; slot = nextVoidSlot(idx, slot + 1)) {
             // all items is appenped
             if (items.isEmpty())
                 return;
 
             QString &&it = items.takeFirst();
-            insert(idx, pos, it);
+            insert(idx, occupancy(idx).point(slot), it);
         }
     }
 
@@ -9,12 +9,42 @@
 
 #include <QMap>
 #include <QSize>
+#include <QVector>
 
 extern uint qHash(const QPoint &key, uint seed);
 
 namespace ddplugin_canvas {
 
 typedef QPair<int, QPoint> GridPos;
+
+// 单个屏幕的栅格占用位图，slot = x * height + y，与原先先列后行的遍历顺序一致。
+// snapshot 与 posItem 中对应屏幕的哈希共享数据，一旦 posItem 被直接改写（不经过
+// GridCore::insert/remove）就不再共享，此时由 GridCore::occupancy 按 posItem 重建。
+struct GridOccupancy
+{
+    QSize size;
+    QVector<quint64> bits;
+    int cursor = 0; // cursor 之前的 slot 都已占用
+    QHash<QPoint, QString> snapshot;
+
+    inline int slotCount() const {
+        return size.width() * size.height();
+    }
+
+    inline int slot(const QPoint &pos) const {
+        return pos.x() * size.height() + pos.y();
+    }
+
+    inline QPoint point(int slot) const {
+        return QPoint(slot / size.height(), slot % size.height());
+    }
+
+    void reset(const QSize &sz, const QHash<QPoint, QString> &used);
+    void set(const QPoint &pos);
+    void unset(const QPoint &pos);
+    int nextVoid(int from);
+};
+
 class GridCore
 {
 protected:
@@ -34,6 +64,11 @@ public:
     virtual bool position(const QString &item, GridPos &pos) const;
     virtual QString item(const GridPos &pos) const;
     virtual void removeAll(const QStringList &items);
+protected:
+    GridOccupancy &occupancy(int index) const;
+    int nextVoidSlot(int index, int from) const;
+    void occupy(int index, const QPoint &pos, const QString &item);
+    QString release(int index, const QPoint &pos);
 public:
     inline QSize surfaceSize(int index) const {
         return surfaces.value(index, QSize(0, 0));
@@ -55,6 +90,8 @@ public:
     QMap<int, QHash<QPoint, QString>> posItem;
     QMap<int, QHash<QString, QPoint>> itemPos;
     QStringList overload;
+protected:
+    mutable QMap<int, GridOccupancy> occupancies;
 };
 
 class MoveGridOper : public GridCore
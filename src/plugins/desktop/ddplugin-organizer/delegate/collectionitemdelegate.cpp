@@ -19,6 +19,7 @@
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/utils/iconutils.h>
 #include <dfm-base/utils/universalutils.h>
+#include <dfm-base/utils/elidetextlayoutcache.h>
 
 #include <dfm-framework/dpf.h>
 
@@ -73,6 +74,7 @@ ElideTextLayout *CollectionItemDelegatePrivate::createTextlayout(const QModelInd
     layout->setAttribute(ElideTextLayout::kWrapMode, (uint)QTextOption::WrapAtWordBoundaryOrAnywhere);
     layout->setAttribute(ElideTextLayout::kLineHeight, lineHeight);
     layout->setAttribute(ElideTextLayout::kAlignment, Qt::AlignHCenter);
+    layout->setCacheEnabled(true);
     if (painter) {
         layout->setAttribute(ElideTextLayout::kFont, painter->font());
         layout->setAttribute(ElideTextLayout::kTextDirection, painter->layoutDirection());
@@ -594,6 +596,8 @@ int CollectionItemDelegate::setIconLevel(int lv)
 
     if (lv >= minimumIconLevel() && lv <= maximumIconLevel()) {
         d->currentIconLevel = lv;
+        // 旧尺寸下的文件名排版不会再用到
+        ElideTextLayoutCache::instance()->clear();
         parent()->setIconSize(iconSize(lv));
         return lv;
     }
@@ -887,7 +891,8 @@ std::optional<QRect> CollectionItemDelegate::paintIcon(QPainter *painter, const
 QRectF CollectionItemDelegate::paintEmblems(QPainter *painter, const QRectF &rect, const FileInfoPointer &info)
 {
     // todo(zy) uing extend painter by registering.
-    if (dpfSlotChannel->push("dfmplugin_emblem", "slot_FileEmblems_Paint", painter, rect, info).toBool()) {
+    static const auto paintHandle { dpfSlotChannel->resolve<bool(QPainter *, QRectF, FileInfoPointer)>("dfmplugin_emblem", "slot_FileEmblems_Paint") };
+    if (paintHandle(painter, rect, info)) {
         static std::once_flag printLog;
         std::call_once(printLog, []() {
             fmInfo() << "publish `kPaintEmblems` event successfully!";
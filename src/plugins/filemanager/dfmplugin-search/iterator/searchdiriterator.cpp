@@ -84,10 +84,10 @@ void SearchDirIteratorPrivate::doSearch()
 void SearchDirIteratorPrivate::onMatched(const QString &id)
 {
     if (taskId == id) {
-        // 直接在主线程更新结果，但使用高效的双缓冲机制
-        const auto &results = SearchManager::instance()->matchedResults(taskId);
+        // 只按游标读取新增的结果，不再拷贝完整结果集
+        const auto &results = SearchManager::instance()->readMatchedResults(taskId, &resultCursor);
         if (!results.isEmpty()) {
-            resultBuffer.updateResults(results);
+            resultBuffer.appendResults(results);
             hasConsumedResults.store(false, std::memory_order_release);   // 标记有新数据
         }
 
@@ -101,6 +101,12 @@ void SearchDirIteratorPrivate::onSearchCompleted(const QString &id)
 {
     if (taskId == id) {
         fmInfo() << "taskId: " << taskId << "search completed!";
+        // 取走最后一次通知之后追加的结果
+        const auto &results = SearchManager::instance()->readMatchedResults(taskId, &resultCursor);
+        if (!results.isEmpty()) {
+            resultBuffer.appendResults(results);
+            hasConsumedResults.store(false, std::memory_order_release);
+        }
         searchFinished.store(true, std::memory_order_release);
     }
 
@@ -190,38 +196,40 @@ QList<QSharedPointer<SortFileInfo>> SearchDirIterator::sortFileInfoList()
 
     const auto results = d->resultBuffer.consumeResults();
 
-    // 如果没有新结果且搜索已完成，返回空
-    if (results.isEmpty() && d->searchFinished.load(std::memory_order_acquire))
+    // 没有新结果时不重复提交
+    if (results.isEmpty()) {
+        d->hasConsumedResults.store(true, std::memory_order_release);
         return {};
+    }
 
-    // TODO (perf) : 存在性能问题，重复获取全量数据
-    // 在子线程中处理数据，不影响主线程
-    // 使用两个QList分别装载文件夹和文件，然后合并
-    // 时间复杂度：O(n)，空间复杂度：O(n)，性能优于stable_partition
-    QList<QSharedPointer<SortFileInfo>> dirs;
-    QList<QSharedPointer<SortFileInfo>> files;
-
-    // 预分配空间以提高性能（可选优化）
-    const int totalCount = results.size();
-    dirs.reserve(totalCount / 4);   // 估算文件夹占比约25%
-    files.reserve(totalCount);   // 文件可能占大部分
-
+    // 只为新增结果创建排序信息并 stat，已有结果直接复用；
+    // 同一URL出现分数更高的结果（如内容匹配）时替换对应的条目
     for (auto it = results.begin(); it != results.end(); ++it) {
+        auto ref = d->sortInfoRefs.find(it.key());
+        if (ref != d->sortInfoRefs.end() && it->matchScore() <= ref->score)
+            continue;
+
         auto sortInfo = QSharedPointer<SortFileInfo>(new SortFileInfo());
         sortInfo->setUrl(it.key());
         sortInfo->setHighlightContent(it->highlightedContent());
         doCompleteSortInfo(sortInfo);
 
-        if (sortInfo->isDir()) {
-            dirs.append(sortInfo);
-        } else {
-            files.append(sortInfo);
+        if (ref != d->sortInfoRefs.end()) {
+            auto &list = ref->isDir ? d->dirInfos : d->fileInfos;
+            list[ref->index] = sortInfo;
+            ref->score = it->matchScore();
+            continue;
         }
+
+        auto &list = sortInfo->isDir() ? d->dirInfos : d->fileInfos;
+        d->sortInfoRefs.insert(it.key(), { sortInfo->isDir(), static_cast<int>(list.size()), it->matchScore() });
+        list.append(sortInfo);
     }
 
-    // 合并结果：文件夹在前，文件在后
-    result = std::move(dirs);
-    result.append(files);
+    // 合并结果：文件夹在前，文件在后，按结果到达的顺序排列
+    result.reserve(d->dirInfos.size() + d->fileInfos.size());
+    result.append(d->dirInfos);
+    result.append(d->fileInfos);
 
     // 标记结果已被消费，避免重复处理
     d->hasConsumedResults.store(true, std::memory_order_release);
@@ -302,42 +310,52 @@ void SearchDirIterator::doCompleteSortInfo(SortInfoPointer sortInfo)
 
 // ======== SearchResultBuffer 实现 ========
 
+void SearchResultBuffer::insertResult(const DFMSearchResult &result)
+{
+    auto existing = pendingResults.find(result.url());
+    if (existing == pendingResults.end())
+        pendingResults.insert(result.url(), result);
+    else if (result.matchScore() > existing->matchScore())
+        *existing = result;
+}
+
 void SearchResultBuffer::updateResults(const DFMSearchResultMap &newResults)
 {
-    QMutexLocker lock(&writerMutex);
-
-    // 写入非活跃缓冲区
-    if (useBufferA.load(std::memory_order_acquire)) {
-        bufferB = newResults;
-        useBufferA.store(false, std::memory_order_release);   // 原子切换
-    } else {
-        bufferA = newResults;
-        useBufferA.store(true, std::memory_order_release);   // 原子切换
+    QMutexLocker lock(&mutex);
+    if (pendingResults.isEmpty()) {
+        pendingResults = newResults;
+        return;
     }
+
+    for (auto it = newResults.cbegin(); it != newResults.cend(); ++it)
+        insertResult(it.value());
+}
+
+void SearchResultBuffer::appendResults(const DFMSearchResultList &newResults)
+{
+    QMutexLocker lock(&mutex);
+    for (const auto &result : newResults)
+        insertResult(result);
 }
 
 DFMSearchResultMap SearchResultBuffer::getResults() const
 {
-    // 无锁读取活跃缓冲区
-    return useBufferA.load(std::memory_order_acquire) ? bufferA : bufferB;
+    QMutexLocker lock(&mutex);
+    return pendingResults;
 }
 
 DFMSearchResultMap SearchResultBuffer::consumeResults()
 {
-    QMutexLocker lock(&writerMutex);
+    QMutexLocker lock(&mutex);
     DFMSearchResultMap results;
-    if (useBufferA.load(std::memory_order_acquire)) {
-        results.swap(bufferA);
-    } else {
-        results.swap(bufferB);
-    }
+    results.swap(pendingResults);
     return results;
 }
 
 bool SearchResultBuffer::isEmpty() const
 {
-    // 检查当前活跃缓冲区是否为空
-    return useBufferA.load(std::memory_order_acquire) ? bufferA.isEmpty() : bufferB.isEmpty();
+    QMutexLocker lock(&mutex);
+    return pendingResults.isEmpty();
 }
 
 }
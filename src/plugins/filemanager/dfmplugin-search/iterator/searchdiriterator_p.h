@@ -14,6 +14,7 @@
 
 #include <QObject>
 #include <QUrl>
+#include <QHash>
 #include <QMutex>
 #include <QScopedPointer>
 #include <QWaitCondition>
@@ -24,30 +25,31 @@ DFMBASE_USE_NAMESPACE
 
 namespace dfmplugin_search {
 
-// 双缓冲搜索结果管理器
+// 增量搜索结果缓冲：主线程追加新结果，遍历线程整批取走
 class SearchResultBuffer
 {
 public:
     SearchResultBuffer() = default;
     ~SearchResultBuffer() = default;
 
-    // 生产者：更新搜索结果（主线程调用）
+    // 生产者：追加搜索结果，同一URL保留分数更高的（主线程调用）
     void updateResults(const DFMSearchResultMap &newResults);
+    void appendResults(const DFMSearchResultList &newResults);
 
-    // 消费者：获取当前搜索结果快照（子线程调用）
+    // 消费者：获取当前未消费结果的快照（子线程调用）
     DFMSearchResultMap getResults() const;
 
-    // 消费者：获取并清空当前搜索结果（子线程调用）
+    // 消费者：获取并清空当前未消费的结果（子线程调用）
     DFMSearchResultMap consumeResults();
 
     // 检查是否有数据
     bool isEmpty() const;
 
 private:
-    mutable DFMSearchResultMap bufferA;
-    mutable DFMSearchResultMap bufferB;
-    std::atomic<bool> useBufferA { true };
-    mutable QMutex writerMutex;   // 只保护写操作
+    void insertResult(const DFMSearchResult &result);
+
+    DFMSearchResultMap pendingResults;
+    mutable QMutex mutex;
 };
 
 class SearchDirIterator;
@@ -77,7 +79,19 @@ public:
     std::atomic<bool> searchFinished { false };   // 搜索是否完成(原子操作保证线程安全)
     std::atomic<bool> searchStoped { false };   // 搜索是否停止(原子操作保证线程安全)
 
-    SearchResultBuffer resultBuffer;   // 双缓冲搜索结果
+    SearchResultBuffer resultBuffer;   // 尚未转换的增量搜索结果
+    qsizetype resultCursor { 0 };   // 已从搜索任务读取到的位置（主线程使用）
+
+    // 已转换的排序信息，只在遍历线程中访问；每次只为新增结果做 stat
+    struct SortInfoRef
+    {
+        bool isDir { false };
+        int index { 0 };
+        double score { 0.0 };
+    };
+    QList<SortInfoPointer> dirInfos;
+    QList<SortInfoPointer> fileInfos;
+    QHash<QUrl, SortInfoRef> sortInfoRefs;
     QScopedPointer<LocalFileWatcher> searchRootWatcher;   // 文件监视器
     std::once_flag searchOnceFlag;   // 一次性标志
     SearchDirIterator *q = nullptr;   // 指向父类的指针
@@ -71,6 +71,14 @@ DFMSearchResultMap MainController::getResults(QString taskId)
     return {};
 }
 
+DFMSearchResultList MainController::readResults(QString taskId, qsizetype *cursor)
+{
+    if (taskManager.contains(taskId))
+        return taskManager[taskId]->readResults(cursor);
+
+    return {};
+}
+
 QList<QUrl> MainController::getResultUrls(QString taskId)
 {
     if (taskManager.contains(taskId))
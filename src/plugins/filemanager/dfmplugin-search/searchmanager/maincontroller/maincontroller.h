@@ -26,6 +26,7 @@ private:
     
     // 获取统一的搜索结果
     DFMSearchResultMap getResults(QString taskId);
+    DFMSearchResultList readResults(QString taskId, qsizetype *cursor);
     
     // 为兼容性保留的接口
     QList<QUrl> getResultUrls(QString taskId);
@@ -7,6 +7,7 @@
 #include "searchmanager/searcher/abstractsearcher.h"
 #include "searchmanager/searcher/dfmsearch/dfmsearcher.h"
 #include "searchmanager/searcher/iterator/iteratorsearcher.h"
+#include "searchmanager/searcher/realtime/realtimesearcher.h"
 #include "utils/searchhelper.h"
 
 #include <dfm-base/base/urlroute.h>
@@ -36,14 +37,12 @@ SimplifiedSearchWorker::~SimplifiedSearchWorker()
 
 DFMSearchResultMap SimplifiedSearchWorker::getResults()
 {
-    QReadLocker locker(&rwLock);
-    return resultMap;
+    return resultStore ? resultStore->compacted() : DFMSearchResultMap();
 }
 
 QList<QUrl> SimplifiedSearchWorker::getResultUrls()
 {
-    QReadLocker locker(&rwLock);
-    return resultMap.keys();
+    return getResults().keys();
 }
 
 void SimplifiedSearchWorker::startSearch()
@@ -52,10 +51,7 @@ void SimplifiedSearchWorker::startSearch()
     isRunning = true;
     finishedSearcherCount = 0;
 
-    {
-        QWriteLocker locker(&rwLock);
-        resultMap.clear();
-    }
+    // 结果存储只追加且与 TaskCommander 共享，每个任务只会启动一次搜索，这里不再清空
 
     // 创建搜索器并启动搜索
     createSearchers();
@@ -139,10 +135,17 @@ void SimplifiedSearchWorker::createSearchersForUrl(const QUrl &url)
         searchTypes.append(SearchType::Content);
     }
 
+    // 网络挂载没有索引，文件名搜索交给并行实时搜索
+    const bool useRealtime = RealtimeSearcher::supportUrl(url);
+
     // 为每种搜索类型创建搜索器
     for (auto type : searchTypes) {
         // 使用DFMSearcher作为默认搜索器
-        AbstractSearcher *searcher = new DFMSearcher(url, searchKeyword, this, type);
+        AbstractSearcher *searcher = nullptr;
+        if (useRealtime && type == SearchType::FileName)
+            searcher = new RealtimeSearcher(url, searchKeyword, this);
+        else
+            searcher = new DFMSearcher(url, searchKeyword, this, type);
 
         // 连接信号
         connect(searcher, &AbstractSearcher::unearthed, this, &SimplifiedSearchWorker::onSearcherUnearthed);
@@ -187,35 +190,9 @@ void SimplifiedSearchWorker::mergeResults(AbstractSearcher *searcher)
     if (!searcher || !searcher->hasItem())
         return;
 
-    // 获取新结果
-    DFMSearchResultMap newResults = searcher->takeAll();
-
-    if (newResults.isEmpty())
-        return;
-
-    // 合并到主结果集
-    {
-        QWriteLocker locker(&rwLock);
-
-        // 第一次直接复制结果
-        if (resultMap.isEmpty()) {
-            resultMap = newResults;
-            return;
-        }
-
-        // 合并结果，保留匹配分数更高的结果
-        for (auto it = newResults.constBegin(); it != newResults.constEnd(); ++it) {
-            const QUrl &url = it.key();
-            auto existing = resultMap.find(url);
-
-            if (existing != resultMap.end()) {
-                if (it.value().matchScore() > existing.value().matchScore())
-                    resultMap[url] = it.value();
-            } else {
-                resultMap.insert(url, it.value());
-            }
-        }
-    }
+    // 只追加不去重，去重留给需要完整结果的 getResults
+    if (resultStore)
+        resultStore->append(searcher->takeAll());
 }
 
 void SimplifiedSearchWorker::onSearcherFinished()
@@ -239,6 +216,10 @@ void SimplifiedSearchWorker::onSearcherFinished()
 
     // 所有搜索器完成时通知搜索完成
     if (searchers.isEmpty() && isRunning) {
+        // 在工作线程中完成去重，之后获取完整结果只需拷贝
+        if (resultStore)
+            resultStore->compacted();
+
         // 通知搜索完成
         emit searchCompleted(taskId);
 
@@ -255,7 +236,9 @@ TaskCommanderPrivate::TaskCommanderPrivate(TaskCommander *parent)
       deleted(false)
 {
     // 创建搜索工作线程
+    resultStore.reset(new SearchResultStore);
     searchWorker = new SimplifiedSearchWorker;
+    searchWorker->setResultStore(resultStore);
     searchWorker->moveToThread(&workerThread);
 
     // 连接信号
@@ -334,6 +317,12 @@ DFMSearchResultMap TaskCommander::getResults() const
     return results;
 }
 
+DFMSearchResultList TaskCommander::readResults(qsizetype *cursor) const
+{
+    // 存储只追加，可以直接在调用线程中无锁读取增量
+    return d->resultStore ? d->resultStore->read(cursor) : DFMSearchResultList();
+}
+
 QList<QUrl> TaskCommander::getResultsUrls() const
 {
     if (!d->searchWorker) {
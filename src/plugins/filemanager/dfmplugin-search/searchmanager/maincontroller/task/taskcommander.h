@@ -29,6 +29,8 @@ private:
     // 获取搜索结果
     DFMSearchResultMap getResults() const;
     QList<QUrl> getResultsUrls() const;
+    // 按游标获取新增结果，可能包含重复的URL
+    DFMSearchResultList readResults(qsizetype *cursor) const;
     
     // 控制搜索流程
     bool start();
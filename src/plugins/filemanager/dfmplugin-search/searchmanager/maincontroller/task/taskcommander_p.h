@@ -7,16 +7,17 @@
 
 #include "taskcommander.h"
 #include "searchmanager/searcher/abstractsearcher.h"
+#include "searchmanager/searcher/searchresultstore.h"
 
 #include <dfm-search/dsearch_global.h>
 #include <dfm-search/contentsearchapi.h>
 
 #include <QObject>
 #include <QList>
-#include <QReadWriteLock>
 #include <QAtomicInt>
 #include <QMap>
 #include <QSet>
+#include <QSharedPointer>
 #include <QThread>
 #include <QMutex>
 #include <QTimer>
@@ -35,6 +36,7 @@ public:
     Q_INVOKABLE void setTaskId(const QString &id) { taskId = id; }
     Q_INVOKABLE void setSearchUrl(const QUrl &url) { searchUrl = url; }
     Q_INVOKABLE void setKeyword(const QString &keyword) { searchKeyword = keyword; }
+    void setResultStore(const QSharedPointer<SearchResultStore> &store) { resultStore = store; }
 
     // 获取结果
     Q_INVOKABLE DFMSearchResultMap getResults();
@@ -67,10 +69,8 @@ private:
     QString searchKeyword;
 
     QList<AbstractSearcher *> searchers;
-    DFMSearchResultMap resultMap;
-
-    QReadWriteLock rwLock;
-    QMutex mutex;
+    // 与 TaskCommander 共享，工作线程只追加，读取方按游标取增量
+    QSharedPointer<SearchResultStore> resultStore;
 
     bool isRunning { false };
     int finishedSearcherCount { 0 };
@@ -98,6 +98,7 @@ private:
 
     QThread workerThread;
     SimplifiedSearchWorker *searchWorker { nullptr };
+    QSharedPointer<SearchResultStore> resultStore;
 
     bool deleted { false };
 };
@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "namematcher.h"
+#include "utils/searchhelper.h"
+
+#include <QFile>
+
+#include <cstring>
+
+DPSEARCH_USE_NAMESPACE
+
+namespace {
+// NAME_MAX 为 255，超出时走 QString 匹配
+constexpr int kMaxNameLength { 1024 };
+
+inline char asciiLower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+// 简单循环便于编译器向量化
+inline void lowerAscii(const char *src, int length, char *dst)
+{
+    for (int i = 0; i < length; ++i)
+        dst[i] = asciiLower(src[i]);
+}
+
+bool isAscii(const QString &str)
+{
+    for (const QChar &c : str) {
+        if (c.unicode() >= 0x80)
+            return false;
+    }
+    return true;
+}
+}   // namespace
+
+NameMatcher::NameMatcher(const QString &keyword)
+{
+    // 与 checkWildcardAndToRegularExpression 一致：不含通配符时视为 *keyword*
+    const bool hasWildcard = keyword.contains('*') || keyword.contains('?');
+    const QString &pattern = hasWildcard ? keyword : '*' + keyword + '*';
+
+    int begin = 0;
+    int end = pattern.size();
+    while (begin < end && pattern.at(begin) == '*')
+        ++begin;
+    while (end > begin && pattern.at(end - 1) == '*')
+        --end;
+
+    const QString &core = pattern.mid(begin, end - begin);
+    if (core.isEmpty()) {
+        matchMode = Mode::kAll;
+        return;
+    }
+
+    // 中间还有通配符、字符集或转义时交给正则表达式
+    static const QString kComplexChars { "*?[\\" };
+    for (const QChar &c : core) {
+        if (kComplexChars.contains(c)) {
+            matchMode = Mode::kRegex;
+            regex = QRegularExpression(SearchHelper::instance()->wildcardToRegularExpression(pattern),
+                                       QRegularExpression::CaseInsensitiveOption);
+            return;
+        }
+    }
+
+    const bool leading = begin > 0;
+    const bool trailing = end < pattern.size();
+    if (leading && trailing)
+        matchMode = Mode::kContains;
+    else if (leading)
+        matchMode = Mode::kSuffix;
+    else if (trailing)
+        matchMode = Mode::kPrefix;
+    else
+        matchMode = Mode::kExact;
+
+    needle = core;
+    if (isAscii(core))
+        asciiNeedle = core.toLatin1().toLower();
+}
+
+bool NameMatcher::matches(QStringView name) const
+{
+    switch (matchMode) {
+    case Mode::kAll:
+        return true;
+    case Mode::kContains:
+        return name.contains(needle, Qt::CaseInsensitive);
+    case Mode::kPrefix:
+        return name.startsWith(needle, Qt::CaseInsensitive);
+    case Mode::kSuffix:
+        return name.endsWith(needle, Qt::CaseInsensitive);
+    case Mode::kExact:
+        return name.compare(needle, Qt::CaseInsensitive) == 0;
+    case Mode::kRegex:
+        return regex.match(name.toString()).hasMatch();
+    }
+    return false;
+}
+
+bool NameMatcher::matches(const char *name, int length) const
+{
+    if (matchMode == Mode::kAll)
+        return true;
+
+    if (asciiNeedle.isEmpty() || length > kMaxNameLength)
+        return matches(QFile::decodeName(QByteArray::fromRawData(name, length)));
+
+    // ASCII 字节不会出现在 UTF-8 多字节序列中，因此可以直接比较原始字节
+    const int needleLength = asciiNeedle.size();
+    if (length < needleLength)
+        return false;
+
+    char lowered[kMaxNameLength];
+    switch (matchMode) {
+    case Mode::kContains:
+        lowerAscii(name, length, lowered);
+        return ::memmem(lowered, static_cast<size_t>(length), asciiNeedle.constData(), static_cast<size_t>(needleLength)) != nullptr;
+    case Mode::kPrefix:
+        lowerAscii(name, needleLength, lowered);
+        return std::memcmp(lowered, asciiNeedle.constData(), static_cast<size_t>(needleLength)) == 0;
+    case Mode::kSuffix:
+        lowerAscii(name + length - needleLength, needleLength, lowered);
+        return std::memcmp(lowered, asciiNeedle.constData(), static_cast<size_t>(needleLength)) == 0;
+    case Mode::kExact:
+        if (length != needleLength)
+            return false;
+        lowerAscii(name, length, lowered);
+        return std::memcmp(lowered, asciiNeedle.constData(), static_cast<size_t>(needleLength)) == 0;
+    default:
+        break;
+    }
+
+    return matches(QFile::decodeName(QByteArray::fromRawData(name, length)));
+}
@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef NAMEMATCHER_H
+#define NAMEMATCHER_H
+
+#include "dfmplugin_search_global.h"
+
+#include <QByteArray>
+#include <QRegularExpression>
+#include <QString>
+
+DPSEARCH_BEGIN_NAMESPACE
+
+/**
+ * @brief 预编译的文件名匹配器，忽略大小写
+ *
+ * 关键字的规则与 SearchHelper::checkWildcardAndToRegularExpression 一致：不含通配符时按子串匹配，
+ * 否则按通配符匹配。只有首尾带 '*' 的简单模式会被转换为子串、前缀、后缀或全等比较，
+ * 其余模式才回退到 QRegularExpression。
+ * 关键字为纯 ASCII 时可直接在原始文件名字节上匹配，无需先解码为 QString。
+ */
+class NameMatcher
+{
+public:
+    enum class Mode {
+        kAll,
+        kContains,
+        kPrefix,
+        kSuffix,
+        kExact,
+        kRegex
+    };
+
+    explicit NameMatcher(const QString &keyword);
+
+    Mode mode() const { return matchMode; }
+    // 是否可以直接使用 matches(const char *, int)
+    bool canMatchBytes() const { return matchMode == Mode::kAll || !asciiNeedle.isEmpty(); }
+
+    bool matches(QStringView name) const;
+    // name 为 UTF-8 编码的文件名；不能按字节匹配时先解码再匹配
+    bool matches(const char *name, int length) const;
+
+private:
+    Mode matchMode { Mode::kAll };
+    QString needle;
+    QByteArray asciiNeedle;   // 小写的 ASCII 关键字，关键字含非 ASCII 字符时为空
+    QRegularExpression regex;
+};
+
+DPSEARCH_END_NAMESPACE
+
+#endif   // NAMEMATCHER_H
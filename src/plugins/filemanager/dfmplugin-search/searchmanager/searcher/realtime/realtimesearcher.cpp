@@ -0,0 +1,293 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "realtimesearcher.h"
+#include "searchmanager/searcher/dfmsearch/dfmsearcher.h"
+
+#include <dfm-base/base/application/application.h>
+#include <dfm-base/base/configs/dconfig/dconfigmanager.h>
+#include <dfm-base/base/device/deviceproxymanager.h>
+#include <dfm-base/file/local/nativedirenumerator.h>
+
+#include <dfm-search/dsearch_global.h>
+#include <dfm-io/dfmio_utils.h>
+
+#include <QElapsedTimer>
+#include <QThread>
+
+#include <algorithm>
+#include <cstring>
+
+DFMBASE_USE_NAMESPACE
+DPSEARCH_USE_NAMESPACE
+
+namespace {
+constexpr int kMaxWalkerCount { 8 };
+// 每个遍历线程攒够这么多结果或超过这个时间就合并一次
+constexpr int kBatchResultLimit { 200 };
+constexpr int kBatchTimeLimit { 200 };   // 毫秒
+// 没有目录可取时的等待时间，兜底避免漏掉唤醒
+constexpr unsigned long kIdleWaitMs { 5 };
+constexpr int kLocalBatchCount { 1024 };
+}   // namespace
+
+RealtimeSearcher::RealtimeSearcher(const QUrl &url, const QString &key, QObject *parent)
+    : AbstractSearcher(url, key, parent),
+      matcher(key)
+{
+    const int walkerCount = qBound(2, QThread::idealThreadCount(), kMaxWalkerCount);
+    walkerPool.setMaxThreadCount(walkerCount);
+    for (int i = 0; i < walkerCount; ++i)
+        queues.emplace_back(new WalkerQueue);
+}
+
+RealtimeSearcher::~RealtimeSearcher()
+{
+    status.storeRelease(kTerminated);
+    idleCondition.wakeAll();
+    walkerPool.waitForDone();
+}
+
+bool RealtimeSearcher::isEnabled()
+{
+    return DConfigManager::instance()->value(DConfig::kSearchCfgPath, DConfig::kEnableRealtimeSearchEngine, true).toBool();
+}
+
+bool RealtimeSearcher::supportUrl(const QUrl &url)
+{
+    if (!isEnabled())
+        return false;
+
+    // 其他协议的迭代器只能在主线程中创建，仍由 IteratorSearcher 通过主线程桥接处理
+    if (!url.isLocalFile())
+        return false;
+
+    return DevProxyMng->isFileOfProtocolMounts(DFMSearcher::realSearchPath(url));
+}
+
+bool RealtimeSearcher::search()
+{
+    if (!status.testAndSetRelease(kReady, kRuning)) {
+        fmWarning() << "Failed to start realtime search - invalid state transition, current status:" << status.loadAcquire();
+        return false;
+    }
+
+    // 与 DFMSearcher 保持一致：在隐藏目录中搜索时总是包含隐藏文件
+    const QString &path = DFMSearcher::realSearchPath(searchUrl);
+    includeHidden = Application::instance()->genericAttribute(Application::kShowedHiddenFiles).toBool()
+            || DFMSEARCH::Global::isHiddenPathOrInHiddenDir(path);
+    searchUrl = QUrl::fromLocalFile(path);
+
+    fmInfo() << "Start realtime search for keyword:" << keyword << "in:" << searchUrl
+             << "walkers:" << queues.size() << "match mode:" << static_cast<int>(matcher.mode());
+
+    pushDirectories(0, { searchUrl });
+    activeWalkerCount.storeRelease(static_cast<int>(queues.size()));
+    for (int i = 0; i < static_cast<int>(queues.size()); ++i)
+        walkerPool.start([this, i]() { walk(i); });
+
+    return true;
+}
+
+void RealtimeSearcher::stop()
+{
+    const int previousState = status.fetchAndStoreRelease(kTerminated);
+    idleCondition.wakeAll();
+
+    if (previousState == kRuning) {
+        if (hasItem())
+            emit unearthed(this);
+
+        emit finished();
+    }
+}
+
+bool RealtimeSearcher::hasItem() const
+{
+    QMutexLocker lk(&mutex);
+    return !resultMap.isEmpty();
+}
+
+DFMSearchResultMap RealtimeSearcher::takeAll()
+{
+    QMutexLocker lk(&mutex);
+    DFMSearchResultMap results = std::move(resultMap);
+    resultMap.clear();
+    notifyPending.storeRelease(0);
+    return results;
+}
+
+void RealtimeSearcher::walk(int index)
+{
+    DFMSearchResultMap results;
+    QElapsedTimer batchTimer;
+    batchTimer.start();
+
+    QUrl dir;
+    while (takeDirectory(index, &dir)) {
+        QList<QUrl> subDirs;
+        scanLocalDirectory(dir, &subDirs, &results);
+
+        // 先入队子目录再减去当前目录，计数才不会提前归零
+        pushDirectories(index, subDirs);
+        if (pendingDirCount.fetchAndSubOrdered(1) == 1)
+            idleCondition.wakeAll();
+
+        if (results.size() >= kBatchResultLimit || (!results.isEmpty() && batchTimer.elapsed() >= kBatchTimeLimit)) {
+            commitResults(&results);
+            batchTimer.restart();
+        }
+    }
+
+    commitResults(&results);
+    if (activeWalkerCount.fetchAndSubOrdered(1) == 1)
+        onWalkersFinished();
+}
+
+bool RealtimeSearcher::takeDirectory(int index, QUrl *dir)
+{
+    const int count = static_cast<int>(queues.size());
+    while (status.loadAcquire() == kRuning) {
+        {
+            WalkerQueue *own = queues[static_cast<size_t>(index)].get();
+            QMutexLocker lk(&own->mutex);
+            if (!own->dirs.empty()) {
+                *dir = std::move(own->dirs.back());
+                own->dirs.pop_back();
+                return true;
+            }
+        }
+
+        for (int i = 1; i < count; ++i) {
+            WalkerQueue *victim = queues[static_cast<size_t>((index + i) % count)].get();
+            QMutexLocker lk(&victim->mutex);
+            if (!victim->dirs.empty()) {
+                *dir = std::move(victim->dirs.front());
+                victim->dirs.pop_front();
+                return true;
+            }
+        }
+
+        if (pendingDirCount.loadAcquire() == 0)
+            return false;
+
+        QMutexLocker lk(&idleMutex);
+        idleWalkerCount.ref();
+        idleCondition.wait(&idleMutex, kIdleWaitMs);
+        idleWalkerCount.deref();
+    }
+
+    return false;
+}
+
+void RealtimeSearcher::pushDirectories(int index, const QList<QUrl> &dirs)
+{
+    if (dirs.isEmpty())
+        return;
+
+    pendingDirCount.fetchAndAddOrdered(static_cast<int>(dirs.size()));
+    {
+        WalkerQueue *own = queues[static_cast<size_t>(index)].get();
+        QMutexLocker lk(&own->mutex);
+        own->dirs.insert(own->dirs.end(), dirs.cbegin(), dirs.cend());
+    }
+
+    if (idleWalkerCount.loadAcquire() > 0)
+        idleCondition.wakeAll();
+}
+
+void RealtimeSearcher::scanLocalDirectory(const QUrl &dir, QList<QUrl> *subDirs, DFMSearchResultMap *results)
+{
+    const QString &dirPath = dir.toLocalFile();
+    if (dirPath.startsWith("/sys/"))
+        return;
+
+    NativeDirEnumerator enumerator(dirPath);
+    enumerator.setTypeOnly(true);
+    if (!enumerator.open())
+        return;
+
+    const QString &prefix = dirPath.endsWith('/') ? dirPath : dirPath + '/';
+    QStringList dirNames;
+    QStringList matchedNames;
+    bool hasHiddenList = false;
+
+    NativeDirEnumerator::Batch batch;
+    while (status.loadAcquire() == kRuning && enumerator.nextBatch(&batch, kLocalBatchCount)) {
+        for (const auto &entry : std::as_const(batch.entries)) {
+            const char *name = batch.names.constData() + entry.nameOffset;
+            if (entry.isHidden && !includeHidden) {
+                if (entry.nameLength == 7 && std::memcmp(name, ".hidden", 7) == 0)
+                    hasHiddenList = true;
+                continue;
+            }
+
+            const bool descend = entry.isDir && !entry.isSymlink;
+            const bool matched = matcher.matches(name, entry.nameLength);
+            if (!descend && !matched)
+                continue;
+
+            const QString &fileName = batch.fileName(entry);
+            if (descend)
+                dirNames.append(fileName);
+            if (matched)
+                matchedNames.append(fileName);
+        }
+    }
+
+    // .hidden 中列出的文件同样视为隐藏文件
+    if (hasHiddenList) {
+        const auto &hiddenNames = DFMIO::DFMUtils::hideListFromUrl(QUrl::fromLocalFile(prefix + ".hidden"));
+        if (!hiddenNames.isEmpty()) {
+            auto isHidden = [&hiddenNames](const QString &name) { return hiddenNames.contains(name); };
+            dirNames.erase(std::remove_if(dirNames.begin(), dirNames.end(), isHidden), dirNames.end());
+            matchedNames.erase(std::remove_if(matchedNames.begin(), matchedNames.end(), isHidden), matchedNames.end());
+        }
+    }
+
+    subDirs->reserve(subDirs->size() + dirNames.size());
+    for (const QString &name : std::as_const(dirNames))
+        subDirs->append(QUrl::fromLocalFile(prefix + name));
+    for (const QString &name : std::as_const(matchedNames))
+        addResult(QUrl::fromLocalFile(prefix + name), results);
+}
+
+void RealtimeSearcher::addResult(const QUrl &url, DFMSearchResultMap *results) const
+{
+    DFMSearchResult result(url);
+    result.setIsContentMatch(false);
+    result.setMatchScore(0.5);   // 与 DFMSearcher 的文件名匹配分数一致
+    results->insert(url, result);
+}
+
+void RealtimeSearcher::commitResults(DFMSearchResultMap *results)
+{
+    if (results->isEmpty())
+        return;
+
+    {
+        QMutexLocker lk(&mutex);
+        if (resultMap.isEmpty()) {
+            resultMap.swap(*results);
+        } else {
+            for (auto it = results->cbegin(); it != results->cend(); ++it)
+                resultMap.insert(it.key(), it.value());
+        }
+    }
+    results->clear();
+
+    // 上一批结果还没有被取走时不重复通知
+    if (status.loadAcquire() == kRuning && notifyPending.fetchAndStoreOrdered(1) == 0)
+        emit unearthed(this);
+}
+
+void RealtimeSearcher::onWalkersFinished()
+{
+    if (!status.testAndSetRelease(kRuning, kCompleted))
+        return;
+
+    // 剩余结果由 finished 的处理方一并取走
+    fmInfo() << "Realtime search completed for keyword:" << keyword << "in:" << searchUrl;
+    emit finished();
+}
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef REALTIMESEARCHER_H
+#define REALTIMESEARCHER_H
+
+#include "searchmanager/searcher/abstractsearcher.h"
+#include "namematcher.h"
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+DPSEARCH_BEGIN_NAMESPACE
+
+/**
+ * @brief 无索引时的实时文件名搜索
+ *
+ * 多个目录遍历线程各自维护一个待处理目录队列：自己从队尾取（深度优先，局部性好），
+ * 空闲时从其他线程的队首窃取（通常是较大的子树）。遍历完全在线程池中进行，不经过主线程：
+ * 目录通过 NativeDirEnumerator 读取，只用 d_type 判断类型。只支持本地路径，
+ * 其他协议的迭代器依赖主线程，仍由 IteratorSearcher 处理。
+ * 匹配结果先在各线程内攒批，再合并到结果集并通过 unearthed 通知，上一批未被取走前不重复通知。
+ */
+class RealtimeSearcher : public AbstractSearcher
+{
+    Q_OBJECT
+    friend class TaskCommander;
+    friend class TaskCommanderPrivate;
+    friend class SimplifiedSearchWorker;
+
+public:
+    explicit RealtimeSearcher(const QUrl &url, const QString &key, QObject *parent = nullptr);
+    ~RealtimeSearcher() override;
+
+    static bool isEnabled();
+    // 本地路径中只接管网络挂载（如 smb、ftp），其余仍由 DFMSearcher 处理
+    static bool supportUrl(const QUrl &url);
+
+    bool search() override;
+    void stop() override;
+    bool hasItem() const override;
+    DFMSearchResultMap takeAll() override;
+
+private:
+    struct WalkerQueue
+    {
+        QMutex mutex;
+        std::deque<QUrl> dirs;
+    };
+
+    void walk(int index);
+    bool takeDirectory(int index, QUrl *dir);
+    void pushDirectories(int index, const QList<QUrl> &dirs);
+    void scanLocalDirectory(const QUrl &dir, QList<QUrl> *subDirs, DFMSearchResultMap *results);
+    void addResult(const QUrl &url, DFMSearchResultMap *results) const;
+    void commitResults(DFMSearchResultMap *results);
+    void onWalkersFinished();
+
+private:
+    QAtomicInt status = kReady;
+    NameMatcher matcher;
+    bool includeHidden { false };
+
+    QThreadPool walkerPool;
+    std::vector<std::unique_ptr<WalkerQueue>> queues;
+    QAtomicInt pendingDirCount { 0 };   // 已入队但尚未处理完的目录数
+    QAtomicInt activeWalkerCount { 0 };
+    QAtomicInt idleWalkerCount { 0 };
+    QMutex idleMutex;
+    QWaitCondition idleCondition;
+
+    mutable QMutex mutex;
+    DFMSearchResultMap resultMap;
+    QAtomicInt notifyPending { 0 };
+};
+
+DPSEARCH_END_NAMESPACE
+
+#endif   // REALTIMESEARCHER_H
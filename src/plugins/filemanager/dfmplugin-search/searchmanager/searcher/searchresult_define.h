@@ -8,6 +8,7 @@
 #include "dfmplugin_search_global.h"
 
 #include <QUrl>
+#include <QList>
 #include <QMap>
 #include <QSharedData>
 
@@ -53,6 +54,8 @@ private:
 
 // 使用QMap的优点：1.按URL自动排序 2.自动去重 3.提供高效查找
 typedef QMap<QUrl, DFMSearchResult> DFMSearchResultMap;
+// 按产生顺序排列的增量结果，可能包含重复的URL
+typedef QList<DFMSearchResult> DFMSearchResultList;
 
 DPSEARCH_END_NAMESPACE
 
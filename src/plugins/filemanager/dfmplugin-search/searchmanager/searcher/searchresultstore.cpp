@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "searchresultstore.h"
+
+#include <new>
+
+DPSEARCH_USE_NAMESPACE
+
+// 未初始化的存储，避免为每个槽位预先分配 DFMSearchResultData
+struct SearchResultStore::Chunk
+{
+    alignas(DFMSearchResult) unsigned char storage[kChunkSize * sizeof(DFMSearchResult)];
+
+    DFMSearchResult *slot(qsizetype index)
+    {
+        return reinterpret_cast<DFMSearchResult *>(storage) + index;
+    }
+};
+
+SearchResultStore::SearchResultStore()
+{
+}
+
+SearchResultStore::~SearchResultStore()
+{
+    const qsizetype count = publishedCount.load(std::memory_order_acquire);
+    for (qsizetype i = 0; i < count; ++i)
+        chunks[i / kChunkSize].load(std::memory_order_relaxed)->slot(i % kChunkSize)->~DFMSearchResult();
+
+    for (auto &chunk : chunks)
+        delete chunk.load(std::memory_order_relaxed);
+}
+
+void SearchResultStore::append(const DFMSearchResultMap &results)
+{
+    if (results.isEmpty())
+        return;
+
+    qsizetype count = publishedCount.load(std::memory_order_relaxed);
+    for (auto it = results.cbegin(); it != results.cend(); ++it) {
+        if (count >= kChunkSize * kMaxChunks) {
+            if (!overflowWarned) {
+                fmWarning() << "Search result store is full, further results are dropped, count:" << count;
+                overflowWarned = true;
+            }
+            break;
+        }
+
+        auto &chunkRef = chunks[count / kChunkSize];
+        Chunk *chunk = chunkRef.load(std::memory_order_relaxed);
+        if (!chunk) {
+            chunk = new Chunk;
+            chunkRef.store(chunk, std::memory_order_release);
+        }
+
+        new (chunk->slot(count % kChunkSize)) DFMSearchResult(it.value());
+        ++count;
+    }
+
+    // 整批写完后再发布，读者不会看到未构造完成的槽位
+    publishedCount.store(count, std::memory_order_release);
+}
+
+qsizetype SearchResultStore::size() const
+{
+    return publishedCount.load(std::memory_order_acquire);
+}
+
+const DFMSearchResult &SearchResultStore::itemAt(qsizetype index) const
+{
+    return *chunks[index / kChunkSize].load(std::memory_order_acquire)->slot(index % kChunkSize);
+}
+
+DFMSearchResultList SearchResultStore::read(qsizetype *cursor) const
+{
+    Q_ASSERT(cursor);
+    const qsizetype count = publishedCount.load(std::memory_order_acquire);
+    DFMSearchResultList results;
+    if (*cursor >= count)
+        return results;
+
+    results.reserve(count - *cursor);
+    for (qsizetype i = *cursor; i < count; ++i)
+        results.append(itemAt(i));
+
+    *cursor = count;
+    return results;
+}
+
+DFMSearchResultMap SearchResultStore::compacted() const
+{
+    QMutexLocker lk(&compactMutex);
+    const qsizetype count = publishedCount.load(std::memory_order_acquire);
+    for (qsizetype i = compactedCount; i < count; ++i) {
+        const DFMSearchResult &result = itemAt(i);
+        auto existing = compactedResults.find(result.url());
+        if (existing == compactedResults.end())
+            compactedResults.insert(result.url(), result);
+        else if (result.matchScore() > existing->matchScore())
+            *existing = result;
+    }
+    compactedCount = count;
+
+    return compactedResults;
+}
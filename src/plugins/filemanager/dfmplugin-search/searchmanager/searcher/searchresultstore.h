@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SEARCHRESULTSTORE_H
+#define SEARCHRESULTSTORE_H
+
+#include "searchresult_define.h"
+
+#include <QMutex>
+
+#include <atomic>
+
+DPSEARCH_BEGIN_NAMESPACE
+
+/**
+ * @brief 只追加的分块搜索结果存储
+ *
+ * 结果按到达顺序写入固定大小的块中，块目录预先分配，写入后的槽位不再修改，
+ * 因此读者只需读取已发布的数量即可无锁地按游标获取增量结果。
+ * 写入时不做去重，按 URL 去重（保留分数高的结果）在 compacted() 中增量完成，
+ * 只有需要完整结果集的调用方才会触发。
+ *
+ * 只允许一个线程写入（搜索工作线程），读取可以在任意线程进行。
+ */
+class SearchResultStore
+{
+    Q_DISABLE_COPY(SearchResultStore)
+
+public:
+    SearchResultStore();
+    ~SearchResultStore();
+
+    void append(const DFMSearchResultMap &results);
+    qsizetype size() const;
+
+    // 读取游标之后新增的结果，并把游标移动到末尾
+    DFMSearchResultList read(qsizetype *cursor) const;
+
+    // 按 URL 去重后的完整结果
+    DFMSearchResultMap compacted() const;
+
+private:
+    struct Chunk;
+    const DFMSearchResult &itemAt(qsizetype index) const;
+
+    static constexpr qsizetype kChunkSize { 4096 };
+    static constexpr qsizetype kMaxChunks { 4096 };
+
+    std::atomic<Chunk *> chunks[kMaxChunks] {};
+    std::atomic<qsizetype> publishedCount { 0 };
+    bool overflowWarned { false };
+
+    mutable QMutex compactMutex;
+    mutable DFMSearchResultMap compactedResults;
+    mutable qsizetype compactedCount { 0 };
+};
+
+DPSEARCH_END_NAMESPACE
+
+#endif   // SEARCHRESULTSTORE_H
@@ -53,6 +53,15 @@ DFMSearchResultMap SearchManager::matchedResults(const QString &taskId)
     return {};
 }
 
+DFMSearchResultList SearchManager::readMatchedResults(const QString &taskId, qsizetype *cursor)
+{
+    if (mainController)
+        return mainController->readResults(taskId, cursor);
+
+    fmWarning() << "MainController not available, cannot retrieve results for taskId:" << taskId;
+    return {};
+}
+
 QList<QUrl> SearchManager::matchedResultUrls(const QString &taskId)
 {
     // Get real-time result URLs from controller
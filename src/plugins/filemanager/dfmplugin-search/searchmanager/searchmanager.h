@@ -28,6 +28,9 @@ public:
     
     // 获取统一的搜索结果数据
     DFMSearchResultMap matchedResults(const QString &taskId);
+
+    // 获取游标之后新增的结果，游标随之前移；同一URL可能因分数更高而再次出现
+    DFMSearchResultList readMatchedResults(const QString &taskId, qsizetype *cursor);
     
     // 为向后兼容保留的接口，只获取URL列表
     QList<QUrl> matchedResultUrls(const QString &taskId);
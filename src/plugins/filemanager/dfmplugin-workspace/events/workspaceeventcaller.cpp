@@ -71,7 +71,9 @@ void WorkspaceEventCaller::sendShowCustomTopWidget(const quint64 windowID, const
 
 void WorkspaceEventCaller::sendPaintEmblems(QPainter *painter, const QRectF &paintArea, const FileInfoPointer &info)
 {
-    dpfSlotChannel->push("dfmplugin_emblem", "slot_FileEmblems_Paint", painter, paintArea, info);
+    // 每个条目绘制时都会调用，使用类型化句柄避免 QVariant 装箱
+    static const auto paintHandle { dpfSlotChannel->resolve<bool(QPainter *, QRectF, FileInfoPointer)>("dfmplugin_emblem", "slot_FileEmblems_Paint") };
+    paintHandle(painter, paintArea, info);
 }
 
 void WorkspaceEventCaller::sendViewSelectionChanged(const quint64 windowID, const QItemSelection &selected, const QItemSelection &deselected)
@@ -537,6 +537,19 @@ void RootInfo::handleTraversalLocalResult(QList<SortInfoPointer> children,
     Q_EMIT iteratorLocalFiles(travseToken, children, originSortRole, originSortOrder, originMixSort, isFirst);
 }
 
+void RootInfo::handleTraversalLocalBatch(const QList<SortInfoPointer> children, const QString &travseToken)
+{
+    if (children.isEmpty())
+        return;
+
+    addChildren(children);
+
+    // 批次未排序，按逐个遍历的方式插入，遍历结束后统一排序
+    bool isFirst = isFirstBatch.exchange(false);   // Get and reset the flag
+    fmDebug() << "Emitting iterator add files signal for local batch - children:" << children.size() << "isFirst:" << isFirst;
+    Q_EMIT iteratorAddFiles(travseToken, children, {}, isFirst);
+}
+
 void RootInfo::handleTraversalFinish(const QString &travseToken)
 {
     fmInfo() << "Traversal finished for token:" << travseToken << "URL:" << url.toString();
@@ -590,6 +603,8 @@ void RootInfo::initConnection(const TraversalThreadManagerPointer &traversalThre
             this, &RootInfo::handleTraversalResultsUpdate, Qt::DirectConnection);
     connect(traversalThread.data(), &TraversalDirThreadManager::updateLocalChildren,
             this, &RootInfo::handleTraversalLocalResult, Qt::DirectConnection);
+    connect(traversalThread.data(), &TraversalDirThreadManager::updateLocalChildrenBatch,
+            this, &RootInfo::handleTraversalLocalBatch, Qt::DirectConnection);
     connect(traversalThread.data(), &TraversalDirThreadManager::traversalRequestSort,
             this, &RootInfo::handleTraversalSort, Qt::DirectConnection);
     // 主线中执行
@@ -108,6 +108,7 @@ public Q_SLOTS:
                                     bool isMixDirAndFile, const QString &travseToken);
     void handleTraversalFinish(const QString &travseToken);
 
+    void handleTraversalLocalBatch(const QList<SortInfoPointer> children, const QString &travseToken);
     void handleTraversalSort(const QString &travseToken);
     void handleGetSourceData(const QString &currentToken);
 
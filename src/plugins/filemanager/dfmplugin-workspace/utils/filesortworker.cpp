@@ -21,6 +21,9 @@
 
 #include <QStandardPaths>
 
+#include <algorithm>
+#include <limits>
+
 #include <sys/stat.h>
 
 using namespace dfmplugin_workspace;
@@ -36,6 +39,19 @@ void insertToList(QList<T> &list, int index, const T &t)
     else
         list.insert(index, t);
 }
+
+// 时间排序值，格式化后的时间字符串按字典序比较与按秒比较等价
+bool timeSortValue(const QVariant &value, qint64 *secs)
+{
+    QDateTime time = value.toDateTime();
+    if (!time.isValid())
+        time = QDateTime::fromString(value.toString(), FileUtils::dateTimeFormat());
+    if (!time.isValid())
+        return false;
+
+    *secs = time.toSecsSinceEpoch();
+    return true;
+}
 }   // namespace
 
 FileSortWorker::FileSortWorker(const QUrl &url, const QString &key, FileViewFilterCallback callfun,
@@ -1646,28 +1662,26 @@ QList<QUrl> FileSortWorker::sortTreeFiles(const QList<QUrl> &children, const boo
     }
 
     QList<QUrl> sortList;
-    int sortIndex = 0;
-    QHash<QUrl, SortInfoPointer> sortInfos = reverse && !isMixDirAndFile ? this->children.value(parentUrl)
-                                                                         : QHash<QUrl, SortInfoPointer>();
-    bool firstFile = false;
-    for (const auto &url : children) {
-        if (isCanceled)
-            return {};
-        if (!reverse) {
-            sortIndex = insertSortList(url, sortList, SortScenarios::kSortScenariosNormal);
-        } else if (!firstFile && !isMixDirAndFile) {
-            auto sortInfo = sortInfos.value(url);
-            if (sortInfo && sortInfo->needsCompletion())
-                doCompleteFileInfo(sortInfo);
-            if (sortInfo && sortInfo->isFile()) {
-                firstFile = true;
-                sortIndex = sortList.count();
-            }
+    if (!reverse) {
+        sortList = sortByKeys(children);
+    } else {
+        // 只改变顺序时，目录和文件各自倒序，目录仍然在前
+        sortList = children;
+        auto firstFile = sortList.end();
+        if (!isMixDirAndFile) {
+            const auto sortInfos = this->children.value(parentUrl);
+            firstFile = std::find_if(sortList.begin(), sortList.end(), [this, &sortInfos](const QUrl &url) {
+                auto sortInfo = sortInfos.value(url);
+                if (sortInfo && sortInfo->needsCompletion())
+                    doCompleteFileInfo(sortInfo);
+                return sortInfo && sortInfo->isFile();
+            });
         }
-        insertToList(sortList, sortIndex, url);
+        std::reverse(sortList.begin(), firstFile);
+        std::reverse(firstFile, sortList.end());
     }
 
-    if (sortList.isEmpty())
+    if (isCanceled || sortList.isEmpty())
         return {};
 
     visibleTreeChildren.insert(parentUrl, sortList);
@@ -1885,63 +1899,64 @@ int FileSortWorker::insertSortList(const QUrl &needNode, const QList<QUrl> &list
 // 左边比右边小返回true，
 bool FileSortWorker::lessThan(const QUrl &left, const QUrl &right, SortScenarios sort)
 {
+    Q_UNUSED(sort)
+
     if (isCanceled)
         return false;
 
-    const auto &leftItem = childrenDataMap.value(left);
-    const auto &rightItem = childrenDataMap.value(right);
-
-    const SortInfoPointer leftSortInfo = (leftItem && leftItem->fileSortInfo()) ? leftItem->fileSortInfo() : nullptr;
-    const SortInfoPointer rightSortInfo = (rightItem && rightItem->fileSortInfo()) ? rightItem->fileSortInfo() : nullptr;
+    return lessThan(makeSortKey(left), makeSortKey(right));
+}
 
-    if (!leftSortInfo)
-        return false;
-    if (!rightSortInfo)
+bool FileSortWorker::lessThan(const SortKey &left, const SortKey &right) const
+{
+    if (isCanceled || !left.valid || !right.valid)
         return false;
 
-    bool isDirLeft = leftSortInfo->isDir();
-    bool isDirRight = rightSortInfo->isDir();
-
     // The folder is fixed in the front position
-    if (!isMixDirAndFile)
-        if (isDirLeft ^ isDirRight)
-            return (sortOrder == Qt::DescendingOrder) ^ isDirLeft;
+    if (!isMixDirAndFile && (left.isDir ^ right.isDir))
+        return (sortOrder == Qt::DescendingOrder) ^ left.isDir;
 
-    if (isCanceled)
-        return false;
+    if (left.number != right.number)
+        return left.number < right.number;
 
-    QVariant leftData = data(leftSortInfo, orgSortRole);
-    QVariant rightData = data(rightSortInfo, orgSortRole);
+    if (left.text != right.text)
+        return SortUtils::compareStringForFileName(left.text, right.text);
 
-    // 1. 符号链接的大小需要直接获取指向的文件的信息排序
-    // 2. 类型排序必须使用 fastMimeType 保证一致性
-    bool useFileInfo = false;
-    if (!leftData.isValid() || (leftSortInfo->isSymLink())) {
-        const FileInfoPointer leftInfo = leftItem && leftItem->fileInfo()
-                ? leftItem->fileInfo()
-                : InfoFactory::create<FileInfo>(left);
-        leftData = data(leftInfo, orgSortRole);
-        useFileInfo = true;
-    }
+    // When the selected sort attribute value is the same, sort by file name
+    return SortUtils::compareStringForFileName(left.name, right.name);
+}
+
+FileSortWorker::SortKey FileSortWorker::makeSortKey(const QUrl &url)
+{
+    SortKey key;
+    key.url = url;
+
+    const auto &item = childrenDataMap.value(url);
+    const SortInfoPointer sortInfo = item ? item->fileSortInfo() : nullptr;
+    if (!sortInfo)
+        return key;
+
+    key.valid = true;
+    key.isDir = sortInfo->isDir();
+    key.name = sortInfo->fileUrl().fileName();
 
-    if (!rightData.isValid() || (rightSortInfo->isSymLink())) {
-        const FileInfoPointer rightInfo = rightItem && rightItem->fileInfo()
-                ? rightItem->fileInfo()
-                : InfoFactory::create<FileInfo>(right);
-        rightData = data(rightInfo, orgSortRole);
-        useFileInfo = true;
+    // 本地文件的时间直接取数值，不再格式化成字符串
+    const bool isTimeRole = orgSortRole == kItemFileLastModifiedRole || orgSortRole == kItemFileLastReadRole;
+    if (isTimeRole && !sortInfo->isSymLink() && sortInfo->fileUrl().isLocalFile()) {
+        key.number = orgSortRole == kItemFileLastReadRole ? sortInfo->lastReadTime() : sortInfo->lastModifiedTime();
+        return key;
     }
 
-    // When the selected sort attribute value is the same, sort by file name
-    if (leftData == rightData) {
-        QString leftName = leftSortInfo->fileUrl().fileName();
-        QString rightName = rightSortInfo->fileUrl().fileName();
-        return SortUtils::compareStringForFileName(leftName, rightName);
+    // 1. 符号链接的大小需要直接获取指向的文件的信息排序
+    // 2. 类型排序必须使用 fastMimeType 保证一致性
+    QVariant value = data(sortInfo, orgSortRole);
+    const bool useFileInfo = !value.isValid() || sortInfo->isSymLink();
+    if (useFileInfo) {
+        const FileInfoPointer info = item->fileInfo() ? item->fileInfo() : InfoFactory::create<FileInfo>(url);
+        value = data(info, orgSortRole);
     }
 
     switch (orgSortRole) {
-    case kItemFileDisplayNameRole:
-        return SortUtils::compareStringForFileName(leftData.toString(), rightData.toString());
     case kItemFileLastModifiedRole:
         [[fallthrough]];
     case kItemFileCreatedRole:
@@ -1949,16 +1964,58 @@ bool FileSortWorker::lessThan(const QUrl &left, const QUrl &right, SortScenarios
     case kItemFileDeletionDate:
         [[fallthrough]];
     case kItemFileLastReadRole:
-        return SortUtils::compareStringForTime(leftData.toString(), rightData.toString());
+        // 无效时间（"-"）排在最前，无法解析的字符串之间仍按字符串比较
+        if (!timeSortValue(value, &key.number)) {
+            key.number = std::numeric_limits<qint64>::min();
+            key.text = value.toString();
+        }
+        break;
     case kItemFileMimeTypeRole:
-        return SortUtils::compareStringForMimeType(leftData.toString(), rightData.toString());
+        key.text = value.toString();
+        key.number = SortUtils::mimeTypeRank(key.text);
+        break;
     case kItemFileSizeRole:
         // 这里的 useFileInfo 指的是使用 FileInfo 得到的 size 的数据，而非使用 sortFileInfo
-        return useFileInfo ? SortUtils::compareForSize(leftData.toLongLong(), rightData.toLongLong())
-                           : SortUtils::compareForSize(leftSortInfo, rightSortInfo);
+        key.number = useFileInfo ? value.toLongLong() : SortUtils::getEffectiveSize(sortInfo);
+        break;
     default:
-        return SortUtils::compareStringForFileName(leftData.toString(), rightData.toString());
+        key.text = value.toString();
+        break;
     }
+
+    return key;
+}
+
+QList<QUrl> FileSortWorker::sortByKeys(const QList<QUrl> &urls)
+{
+    // 每一项只取一次排序值，排序时只比较连续数组中的 SortKey
+    QVector<SortKey> keys;
+    keys.reserve(urls.size());
+    for (const auto &url : urls) {
+        if (isCanceled)
+            return {};
+        keys.append(makeSortKey(url));
+    }
+
+    // 缺少排序信息的项无法比较，保持原有顺序放到最后
+    auto validEnd = std::stable_partition(keys.begin(), keys.end(), [](const SortKey &key) {
+        return key.valid;
+    });
+
+    const bool ascending = sortOrder == Qt::AscendingOrder;
+    std::stable_sort(keys.begin(), validEnd, [this, ascending](const SortKey &left, const SortKey &right) {
+        return ascending ? lessThan(left, right) : lessThan(right, left);
+    });
+
+    if (isCanceled)
+        return {};
+
+    QList<QUrl> sortList;
+    sortList.reserve(keys.size());
+    for (const auto &key : std::as_const(keys))
+        sortList.append(key.url);
+
+    return sortList;
 }
 
 QVariant FileSortWorker::data(const FileInfoPointer &info, ItemRoles role)
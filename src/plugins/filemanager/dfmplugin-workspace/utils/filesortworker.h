@@ -68,6 +68,17 @@ class FileSortWorker : public QObject
         kRemoveGroupFinished
     };
 
+    // 排序前为每一项预先取出的排序值，比较时不再查表、不再构造 QVariant
+    struct SortKey
+    {
+        QUrl url;
+        QString name;   // 排序值相同时按文件名排序
+        QString text;   // 名称、类型等字符串排序值
+        qint64 number { 0 };   // 时间、大小、类型排名等数值排序值
+        bool isDir { false };
+        bool valid { false };
+    };
+
 public:
     explicit FileSortWorker(const QUrl &url,
                             const QString &key,
@@ -246,6 +257,9 @@ private:
     int insertSortList(const QUrl &needNode, const QList<QUrl> &list,
                        SortScenarios sort);
     bool lessThan(const QUrl &left, const QUrl &right, SortScenarios sort);
+    bool lessThan(const SortKey &left, const SortKey &right) const;
+    SortKey makeSortKey(const QUrl &url);
+    QList<QUrl> sortByKeys(const QList<QUrl> &urls);
     QVariant data(const FileInfoPointer &info, Global::ItemRoles role);
     QVariant data(const SortInfoPointer &info, Global::ItemRoles role);
 
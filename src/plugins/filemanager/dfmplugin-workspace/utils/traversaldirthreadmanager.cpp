@@ -6,7 +6,11 @@
 #include <dfm-base/dfm_log_defines.h>
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/file/local/localdiriterator.h>
+#include <dfm-base/file/local/nativedirenumerator.h>
 #include <dfm-base/utils/fileutils.h>
+#include <dfm-base/base/configs/dconfig/dconfigmanager.h>
+
+#include <dfm-io/dfmio_utils.h>
 
 #include <QElapsedTimer>
 #include <QDebug>
@@ -17,6 +21,13 @@ using namespace dfmbase;
 using namespace dfmplugin_workspace;
 USING_IO_NAMESPACE
 
+namespace DConfigKeys {
+static constexpr char kNativeIterator[] { "dfm.iterator.native" };
+}
+
+// 原生遍历每批最多的文件数，首批使用 countCeiling 以尽快显示
+static constexpr int kMaxNativeBatchCount { 16384 };
+
 TraversalDirThreadManager::TraversalDirThreadManager(const QUrl &url,
                                                      const QStringList &nameFilters,
                                                      QDir::Filters filters,
@@ -143,7 +154,9 @@ void TraversalDirThreadManager::run()
     fmInfo() << "dir query start, url: " << dirUrl;
 
     int count = 0;
-    if (!dirIterator->oneByOne()) {
+    if (!dirIterator->oneByOne() && canIteratorNative() && (count = iteratorNative()) >= 0) {
+        fmInfo() << "local dir native query end, file count: " << count << " url: " << dirUrl << " elapsed: " << timer.elapsed();
+    } else if (!dirIterator->oneByOne()) {
         const QList<SortInfoPointer> &fileList = iteratorAll();
         count = fileList.count();
         fmInfo() << "local dir query end, file count: " << count << " url: " << dirUrl << " elapsed: " << timer.elapsed();
@@ -268,3 +281,70 @@ QList<SortInfoPointer> TraversalDirThreadManager::iteratorAll()
 
     return fileList;
 }
+
+bool TraversalDirThreadManager::canIteratorNative() const
+{
+    if (!dirUrl.isLocalFile() || !dirIterator.dynamicCast<LocalDirIterator>())
+        return false;
+
+    // 原生遍历不处理名称过滤，只用于列出目录全部文件的场景
+    const QDir::Filters required = QDir::AllEntries | QDir::Hidden | QDir::System;
+    if (!nameFilters.isEmpty() || (filters & required) != required)
+        return false;
+
+    return DConfigManager::instance()->value(GlobalDConfDefines::ConfigPath::kDefaultCfgPath, DConfigKeys::kNativeIterator, true).toBool();
+}
+
+int TraversalDirThreadManager::iteratorNative()
+{
+    const QString &dirPath = dirUrl.toLocalFile();
+    NativeDirEnumerator enumerator(dirPath);
+    if (!enumerator.open()) {
+        fmWarning() << "native iterator open failed, fallback to dfm-io, url: " << dirUrl;
+        return -1;
+    }
+
+    const QUrl &hiddenUrl = QUrl::fromLocalFile(dirPath + "/.hidden");
+    enumerator.setHiddenNames(DFMIO::DFMUtils::hideListFromUrl(hiddenUrl));
+    Q_EMIT iteratorInitFinished();
+
+    const QString &prefix = dirPath.endsWith('/') ? dirPath : dirPath + '/';
+    NativeDirEnumerator::Batch batch;
+    int batchCount = countCeiling;
+    int filecount = 0;
+    while (!stopFlag && enumerator.nextBatch(&batch, batchCount)) {
+        QList<SortInfoPointer> children;
+        children.reserve(batch.entries.size());
+        for (const auto &entry : std::as_const(batch.entries)) {
+            SortInfoPointer info(new SortFileInfo);
+            info->setUrl(QUrl::fromLocalFile(prefix + batch.fileName(entry)));
+            info->setSize(entry.size);
+            info->setFile(entry.isFile);
+            info->setDir(entry.isDir);
+            info->setHide(entry.isHidden);
+            info->setSymlink(entry.isSymlink);
+            info->setReadable(entry.readable);
+            info->setWriteable(entry.writable);
+            info->setExecutable(entry.executable);
+            info->setLastReadTime(entry.lastRead);
+            info->setLastModifiedTime(entry.lastModified);
+            info->setCreateTime(entry.changed);
+            info->setInfoCompleted(true);
+            children.append(info);
+        }
+
+        filecount += children.size();
+        emit updateLocalChildrenBatch(children, traversalToken);
+        // 首批尽快显示，之后逐步加大批次减少界面插入的次数
+        batchCount = qMin(batchCount * 2, kMaxNativeBatchCount);
+    }
+
+    if (!stopFlag) {
+        if (enumerator.error() != 0)
+            fmWarning() << "native iterator stopped with error:" << enumerator.error() << "url: " << dirUrl;
+        emit traversalRequestSort(traversalToken);
+    }
+    emit traversalFinished(traversalToken);
+
+    return filecount;
+}
@@ -58,6 +58,8 @@ Q_SIGNALS:
                              Qt::SortOrder sortOrder,
                              bool isMixDirAndFile, QString traversalToken);
     void updateChildrenInfo(const QList<SortInfoPointer> updateInfos, QString traversalToken);
+    // 原生遍历的一批未排序的本地文件，遍历结束后通过 traversalRequestSort 统一排序
+    void updateLocalChildrenBatch(const QList<SortInfoPointer> children, QString traversalToken);
     void traversalFinished(QString traversalToken);
     void traversalRequestSort(QString traversalToken);
 
@@ -69,6 +71,8 @@ protected:
 private:
     int iteratorOneByOne(const QElapsedTimer &timere);
     QList<SortInfoPointer> iteratorAll();
+    bool canIteratorNative() const;
+    int iteratorNative();
 };
 }
 
@@ -40,6 +40,7 @@
 #include <dfm-base/utils/fileinfohelper.h>
 #include <dfm-base/utils/protocolutils.h>
 #include <dfm-base/utils/viewdefines.h>
+#include <dfm-base/utils/thumbnail/thumbnailfactory.h>
 
 #ifdef DTKWIDGET_CLASS_DSizeMode
 #    include <DSizeMode>
@@ -688,6 +689,47 @@ FileView::RandeIndexList FileView::visibleIndexes(const QRect &rect) const
     return list;
 }
 
+QList<QUrl> FileView::indexesToUrls(const RandeIndexList &list) const
+{
+    QList<QUrl> urls;
+    for (const auto &range : list) {
+        for (int row = range.first; row <= range.second; ++row) {
+            const QModelIndex &index = model()->index(row, 0, rootIndex());
+            if (index.isValid())
+                urls << model()->data(index, ItemRoles::kItemUrlRole).toUrl();
+        }
+    }
+
+    return urls;
+}
+
+void FileView::requestThumbnails(const RandeIndexList &list)
+{
+    for (const auto &range : list) {
+        for (int row = range.first; row <= range.second; ++row) {
+            // 访问图标会为尚未请求的文件加入缩略图任务
+            const QModelIndex &index = model()->index(row, 0, rootIndex());
+            if (index.isValid())
+                model()->data(index, Qt::DecorationRole);
+        }
+    }
+}
+
+void FileView::updateThumbnailPriority()
+{
+    if (count() <= 0)
+        return;
+
+    // 当前可见的区域优先生成，其下一屏作为预取，其余已加入的任务排到最后
+    const QRect visibleRect(QPoint(horizontalOffset(), verticalOffset()), viewport()->size());
+    const RandeIndexList &visibleList = visibleIndexes(visibleRect);
+    const RandeIndexList &prefetchList = visibleIndexes(visibleRect.translated(0, visibleRect.height()));
+    requestThumbnails(visibleList);
+    requestThumbnails(prefetchList);
+
+    ThumbnailFactory::instance()->updateTaskPriority(rootUrl(), indexesToUrls(visibleList), indexesToUrls(prefetchList));
+}
+
 FileView::RandeIndexList FileView::rectContainsIndexes(const QRect &rect) const
 {
     RandeIndexList list;
@@ -2495,11 +2537,18 @@ void FileView::initializeScrollBarWatcher()
 
     connect(d->scrollBarValueChangedTimer, &QTimer::timeout, this, [this] { this->update(); });
 
+    // 滚动停下后再调整缩略图任务的优先级，避免拖动滚动条时频繁调度
+    d->thumbnailPriorityTimer = new QTimer(this);
+    d->thumbnailPriorityTimer->setInterval(100);
+    d->thumbnailPriorityTimer->setSingleShot(true);
+    connect(d->thumbnailPriorityTimer, &QTimer::timeout, this, &FileView::updateThumbnailPriority);
+
     connect(verticalScrollBar(), &QScrollBar::sliderPressed, this, [this] { d->scrollBarSliderPressed = true; });
     connect(verticalScrollBar(), &QScrollBar::sliderReleased, this, [this] { d->scrollBarSliderPressed = false; });
     connect(verticalScrollBar(), &QScrollBar::valueChanged, this, [this](int value) {
         if (d->scrollBarSliderPressed)
             d->scrollBarValueChangedTimer->start();
+        d->thumbnailPriorityTimer->start();
 
         if (d->headerWidget && d->headerWidget->isVisible()) {
             auto headerLayout = d->headerWidget->layout();
@@ -230,6 +230,9 @@ private:
     RandeIndexList rectContainsIndexes(const QRect &rect) const;
     RandeIndexList calcRectContiansIndexes(int columnCount, const QRect &rect) const;
     RandeIndexList calcGroupRectContiansIndexes(const QRect &rect) const;
+    QList<QUrl> indexesToUrls(const RandeIndexList &list) const;
+    void requestThumbnails(const RandeIndexList &list);
+    void updateThumbnailPriority();
 
     QSize itemSizeHint() const;
 
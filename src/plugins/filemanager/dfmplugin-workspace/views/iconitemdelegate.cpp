@@ -21,6 +21,7 @@
 #include <dfm-base/base/application/application.h>
 #include <dfm-base/base/device/deviceutils.h>
 #include <dfm-base/utils/universalutils.h>
+#include <dfm-base/utils/elidetextlayoutcache.h>
 
 #include <DPaletteHelper>
 #include <DGuiApplicationHelper>
@@ -334,6 +335,8 @@ int IconItemDelegate::setIconSizeByIconSizeLevel(int level)
     if (level >= minimumIconSizeLevel() && level <= maximumIconSizeLevel()) {
         d->currentIconSizeIndex = level;
         d->itemIconSize = iconSizeByIconSizeLevel();
+        // 旧尺寸下的文件名排版不会再用到
+        ElideTextLayoutCache::instance()->clear();
         parent()->parent()->setIconSize(iconSizeByIconSizeLevel());
 
         fmInfo() << "Icon size changed to level" << d->currentIconSizeIndex << "size:" << d->itemIconSize;
@@ -360,6 +363,7 @@ void IconItemDelegate::setItemMinimumWidthByWidthLevel(int level)
     if (level >= 0 && level < d->viewDefines.iconGridDensityCount()) {
         int oldLevel = d->currentIconGridWidthIndex;
         d->currentIconGridWidthIndex = level;
+        ElideTextLayoutCache::instance()->clear();
         updateItemSizeHint();
 
         fmInfo() << "Item width level changed from" << oldLevel << "to" << level;
@@ -476,6 +480,7 @@ QList<QRectF> IconItemDelegate::calcFileNameRect(const QModelIndex &index, const
     int lineHeight = UniversalUtils::getTextLineHeight(name, parent()->parent()->fontMetrics());
     QScopedPointer<ElideTextLayout> layout(ItemDelegateHelper::createTextLayout(name, QTextOption::WrapAtWordBoundaryOrAnywhere,
                                                                                 lineHeight, Qt::AlignCenter));
+    layout->setCacheEnabled(true);
 
     // Add tag support by calling hook, same as Canvas implementation
     const FileInfoPointer &info = parent()->fileInfo(index);
@@ -734,6 +739,7 @@ void IconItemDelegate::paintItemFileName(QPainter *painter, QRectF iconRect, QPa
     int lineHeight = UniversalUtils::getTextLineHeight(displayName, parent()->parent()->fontMetrics());
     QScopedPointer<ElideTextLayout> layout(ItemDelegateHelper::createTextLayout(displayName, QTextOption::WrapAtWordBoundaryOrAnywhere,
                                                                                 lineHeight, Qt::AlignCenter, painter));
+    layout->setCacheEnabled(true);
     layout->setHighlightEnabled(!isSelected);
     layout->setHighlightKeywords(parent()->parent()->model()->getKeyWords());
     layout->setHighlightColor(QColor("#0081FF"));
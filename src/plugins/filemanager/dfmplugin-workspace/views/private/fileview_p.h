@@ -80,6 +80,7 @@ class FileViewPrivate
 
     QTimer *scrollBarValueChangedTimer { nullptr };
     bool scrollBarSliderPressed { false };
+    QTimer *thumbnailPriorityTimer { nullptr };
 
     bool pressedStartWithExpand { false };
     bool mouseLeftPressed { false };
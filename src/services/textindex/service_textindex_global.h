@@ -37,6 +37,7 @@ inline const QString kFolderExcludeFilters = QLatin1String("folderExcludeFilters
 inline const QString kCpuUsageLimitPercent = QLatin1String("cpuUsageLimitPercent");
 inline const QString kInotifyWatchesCoefficient = QLatin1String("inotifyWatchesCoefficient");
 inline const QString kBatchCommitInterval = QLatin1String("batchCommitInterval");
+inline const QString kExtractionWorkerCount = QLatin1String("extractionWorkerCount");
 
 }   // namesapce DConf
 
@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "extractionpipeline.h"
+
+#include <QThread>
+
+SERVICETEXTINDEX_USE_NAMESPACE
+
+namespace {
+// 每个提取线程在队列中预留的任务数
+constexpr int kQueueSlotsPerWorker = 4;
+// 等待时定期检查任务是否被停止
+constexpr unsigned long kWaitTimeoutMs = 100;
+}   // namespace
+
+ExtractionPipeline::ExtractionPipeline(int workerCount, TaskState &state, Extractor extractor, Writer writer)
+    : m_workerCount(qMax(1, workerCount)),
+      m_capacity(qMax(1, workerCount) * kQueueSlotsPerWorker),
+      m_state(state),
+      m_extractor(std::move(extractor)),
+      m_writer(std::move(writer))
+{
+    m_pool.setMaxThreadCount(m_workerCount);
+    m_activeWorkers = m_workerCount;
+    for (int i = 0; i < m_workerCount; ++i)
+        m_pool.start([this]() { workerLoop(); });
+
+    fmInfo() << "[ExtractionPipeline] Started with" << m_workerCount << "extraction workers";
+}
+
+ExtractionPipeline::~ExtractionPipeline()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_closed = true;
+        m_input.clear();
+        m_changed.wakeAll();
+    }
+    m_pool.waitForDone();
+}
+
+int ExtractionPipeline::resolveWorkerCount(int configured, int cpuQuotaPercent)
+{
+    int count = configured > 0 ? configured : qBound(1, QThread::idealThreadCount() / 2, 4);
+
+    // 静默模式下服务受 CPU 配额限制，线程数超过配额只会互相争抢
+    if (cpuQuotaPercent > 0)
+        count = qMin(count, qMax(1, cpuQuotaPercent / 100));
+
+    return count;
+}
+
+bool ExtractionPipeline::submit(const QString &path)
+{
+    QMutexLocker locker(&m_mutex);
+    while (m_input.size() >= m_capacity) {
+        if (!m_state.isRunning())
+            return false;
+        if (!m_output.isEmpty()) {
+            drainOutput(locker);
+            continue;
+        }
+        m_changed.wait(&m_mutex, kWaitTimeoutMs);
+    }
+
+    if (!m_state.isRunning())
+        return false;
+
+    m_input.enqueue(path);
+    m_changed.wakeAll();
+
+    // 顺便写入已经提取好的文档，避免输出队列积压
+    drainOutput(locker);
+    return true;
+}
+
+void ExtractionPipeline::finish()
+{
+    QMutexLocker locker(&m_mutex);
+    m_closed = true;
+    m_changed.wakeAll();
+
+    while (m_activeWorkers > 0 || !m_output.isEmpty()) {
+        if (!m_output.isEmpty()) {
+            drainOutput(locker);
+            continue;
+        }
+        m_changed.wait(&m_mutex, kWaitTimeoutMs);
+    }
+}
+
+void ExtractionPipeline::drainOutput(QMutexLocker<QMutex> &locker)
+{
+    while (!m_output.isEmpty()) {
+        QQueue<Extracted> ready;
+        ready.swap(m_output);
+        // 队列有空位了，唤醒可能在等待的遍历
+        m_changed.wakeAll();
+
+        locker.unlock();
+        for (const Extracted &item : std::as_const(ready)) {
+            if (m_state.isRunning())
+                m_writer(item.path, item.doc);
+        }
+        locker.relock();
+    }
+}
+
+void ExtractionPipeline::workerLoop()
+{
+    QMutexLocker locker(&m_mutex);
+    while (true) {
+        while (m_input.isEmpty() && !m_closed && m_state.isRunning())
+            m_changed.wait(&m_mutex, kWaitTimeoutMs);
+
+        if (m_input.isEmpty() || !m_state.isRunning())
+            break;
+
+        const QString path = m_input.dequeue();
+        m_changed.wakeAll();
+        locker.unlock();
+
+        Lucene::DocumentPtr doc;
+        try {
+            doc = m_extractor(path);
+        } catch (...) {
+            fmWarning() << "[ExtractionPipeline] Extract document failed with unknown exception:" << path;
+        }
+
+        locker.relock();
+        if (doc)
+            m_output.enqueue({ path, doc });
+        else
+            fmWarning() << "[ExtractionPipeline] Failed to create document for:" << path;
+        m_changed.wakeAll();
+    }
+
+    --m_activeWorkers;
+    m_changed.wakeAll();
+}
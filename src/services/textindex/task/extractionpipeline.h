@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef EXTRACTIONPIPELINE_H
+#define EXTRACTIONPIPELINE_H
+
+#include "service_textindex_global.h"
+#include "utils/taskstate.h"
+
+#include <lucene++/LuceneHeaders.h>
+
+#include <QMutex>
+#include <QQueue>
+#include <QString>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <functional>
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+/**
+ * @brief 文档提取流水线
+ *
+ * 遍历阶段（调用线程）通过 submit() 投递文件路径，N 个提取线程并行读取文件、
+ * 检测编码并生成 Lucene 文档，写入阶段始终在调用线程执行（submit()/finish() 中），
+ * 因此 IndexWriter 和进度上报都只会被一个线程访问。
+ * 提取函数会在多个线程中同时调用，DocUtils::extractFileContent 只对不可重入的 DocParser 后端按后端串行化，
+ * 纯文本等格式的提取吞吐随线程数增长。
+ *
+ * 输入和输出队列都有上限，提取速度跟不上时遍历会被阻塞，内存占用与目录规模无关。
+ */
+class ExtractionPipeline
+{
+public:
+    using Extractor = std::function<Lucene::DocumentPtr(const QString &path)>;
+    using Writer = std::function<void(const QString &path, const Lucene::DocumentPtr &doc)>;
+
+    ExtractionPipeline(int workerCount, TaskState &state, Extractor extractor, Writer writer);
+    ~ExtractionPipeline();
+
+    // 投递一个文件，队列已满时一边写入已提取的文档一边等待，任务停止时返回 false
+    bool submit(const QString &path);
+    // 不再投递新文件，等待提取线程结束并写入剩余文档
+    void finish();
+
+    int workerCount() const { return m_workerCount; }
+
+    // 根据配置和 CPU 配额计算提取线程数，configured <= 0 表示自动
+    static int resolveWorkerCount(int configured, int cpuQuotaPercent);
+
+private:
+    struct Extracted
+    {
+        QString path;
+        Lucene::DocumentPtr doc;
+    };
+
+    void workerLoop();
+    void drainOutput(QMutexLocker<QMutex> &locker);
+
+    const int m_workerCount;
+    const int m_capacity;
+    TaskState &m_state;
+    Extractor m_extractor;
+    Writer m_writer;
+
+    QThreadPool m_pool;
+    QMutex m_mutex;
+    QWaitCondition m_changed;
+    QQueue<QString> m_input;
+    QQueue<Extracted> m_output;
+    int m_activeWorkers { 0 };
+    bool m_closed { false };
+};
+
+SERVICETEXTINDEX_END_NAMESPACE
+
+#endif   // EXTRACTIONPIPELINE_H
@@ -61,6 +61,7 @@ void IndexTask::setSilent(bool newSilent)
 
 void IndexTask::throttleCpuUsage()
 {
+    m_state.setCpuQuotaPercent(0);
     if (!silent()) {
         fmDebug() << "[IndexTask::throttleCpuUsage] Skipping CPU throttling - not in silent mode";
         return;
@@ -76,6 +77,7 @@ void IndexTask::throttleCpuUsage()
                     << "service:" << Defines::kTextIndexServiceName << "limit:" << limit << "%";
     } else {
         fmDebug() << "[IndexTask::throttleCpuUsage] CPU quota applied successfully - limit:" << limit << "%";
+        m_state.setCpuQuotaPercent(limit);
     }
 }
 
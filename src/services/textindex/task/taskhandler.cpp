@@ -6,9 +6,11 @@
 #include "fileprovider.h"
 #include "progressnotifier.h"
 #include "moveprocessor.h"
+#include "extractionpipeline.h"
 #include "utils/scopeguard.h"
 #include "utils/docutils.h"
 #include "utils/indexutility.h"
+#include "utils/indexsnapshot.h"
 #include "utils/textindexconfig.h"
 #include "utils/pathexcludematcher.h"
 
@@ -22,6 +24,7 @@
 #include <FilterIndexReader.h>
 #include <FuzzyQuery.h>
 #include <QueryWrapperFilter.h>
+#include <MapFieldSelector.h>
 
 #include <QDir>
 #include <QDateTime>
@@ -187,10 +190,9 @@ DocumentPtr createFileDocument(const QString &file)
     }
 }
 
-bool checkNeedUpdate(const QString &file, const IndexReaderPtr &reader, bool *needAdd)
+bool checkNeedUpdate(const QString &file, const SearcherPtr &searcher, bool *needAdd)
 {
     try {
-        SearcherPtr searcher = newLucene<IndexSearcher>(reader);
         TermQueryPtr query = newLucene<TermQuery>(newLucene<Term>(L"path", file.toStdWString()));
 
         TopDocsPtr topDocs = searcher->search(query, 1);
@@ -233,35 +235,54 @@ bool checkNeedUpdate(const QString &file, const IndexReaderPtr &reader, bool *ne
     }
 }
 
-void processFile(const QString &path, const IndexWriterPtr &writer, ProgressReporter *reporter)
+void writeDocument(const QString &path, const DocumentPtr &doc, const IndexWriterPtr &writer, ProgressReporter *reporter)
 {
     try {
-        if (!IndexUtility::isSupportedFile(path))
-            return;
 #ifdef QT_DEBUG
         fmDebug() << "Adding [" << path << "]";
 #endif
-        DocumentPtr doc = createFileDocument(path);
-        if (!doc) {
-            fmWarning() << "[processFile] Failed to create document for:" << path;
-            return;
-        }
         writer->addDocument(doc);
         if (reporter) {
             reporter->increment();
         }
     } catch (const LuceneException &e) {
-        fmWarning() << "[processFile] Process file failed with Lucene exception:" << path
+        fmWarning() << "[writeDocument] Write document failed with Lucene exception:" << path
                     << "error:" << QString::fromStdWString(e.getError());
     } catch (const std::exception &e) {
-        fmWarning() << "[processFile] Process file failed with exception:" << path
+        fmWarning() << "[writeDocument] Write document failed with exception:" << path
                     << "error:" << e.what();
     } catch (...) {
-        fmWarning() << "[processFile] Process file failed with unknown exception:" << path;
+        fmWarning() << "[writeDocument] Write document failed with unknown exception:" << path;
     }
 }
 
-void updateFile(const QString &path, const IndexReaderPtr &reader,
+// 快照可用时直接查表，否则（或路径哈希冲突时）按路径查询索引
+bool needUpdate(const QString &path, const SearcherPtr &searcher, IndexSnapshot *snapshot, bool *needAdd)
+{
+    if (!snapshot)
+        return checkNeedUpdate(path, searcher, needAdd);
+
+    QFileInfo fileInfo(path);
+    if (!fileInfo.exists())
+        return false;
+
+    switch (snapshot->check(path, fileInfo.lastModified().toSecsSinceEpoch())) {
+    case IndexSnapshot::FileState::New:
+        if (needAdd)
+            *needAdd = true;
+        return true;
+    case IndexSnapshot::FileState::Unchanged:
+        return false;
+    case IndexSnapshot::FileState::Modified:
+        fmDebug() << "[needUpdate] File needs update:" << path;
+        return true;
+    case IndexSnapshot::FileState::Unknown:
+        break;
+    }
+    return checkNeedUpdate(path, searcher, needAdd);
+}
+
+void updateFile(const QString &path, const SearcherPtr &searcher, IndexSnapshot *snapshot,
                 const IndexWriterPtr &writer, ProgressReporter *reporter)
 {
     try {
@@ -269,7 +290,7 @@ void updateFile(const QString &path, const IndexReaderPtr &reader,
             return;
 
         bool needAdd = false;
-        if (checkNeedUpdate(path, reader, &needAdd)) {
+        if (needUpdate(path, searcher, snapshot, &needAdd)) {
             DocumentPtr doc = createFileDocument(path);
             if (!doc) {
                 fmWarning() << "[updateFile] Failed to create document for:" << path;
@@ -324,7 +345,7 @@ void removeFile(const QString &path, const IndexWriterPtr &writer, ProgressRepor
     }
 }
 
-bool cleanupIndexs(IndexReaderPtr reader, IndexWriterPtr writer, TaskState &running)
+bool cleanupIndexs(IndexReaderPtr reader, IndexWriterPtr writer, const IndexSnapshot &snapshot, TaskState &running)
 {
     try {
         if (!reader || !writer) {
@@ -332,23 +353,10 @@ bool cleanupIndexs(IndexReaderPtr reader, IndexWriterPtr writer, TaskState &runn
             return false;
         }
 
-        fmInfo() << "[cleanupIndexs] Starting index cleanup - checking for deleted files";
-        SearcherPtr searcher = newLucene<IndexSearcher>(reader);
-        if (!searcher) {
-            fmCritical() << "[cleanupIndexs] Failed to create searcher for index cleanup";
-            return false;
-        }
-
-        // 获取所有文档
-        TermPtr allDocsTerm = newLucene<Term>(L"path", L"*");
-        WildcardQueryPtr allDocsQuery = newLucene<WildcardQuery>(allDocsTerm);
-        TopDocsPtr allDocs = searcher->search(allDocsQuery, reader->maxDoc());
-        if (!allDocs) {
-            fmCritical() << "[cleanupIndexs] Search returned null result for index cleanup";
-            return false;
-        }
-
-        fmInfo() << "[cleanupIndexs] Found" << allDocs->totalHits << "documents to check";
+        // 遍历时已经访问到的文件一定存在且受支持，只需检查剩下的文档
+        const QList<int32_t> docIds = snapshot.unvisitedDocIds();
+        fmInfo() << "[cleanupIndexs] Starting index cleanup -" << docIds.size() << "of" << snapshot.size()
+                 << "documents were not seen during traversal";
 
         // Use static factory method to create configured blacklist matcher
         PathExcludeMatcher excludeMatcher = PathExcludeMatcher::createForIndex();
@@ -358,23 +366,21 @@ bool cleanupIndexs(IndexReaderPtr reader, IndexWriterPtr writer, TaskState &runn
         int removedCount = 0;
         const QStringList supportedExtensions = TextIndexConfig::instance().supportedFileExtensions();
 
-        // 检查每个文档对应的文件是否存在
-        for (int32_t i = 0; i < allDocs->totalHits && running.isRunning(); ++i) {
-            // Ensure scoreDocs[i] is not null before accessing ->doc
-            if (!allDocs->scoreDocs || !allDocs->scoreDocs[i]) {
-                fmWarning() << "[cleanupIndexs] Null scoreDoc at index" << i << "during index cleanup";
-                return false;
-            }
+        Collection<String> fields = Collection<String>::newInstance();
+        fields.add(L"path");
+        FieldSelectorPtr pathSelector = newLucene<MapFieldSelector>(fields);
 
-            DocumentPtr doc = searcher->doc(allDocs->scoreDocs[i]->doc);
+        // 检查每个文档对应的文件是否存在
+        for (int i = 0; i < docIds.size() && running.isRunning(); ++i) {
+            DocumentPtr doc = reader->document(docIds.at(i), pathSelector);
             if (!doc) {   // Ensure document is valid
-                fmWarning() << "[cleanupIndexs] Null document at index" << i << "during index cleanup";
+                fmWarning() << "[cleanupIndexs] Null document" << docIds.at(i) << "during index cleanup";
                 return false;
             }
 
             String pathValue = doc->get(L"path");
             if (pathValue.empty()) {
-                fmWarning() << "[cleanupIndexs] Document at index" << i << "has empty path during index cleanup";
+                fmWarning() << "[cleanupIndexs] Document" << docIds.at(i) << "has empty path during index cleanup";
                 return false;
             }
 
@@ -391,8 +397,6 @@ bool cleanupIndexs(IndexReaderPtr reader, IndexWriterPtr writer, TaskState &runn
                 // If exists, check suffix (only if not already marked for deletion)
                 QString suffix = fileInfo.suffix().toLower();   // Normalize to lowercase for case-insensitive comparison
 
-                // Use the pre-fetched list/set
-                // if (!supportedExtensionsSet.contains(suffix)) { // If using QSet
                 if (!supportedExtensions.contains(suffix, Qt::CaseInsensitive)) {   // QStringList::contains with case insensitivity
                     shouldDelete = true;
                 }
@@ -610,9 +614,21 @@ TaskHandler TaskHandlers::CreateIndexHandler()
             reporter.setTotal(totalCount);
             fmInfo() << "[CreateIndexHandler] Starting file processing, estimated total files:" << totalCount;
 
+            // 遍历在当前线程进行，文档提取交给流水线中的多个线程，写入仍在当前线程
+            const int workerCount = ExtractionPipeline::resolveWorkerCount(
+                    TextIndexConfig::instance().extractionWorkerCount(), running.cpuQuotaPercent());
+            ExtractionPipeline pipeline(
+                    workerCount, running,
+                    [](const QString &file) { return createFileDocument(file); },
+                    [&writer, &reporter](const QString &file, const DocumentPtr &doc) {
+                        writeDocument(file, doc, writer, &reporter);
+                    });
+
             provider->traverse(running, [&](const QString &file) {
-                processFile(file, writer, &reporter);
+                if (IndexUtility::isSupportedFile(file))
+                    pipeline.submit(file);
             });
+            pipeline.finish();
 
             // Only the creation of an index that is interrupted is also considered a failure
             // Created indexes must be guaranteed to be complete
@@ -691,13 +707,14 @@ TaskHandler TaskHandlers::UpdateIndexHandler()
 
             fmDebug() << "[UpdateIndexHandler] Index reader and writer initialized for directory:" << indexDir;
 
-            // 清理已删除文件的索引
-            if (!cleanupIndexs(reader, writer, running)) {
-                fmCritical() << "[UpdateIndexHandler] Index cleanup failed, aborting update";
-                result.success = false;
-                result.fatal = true;
+            // 一次性读出索引中所有文件的修改时间，遍历时查表判断是否需要更新
+            IndexSnapshot snapshot;
+            if (!snapshot.load(reader, running)) {
+                fmWarning() << "[UpdateIndexHandler] Index update was interrupted while loading snapshot";
+                result.interrupted = true;
                 return result;
             }
+            SearcherPtr searcher = newLucene<IndexSearcher>(reader);
 
             // 使用文件提供者遍历文件
             auto provider = createFileProvider(path);
@@ -717,9 +734,17 @@ TaskHandler TaskHandlers::UpdateIndexHandler()
             fmDebug() << "[UpdateIndexHandler] Starting file update processing, estimated total files:" << totalCount;
 
             provider->traverse(running, [&](const QString &file) {
-                updateFile(file, reader, writer, &reporter);
+                updateFile(file, searcher, &snapshot, writer, &reporter);
             });
 
+            // 清理已删除文件的索引
+            if (!cleanupIndexs(reader, writer, snapshot, running)) {
+                fmCritical() << "[UpdateIndexHandler] Index cleanup failed, aborting update";
+                result.success = false;
+                result.fatal = true;
+                return result;
+            }
+
             if (!running.isRunning()) {
                 fmWarning() << "[UpdateIndexHandler] Index update was interrupted by user request";
                 result.interrupted = true;
@@ -810,8 +835,9 @@ TaskHandler TaskHandlers::CreateOrUpdateFileListHandler(const QStringList &fileL
             reporter.setTotal(totalCount);
             fmInfo() << "[CreateOrUpdateFileListHandler] Starting file list processing, total files:" << totalCount;
 
+            SearcherPtr searcher = newLucene<IndexSearcher>(reader);
             provider->traverse(running, [&](const QString &file) {
-                updateFile(file, reader, writer, &reporter);
+                updateFile(file, searcher, nullptr, writer, &reporter);
             });
 
             if (!running.isRunning()) {
@@ -9,16 +9,40 @@
 #include <docparser.h>
 
 #include <QSet>
+#include <QHash>
 #include <QFile>
 #include <QTextDocument>
 #include <QFileInfo>
 #include <QDebug>
 #include <QMimeDatabase>
+#include <QMutex>
 
 SERVICETEXTINDEX_BEGIN_NAMESPACE
 
 namespace DocUtils {
 
+namespace {
+// DocParser 内部的部分第三方解析器（旧版 office 二进制格式、pdf、rtf）没有承诺可重入，
+// 按解析后端分别串行调用；纯文本和基于 xml 的格式（docx、xlsx、pptx、odt 等）直接并行解析
+QMutex *docParserMutex(const QString &filePath)
+{
+    static QMutex wordMutex;
+    static QMutex sheetMutex;
+    static QMutex slideMutex;
+    static QMutex pdfMutex;
+    static QMutex rtfMutex;
+    static const QHash<QString, QMutex *> kNonReentrantBackends {
+        { "doc", &wordMutex }, { "dot", &wordMutex }, { "wps", &wordMutex },
+        { "xls", &sheetMutex }, { "xlt", &sheetMutex }, { "et", &sheetMutex },
+        { "ppt", &slideMutex }, { "pps", &slideMutex }, { "pot", &slideMutex }, { "dps", &slideMutex },
+        { "pdf", &pdfMutex },
+        { "rtf", &rtfMutex }
+    };
+
+    return kNonReentrantBackends.value(QFileInfo(filePath).suffix().toLower(), nullptr);
+}
+}   // namespace
+
 QByteArray detectFileEncoding(const QString &filePath)
 {
     return Dtk::Core::DTextEncoding::detectFileEncoding(filePath);
@@ -133,6 +157,8 @@ std::optional<QString> extractFileContent(const QString &filePath, size_t maxByt
 
         // Convert file content using the new DocParser interface with maxBytes support
         std::string stdContents;
+        // 返回空指针时 locker 不加锁
+        QMutexLocker locker(docParserMutex(filePath));
         if (maxBytes > 0) {
             // Use the new convertFile interface with maxBytes parameter
             stdContents = DocParser::convertFile(filePath.toStdString(), maxBytes);
@@ -140,6 +166,7 @@ std::optional<QString> extractFileContent(const QString &filePath, size_t maxByt
             // Use the original convertFile interface without truncation
             stdContents = DocParser::convertFile(filePath.toStdString());
         }
+        locker.unlock();
 
         QByteArray contentBytes(stdContents.c_str(), stdContents.length());
         return convertToUtf8(contentBytes, fromEncoding);
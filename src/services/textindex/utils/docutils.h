@@ -47,6 +47,10 @@ std::optional<QString> convertToUtf8(const QByteArray &content, const QString &f
 
 /**
  * @brief Extracts text content from a file
+ *
+ * Safe to call from several threads: encoding detection, QMimeDatabase and QTextDocument
+ * are reentrant. DocParser backends that are not (legacy binary office, pdf, rtf) are
+ * serialized per backend, plain text and xml based formats are parsed without a lock.
  * @param filePath Path to the file
  * @param maxBytes Maximum number of bytes to process (0 means no limit)
  * @return Extracted text content or empty optional if extraction failed
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "indexsnapshot.h"
+
+#include <MapFieldSelector.h>
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+using namespace Lucene;
+
+bool IndexSnapshot::load(const IndexReaderPtr &reader, TaskState &state)
+{
+    m_entries.clear();
+    m_ambiguousDocIds.clear();
+    m_ambiguousKeys.clear();
+
+    // 只读取 path 和 modified，跳过体积较大的 contents 字段
+    Collection<String> fields = Collection<String>::newInstance();
+    fields.add(L"path");
+    fields.add(L"modified");
+    FieldSelectorPtr selector = newLucene<MapFieldSelector>(fields);
+
+    const int32_t maxDoc = reader->maxDoc();
+    m_entries.reserve(maxDoc);
+    for (int32_t docId = 0; docId < maxDoc; ++docId) {
+        if (!state.isRunning())
+            return false;
+        if (reader->isDeleted(docId))
+            continue;
+
+        DocumentPtr doc = reader->document(docId, selector);
+        if (!doc)
+            continue;
+
+        const String &path = doc->get(L"path");
+        if (path.empty())
+            continue;
+
+        const QByteArray key = pathKey(QString::fromStdWString(path));
+        if (m_ambiguousKeys.contains(key)) {
+            m_ambiguousDocIds.append(docId);
+            continue;
+        }
+
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            // 同一路径有多篇文档：都交给按路径查询的流程处理
+            m_ambiguousDocIds.append(it->docId);
+            m_ambiguousDocIds.append(docId);
+            m_ambiguousKeys.insert(key);
+            m_entries.erase(it);
+            continue;
+        }
+
+        Entry entry;
+        entry.modified = QString::fromStdWString(doc->get(L"modified")).toLongLong();
+        entry.docId = docId;
+        m_entries.insert(key, entry);
+    }
+
+    fmInfo() << "[IndexSnapshot::load] Loaded" << m_entries.size() << "documents,"
+             << m_ambiguousDocIds.size() << "with duplicated path";
+    return true;
+}
+
+IndexSnapshot::FileState IndexSnapshot::check(const QString &path, qint64 modifiedEpoch)
+{
+    const QByteArray key = pathKey(path);
+    if (m_ambiguousKeys.contains(key))
+        return FileState::Unknown;
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return FileState::New;
+
+    it->visited = true;
+    return it->modified == modifiedEpoch ? FileState::Unchanged : FileState::Modified;
+}
+
+QList<int32_t> IndexSnapshot::unvisitedDocIds() const
+{
+    QList<int32_t> docIds = m_ambiguousDocIds;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        if (!it->visited)
+            docIds.append(it->docId);
+    }
+    return docIds;
+}
+
+QByteArray IndexSnapshot::pathKey(const QString &path)
+{
+    // 保存完整路径而不是哈希，不同路径不会被误判为同一文件；UTF-8 比 QString 节省一半内存
+    return path.toUtf8();
+}
+
+SERVICETEXTINDEX_END_NAMESPACE
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef INDEXSNAPSHOT_H
+#define INDEXSNAPSHOT_H
+
+#include "service_textindex_global.h"
+#include "utils/taskstate.h"
+
+#include <lucene++/LuceneHeaders.h>
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+/**
+ * @brief 索引快照：路径 -> (修改时间, 文档号)
+ *
+ * 增量更新开始时从索引中一次性读出所有文档的 path/modified 字段，
+ * 之后遍历文件系统时直接查表判断文件是否需要更新，不再为每个文件执行一次 Lucene 查询。
+ * 遍历中没有命中的文档就是可能已删除、已不支持或被加入黑名单的文件，只需检查这部分。
+ *
+ * 快照以 UTF-8 编码的完整路径为键，查表结果与按路径查询一致；索引中同一路径有多篇文档时
+ * 标记为不确定，由调用方回退到按路径查询。
+ */
+class IndexSnapshot
+{
+public:
+    enum class FileState {
+        New,   // 索引中没有该文件
+        Unchanged,   // 修改时间与索引一致
+        Modified,   // 修改时间与索引不一致
+        Unknown   // 索引中有多篇该路径的文档，需要按路径查询
+    };
+
+    // 从索引读出所有未删除文档，任务停止时返回 false
+    bool load(const Lucene::IndexReaderPtr &reader, TaskState &state);
+
+    // 查询文件状态并标记为已访问
+    FileState check(const QString &path, qint64 modifiedEpoch);
+
+    // 遍历中未访问到的文档（含路径重复的文档）
+    QList<int32_t> unvisitedDocIds() const;
+
+    int size() const { return m_entries.size() + m_ambiguousDocIds.size(); }
+
+    static QByteArray pathKey(const QString &path);
+
+private:
+    struct Entry
+    {
+        qint64 modified { 0 };
+        int32_t docId { -1 };
+        bool visited { false };
+    };
+
+    QHash<QByteArray, Entry> m_entries;
+    QList<int32_t> m_ambiguousDocIds;
+    QSet<QByteArray> m_ambiguousKeys;
+};
+
+SERVICETEXTINDEX_END_NAMESPACE
+
+#endif   // INDEXSNAPSHOT_H
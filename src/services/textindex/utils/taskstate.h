@@ -33,8 +33,20 @@ public:
         m_running.storeRelease(false);
     }
 
+    // 任务执行时服务所受的 CPU 配额（百分比），0 表示不限制
+    int cpuQuotaPercent() const
+    {
+        return m_cpuQuotaPercent.loadAcquire();
+    }
+
+    void setCpuQuotaPercent(int percent)
+    {
+        m_cpuQuotaPercent.storeRelease(percent);
+    }
+
 private:
     QAtomicInteger<bool> m_running;
+    QAtomicInteger<int> m_cpuQuotaPercent { 0 };
 };
 
 SERVICETEXTINDEX_END_NAMESPACE
@@ -177,6 +177,16 @@ void TextIndexConfig::loadAllConfigs()
         m_batchCommitInterval = DEFAULT_BATCH_COMMIT_INTERVAL;
     }
 
+    // Extraction worker count
+    m_extractionWorkerCount = m_dconfigManager->value(
+                                                      Defines::DConf::kTextIndexSchema,
+                                                      Defines::DConf::kExtractionWorkerCount,
+                                                      DEFAULT_EXTRACTION_WORKER_COUNT)
+                                      .toInt();
+    if (m_extractionWorkerCount < 0 || m_extractionWorkerCount > 16) {
+        m_extractionWorkerCount = DEFAULT_EXTRACTION_WORKER_COUNT;
+    }
+
     fmDebug() << "TextIndexConfig: Text index configurations loaded successfully";
     // You might want to print the loaded values here for debugging if needed
     // fmDebug() << "AutoIndexUpdateInterval:" << m_autoIndexUpdateInterval;
@@ -262,4 +272,10 @@ int TextIndexConfig::batchCommitInterval() const
     return m_batchCommitInterval;
 }
 
+int TextIndexConfig::extractionWorkerCount() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_extractionWorkerCount;
+}
+
 SERVICETEXTINDEX_END_NAMESPACE
@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 对比文件复制线程池两种等待方式的耗时：
+//   poll  - 旧实现，QThread::msleep(10) 轮询 activeThreadCount()
+//   latch - 新实现，最后一个任务结束时通过 QWaitCondition 唤醒等待方
+// 用法: dfm-copy-wait-bench [文件数，默认 100000] [每个目录的文件数，默认 100]
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+bool copySmallFile(const QByteArray &from, const QByteArray &to)
+{
+    int src = ::open(from.constData(), O_RDONLY | O_CLOEXEC);
+    if (src < 0)
+        return false;
+    int dst = ::open(to.constData(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (dst < 0) {
+        ::close(src);
+        return false;
+    }
+    char buf[4096];
+    ssize_t n = 0;
+    bool ok = true;
+    while ((n = ::read(src, buf, sizeof(buf))) > 0) {
+        if (::write(dst, buf, static_cast<size_t>(n)) != n) {
+            ok = false;
+            break;
+        }
+    }
+    ::close(src);
+    ::close(dst);
+    return ok && n == 0;
+}
+
+class CopyTaskLatch
+{
+public:
+    void add()
+    {
+        QMutexLocker locker(&mutex);
+        ++pending;
+    }
+    void done()
+    {
+        QMutexLocker locker(&mutex);
+        if (--pending == 0)
+            finished.wakeAll();
+    }
+    void wait()
+    {
+        QMutexLocker locker(&mutex);
+        while (pending > 0)
+            finished.wait(&mutex);
+    }
+
+private:
+    int pending { 0 };
+    QMutex mutex;
+    QWaitCondition finished;
+};
+
+void createTree(const QString &root, int fileCount, int filesPerDir)
+{
+    const QByteArray content(512, 'x');
+    for (int i = 0; i < fileCount; ++i) {
+        const QString dir = QString("%1/d%2").arg(root).arg(i / filesPerDir);
+        if (i % filesPerDir == 0)
+            QDir().mkpath(dir);
+        const QByteArray path = QString("%1/f%2").arg(dir).arg(i).toLocal8Bit();
+        int fd = ::open(path.constData(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd >= 0) {
+            if (::write(fd, content.constData(), static_cast<size_t>(content.size())) < 0)
+                qWarning() << "write failed:" << path;
+            ::close(fd);
+        }
+    }
+}
+
+// 每个目录复制完后都等待线程池清空，与 waitThreadPoolOver 在目录/大文件边界处的调用方式一致
+qint64 runCopy(const QString &source, const QString &target, bool useLatch)
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    CopyTaskLatch latch;
+
+    QElapsedTimer timer;
+    timer.start();
+    const QStringList dirs = QDir(source).entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString &dir : dirs) {
+        const QString toDir = target + "/" + dir;
+        QDir().mkpath(toDir);
+        const QStringList files = QDir(source + "/" + dir).entryList(QDir::Files);
+        for (const QString &file : files) {
+            const QByteArray from = QString("%1/%2/%3").arg(source, dir, file).toLocal8Bit();
+            const QByteArray to = QString("%1/%2").arg(toDir, file).toLocal8Bit();
+            if (useLatch)
+                latch.add();
+            pool.start([from, to, useLatch, &latch]() {
+                copySmallFile(from, to);
+                if (useLatch)
+                    latch.done();
+            });
+        }
+
+        if (useLatch) {
+            latch.wait();
+        } else {
+            QThread::msleep(10);
+            while (pool.activeThreadCount() > 0)
+                QThread::msleep(10);
+        }
+    }
+    return timer.elapsed();
+}
+
+}   // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const QStringList args = app.arguments();
+    const int fileCount = args.size() > 1 ? args.at(1).toInt() : 100000;
+    const int filesPerDir = args.size() > 2 ? qMax(1, args.at(2).toInt()) : 100;
+
+    QTemporaryDir workDir;
+    if (!workDir.isValid()) {
+        qWarning() << "create temporary dir failed";
+        return 1;
+    }
+
+    const QString source = workDir.filePath("source");
+    createTree(source, fileCount, filesPerDir);
+    qInfo() << "tree ready:" << fileCount << "files," << filesPerDir << "files per dir";
+
+    const qint64 pollMs = runCopy(source, workDir.filePath("poll"), false);
+    const qint64 latchMs = runCopy(source, workDir.filePath("latch"), true);
+
+    qInfo() << "poll  (msleep loop):" << pollMs << "ms";
+    qInfo() << "latch (wait condition):" << latchMs << "ms";
+    return 0;
+}
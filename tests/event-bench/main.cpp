@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 测量 slot 事件每次调用的耗时（ns/call），对比：
+//   push(space, topic) - 每次调用都经过 EventConverter 把字符串转换为 EventType
+//   push(type)         - 事先取得 EventType，参数装箱为 QVariantList
+//   handle             - EventChannelHandle，解析一次，签名一致时直接调用
+// 用法: dfm-event-bench [--count N]
+
+#include <dfm-framework/event/event.h>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QUrl>
+
+DPF_USE_NAMESPACE
+
+namespace {
+
+static constexpr char kSpace[] { "dfmplugin_bench" };
+static constexpr char kTopic[] { "slot_Bench_FileName" };
+
+class Receiver : public QObject
+{
+    Q_OBJECT
+public:
+    QString fileName(quint64 winId, const QUrl &url)
+    {
+        sum += winId;
+        return url.fileName();
+    }
+
+    quint64 sum { 0 };
+};
+
+void report(const char *name, int count, qint64 nsecs)
+{
+    qInfo().noquote() << QString("%1 %2 %3 %4")
+                                 .arg(name, -18)
+                                 .arg(count, 10)
+                                 .arg(nsecs / 1e6, 10, 'f', 1)
+                                 .arg(double(nsecs) / count, 10, 'f', 1);
+}
+
+}   // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int count = 1000000;
+    const QStringList args = app.arguments().mid(1);
+    for (int i = 0; i < args.size(); ++i) {
+        if (args.at(i) == "--count" && i + 1 < args.size()) {
+            count = qMax(1, args.at(++i).toInt());
+        } else {
+            qWarning() << "usage: dfm-event-bench [--count N]";
+            return 1;
+        }
+    }
+
+    // 注册一批事件，使查表规模接近文管实际加载全部插件后的状态
+    for (int i = 0; i < 700; ++i)
+        dpfEvent->registerEventType(EventStratege::kSlot, kSpace, QString("slot_Bench_Filler%1").arg(i));
+    dpfEvent->registerEventType(EventStratege::kSlot, kSpace, kTopic);
+
+    Receiver receiver;
+    if (!dpfSlotChannel->connect(kSpace, kTopic, &receiver, &Receiver::fileName))
+        return 1;
+
+    const QUrl url = QUrl::fromLocalFile("/home/user/Documents/bench.txt");
+    const quint64 winId = 1;
+    int checksum = 0;
+
+    qInfo().noquote() << QString("%1 %2 %3 %4").arg("case", -18).arg("calls", 10).arg("total ms", 10).arg("ns/call", 10);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < count; ++i)
+        checksum += dpfSlotChannel->push(kSpace, kTopic, winId, url).toString().size();
+    report("push(space,topic)", count, timer.nsecsElapsed());
+
+    const EventType type = DPF_EVENT_TYPE(kSpace, kTopic);
+    timer.restart();
+    for (int i = 0; i < count; ++i)
+        checksum += dpfSlotChannel->push(type, winId, url).toString().size();
+    report("push(type)", count, timer.nsecsElapsed());
+
+    const auto handle = dpfSlotChannel->resolve<QString(quint64, QUrl)>(kSpace, kTopic);
+    timer.restart();
+    for (int i = 0; i < count; ++i)
+        checksum += handle(winId, url).size();
+    report("handle", count, timer.nsecsElapsed());
+
+    qInfo() << "checksum:" << checksum << receiver.sum;
+    return 0;
+}
+
+#include "main.moc"
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 测量桌面栅格在多屏、大量图标时的排列耗时：
+//   append 1by1  - 逐个 findVoidPos + insert（CanvasGrid::append(item) 的方式）
+//   append bulk  - AppendOper::append 一次放入全部图标
+//   append after - 隔格占用的栅格上从屏幕中部 tryAppendAfter（拖放到拥挤桌面）
+//   void pos     - 在隔格占用的栅格上对每个屏幕取 voidPos
+// 用法: dfm-grid-arrange-bench [--items N] [--surfaces N] [--size WxH]
+
+#include "gridcore.h"
+#include "displayconfig.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+
+namespace ddplugin_canvas {
+DFM_LOG_REGISTER_CATEGORY(DDP_CANVAS_NAMESPACE)
+}
+
+using namespace ddplugin_canvas;
+
+namespace {
+
+class BenchGrid : public GridCore
+{
+public:
+    BenchGrid(int count, const QSize &size)
+    {
+        for (int i = 1; i <= count; ++i)
+            surfaces.insert(i, size);
+    }
+};
+
+void report(const char *name, int count, qint64 nsecs)
+{
+    const double ms = nsecs / 1e6;
+    qInfo().noquote() << QString("%1 %2 %3 %4")
+                                 .arg(name, -13)
+                                 .arg(count, 8)
+                                 .arg(ms, 10, 'f', 2)
+                                 .arg(count > 0 ? nsecs / count : 0, 10);
+}
+
+// 每个屏幕隔一格放一个图标，返回放入的数量
+int fillHalf(BenchGrid &grid, const QSize &size)
+{
+    int count = 0;
+    for (int idx : grid.surfaceIndex())
+        for (int x = 0; x < size.width(); ++x)
+            for (int y = (x % 2); y < size.height(); y += 2)
+                grid.insert(idx, QPoint(x, y), QString("file:///home/user/Desktop/half-%1").arg(count++));
+    return count;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int itemCount = 10000;
+    int surfaceCount = 3;
+    // 4K 屏幕默认图标大小下约为 38 x 21 格，这里放大以容纳全部图标
+    QSize size(70, 50);
+    const QStringList args = app.arguments().mid(1);
+    for (int i = 0; i < args.size(); ++i) {
+        if (args.at(i) == "--items" && i + 1 < args.size()) {
+            itemCount = qMax(1, args.at(++i).toInt());
+        } else if (args.at(i) == "--surfaces" && i + 1 < args.size()) {
+            surfaceCount = qMax(1, args.at(++i).toInt());
+        } else if (args.at(i) == "--size" && i + 1 < args.size()) {
+            const QStringList wh = args.at(++i).split('x');
+            if (wh.size() == 2)
+                size = QSize(qMax(1, wh.first().toInt()), qMax(1, wh.last().toInt()));
+        } else {
+            qWarning() << "usage: dfm-grid-arrange-bench [--items N] [--surfaces N] [--size WxH]";
+            return 1;
+        }
+    }
+
+    QStringList items;
+    items.reserve(itemCount);
+    for (int i = 0; i < itemCount; ++i)
+        items << QString("file:///home/user/Desktop/file-%1.txt").arg(i);
+
+    qInfo() << "surfaces:" << surfaceCount << "size:" << size << "autoAlign:" << DisplayConfig::instance()->autoAlign();
+    qInfo().noquote() << QString("%1 %2 %3 %4").arg("case", -13).arg("items", 8).arg("total ms", 10).arg("ns/item", 10);
+
+    QElapsedTimer timer;
+    {
+        BenchGrid grid(surfaceCount, size);
+        timer.start();
+        for (const QString &item : items) {
+            GridPos pos;
+            if (grid.findVoidPos(pos))
+                grid.insert(pos.first, pos.second, item);
+            else
+                grid.pushOverload({ item });
+        }
+        report("append 1by1", itemCount, timer.nsecsElapsed());
+    }
+
+    {
+        BenchGrid grid(surfaceCount, size);
+        timer.restart();
+        AppendOper oper(&grid);
+        oper.append(items);
+        grid.applay(&oper);
+        report("append bulk", itemCount, timer.nsecsElapsed());
+        qInfo() << "overload:" << grid.overload.size();
+    }
+
+    {
+        BenchGrid grid(surfaceCount, size);
+        fillHalf(grid, size);
+        const QPoint center(size.width() / 2, size.height() / 2);
+        timer.restart();
+        AppendOper oper(&grid);
+        oper.tryAppendAfter(items, 1, center);
+        grid.applay(&oper);
+        report("append after", itemCount, timer.nsecsElapsed());
+    }
+
+    {
+        BenchGrid grid(surfaceCount, size);
+        fillHalf(grid, size);
+        int found = 0;
+        timer.restart();
+        for (int idx : grid.surfaceIndex())
+            found += grid.voidPos(idx).size();
+        report("void pos", found, timer.nsecsElapsed());
+    }
+
+    return 0;
+}
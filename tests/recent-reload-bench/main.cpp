@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 测量最近使用服务重载大 xbel 文件的耗时：
+//   initial   - 首次加载全部书签
+//   unchanged - 文件未变化时的重载（不再解析，仍检查全部文件是否存在）
+//   append    - 追加一条书签后的重载（只解析新增的一条）
+//   forced    - 强制重载（重新检查全部文件是否存在）
+// 程序在临时目录下创建对应数量的文件和 xbel。
+// 用法: dfm-recent-reload-bench [--count N]
+
+#include "recentiterateworker.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QUrl>
+
+namespace serverplugin_recentmanager {
+DFM_LOG_REGISTER_CATEGORY(SERVERRECENTMANAGER_NAMESPACE)
+}
+
+using namespace serverplugin_recentmanager;
+
+namespace {
+
+QByteArray bookmark(const QString &path, int index)
+{
+    // 与 GLib 写出的 xbel 结构一致
+    const QByteArray time = QDateTime::fromSecsSinceEpoch(1700000000 + index).toUTC().toString(Qt::ISODate).toUtf8();
+    return "  <bookmark href=\"" + QUrl::fromLocalFile(path).toEncoded() + "\" added=\"" + time
+            + "\" modified=\"" + time + "\" visited=\"" + time + "\">\n"
+            + "    <info>\n"
+            + "      <metadata owner=\"http://freedesktop.org\">\n"
+            + "        <mime:mime-type type=\"text/plain\"/>\n"
+            + "        <bookmark:applications>\n"
+            + "          <bookmark:application name=\"bench\" exec=\"&apos;bench %u&apos;\" modified=\"" + time + "\" count=\"1\"/>\n"
+            + "        </bookmark:applications>\n"
+            + "      </metadata>\n"
+            + "    </info>\n"
+            + "  </bookmark>\n";
+}
+
+bool writeXbel(const QString &xbelPath, const QByteArray &bookmarks)
+{
+    QFile file(xbelPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    file.write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+               "<xbel version=\"1.0\"\n"
+               "      xmlns:bookmark=\"http://www.freedesktop.org/standards/desktop-bookmarks\"\n"
+               "      xmlns:mime=\"http://www.freedesktop.org/standards/shared-mime-info\"\n"
+               ">\n");
+    file.write(bookmarks);
+    file.write("</xbel>\n");
+    return true;
+}
+
+void report(const char *name, int count, qint64 nsecs)
+{
+    qInfo().noquote() << QString("%1 %2 %3").arg(name, -10).arg(count, 8).arg(nsecs / 1e6, 10, 'f', 2);
+}
+
+}   // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int count = 20000;
+    const QStringList args = app.arguments().mid(1);
+    for (int i = 0; i < args.size(); ++i) {
+        if (args.at(i) == "--count" && i + 1 < args.size()) {
+            count = qMax(1, args.at(++i).toInt());
+        } else {
+            qWarning() << "usage: dfm-recent-reload-bench [--count N]";
+            return 1;
+        }
+    }
+
+    QTemporaryDir dir;
+    if (!dir.isValid())
+        return 1;
+
+    QByteArray bookmarks;
+    for (int i = 0; i <= count; ++i) {
+        const QString &path = dir.filePath(QString("file-%1.txt").arg(i));
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly))
+            return 1;
+        // 最后一个文件留给追加的书签
+        if (i < count)
+            bookmarks += bookmark(path, i);
+    }
+
+    const QString &xbelPath = dir.filePath("recently-used.xbel");
+    if (!writeXbel(xbelPath, bookmarks))
+        return 1;
+
+    RecentIterateWorker worker;
+    int added = 0;
+    QObject::connect(&worker, &RecentIterateWorker::itemAdded, [&added]() { ++added; });
+
+    qInfo().noquote() << QString("%1 %2 %3").arg("case", -10).arg("added", 8).arg("ms", 10);
+
+    QElapsedTimer timer;
+    timer.start();
+    worker.onRequestReload(xbelPath, 0);
+    report("initial", added, timer.nsecsElapsed());
+
+    added = 0;
+    timer.restart();
+    worker.onRequestReload(xbelPath, 0);
+    report("unchanged", added, timer.nsecsElapsed());
+
+    bookmarks += bookmark(dir.filePath(QString("file-%1.txt").arg(count)), count);
+    if (!writeXbel(xbelPath, bookmarks))
+        return 1;
+
+    added = 0;
+    timer.restart();
+    worker.onRequestReload(xbelPath, 0);
+    report("append", added, timer.nsecsElapsed());
+
+    added = 0;
+    timer.restart();
+    worker.onRequestReload(xbelPath, QDateTime::currentMSecsSinceEpoch());
+    report("forced", added, timer.nsecsElapsed());
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 测量标记表（file_tags）在 SqliteConnectionPool 之上的插入和查询吞吐：
+//   orm insert     - SqliteHandle::insert 在一个事务中逐行插入（绑定参数，复用预编译语句）
+//   orm lookup     - SqliteHandle::query().where(filePath == ?) 逐个路径查询
+//   prepared       - 连接池缓存的预编译语句逐个路径查询
+//   in-chunk       - 每 500 个路径一条 IN (...) 预编译查询
+// 用法: dfm-sqlite-tag-bench [--rows N] [--lookups N] [--db 数据库文件]
+
+#include "beans/filetaginfo.h"
+
+#include <dfm-base/base/db/sqlitehandle.h>
+#include <dfm-base/base/db/sqlitehelper.h>
+#include <dfm-base/base/db/sqliteconnectionpool.h>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+
+DFMBASE_USE_NAMESPACE
+using daemonplugin_tag::FileTagInfo;
+
+namespace {
+
+static constexpr int kChunkSize { 500 };
+
+void report(const char *name, int count, qint64 nsecs)
+{
+    const double ms = nsecs / 1e6;
+    qInfo().noquote() << QString("%1 %2 %3 %4")
+                                 .arg(name, -12)
+                                 .arg(count, 8)
+                                 .arg(ms, 10, 'f', 1)
+                                 .arg(ms > 0 ? count * 1000.0 / ms : 0, 12, 'f', 0);
+}
+
+QString pathOf(int index)
+{
+    return QString("/home/user/Documents/bench/file-%1.txt").arg(index);
+}
+
+}   // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int rows = 20000;
+    int lookups = 5000;
+    QString dbFile;
+    const QStringList args = app.arguments().mid(1);
+    for (int i = 0; i < args.size(); ++i) {
+        if (args.at(i) == "--rows" && i + 1 < args.size()) {
+            rows = qMax(1, args.at(++i).toInt());
+        } else if (args.at(i) == "--lookups" && i + 1 < args.size()) {
+            lookups = qMax(1, args.at(++i).toInt());
+        } else if (args.at(i) == "--db" && i + 1 < args.size()) {
+            dbFile = args.at(++i);
+        } else {
+            qWarning() << "usage: dfm-sqlite-tag-bench [--rows N] [--lookups N] [--db file]";
+            return 1;
+        }
+    }
+
+    QTemporaryDir dir;
+    if (dbFile.isEmpty()) {
+        if (!dir.isValid())
+            return 1;
+        dbFile = dir.filePath("bench.db");
+    }
+
+    // 与 TagDbHandler 的连接配置和建表方式一致
+    SqliteConnectionPool::instance().enableWal(dbFile);
+    SqliteHandle handle(dbFile);
+    if (!handle.createTable<FileTagInfo>(SqliteConstraint::primary("fileIndex"),
+                                         SqliteConstraint::autoIncreament("fileIndex"),
+                                         SqliteConstraint::unique("fileIndex"))) {
+        qWarning() << "failed to create table in" << dbFile;
+        return 1;
+    }
+    handle.excute("CREATE INDEX IF NOT EXISTS idx_file_tags_filePath ON file_tags (filePath);");
+
+    qInfo().noquote() << QString("%1 %2 %3 %4").arg("case", -12).arg("count", 8).arg("total ms", 10).arg("ops/s", 12);
+
+    QElapsedTimer timer;
+    timer.start();
+    handle.transaction([&handle, rows]() -> bool {
+        for (int i = 0; i < rows; ++i) {
+            FileTagInfo info;
+            info.setFilePath(pathOf(i));
+            info.setTagName(i % 2 ? "Red" : "Blue");
+            info.setTagOrder(0);
+            info.setFuture("null");
+            if (handle.insert<FileTagInfo>(info) == -1)
+                return false;
+        }
+        return true;
+    });
+    report("orm insert", rows, timer.nsecsElapsed());
+
+    QStringList paths;
+    paths.reserve(lookups);
+    for (int i = 0; i < lookups; ++i)
+        paths << pathOf(QRandomGenerator::global()->bounded(rows));
+
+    int found = 0;
+    const auto &field = Expression::Field<FileTagInfo>;
+    timer.restart();
+    for (const QString &path : paths)
+        found += handle.query<FileTagInfo>().where(field("filePath") == path).toBeans().size();
+    report("orm lookup", lookups, timer.nsecsElapsed());
+
+    auto &pool = SqliteConnectionPool::instance();
+    found = 0;
+    timer.restart();
+    for (const QString &path : paths) {
+        QSharedPointer<QSqlQuery> query = pool.preparedQuery(dbFile, "SELECT tagName FROM file_tags WHERE filePath = ?;");
+        if (!query)
+            return 1;
+        query->bindValue(0, path);
+        query->exec();
+        while (query->next())
+            ++found;
+        query->finish();
+    }
+    report("prepared", lookups, timer.nsecsElapsed());
+
+    QStringList placeholders;
+    for (int i = 0; i < kChunkSize; ++i)
+        placeholders << "?";
+    const QString &inSql = QString("SELECT filePath, tagName FROM file_tags WHERE filePath IN (%1);").arg(placeholders.join(','));
+    found = 0;
+    timer.restart();
+    for (int start = 0; start < paths.size(); start += kChunkSize) {
+        QSharedPointer<QSqlQuery> query = pool.preparedQuery(dbFile, inSql);
+        if (!query)
+            return 1;
+        for (int i = 0; i < kChunkSize; ++i)
+            query->bindValue(i, paths.at(qMin(start + i, paths.size() - 1)));
+        query->exec();
+        while (query->next())
+            ++found;
+        query->finish();
+    }
+    report("in-chunk", lookups, timer.nsecsElapsed());
+    qInfo() << "matched rows:" << found;
+
+    return 0;
+}
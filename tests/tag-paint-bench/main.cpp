@@ -0,0 +1,216 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 测量完全标记的大目录中绘制标记圆点的耗时，对比三种取数方式：
+//   per-item  - 每个条目单独通过 DBus 查询标记和颜色（旧的逐个查询方式）
+//   per-page  - 每页条目一次 QueryTagsOfFiles，颜色从进程内的标记定义中取
+//   cached    - 启动时加载全部标记到进程内缓存，绘制时只查内存（FileTagCache 的方式）
+// 需要已运行的 dde-file-manager-daemon。程序会在临时目录下创建文件并用一个
+// 独立的标记名标记它们，结束时删除该标记。
+// 用法: dfm-tag-paint-bench [--count N] [--page N]
+
+#include <QGuiApplication>
+#include <QDBusArgument>
+#include <QDBusInterface>
+#include <QDBusReply>
+#include <QDBusVariant>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QImage>
+#include <QPainter>
+#include <QPainterPath>
+#include <QTemporaryDir>
+
+namespace {
+
+// 与 dfmplugin_tag 中的 QueryOpts/InsertOpts/DeleteOpts 取值一致
+enum { kQueryTags = 0,
+       kQueryFilesWithTags = 1,
+       kQueryTagsOfFile = 2,
+       kQueryColorOfTags = 4 };
+enum { kInsertTags = 0,
+       kInsertTagOfFiles = 1 };
+enum { kDeleteTags = 0 };
+
+static constexpr char kDaemonName[] { "org.deepin.Filemanager.Daemon" };
+static constexpr char kTagDBusPath[] { "/org/deepin/Filemanager/Daemon/TagManager" };
+static constexpr char kTagInterface[] { "org.deepin.Filemanager.Daemon.TagManager" };
+static constexpr qreal kTagDiameter { 10 };
+
+QVariantMap toMap(const QVariant &value)
+{
+    if (value.canConvert<QDBusArgument>()) {
+        QVariantMap map;
+        value.value<QDBusArgument>() >> map;
+        return map;
+    }
+    return value.toMap();
+}
+
+QVariantMap query(QDBusInterface &iface, int opt, const QStringList &value = {})
+{
+    QDBusReply<QDBusVariant> reply = iface.call("Query", opt, value);
+    return reply.isValid() ? toMap(reply.value().variant()) : QVariantMap {};
+}
+
+// 与 TagHelper::paintTags 相同的绘制方式
+void paintTags(QPainter *painter, QRectF rect, const QList<QColor> &colors)
+{
+    painter->setRenderHint(QPainter::Antialiasing);
+    painter->setPen(QPen(Qt::white, 1));
+    for (const QColor &color : colors) {
+        QPainterPath circle;
+        painter->setBrush(QBrush(color));
+        circle.addEllipse(QRectF(QPointF(rect.right() - kTagDiameter, rect.top()), rect.bottomRight()));
+        painter->drawPath(circle);
+        rect.setRight(rect.right() - kTagDiameter / 2);
+    }
+}
+
+struct Result
+{
+    double totalMs { 0 };
+    int painted { 0 };
+};
+
+template<typename Fn>
+Result measure(const QStringList &files, Fn tagColorsOf)
+{
+    QImage canvas(256, 24, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&canvas);
+    const QRectF rect(0, 0, canvas.width(), kTagDiameter);
+
+    Result result;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < files.size(); ++i) {
+        const QList<QColor> &colors = tagColorsOf(i);
+        if (colors.isEmpty())
+            continue;
+        paintTags(&painter, rect, colors);
+        ++result.painted;
+    }
+    result.totalMs = timer.nsecsElapsed() / 1e6;
+    return result;
+}
+
+QList<QColor> colorsOf(const QStringList &tags, const QHash<QString, QColor> &tagColors)
+{
+    QList<QColor> colors;
+    for (const QString &tag : tags) {
+        auto it = tagColors.constFind(tag);
+        if (it != tagColors.cend())
+            colors << it.value();
+    }
+    return colors;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+
+    int count = 20000;
+    int pageSize = 200;
+    const QStringList args = app.arguments().mid(1);
+    for (int i = 0; i < args.size(); ++i) {
+        if (args.at(i) == "--count" && i + 1 < args.size()) {
+            count = qMax(1, args.at(++i).toInt());
+        } else if (args.at(i) == "--page" && i + 1 < args.size()) {
+            pageSize = qMax(1, args.at(++i).toInt());
+        } else {
+            qWarning() << "usage: dfm-tag-paint-bench [--count N] [--page N]";
+            return 1;
+        }
+    }
+
+    QDBusInterface iface(kDaemonName, kTagDBusPath, kTagInterface, QDBusConnection::sessionBus());
+    if (!iface.isValid()) {
+        qWarning() << "tag service is not available:" << iface.lastError().message();
+        return 1;
+    }
+    iface.setTimeout(120 * 1000);
+
+    QTemporaryDir dir;
+    if (!dir.isValid())
+        return 1;
+
+    QStringList files;
+    files.reserve(count);
+    QVariantMap fileTags;
+    const QString &tagName = QString("dfm-tag-bench-%1").arg(QCoreApplication::applicationPid());
+    for (int i = 0; i < count; ++i) {
+        const QString &path = dir.filePath(QString("file-%1").arg(i));
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly))
+            return 1;
+        files << path;
+        fileTags.insert(path, QStringList { tagName });
+    }
+
+    iface.call("Insert", kInsertTags, QVariantMap { { tagName, QStringList { "#ff1c49" } } });
+    QElapsedTimer timer;
+    timer.start();
+    QDBusReply<bool> tagged = iface.call("Insert", kInsertTagOfFiles, fileTags);
+    if (!tagged.isValid() || !tagged.value()) {
+        qWarning() << "failed to tag files";
+        iface.call("Delete", kDeleteTags, QVariantMap { { "deleteTagData", QStringList { tagName } } });
+        return 1;
+    }
+    qInfo().noquote() << QString("tagged %1 files in %2 ms").arg(count).arg(timer.elapsed());
+
+    const Result perItem = measure(files, [&](int i) {
+        const QStringList &tags = query(iface, kQueryTagsOfFile, { files.at(i) }).value(files.at(i)).toStringList();
+        const QVariantMap &colorMap = query(iface, kQueryColorOfTags, tags);
+        QHash<QString, QColor> tagColors;
+        for (auto it = colorMap.cbegin(); it != colorMap.cend(); ++it)
+            tagColors.insert(it.key(), QColor(it.value().toString()));
+        return colorsOf(tags, tagColors);
+    });
+
+    QHash<QString, QColor> allTagColors;
+    const QVariantMap &allTags = query(iface, kQueryTags);
+    for (auto it = allTags.cbegin(); it != allTags.cend(); ++it)
+        allTagColors.insert(it.key(), QColor(it.value().toString()));
+
+    QVariantMap pageTags;
+    const Result perPage = measure(files, [&](int i) {
+        if (i % pageSize == 0) {
+            QDBusReply<QVariantMap> reply = iface.call("QueryTagsOfFiles", files.mid(i, pageSize));
+            pageTags = reply.isValid() ? reply.value() : QVariantMap {};
+        }
+        return colorsOf(pageTags.value(files.at(i)).toStringList(), allTagColors);
+    });
+
+    timer.restart();
+    QHash<QString, QStringList> cache;
+    const QVariantMap &filesWithTags = query(iface, kQueryFilesWithTags);
+    for (auto it = filesWithTags.cbegin(); it != filesWithTags.cend(); ++it)
+        cache.insert(it.key(), it.value().toStringList());
+    const qint64 loadMs = timer.elapsed();
+    const Result cached = measure(files, [&](int i) {
+        return colorsOf(cache.value(files.at(i)), allTagColors);
+    });
+
+    iface.call("Delete", kDeleteTags, QVariantMap { { "deleteTagData", QStringList { tagName } } });
+
+    qInfo().noquote() << QString("%1 %2 %3 %4").arg("mode", -10).arg("painted", 8).arg("total ms", 10).arg("us/item", 9);
+    const auto print = [count](const char *mode, const Result &result) {
+        qInfo().noquote() << QString("%1 %2 %3 %4")
+                                     .arg(mode, -10)
+                                     .arg(result.painted, 8)
+                                     .arg(result.totalMs, 10, 'f', 1)
+                                     .arg(result.totalMs * 1000 / count, 9, 'f', 2);
+    };
+    print("per-item", perItem);
+    print("per-page", perPage);
+    print("cached", cached);
+    qInfo().noquote() << QString("cache load: %1 ms").arg(loadMs);
+
+    return 0;
+}
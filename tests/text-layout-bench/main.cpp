@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 测量图标视图中文件名绘制的耗时：按图标模式的参数（两行、居中、中间省略）
+// 在离屏图像上重复绘制 N 个图标的文件名，模拟框选和平滑滚动时的整屏重绘。
+//   uncached - 每次绘制都新建 ElideTextLayout 并重新分行（原来的方式）
+//   cached   - 启用 ElideTextLayoutCache，首帧之后复用已排好的行
+// 用法: dfm-text-layout-bench [--count N] [--frames N] [--width W]
+
+#include <dfm-base/utils/elidetextlayout.h>
+#include <dfm-base/utils/elidetextlayoutcache.h>
+
+#include <QGuiApplication>
+#include <QElapsedTimer>
+#include <QFontMetrics>
+#include <QImage>
+#include <QPainter>
+
+using namespace dfmbase;
+
+namespace {
+
+QStringList makeNames(int count)
+{
+    static const QStringList kWords { "report", "final", "2026", "照片", "backup", "draft",
+                                      "项目计划", "screenshot", "meeting-notes", "v2" };
+    QStringList names;
+    names.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        QString name;
+        for (int w = 0; w <= i % 6; ++w)
+            name += kWords.at((i + w * 3) % kWords.size()) + (w % 2 ? " " : "_");
+        names << name + QString::number(i) + ".txt";
+    }
+    return names;
+}
+
+double paintFrames(const QStringList &names, int frames, int width, bool cached)
+{
+    QImage canvas(width, 64, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&canvas);
+    const int lineHeight = painter.fontMetrics().height();
+    const QRectF rect(0, 0, width, lineHeight * 2);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int f = 0; f < frames; ++f) {
+        for (const QString &name : names) {
+            ElideTextLayout layout(name);
+            layout.setAttribute(ElideTextLayout::kWrapMode, (uint)QTextOption::WrapAtWordBoundaryOrAnywhere);
+            layout.setAttribute(ElideTextLayout::kLineHeight, lineHeight);
+            layout.setAttribute(ElideTextLayout::kAlignment, Qt::AlignHCenter);
+            layout.setAttribute(ElideTextLayout::kFont, painter.font());
+            layout.setAttribute(ElideTextLayout::kTextDirection, painter.layoutDirection());
+            layout.setCacheEnabled(cached);
+            layout.layout(rect, Qt::ElideMiddle, &painter);
+        }
+    }
+    return timer.nsecsElapsed() / 1e6;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+
+    int count = 2000;
+    int frames = 20;
+    int width = 96;
+    const QStringList args = app.arguments().mid(1);
+    for (int i = 0; i < args.size(); ++i) {
+        if (args.at(i) == "--count" && i + 1 < args.size()) {
+            count = qMax(1, args.at(++i).toInt());
+        } else if (args.at(i) == "--frames" && i + 1 < args.size()) {
+            frames = qMax(1, args.at(++i).toInt());
+        } else if (args.at(i) == "--width" && i + 1 < args.size()) {
+            width = qMax(16, args.at(++i).toInt());
+        } else {
+            qWarning() << "usage: dfm-text-layout-bench [--count N] [--frames N] [--width W]";
+            return 1;
+        }
+    }
+
+    const QStringList &names = makeNames(count);
+    ElideTextLayoutCache::instance()->clear();
+
+    // 首帧单独统计，体现缓存未命中时的额外开销
+    const double uncachedFirst = paintFrames(names, 1, width, false);
+    const double uncached = paintFrames(names, frames, width, false);
+    const double cachedFirst = paintFrames(names, 1, width, true);
+    const double cached = paintFrames(names, frames, width, true);
+
+    qInfo().noquote() << QString("%1 %2 %3 %4").arg("mode", -10).arg("first ms", 10).arg("ms/frame", 10).arg("us/icon", 9);
+    const auto print = [count, frames](const char *mode, double first, double total) {
+        qInfo().noquote() << QString("%1 %2 %3 %4")
+                                     .arg(mode, -10)
+                                     .arg(first, 10, 'f', 2)
+                                     .arg(total / frames, 10, 'f', 2)
+                                     .arg(total * 1000 / frames / count, 9, 'f', 2);
+    };
+    print("uncached", uncachedFirst, uncached);
+    print("cached", cachedFirst, cached);
+    qInfo() << "cache entries:" << ElideTextLayoutCache::instance()->count();
+
+    return 0;
+}
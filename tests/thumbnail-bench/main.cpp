@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// 测量各类型文件生成缩略图的耗时和内存峰值（按 MIME 类型分组统计）：
+//   ms/thumb  - 每个缩略图的平均耗时和最大耗时
+//   peak RSS  - 该组生成过程中进程常驻内存峰值相对开始时的增量
+// 内存峰值通过向 /proc/self/clear_refs 写入 5 在每组开始前重置 VmHWM（需要 Linux 4.0+）
+// 用法: dfm-thumbnail-bench [--size small|normal|large] [--repeat N] <文件或目录>...
+
+#include <dfm-base/utils/thumbnail/thumbnailcreators.h>
+#include <dfm-base/base/schemefactory.h>
+#include <dfm-base/base/urlroute.h>
+#include <dfm-base/file/local/syncfileinfo.h>
+
+#include <QGuiApplication>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QMimeDatabase>
+
+DFMBASE_USE_NAMESPACE
+DFMGLOBAL_USE_NAMESPACE
+
+namespace {
+
+using Creator = QImage (*)(const QString &, ThumbnailSize);
+
+struct FormatStat
+{
+    int count { 0 };
+    int failed { 0 };
+    double totalMs { 0 };
+    double maxMs { 0 };
+    qint64 peakKb { 0 };
+};
+
+qint64 procStatusKb(const QByteArray &key)
+{
+    QFile status("/proc/self/status");
+    if (!status.open(QIODevice::ReadOnly))
+        return 0;
+    const QList<QByteArray> lines = status.readAll().split('\n');
+    for (const QByteArray &line : lines) {
+        if (line.startsWith(key))
+            return line.mid(key.size()).simplified().split(' ').value(0).toLongLong();
+    }
+    return 0;
+}
+
+void resetPeakRss()
+{
+    QFile clearRefs("/proc/self/clear_refs");
+    if (clearRefs.open(QIODevice::WriteOnly))
+        clearRefs.write("5");
+}
+
+Creator creatorFor(const QMimeType &mime)
+{
+    const QString &name = mime.name();
+    if (name.startsWith("image/"))
+        return ThumbnailCreators::imageThumbnailCreator;
+    if (name == Mime::kTypeAppPdf || mime.inherits(Mime::kTypeAppPdf))
+        return ThumbnailCreators::pdfThumbnailCreator;
+    if (name == Mime::kTypeAppPptx || mime.inherits(Mime::kTypeAppPptx))
+        return ThumbnailCreators::pptxThumbnailCreator;
+    if (name.startsWith("video/"))
+        return ThumbnailCreators::videoThumbnailCreator;
+    if (name.startsWith("audio/"))
+        return ThumbnailCreators::audioThumbnailCreator;
+    if (name == Mime::kTypeTextPlain)
+        return ThumbnailCreators::textThumbnailCreator;
+    return nullptr;
+}
+
+QStringList collectFiles(const QStringList &paths)
+{
+    QStringList files;
+    for (const QString &path : paths) {
+        if (QFileInfo(path).isDir()) {
+            QDirIterator it(path, QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext())
+                files << it.next();
+        } else if (QFileInfo(path).isFile()) {
+            files << path;
+        }
+    }
+    return files;
+}
+
+ThumbnailSize parseSize(const QString &value)
+{
+    if (value == "small")
+        return kSmall;
+    if (value == "normal")
+        return kNormal;
+    return kLarge;
+}
+
+}   // namespace
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+
+    UrlRoute::regScheme(Global::Scheme::kFile, "/");
+    InfoFactory::regClass<SyncFileInfo>(Global::Scheme::kFile);
+
+    ThumbnailSize size = kLarge;
+    int repeat = 1;
+    QStringList paths;
+    const QStringList args = app.arguments().mid(1);
+    for (int i = 0; i < args.size(); ++i) {
+        if (args.at(i) == "--size" && i + 1 < args.size())
+            size = parseSize(args.at(++i));
+        else if (args.at(i) == "--repeat" && i + 1 < args.size())
+            repeat = qMax(1, args.at(++i).toInt());
+        else
+            paths << args.at(i);
+    }
+
+    const QStringList files = collectFiles(paths);
+    if (files.isEmpty()) {
+        qWarning() << "usage: dfm-thumbnail-bench [--size small|normal|large] [--repeat N] <file or dir>...";
+        return 1;
+    }
+
+    // 按类型分组，保证同组文件连续生成，峰值内存才能归到对应的类型
+    QMimeDatabase db;
+    QMap<QString, QStringList> groups;
+    for (const QString &file : files)
+        groups[db.mimeTypeForFile(file).name()] << file;
+
+    QMap<QString, FormatStat> stats;
+    for (auto it = groups.cbegin(); it != groups.cend(); ++it) {
+        Creator creator = creatorFor(db.mimeTypeForName(it.key()));
+        if (!creator)
+            continue;
+
+        FormatStat &stat = stats[it.key()];
+        resetPeakRss();
+        const qint64 baseKb = procStatusKb("VmRSS:");
+
+        for (int round = 0; round < repeat; ++round) {
+            for (const QString &file : it.value()) {
+                QElapsedTimer timer;
+                timer.start();
+                const QImage &img = creator(file, size);
+                const double ms = timer.nsecsElapsed() / 1e6;
+
+                ++stat.count;
+                stat.totalMs += ms;
+                stat.maxMs = qMax(stat.maxMs, ms);
+                if (img.isNull())
+                    ++stat.failed;
+            }
+        }
+
+        stat.peakKb = qMax<qint64>(0, procStatusKb("VmHWM:") - baseKb);
+    }
+
+    qInfo().noquote() << QString("%1 %2 %3 %4 %5 %6")
+                                 .arg("mime type", -40)
+                                 .arg("count", 6)
+                                 .arg("failed", 6)
+                                 .arg("avg ms", 9)
+                                 .arg("max ms", 9)
+                                 .arg("peak RSS MB", 12);
+    for (auto it = stats.cbegin(); it != stats.cend(); ++it) {
+        const FormatStat &stat = it.value();
+        qInfo().noquote() << QString("%1 %2 %3 %4 %5 %6")
+                                     .arg(it.key(), -40)
+                                     .arg(stat.count, 6)
+                                     .arg(stat.failed, 6)
+                                     .arg(stat.totalMs / qMax(1, stat.count), 9, 'f', 2)
+                                     .arg(stat.maxMs, 9, 'f', 2)
+                                     .arg(stat.peakKb / 1024.0, 12, 'f', 1);
+    }
+
+    return 0;
+}